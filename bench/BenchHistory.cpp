@@ -0,0 +1,162 @@
+/**
+ * @file BenchHistory.cpp
+ * @brief BenchHistoryimplementação do projeto Traveling Dragon.
+ *
+ * Mede as consultas do histórico de partidas (MatchHistory) com um histórico grande
+ * (2 * 10^7 partidas de 10^5 jogadores por padrão): média, percentis, histograma por
+ * dia e melhores partidas de um jogador e de todos, comparando a média com a mesma
+ * varredura sobre um vetor de structs (uma partida por elemento). Também mede a
+ * gravação e a leitura do arquivo e o tamanho dele por partida.
+ * Uso: bench_history [partidas] [jogadores].
+ */
+
+
+#include "MatchHistory.hpp" // Histórico medido
+#include <chrono>           // Para medir os tempos
+#include <cstdlib>          // Para std::atoll
+#include <filesystem>       // Para o tamanho e a remoção do arquivo gerado
+#include <iostream>         // Para saída dos resultados
+#include <random>           // Para sortear as partidas
+#include <string>           // Para os apelidos dos jogadores
+#include <vector>           // Para o vetor de structs da comparação
+
+/// @brief Relógio usado nas medições.
+using Relogio = std::chrono::steady_clock;
+
+/**
+ * @brief Retorna o tempo decorrido desde um instante, em milissegundos.
+ * @param inicio O instante inicial.
+ * @return O tempo decorrido.
+ */
+static double msDesde(Relogio::time_point inicio) {
+    return std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+}
+
+/**
+ * @brief Média de um jogador sobre um vetor de partidas inteiras (uma struct por partida).
+ * @param partidas As partidas.
+ * @param jogador O código do jogador.
+ * @return A média (0 sem partidas).
+ */
+static double mediaLinhas(const std::vector<MatchHistory::Partida>& partidas, int32_t jogador) {
+    int64_t soma = 0;
+    size_t quantidade = 0;
+    for (const MatchHistory::Partida& p : partidas) {
+        if (p.jogador == jogador) {
+            soma += p.pontuacao;
+            ++quantidade;
+        }
+    }
+    return quantidade ? (double)soma / quantidade : 0.0;
+}
+
+/**
+ * @brief Função principal do benchmark.
+ * @param argc Quantidade de argumentos.
+ * @param argv Quantidade de partidas (padrão 20000000) e de jogadores (padrão 100000).
+ * @return 0 se as consultas e a releitura deram os resultados esperados, 1 caso contrário.
+ */
+int main(int argc, char** argv) {
+    long long totalPartidas = argc > 1 ? std::atoll(argv[1]) : 20000000;
+    long long totalJogadores = argc > 2 ? std::atoll(argv[2]) : 100000;
+    if (totalPartidas <= 0 || totalJogadores <= 0 || totalJogadores > INT32_MAX) {
+        std::cerr << "Uso: bench_history [partidas] [jogadores]\n";
+        return 1;
+    }
+
+    // Partidas em ordem de tempo, uns poucos segundos entre elas, ao longo de vários dias
+    const uint32_t inicioHistorico = 1700000000u;
+    MatchHistory historico("bench_historico.dat");
+    std::vector<MatchHistory::Partida> linhas; // Só para a comparação com o vetor de structs
+    linhas.reserve((size_t)totalPartidas);
+    std::mt19937 sorteio(42);
+    std::uniform_int_distribution<int32_t> qualquerJogador(0, (int32_t)totalJogadores - 1);
+    std::geometric_distribution<int32_t> pontos(0.05);
+    for (long long j = 0; j < totalJogadores; ++j) {
+        historico.cadastrarApelido("jogador" + std::to_string(j)); // Códigos 0 a totalJogadores - 1
+    }
+    MatchHistory::Partida partida;
+    partida.instante = inicioHistorico;
+    for (long long i = 0; i < totalPartidas; ++i) {
+        partida.jogador = qualquerJogador(sorteio);
+        partida.pontuacao = pontos(sorteio);
+        partida.nivel = 1 + partida.pontuacao / 20;
+        partida.duracaoMs = 2000 + partida.pontuacao * 1500;
+        partida.batidas = 3 + partida.pontuacao * 4;
+        partida.instante += sorteio() % 4;
+        historico.registrar(partida);
+        linhas.push_back(partida);
+    }
+    int dias = (int)((partida.instante - inicioHistorico) / 86400) + 1;
+    const int32_t jogador = 7;
+    int erros = 0;
+
+    Relogio::time_point inicio = Relogio::now();
+    double media = historico.media(jogador);
+    double msMedia = msDesde(inicio);
+
+    inicio = Relogio::now();
+    double mediaStructs = mediaLinhas(linhas, jogador);
+    double msMediaStructs = msDesde(inicio);
+    if (media != mediaStructs) ++erros;
+    linhas.clear();
+    linhas.shrink_to_fit();
+
+    inicio = Relogio::now();
+    double mediaTodos = historico.media(MatchHistory::TODOS);
+    double msMediaTodos = msDesde(inicio);
+
+    inicio = Relogio::now();
+    std::vector<int> percentis = historico.calcularPercentis(jogador, {50.0, 90.0, 99.0});
+    double msPercentis = msDesde(inicio);
+
+    inicio = Relogio::now();
+    std::vector<int> percentisTodos = historico.calcularPercentis(MatchHistory::TODOS, {50.0, 90.0, 99.0});
+    double msPercentisTodos = msDesde(inicio);
+    if (percentis.size() != 3 || percentisTodos.size() != 3) return 1;
+
+    inicio = Relogio::now();
+    std::vector<int> porDia = historico.histogramaDiario(jogador, inicioHistorico, dias);
+    double msHistograma = msDesde(inicio);
+    long long somaDias = 0;
+    for (int n : porDia) somaDias += n;
+    if (somaDias != (long long)historico.contar(jogador)) ++erros;
+
+    inicio = Relogio::now();
+    std::vector<size_t> top = historico.melhores(MatchHistory::TODOS, 10);
+    double msMelhores = msDesde(inicio);
+    if (top.empty() || historico.getPartida(top[0]).pontuacao < percentisTodos[2]) ++erros;
+
+    std::error_code erro;
+    std::filesystem::remove("bench_historico.dat", erro);
+    inicio = Relogio::now();
+    if (!historico.salvar()) ++erros;
+    double msSalvar = msDesde(inicio);
+    double bytes = (double)std::filesystem::file_size("bench_historico.dat", erro);
+
+    MatchHistory relido("bench_historico.dat");
+    inicio = Relogio::now();
+    relido.carregar();
+    double msCarregar = msDesde(inicio);
+    int32_t jogadorRelido = relido.getCodigo(historico.getApelido(jogador)); // Os códigos mudam na releitura
+    if (relido.getQuantidade() != historico.getQuantidade() || relido.media(jogadorRelido) != media) ++erros;
+    std::filesystem::remove("bench_historico.dat", erro);
+
+    std::cout << totalPartidas << " partidas de " << totalJogadores << " jogadores, em " << dias << " dias.\n";
+    std::cout << "Media de um jogador: " << msMedia << " ms (vetor de structs: " << msMediaStructs << " ms).\n";
+    std::cout << "Media de todos: " << msMediaTodos << " ms (" << mediaTodos << ").\n";
+    std::cout << "Mediana, p90 e p99 de um jogador: " << msPercentis << " ms ("
+              << percentis[0] << ", " << percentis[1] << ", " << percentis[2] << ").\n";
+    std::cout << "Mediana, p90 e p99 de todos: " << msPercentisTodos << " ms ("
+              << percentisTodos[0] << ", " << percentisTodos[1] << ", " << percentisTodos[2] << ").\n";
+    std::cout << "Histograma diario de um jogador: " << msHistograma << " ms.\n";
+    std::cout << "10 melhores partidas de todos: " << msMelhores << " ms.\n";
+    std::cout << "Gravacao: " << msSalvar << " ms; leitura: " << msCarregar << " ms; "
+              << bytes / totalPartidas << " bytes por partida no arquivo (19 na memoria).\n";
+
+    if (erros > 0) {
+        std::cerr << "Erro: " << erros << " consulta(s) com resultado errado.\n";
+        return 1;
+    }
+    return 0;
+}
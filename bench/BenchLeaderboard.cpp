@@ -0,0 +1,151 @@
+/**
+ * @file BenchLeaderboard.cpp
+ * @brief BenchLeaderboardimplementação do projeto Traveling Dragon.
+ *
+ * Mede o ranking mantido em ordem (Leaderboard) com 10^6 jogadores por padrão:
+ * montagem, mudanças de pontuação, posição de um jogador, 10 primeiros e recorde
+ * geral, comparando com o que a tela de ranking e o fim de partida faziam antes
+ * (copiar e ordenar o cadastro, procurar o jogador na lista ordenada e percorrer
+ * todos os jogadores atrás do recorde). Uso: bench_leaderboard [jogadores] [operacoes].
+ */
+
+
+#include "Leaderboard.hpp" // Ranking medido
+#include "Player.hpp"      // Cadastro usado na comparação
+#include <algorithm>       // Para std::sort (ranking antigo)
+#include <chrono>          // Para medir os tempos
+#include <cstdlib>         // Para std::atoi
+#include <iostream>        // Para saída dos resultados
+#include <random>          // Para sortear pontuações e jogadores
+#include <string>          // Para montar os apelidos
+#include <vector>          // Para o cadastro
+
+/// @brief Relógio usado nas medições.
+using Relogio = std::chrono::steady_clock;
+
+/**
+ * @brief Retorna o tempo decorrido desde um instante, em nanossegundos.
+ * @param inicio O instante inicial.
+ * @return O tempo decorrido.
+ */
+static double nsDesde(Relogio::time_point inicio) {
+    return std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count();
+}
+
+/**
+ * @brief Posição de um jogador como a tela de ranking calculava antes: copia o cadastro,
+ * ordena por pontuação e procura o apelido na lista ordenada.
+ * @param jogadores O cadastro.
+ * @param apelido O apelido procurado.
+ * @param primeiro Recebe a pontuação do primeiro colocado.
+ * @return A posição, a partir de 1 (0 se não encontrado).
+ */
+static size_t posicaoOrdenando(const std::vector<Player>& jogadores, const std::string& apelido, int& primeiro) {
+    std::vector<Player> copia = jogadores;
+    std::sort(copia.begin(), copia.end(), [](const Player& a, const Player& b) {
+        return a.getMaiorPontuacao() > b.getMaiorPontuacao();
+    });
+    primeiro = copia.empty() ? 0 : copia[0].getMaiorPontuacao();
+    for (size_t i = 0; i < copia.size(); ++i) {
+        if (copia[i].getApelido() == apelido) return i + 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Função principal do benchmark.
+ * @param argc Quantidade de argumentos.
+ * @param argv Quantidade de jogadores (padrão 1000000) e de operações medidas (padrão 1000000).
+ * @return 0 se o ranking concordou com as contas feitas à mão, 1 caso contrário.
+ */
+int main(int argc, char** argv) {
+    int totalJogadores = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int totalOperacoes = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    if (totalJogadores <= 0 || totalOperacoes <= 0) {
+        std::cerr << "Uso: bench_leaderboard [jogadores] [operacoes]\n";
+        return 1;
+    }
+
+    std::mt19937 sorteio(42);
+    std::geometric_distribution<int> pontos(0.01);
+    std::vector<Player> jogadores;
+    std::vector<int> pontuacoes;
+    jogadores.reserve(totalJogadores);
+    pontuacoes.reserve(totalJogadores);
+    for (int i = 0; i < totalJogadores; ++i) {
+        int maior = pontos(sorteio);
+        std::string apelido = "jogador" + std::to_string(i);
+        jogadores.emplace_back(apelido, apelido, 1, maior);
+        pontuacoes.push_back(maior);
+    }
+    std::uniform_int_distribution<int> qualquer(0, totalJogadores - 1);
+    int erros = 0;
+
+    Leaderboard ranking;
+    Relogio::time_point inicio = Relogio::now();
+    ranking.reconstruir(pontuacoes);
+    double nsMontagem = nsDesde(inicio);
+
+    // Partidas que batem o recorde pessoal: o jogador sobe no ranking
+    std::vector<int> ids(totalOperacoes);
+    for (int& id : ids) id = qualquer(sorteio);
+    inicio = Relogio::now();
+    for (int id : ids) {
+        pontuacoes[id] += 1 + (int)(sorteio() % 50);
+        ranking.atualizar(id, pontuacoes[id]);
+    }
+    double nsAtualizacao = nsDesde(inicio);
+
+    inicio = Relogio::now();
+    size_t somaPosicoes = 0;
+    for (int id : ids) somaPosicoes += ranking.getPosicao(id);
+    double nsPosicao = nsDesde(inicio);
+    if (somaPosicoes == 0) ++erros;
+
+    inicio = Relogio::now();
+    long long somaTop = 0;
+    for (int i = 0; i < totalOperacoes; ++i) somaTop += ranking.melhores(10).back();
+    double nsTop = nsDesde(inicio);
+
+    inicio = Relogio::now();
+    long long somaRecorde = 0;
+    for (int i = 0; i < totalOperacoes; ++i) somaRecorde += ranking.getRecorde();
+    double nsRecorde = nsDesde(inicio);
+
+    // O que era feito antes, com o cadastro atualizado
+    for (int i = 0; i < totalJogadores; ++i) {
+        jogadores[i] = Player(jogadores[i].getNome(), jogadores[i].getApelido(), 1, pontuacoes[i]);
+    }
+    int recordeOrdenando = 0;
+    inicio = Relogio::now();
+    size_t posicaoAntiga = posicaoOrdenando(jogadores, jogadores[ids[0]].getApelido(), recordeOrdenando);
+    double nsOrdenando = nsDesde(inicio);
+
+    inicio = Relogio::now();
+    int recordeVarrendo = 0;
+    for (const Player& p : jogadores) recordeVarrendo = std::max(recordeVarrendo, p.getMaiorPontuacao());
+    double nsVarrendo = nsDesde(inicio);
+
+    // O sort antigo não desempata: confere a posição pela quantidade de pontuações maiores
+    size_t maiores = 0;
+    for (int p : pontuacoes) maiores += p > pontuacoes[ids[0]];
+    size_t posicaoNova = ranking.getPosicao(ids[0]);
+    if (posicaoAntiga <= maiores || posicaoNova <= maiores) ++erros;
+    if (recordeVarrendo != ranking.getRecorde() || recordeOrdenando != recordeVarrendo) ++erros;
+    if (ranking.getJogadorNaPosicao(posicaoNova) != ids[0]) ++erros;
+
+    std::cout << totalJogadores << " jogadores; ranking montado em " << nsMontagem / 1e6 << " ms.\n";
+    std::cout << "Mudanca de pontuacao: " << nsAtualizacao / totalOperacoes << " ns.\n";
+    std::cout << "Posicao de um jogador: " << nsPosicao / totalOperacoes << " ns (copiando e ordenando: "
+              << nsOrdenando / 1e6 << " ms).\n";
+    std::cout << "10 primeiros: " << nsTop / totalOperacoes << " ns.\n";
+    std::cout << "Recorde geral: " << nsRecorde / totalOperacoes << " ns (percorrendo os jogadores: "
+              << nsVarrendo / 1e6 << " ms).\n";
+    if (somaTop < 0 || somaRecorde < 0) ++erros; // Usa as somas (o compilador não descarta os laços)
+
+    if (erros > 0) {
+        std::cerr << "Erro: " << erros << " resultado(s) do ranking nao conferem.\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file BenchLeaderboardService.cpp
+ * @brief BenchLeaderboardServiceimplementação do projeto Traveling Dragon.
+ *
+ * Mede o serviço de ranking compartilhado: um LeaderboardServer em uma thread e N
+ * gabinetes (LeaderboardClient, cada um com a sua conexão e a sua thread de envio)
+ * mandando partidas ao mesmo tempo. Mede as partidas por segundo que o serviço
+ * confirma, quanto tempo `enviar` segura a thread do jogo e, para comparar, uma ida
+ * e volta por partida (esperando a confirmação de cada uma). No fim, confere se
+ * nenhuma partida se perdeu. Uso: bench_leaderboard_service [gabinetes] [partidas por gabinete].
+ */
+
+
+#include "LeaderboardClient.hpp" // Gabinetes
+#include "LeaderboardServer.hpp" // Serviço medido
+#include <algorithm>             // Para std::max e std::sort (tempos de `enviar`)
+#include <chrono>                // Para medir os tempos
+#include <cstdlib>               // Para std::atoi
+#include <filesystem>            // Para a pasta do socket
+#include <iostream>              // Para saída dos resultados
+#include <memory>                // Para std::unique_ptr (gabinetes)
+#include <string>                // Para os apelidos
+#include <vector>                // Para os gabinetes
+
+/// @brief Relógio usado nas medições.
+using Relogio = std::chrono::steady_clock;
+
+/// @brief Pasta do socket e dos arquivos de pendentes.
+static const char* PASTA = "bench_servico_ranking";
+
+/**
+ * @brief Corpo da thread que roda o serviço até `parar`.
+ * @param thread A thread atual (não usada).
+ * @param arg Ponteiro para o LeaderboardServer.
+ * @return Sempre nullptr.
+ */
+static void* rodarServico(ALLEGRO_THREAD* thread, void* arg) {
+    (void)thread;
+    static_cast<LeaderboardServer*>(arg)->executar();
+    return nullptr;
+}
+
+/**
+ * @brief Função principal do benchmark.
+ * @param argc Quantidade de argumentos.
+ * @param argv Gabinetes (padrão 16) e partidas por gabinete (padrão 20000).
+ * @return 0 se todas as partidas foram contadas, 1 caso contrário.
+ */
+int main(int argc, char** argv) {
+    int gabinetes = argc > 1 ? std::atoi(argv[1]) : 16;
+    int partidas = argc > 2 ? std::atoi(argv[2]) : 20000;
+    if (gabinetes <= 0 || partidas <= 0) {
+        std::cerr << "Uso: bench_leaderboard_service [gabinetes] [partidas por gabinete]\n";
+        return 1;
+    }
+
+    std::error_code erro;
+    std::filesystem::remove_all(PASTA, erro);
+    std::filesystem::create_directories(PASTA, erro);
+    std::filesystem::path pasta(PASTA);
+    std::string socket = (pasta / "ranking.sock").string();
+    int erros = 0;
+
+    LeaderboardServer servico(socket);
+    if (!servico.iniciar()) return 1;
+    ALLEGRO_THREAD* thread = al_create_thread(&rodarServico, &servico);
+    if (!thread) return 1;
+    al_start_thread(thread);
+
+    // Uma ida e volta por partida: o jogo esperaria a confirmação de cada uma
+    double msPorPartida = 0;
+    {
+        LeaderboardClient sozinho(socket, (pasta / "sozinho.txt").string(), LeaderboardClient::LIMITE_PADRAO, 0);
+        const int vezes = 500;
+        Relogio::time_point inicio = Relogio::now();
+        for (int i = 0; i < vezes; ++i) {
+            sozinho.enviar("sozinho", i);
+            if (!sozinho.aguardar(5000)) ++erros;
+        }
+        msPorPartida = std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count() / vezes;
+    }
+
+    // Todos os gabinetes ao mesmo tempo, cada um entregando as partidas o mais rápido que pode
+    std::vector<std::unique_ptr<LeaderboardClient>> clientes;
+    for (int g = 0; g < gabinetes; ++g) {
+        clientes.emplace_back(new LeaderboardClient(socket, (pasta / ("g" + std::to_string(g) + ".txt")).string(),
+                                                    (size_t)partidas));
+    }
+    std::vector<std::string> apelidos;
+    for (int i = 0; i < 1000; ++i) apelidos.push_back("jogador" + std::to_string(i));
+    std::vector<float> enviarUs;
+    enviarUs.reserve((size_t)gabinetes * partidas);
+    Relogio::time_point inicio = Relogio::now();
+    for (int k = 0; k < partidas; ++k) {
+        for (int g = 0; g < gabinetes; ++g) {
+            Relogio::time_point antes = Relogio::now();
+            clientes[g]->enviar(apelidos[(g * 7 + k) % 1000], k);
+            enviarUs.push_back(std::chrono::duration<float, std::micro>(Relogio::now() - antes).count());
+        }
+    }
+    double msEntrega = std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+    for (std::unique_ptr<LeaderboardClient>& cliente : clientes) {
+        if (!cliente->aguardar(60000)) ++erros;
+    }
+    double ms = std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+
+    long long lotes = 0;
+    long long descartadas = 0;
+    for (std::unique_ptr<LeaderboardClient>& cliente : clientes) {
+        LeaderboardClient::Estatisticas e = cliente->getEstatisticas();
+        lotes += e.lotes;
+        descartadas += e.descartadas;
+    }
+    clientes.clear();
+
+    servico.parar();
+    al_join_thread(thread, nullptr);
+    al_destroy_thread(thread);
+
+    long long total = (long long)gabinetes * partidas;
+    const LeaderboardServer::Estatisticas& e = servico.getEstatisticas();
+    if (e.partidas != total + 500 || descartadas != 0 || e.repetidas != 0) ++erros;
+    if (servico.getRanking().getRecorde() != std::max(partidas - 1, 499)) ++erros;
+
+    std::cout << "Uma ida e volta por partida: " << msPorPartida << " ms por partida ("
+              << (long long)(1000.0 / msPorPartida) << " partidas/s).\n";
+    std::cout << gabinetes << " gabinete(s): " << total << " partidas confirmadas em " << ms << " ms ("
+              << (long long)(total / (ms / 1000.0)) << " partidas/s, " << lotes << " lotes).\n";
+    std::sort(enviarUs.begin(), enviarUs.end()); // Com poucos núcleos, o pior caso é a thread do jogo sem CPU
+    std::cout << "enviar na thread do jogo: " << msEntrega * 1000.0 / total << " us em media, p99 "
+              << enviarUs[enviarUs.size() * 99 / 100] << " us, pior caso " << enviarUs.back() << " us.\n";
+
+    std::filesystem::remove_all(PASTA, erro);
+    if (erros > 0) {
+        std::cerr << "Erro: " << erros << " resultado(s) do servico de ranking nao conferem.\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file BenchNicknames.cpp
+ * @brief BenchNicknamesimplementação do projeto Traveling Dragon.
+ *
+ * Mede o índice de prefixos dos apelidos (NicknameIndex) com 10^6 jogadores por padrão:
+ * montagem, cada tecla de um apelido digitado letra a letra (com algumas apagadas no
+ * meio) e mudanças de pontuação, comparando com procurar o prefixo em todos os
+ * apelidos a cada tecla. Uso: bench_nicknames [jogadores] [apelidos digitados].
+ */
+
+
+#include "NicknameIndex.hpp" // Índice medido
+#include "Player.hpp"        // Cadastro indexado
+#include <algorithm>         // Para std::sort (comparação)
+#include <chrono>            // Para medir os tempos
+#include <cstdlib>           // Para std::atoi
+#include <iostream>          // Para saída dos resultados
+#include <random>            // Para sortear apelidos e pontuações
+#include <string>            // Para montar os apelidos
+#include <vector>            // Para o cadastro
+
+/// @brief Relógio usado nas medições.
+using Relogio = std::chrono::steady_clock;
+
+/// @brief Sugestões pedidas a cada tecla (as que o menu mostra).
+static const size_t SUGESTOES = 3;
+
+/**
+ * @brief Retorna o tempo decorrido desde um instante, em nanossegundos.
+ * @param inicio O instante inicial.
+ * @return O tempo decorrido.
+ */
+static double nsDesde(Relogio::time_point inicio) {
+    return std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count();
+}
+
+/**
+ * @brief Sugestões sem índice: percorre todos os apelidos e ordena os que começam com o prefixo.
+ * @param jogadores O cadastro.
+ * @param prefixo O começo do apelido.
+ * @return Os Ids das SUGESTOES melhores, como o índice ordena.
+ */
+static std::vector<uint32_t> sugerirVarrendo(const std::vector<Player>& jogadores, const std::string& prefixo) {
+    std::vector<uint32_t> achados;
+    for (uint32_t i = 0; i < jogadores.size(); ++i) {
+        if (jogadores[i].getApelido().compare(0, prefixo.size(), prefixo) == 0) achados.push_back(i);
+    }
+    std::sort(achados.begin(), achados.end(), [&](uint32_t a, uint32_t b) {
+        int pa = jogadores[a].getMaiorPontuacao(), pb = jogadores[b].getMaiorPontuacao();
+        if (pa != pb) return pa > pb;
+        int c = jogadores[a].getApelido().compare(jogadores[b].getApelido());
+        return c != 0 ? c < 0 : a < b;
+    });
+    if (achados.size() > SUGESTOES) achados.resize(SUGESTOES);
+    return achados;
+}
+
+/**
+ * @brief Função principal do benchmark.
+ * @param argc Quantidade de argumentos.
+ * @param argv Quantidade de jogadores (padrão 1000000) e de apelidos digitados (padrão 10000).
+ * @return 0 se as sugestões conferiram com a busca em todos os apelidos, 1 caso contrário.
+ */
+int main(int argc, char** argv) {
+    int totalJogadores = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int totalDigitados = argc > 2 ? std::atoi(argv[2]) : 10000;
+    if (totalJogadores <= 0 || totalDigitados <= 0) {
+        std::cerr << "Uso: bench_nicknames [jogadores] [apelidos digitados]\n";
+        return 1;
+    }
+
+    // Apelidos de 4 a 12 letras de um alfabeto pequeno: muitos prefixos em comum
+    std::mt19937 sorteio(42);
+    std::uniform_int_distribution<int> tamanho(4, 12);
+    std::uniform_int_distribution<int> letra(0, 11);
+    std::geometric_distribution<int> pontos(0.01);
+    std::vector<Player> jogadores;
+    jogadores.reserve(totalJogadores);
+    for (int i = 0; i < totalJogadores; ++i) {
+        std::string apelido;
+        for (int k = tamanho(sorteio); k > 0; --k) apelido += (char)('a' + letra(sorteio));
+        jogadores.emplace_back(apelido, apelido, 1, pontos(sorteio));
+    }
+    std::uniform_int_distribution<int> qualquer(0, totalJogadores - 1);
+    int erros = 0;
+
+    NicknameIndex indice;
+    Relogio::time_point inicio = Relogio::now();
+    indice.reconstruir(jogadores);
+    double nsMontagem = nsDesde(inicio);
+
+    // Cada apelido digitado é um existente, letra a letra, apagando uma letra a cada três
+    std::vector<std::string> teclas;
+    for (int i = 0; i < totalDigitados; ++i) {
+        const std::string& alvo = jogadores[qualquer(sorteio)].getApelido();
+        std::string digitado;
+        for (size_t k = 0; k < alvo.size(); ++k) {
+            digitado += alvo[k];
+            teclas.push_back(digitado);
+            if (k % 3 == 2) {
+                teclas.push_back(digitado.substr(0, k)); // Backspace
+                teclas.push_back(digitado);              // E a letra de novo
+            }
+        }
+        teclas.push_back(""); // Campo limpo para o próximo apelido
+    }
+
+    size_t somaSugestoes = 0;
+    inicio = Relogio::now();
+    for (const std::string& prefixo : teclas) somaSugestoes += indice.sugerir(prefixo, SUGESTOES, jogadores).size();
+    double nsTecla = nsDesde(inicio);
+
+    // Partidas que mudam o recorde de jogadores quaisquer
+    std::vector<int> ids(totalDigitados);
+    for (int& id : ids) id = qualquer(sorteio);
+    inicio = Relogio::now();
+    for (int id : ids) {
+        int nova = jogadores[id].getMaiorPontuacao() + 1 + (int)(sorteio() % 50);
+        jogadores[id] = Player(jogadores[id].getNome(), jogadores[id].getApelido(), 1, nova);
+        indice.atualizar((uint32_t)id, nova);
+    }
+    double nsAtualizacao = nsDesde(inicio);
+
+    // Sem índice, cada tecla percorre o cadastro todo; confere algumas teclas com o índice
+    size_t conferidas = std::min<size_t>(teclas.size(), 20);
+    double nsVarrendo = 0;
+    for (size_t i = 0; i < conferidas; ++i) {
+        const std::string& prefixo = teclas[teclas.size() / conferidas * i];
+        inicio = Relogio::now();
+        std::vector<uint32_t> esperado = sugerirVarrendo(jogadores, prefixo);
+        nsVarrendo += nsDesde(inicio);
+        if (indice.sugerir(prefixo, SUGESTOES, jogadores) != esperado) ++erros;
+    }
+
+    std::cout << totalJogadores << " apelidos; indice montado em " << nsMontagem / 1e6 << " ms.\n";
+    std::cout << "Sugestoes por tecla: " << nsTecla / teclas.size() / 1e3 << " us ("
+              << teclas.size() << " teclas; percorrendo os apelidos: " << nsVarrendo / conferidas / 1e6 << " ms).\n";
+    std::cout << "Mudanca de pontuacao: " << nsAtualizacao / totalDigitados << " ns.\n";
+    if (somaSugestoes == 0) ++erros;
+
+    if (erros > 0) {
+        std::cerr << "Erro: " << erros << " sugestao(oes) do indice nao conferem.\n";
+        return 1;
+    }
+    return 0;
+}
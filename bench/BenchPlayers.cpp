@@ -0,0 +1,184 @@
+/**
+ * @file BenchPlayers.cpp
+ * @brief BenchPlayersimplementação do projeto Traveling Dragon.
+ *
+ * Mede o cadastro e a busca de jogadores no PlayerManager com um cadastro grande
+ * (10^6 jogadores por padrão), comparando a busca pelo índice de apelidos com a
+ * varredura linear usada antes, e a carga do banco binário com a leitura do
+ * arquivo de texto antigo. Uso: bench_players [jogadores] [buscas] [partidas].
+ */
+
+
+#include "PlayerManager.hpp" // Cadastro e índice de apelidos
+#include "PlayerDatabase.hpp" // Banco binário medido na carga
+#include <chrono>            // Para medir os tempos
+#include <cstdlib>           // Para std::atoi
+#include <filesystem>        // Para apagar os arquivos gerados
+#include <fstream>           // Para gravar e ler o arquivo de texto antigo
+#include <iostream>          // Para saída dos resultados
+#include <random>            // Para sortear os apelidos buscados
+#include <string>            // Para montar os apelidos
+#include <unordered_map>     // Para o índice montado na carga do texto antigo
+#include <vector>            // Para a lista de apelidos buscados
+
+/// @brief Relógio usado nas medições.
+using Relogio = std::chrono::steady_clock;
+
+/**
+ * @brief Retorna o tempo decorrido desde um instante, em nanossegundos.
+ * @param inicio O instante inicial.
+ * @return O tempo decorrido.
+ */
+static double nsDesde(Relogio::time_point inicio) {
+    return std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count();
+}
+
+/**
+ * @brief Busca linear por apelido, como o PlayerManager fazia antes do índice.
+ * @param jogadores O cadastro.
+ * @param apelido O apelido procurado.
+ * @return O jogador encontrado, ou nullptr.
+ */
+static const Player* buscarVarrendo(const std::vector<Player>& jogadores, const std::string& apelido) {
+    for (const Player& p : jogadores) {
+        if (p.getApelido() == apelido) return &p;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Carrega o arquivo de texto antigo como o PlayerManager fazia antes do banco binário:
+ * cada jogador é refeito chamando `adicionarPartida` uma vez por partida registrada e o
+ * índice de apelidos é montado do zero.
+ * @param caminho O arquivo de texto.
+ * @param indice Recebe o índice de apelidos.
+ * @return Os jogadores lidos.
+ */
+static std::vector<Player> carregarTextoAntigo(const std::string& caminho, std::unordered_map<std::string, int>& indice) {
+    std::vector<Player> jogadores;
+    std::ifstream arq(caminho);
+    std::string nome, apelido;
+    int partidas, maiorPontuacao;
+    while (arq >> nome >> apelido >> partidas >> maiorPontuacao) {
+        Player p(nome, apelido);
+        for (int i = 0; i < partidas; ++i) p.adicionarPartida(maiorPontuacao);
+        indice.emplace(apelido, (int)jogadores.size());
+        jogadores.push_back(p);
+    }
+    return jogadores;
+}
+
+/**
+ * @brief Função principal do benchmark.
+ * @param argc Quantidade de argumentos.
+ * @param argv Quantidade de jogadores (padrão 1000000), de buscas (padrão 1000000) e de
+ * partidas por jogador nos arquivos carregados (padrão 100).
+ * @return 0 se todas as buscas encontraram o jogador certo, 1 caso contrário.
+ */
+int main(int argc, char** argv) {
+    int totalJogadores = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int totalBuscas = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    int partidasPorJogador = argc > 3 ? std::atoi(argv[3]) : 100;
+    if (totalJogadores <= 0 || totalBuscas <= 0 || partidasPorJogador < 0) {
+        std::cerr << "Uso: bench_players [jogadores] [buscas] [partidas]\n";
+        return 1;
+    }
+
+    // Sem `carregar` o diário não é aberto: o cadastro fica só na memória
+    PlayerManager manager("bench_players.dat");
+
+    Relogio::time_point inicio = Relogio::now();
+    PlayerManager::Id primeiro = manager.cadastrar("Jogador0", "jogador0");
+    for (int i = 1; i < totalJogadores; ++i) {
+        std::string apelido = "jogador" + std::to_string(i);
+        manager.cadastrar(apelido, apelido);
+    }
+    double nsCadastro = nsDesde(inicio);
+
+    // O Id do primeiro jogador continua valendo depois de o vetor crescer muitas vezes
+    Player* jogadorPrimeiro = manager.getJogador(primeiro);
+    bool idEstavel = jogadorPrimeiro && jogadorPrimeiro->getApelido() == "jogador0";
+
+    std::mt19937 sorteio(42);
+    std::uniform_int_distribution<int> qualquer(0, totalJogadores - 1);
+    std::vector<std::string> apelidos;
+    apelidos.reserve(totalBuscas);
+    for (int i = 0; i < totalBuscas; ++i) {
+        apelidos.push_back("jogador" + std::to_string(qualquer(sorteio)));
+    }
+
+    int erros = 0;
+    inicio = Relogio::now();
+    for (const std::string& apelido : apelidos) {
+        Player* p = manager.buscar(apelido);
+        if (!p || p->getApelido() != apelido) ++erros;
+    }
+    double nsIndice = nsDesde(inicio);
+
+    inicio = Relogio::now();
+    for (int i = 0; i < totalBuscas; ++i) {
+        if (manager.buscar("ausente" + std::to_string(i))) ++erros;
+    }
+    double nsAusentes = nsDesde(inicio);
+
+    // A varredura é milhares de vezes mais lenta: poucas buscas já dão a média
+    int buscasVarrendo = totalBuscas < 200 ? totalBuscas : 200;
+    inicio = Relogio::now();
+    for (int i = 0; i < buscasVarrendo; ++i) {
+        if (!buscarVarrendo(manager.getJogadores(), apelidos[i])) ++erros;
+    }
+    double nsVarrendo = nsDesde(inicio);
+
+    std::cout << totalJogadores << " jogadores cadastrados em " << nsCadastro / 1e6 << " ms ("
+              << nsCadastro / totalJogadores << " ns cada).\n";
+    std::cout << "Busca pelo indice: " << nsIndice / totalBuscas << " ns por busca ("
+              << totalBuscas << " buscas).\n";
+    std::cout << "Busca de apelido inexistente: " << nsAusentes / totalBuscas << " ns por busca.\n";
+    std::cout << "Busca varrendo o vetor (antiga): " << nsVarrendo / buscasVarrendo / 1000.0
+              << " us por busca (" << buscasVarrendo << " buscas).\n";
+    std::cout << "Id do primeiro jogador " << (idEstavel ? "continua valido" : "INVALIDO") << " apos os cadastros.\n";
+
+    // Carga: o mesmo cadastro, com um histórico de partidas, em texto e no banco binário
+    const std::string caminhoTexto = "bench_players.txt";
+    const std::string caminhoBanco = "bench_players.dat";
+    {
+        std::ofstream texto(caminhoTexto);
+        std::vector<Player> comHistorico;
+        comHistorico.reserve(manager.getJogadores().size());
+        for (const Player& p : manager.getJogadores()) {
+            texto << p.getNome() << " " << p.getApelido() << " " << partidasPorJogador << " 42\n";
+            comHistorico.emplace_back(p.getNome(), p.getApelido(), partidasPorJogador, 42);
+        }
+        PlayerDatabase::gravar(caminhoBanco, comHistorico, 0);
+    }
+
+    inicio = Relogio::now();
+    std::unordered_map<std::string, int> indiceTexto;
+    std::vector<Player> doTexto = carregarTextoAntigo(caminhoTexto, indiceTexto);
+    double nsTexto = nsDesde(inicio);
+
+    double nsBanco;
+    {
+        PlayerManager carregado(caminhoBanco, MatchJournal::SYNC_NUNCA);
+        inicio = Relogio::now();
+        carregado.carregar();
+        nsBanco = nsDesde(inicio);
+        if (carregado.getJogadores().size() != doTexto.size()) ++erros;
+        Player* p = carregado.buscar(apelidos[0]); // Busca pelo índice que veio pronto no banco
+        if (!p || p->getApelido() != apelidos[0] || p->getPartidas() != partidasPorJogador) ++erros;
+    }
+    std::error_code erro;
+    std::filesystem::remove(caminhoTexto, erro);
+    std::filesystem::remove(caminhoBanco, erro);
+    std::filesystem::remove("bench_players.journal", erro);
+
+    std::cout << "Carga do texto antigo (" << partidasPorJogador << " partidas por jogador): "
+              << nsTexto / 1e6 << " ms.\n";
+    std::cout << "Carga do banco binario: " << nsBanco / 1e6 << " ms.\n";
+
+    if (erros > 0 || !idEstavel) {
+        std::cerr << "Erro: " << erros << " busca(s) com resultado errado.\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file BenchSharedPlayers.cpp
+ * @brief BenchSharedPlayersimplementação do projeto Traveling Dragon.
+ *
+ * Mede o cadastro compartilhado por vários jogos: abre N processos escritores (o
+ * próprio benchmark, chamado com "escritor") que registram partidas no mesmo
+ * players.dat ao mesmo tempo, cada um com o seu jogador e todos com um jogador em
+ * comum, compactando o diário como o jogo faz. No fim, confere se nenhuma partida
+ * se perdeu e se a maior pontuação do jogador em comum é a maior de todos os
+ * processos. Uso: bench_shared_players [processos] [partidas por processo] [sincronia 0-2].
+ */
+
+
+#include "PlayerManager.hpp" // Cadastro compartilhado
+#include <allegro5/allegro.h> // Para as threads que esperam cada processo
+#include <chrono>            // Para medir os tempos
+#include <cstdlib>           // Para std::atoi e std::system
+#include <filesystem>        // Para a pasta do cadastro compartilhado
+#include <iostream>          // Para saída dos resultados
+#include <string>            // Para montar as linhas de comando
+#include <vector>            // Para as threads dos processos
+
+/// @brief Relógio usado nas medições.
+using Relogio = std::chrono::steady_clock;
+
+/// @brief Pasta do cadastro compartilhado (relativa, sem espaços, para a linha de comando).
+static const char* PASTA = "bench_compartilhado";
+
+/**
+ * @brief Pontuação da partida `k` do processo `i` (as do processo seguinte são sempre maiores).
+ */
+static int pontuacao(int i, int k) {
+    return (i + 1) * 1000000 + k;
+}
+
+/**
+ * @brief Corpo de um processo escritor: registra as partidas e sai (o destrutor grava o resto).
+ * Partidas pares vão para o jogador do processo; ímpares, para o jogador em comum.
+ * @return 0 se tudo foi registrado.
+ */
+static int escritor(const std::string& pasta, int indice, int partidas, int sincronia) {
+    PlayerManager cadastro((std::filesystem::path(pasta) / "players.dat").string(), (MatchJournal::Sincronia)sincronia);
+    cadastro.carregar();
+    PlayerManager::Id proprio = cadastro.cadastrar("Gabinete", "gabinete" + std::to_string(indice));
+    PlayerManager::Id comum = cadastro.cadastrar("Comum", "comum");
+    for (int k = 0; k < partidas; ++k) {
+        if (!cadastro.registrarPartida(k % 2 == 0 ? proprio : comum, pontuacao(indice, k))) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Linha de comando de um processo e o código que ele devolveu.
+ */
+struct Processo {
+    std::string comando; ///< @brief Linha de comando.
+    int codigo = -1;     ///< @brief Código de saída.
+};
+
+/**
+ * @brief Corpo da thread que roda um processo e espera ele terminar.
+ * @param thread A thread atual (não usada).
+ * @param arg Ponteiro para o Processo.
+ * @return Sempre nullptr.
+ */
+static void* rodarProcesso(ALLEGRO_THREAD* thread, void* arg) {
+    Processo* processo = static_cast<Processo*>(arg);
+    processo->codigo = std::system(processo->comando.c_str());
+    return nullptr;
+}
+
+/**
+ * @brief Roda `processos` escritores ao mesmo tempo e confere o cadastro resultante.
+ * @param programa Caminho deste executável.
+ * @param processos Quantidade de processos.
+ * @param partidas Partidas por processo (par).
+ * @param sincronia Política de sincronia do diário.
+ * @param erros Recebe +1 a cada resultado que não confere.
+ */
+static void medir(const std::string& programa, int processos, int partidas, int sincronia, int& erros) {
+    std::error_code erro;
+    std::filesystem::remove_all(PASTA, erro);
+    std::filesystem::create_directories(PASTA, erro);
+
+    std::vector<Processo> lista(processos);
+    std::vector<ALLEGRO_THREAD*> threads;
+    Relogio::time_point inicio = Relogio::now();
+    for (int i = 0; i < processos; ++i) {
+        lista[i].comando = "\"" + programa + "\" escritor " + PASTA + " " + std::to_string(i) + " " +
+                           std::to_string(partidas) + " " + std::to_string(sincronia);
+        ALLEGRO_THREAD* t = al_create_thread(&rodarProcesso, &lista[i]);
+        if (t) {
+            al_start_thread(t);
+            threads.push_back(t);
+        } else {
+            rodarProcesso(nullptr, &lista[i]);
+        }
+    }
+    for (ALLEGRO_THREAD* t : threads) {
+        al_join_thread(t, nullptr);
+        al_destroy_thread(t);
+    }
+    double ms = std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+    for (const Processo& p : lista) {
+        if (p.codigo != 0) ++erros;
+    }
+
+    // Confere o cadastro que ficou: nenhuma partida perdida, maiores pontuações juntadas
+    PlayerManager cadastro((std::filesystem::path(PASTA) / "players.dat").string(), MatchJournal::SYNC_NUNCA);
+    cadastro.carregar();
+    long long total = (long long)processos * partidas;
+    Player* comum = cadastro.buscar("comum");
+    if (!comum || comum->getPartidas() != processos * (partidas / 2) ||
+        comum->getMaiorPontuacao() != pontuacao(processos - 1, partidas - 1)) {
+        ++erros;
+    }
+    for (int i = 0; i < processos; ++i) {
+        Player* proprio = cadastro.buscar("gabinete" + std::to_string(i));
+        if (!proprio || proprio->getPartidas() != partidas / 2 || proprio->getMaiorPontuacao() != pontuacao(i, partidas - 2)) {
+            ++erros;
+        }
+    }
+    if ((long long)cadastro.getPontuacoesPartidas().getTotal() != total) ++erros;
+
+    std::cout << processos << " processo(s): " << total << " partidas em " << ms << " ms ("
+              << (long long)(total / (ms / 1000.0)) << " partidas/s, contando a abertura dos processos).\n";
+}
+
+/**
+ * @brief Função principal do benchmark (ou de um processo escritor).
+ * @param argc Quantidade de argumentos.
+ * @param argv Processos (padrão 8), partidas por processo (padrão 20000) e sincronia (padrão 1, grupo);
+ * ou "escritor" seguido da pasta, do índice, das partidas e da sincronia.
+ * @return 0 se o cadastro conferiu, 1 caso contrário.
+ */
+int main(int argc, char** argv) {
+    if (argc == 6 && std::string(argv[1]) == "escritor") {
+        return escritor(argv[2], std::atoi(argv[3]), std::atoi(argv[4]), std::atoi(argv[5]));
+    }
+
+    int processos = argc > 1 ? std::atoi(argv[1]) : 8;
+    int partidas = argc > 2 ? std::atoi(argv[2]) : 20000;
+    int sincronia = argc > 3 ? std::atoi(argv[3]) : (int)MatchJournal::SYNC_GRUPO;
+    if (processos <= 0 || partidas <= 0 || partidas % 2 != 0 || sincronia < 0 || sincronia > 2) {
+        std::cerr << "Uso: bench_shared_players [processos] [partidas por processo (par)] [sincronia 0-2]\n";
+        return 1;
+    }
+
+    int erros = 0;
+    medir(argv[0], 1, partidas, sincronia, erros); // Referência: um jogo só
+    if (processos > 1) medir(argv[0], processos, partidas, sincronia, erros);
+
+    std::error_code erro;
+    std::filesystem::remove_all(PASTA, erro);
+    if (erros > 0) {
+        std::cerr << "Erro: " << erros << " resultado(s) do cadastro compartilhado nao conferem.\n";
+        return 1;
+    }
+    return 0;
+}
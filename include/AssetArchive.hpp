@@ -0,0 +1,158 @@
+/**
+ * @file AssetArchive.hpp
+ * @brief AssetArchiveheader do projeto Traveling Dragon.
+ */
+
+#ifndef ASSETARCHIVE_HPP
+#define ASSETARCHIVE_HPP
+
+#include <allegro5/allegro.h>       // Para ALLEGRO_FILE e ALLEGRO_BITMAP
+#include <allegro5/allegro_audio.h> // Para ALLEGRO_SAMPLE e ALLEGRO_AUDIO_STREAM
+#include <allegro5/allegro_font.h>  // Para ALLEGRO_FONT
+#include <cstddef>                  // Para size_t
+#include <cstdint>                  // Para tipos de tamanho fixo do formato
+#include <string>                   // Para usar std::string (nomes dos assets)
+#include <unordered_map>            // Para usar std::unordered_map (índice do pacote)
+#include "MappedFile.hpp"           // Mapeamento do arquivo do pacote
+
+/**
+ * @brief Pacote com todos os assets do jogo em um único arquivo, lido por mapeamento em memória.
+ *
+ * Formato (inteiros little-endian):
+ * - cabeçalho de 16 bytes: "TDPK", versão, quantidade de entradas e tamanho do índice;
+ * - índice: para cada entrada, offset (64 bits), tamanho (64 bits), tamanho do nome
+ *   (32 bits) e o nome (ex: "assets/background1.png", sempre com '/');
+ * - dados de cada entrada, começando em um offset múltiplo de `ALINHAMENTO`.
+ *
+ * O arquivo é mapeado inteiro na memória ao abrir, então cada asset é só um ponteiro
+ * para dentro do mapeamento: abrir um asset não abre arquivo nem faz seek, e as
+ * páginas só são lidas do disco quando o decodificador chega nelas. Os assets são
+ * entregues ao Allegro como arquivos em memória (al_open_memfile).
+ *
+ * Sem o pacote (ou para nomes que não estão nele), tudo cai para os arquivos soltos
+ * em `assets/`, então o jogo continua rodando direto da pasta durante o desenvolvimento.
+ */
+class AssetArchive {
+public:
+    /// @brief Alinhamento do início dos dados de cada entrada, em bytes.
+    static const uint32_t ALINHAMENTO = 64;
+
+    /**
+     * @brief Construtor da classe AssetArchive. Mapeia o pacote, se ele existir.
+     * Não depende do Allegro estar inicializado.
+     * @param caminhoPacote Caminho do arquivo do pacote.
+     */
+    explicit AssetArchive(const std::string& caminhoPacote);
+
+    /**
+     * @brief Destrutor da classe AssetArchive. Desfaz o mapeamento.
+     * Os arquivos abertos a partir do pacote (músicas, fontes) precisam ter sido fechados antes.
+     */
+    ~AssetArchive();
+
+    AssetArchive(const AssetArchive&) = delete;            ///< @brief Não copiável (possui o mapeamento).
+    AssetArchive& operator=(const AssetArchive&) = delete; ///< @brief Não copiável (possui o mapeamento).
+
+    /**
+     * @brief Informa se o pacote foi aberto.
+     * @return true se os assets estão vindo do pacote.
+     */
+    bool isAberto() const { return base != nullptr; }
+
+    /**
+     * @brief Retorna quantos assets existem no pacote.
+     * @return O número de entradas (0 se o pacote não foi aberto).
+     */
+    int getNumeroEntradas() const { return (int)indice.size(); }
+
+    /**
+     * @brief Localiza um asset dentro do pacote, sem copiar nada.
+     * @param nome Nome do asset (ex: "assets/pipe1.png").
+     * @param dados Recebe o ponteiro para os bytes do asset no mapeamento.
+     * @param tamanho Recebe o tamanho do asset.
+     * @return true se o asset está no pacote.
+     */
+    bool obter(const std::string& nome, const unsigned char*& dados, size_t& tamanho) const;
+
+    /**
+     * @brief Informa se um asset existe, no pacote ou como arquivo solto.
+     * @param nome Nome do asset.
+     * @return true se o asset pode ser aberto.
+     */
+    bool existe(const std::string& nome) const;
+
+    /**
+     * @brief Abre um asset como arquivo do Allegro: em memória se estiver no pacote, do disco se não.
+     * @param nome Nome do asset.
+     * @return O arquivo aberto (a ser fechado com al_fclose), ou nullptr.
+     */
+    ALLEGRO_FILE* abrir(const std::string& nome) const;
+
+    /**
+     * @brief Carrega uma imagem (com os parâmetros de novo bitmap da thread atual).
+     * @param nome Nome do asset.
+     * @return O bitmap, ou nullptr.
+     */
+    ALLEGRO_BITMAP* carregarBitmap(const std::string& nome) const;
+
+    /**
+     * @brief Carrega um efeito sonoro inteiro para a memória.
+     * @param nome Nome do asset.
+     * @return O sample, ou nullptr.
+     */
+    ALLEGRO_SAMPLE* carregarSample(const std::string& nome) const;
+
+    /**
+     * @brief Abre uma música para tocar em stream.
+     * @param nome Nome do asset.
+     * @param buffers Quantidade de buffers da stream.
+     * @param amostras Amostras por buffer.
+     * @return A stream (dona do arquivo aberto), ou nullptr.
+     */
+    ALLEGRO_AUDIO_STREAM* carregarMusica(const std::string& nome, size_t buffers, unsigned int amostras) const;
+
+    /**
+     * @brief Carrega uma fonte TrueType.
+     * @param nome Nome do asset.
+     * @param tamanho Tamanho da fonte.
+     * @param flags Flags do add-on TTF.
+     * @return A fonte (dona do arquivo aberto), ou nullptr.
+     */
+    ALLEGRO_FONT* carregarFonte(const std::string& nome, int tamanho, int flags) const;
+
+    /**
+     * @brief Cria um pacote com todos os arquivos de uma pasta (usado pela ferramenta de empacotamento).
+     * Os nomes das entradas começam pelo nome da pasta (ex: "assets/menu.ogg").
+     * @param diretorio Pasta com os assets.
+     * @param saida Caminho do pacote a gravar.
+     * @return O número de entradas gravadas, ou -1 em caso de erro.
+     */
+    static int construir(const std::string& diretorio, const std::string& saida);
+
+private:
+    /**
+     * @brief Posição de um asset dentro do pacote.
+     */
+    struct Entrada {
+        uint64_t offset;  ///< @brief Início dos dados, a partir do começo do arquivo.
+        uint64_t tamanho; ///< @brief Tamanho dos dados.
+    };
+
+    std::unordered_map<std::string, Entrada> indice; ///< @brief Entradas do pacote, por nome.
+    MappedFile mapa;                                 ///< @brief O arquivo do pacote mapeado.
+    const unsigned char* base;                       ///< @brief Início do mapeamento (nullptr sem pacote).
+    size_t tamanhoMapeado;                           ///< @brief Tamanho do arquivo mapeado.
+
+    /**
+     * @brief Lê e valida o cabeçalho e o índice do pacote mapeado.
+     * @return true se o pacote é válido.
+     */
+    bool lerIndice();
+
+    /**
+     * @brief Desfaz o mapeamento e fecha o arquivo.
+     */
+    void fechar();
+};
+
+#endif // ASSETARCHIVE_HPP
@@ -0,0 +1,99 @@
+/**
+ * @file AssetLoader.hpp
+ * @brief AssetLoaderheader do projeto Traveling Dragon.
+ */
+
+#ifndef ASSETLOADER_HPP
+#define ASSETLOADER_HPP
+
+#include <allegro5/allegro.h> // Para as threads, mutexes e variáveis de condição do Allegro
+#include <deque>              // Para usar std::deque (filas de trabalhos)
+#include <functional>         // Para usar std::function (etapas de cada trabalho)
+#include <vector>             // Para usar std::vector (threads trabalhadoras)
+
+/**
+ * @brief Carrega assets em paralelo, com um grupo de threads trabalhadoras.
+ *
+ * Cada trabalho tem duas etapas. A primeira (decodificar um PNG, reduzir uma
+ * imagem, ler um WAV) roda em uma das threads trabalhadoras e só mexe em memória
+ * comum. A segunda (enviar a imagem para a placa de vídeo, abrir uma stream de
+ * áudio) precisa do contexto gráfico e roda na thread principal, quando ela chama
+ * `processarProntos()`, um pouco por frame para a tela de carregamento continuar animada.
+ *
+ * As threads são as do próprio Allegro, que funcionam em qualquer toolchain em
+ * que o jogo já compila (o MinGW nem sempre tem std::thread).
+ */
+class AssetLoader {
+public:
+    /**
+     * @brief Construtor da classe AssetLoader. Inicia as threads trabalhadoras.
+     * @param trabalhadores Quantidade de threads (0 = escolher pela quantidade de núcleos).
+     */
+    explicit AssetLoader(int trabalhadores = 0);
+
+    /**
+     * @brief Destrutor da classe AssetLoader.
+     * Espera os trabalhos em andamento terminarem e encerra as threads.
+     */
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;            ///< @brief Não copiável (possui threads).
+    AssetLoader& operator=(const AssetLoader&) = delete; ///< @brief Não copiável (possui threads).
+
+    /**
+     * @brief Agenda um trabalho.
+     * @param emSegundoPlano Etapa executada em uma thread trabalhadora (pode ser vazia).
+     * @param naThreadPrincipal Etapa executada depois, na thread principal (pode ser vazia).
+     */
+    void adicionar(std::function<void()> emSegundoPlano, std::function<void()> naThreadPrincipal);
+
+    /**
+     * @brief Executa as etapas da thread principal dos trabalhos prontos.
+     * @param orcamentoMs Tempo máximo a gastar nesta chamada (ao menos uma etapa sempre roda).
+     * @return Quantas etapas foram executadas.
+     */
+    int processarProntos(double orcamentoMs);
+
+    /**
+     * @brief Retorna a fração dos trabalhos já concluídos (as duas etapas).
+     * @return Valor de 0 a 1 (1 se não há trabalhos).
+     */
+    float getProgresso() const;
+
+    /**
+     * @brief Informa se todos os trabalhos agendados foram concluídos.
+     * @return true quando não há mais nada a fazer.
+     */
+    bool terminou() const;
+
+    /**
+     * @brief Retorna quantas threads trabalhadoras estão ativas.
+     * @return O número de threads.
+     */
+    int getTrabalhadores() const { return (int)threads.size(); }
+
+private:
+    /**
+     * @brief Um trabalho agendado.
+     */
+    struct Trabalho {
+        std::function<void()> emSegundoPlano;    ///< @brief Etapa das threads trabalhadoras.
+        std::function<void()> naThreadPrincipal; ///< @brief Etapa da thread principal.
+    };
+
+    std::vector<ALLEGRO_THREAD*> threads; ///< @brief Threads trabalhadoras.
+    ALLEGRO_MUTEX* mutex;                 ///< @brief Protege as filas e os contadores.
+    ALLEGRO_COND* haTrabalho;             ///< @brief Acorda as threads quando chega um trabalho (ou no encerramento).
+    std::deque<Trabalho> pendentes;       ///< @brief Trabalhos esperando uma thread livre.
+    std::deque<Trabalho> prontos;         ///< @brief Trabalhos com a etapa de segundo plano já feita.
+    int total;                            ///< @brief Trabalhos agendados.
+    int concluidos;                       ///< @brief Trabalhos com as duas etapas feitas.
+    bool encerrando;                      ///< @brief Flag: true quando as threads devem sair.
+
+    /**
+     * @brief Laço de cada thread trabalhadora: pega um trabalho pendente, executa e o move para `prontos`.
+     */
+    static void* executarTrabalhador(ALLEGRO_THREAD* thread, void* arg);
+};
+
+#endif // ASSETLOADER_HPP
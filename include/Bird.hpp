@@ -8,6 +8,7 @@
 
 #include <allegro5/allegro.h> // Necessário para usar tipos do Allegro, como ALLEGRO_BITMAP
 #include "GameObject.hpp"     // A classe base da qual Bird herda propriedades e comportamentos
+#include "RenderQueue.hpp"    // Lista de comandos onde o pássaro é gravado
 
 /**
  * @brief Representa o personagem principal do jogo, o pássaro.
@@ -85,9 +86,10 @@ public:
     void update(float deltaTime);
 
     /**
-     * @brief Renderiza (desenha) o pássaro na tela na sua posição e com sua rotação atual.
+     * @brief Grava o desenho do pássaro, na sua posição e com sua rotação atual, na lista do frame.
+     * @param fila Lista de comandos do frame.
      */
-    void render();
+    void render(RenderQueue& fila);
 
     /**
      * @brief Reseta o estado do pássaro para as condições iniciais de uma nova partida.
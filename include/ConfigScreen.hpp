@@ -8,12 +8,16 @@
 
 #include <allegro5/allegro.h>     // Para funcionalidades básicas do Allegro
 #include <allegro5/allegro_font.h> // Para desenhar texto com fontes
+#include "GameConfig.hpp"             // Opções editadas nesta tela
 
 /**
  * @brief Gerencia a tela de configurações do jogo.
  *
  * Esta classe é responsável por exibir as opções de configuração do jogo
  * e processar as interações do usuário com essas opções.
+ * Hoje as opções são a escala de renderização (setas esquerda/direita), o
+ * ajuste dinâmico da escala (tecla D) e a troca de resolução (tecla R, que abre
+ * o seletor de resolução); ESC ou Enter voltam ao menu.
  */
 class ConfigScreen {
 public:
@@ -27,8 +31,9 @@ public:
      * @param background Ponteiro para o bitmap de fundo da tela de configurações.
      * @param screenWidth Largura da tela do jogo.
      * @param screenHeight Altura da tela do jogo.
+     * @param config Configurações editadas pela tela (pertencem ao GameEngine).
      */
-    ConfigScreen(ALLEGRO_FONT* font, ALLEGRO_BITMAP* background, int screenWidth, int screenHeight);
+    ConfigScreen(ALLEGRO_FONT* font, ALLEGRO_BITMAP* background, int screenWidth, int screenHeight, GameConfig* config);
 
     /**
      * @brief Destrutor da classe ConfigScreen.
@@ -47,11 +52,19 @@ public:
      */
     void render();
 
+    /**
+     * @brief Informa se a imagem da tela mudou desde o último desenho.
+     * A tela é composta uma vez em um bitmap e só é recomposta quando marcada como suja.
+     * @return true se a tela precisa ser recomposta.
+     */
+    bool precisaRedesenhar() const { return sujo || !quadroCache; }
+
     /**
      * @brief Processa um evento do Allegro, como entrada de teclado ou mouse,
      * e reage de acordo com a interação na tela de configurações.
      * @param ev O evento Allegro a ser processado.
-     * @return Um inteiro que representa a ação a ser tomada após o evento (ex: 0 para continuar, 1 para voltar ao menu).
+     * @return Um inteiro que representa a ação a ser tomada após o evento (0 para continuar, 1 para voltar ao menu,
+     *         2 se alguma configuração mudou e precisa ser aplicada, 3 para abrir o seletor de resolução).
      */
     int handleEvent(ALLEGRO_EVENT ev);
 
@@ -69,6 +82,15 @@ private:
     bool waitingForKeyPress;    ///< @brief Flag que indica se a tela está aguardando um pressionamento de tecla.
     float scale_x;              ///< @brief Fator de escala horizontal para ajustar elementos à resolução.
     float scale_y;              ///< @brief Fator de escala vertical para ajustar elementos à resolução.
+    GameConfig* config;         ///< @brief Configurações editadas (não pertencem a esta classe).
+
+    ALLEGRO_BITMAP* quadroCache; ///< @brief A tela inteira já composta, reaproveitada enquanto nada mudar.
+    bool sujo;                   ///< @brief Flag: true se `quadroCache` precisa ser recomposto.
+
+    /**
+     * @brief Desenha o fundo e os textos da tela no alvo atual.
+     */
+    void compor();
 };
 
 #endif
\ No newline at end of file
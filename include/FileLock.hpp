@@ -0,0 +1,126 @@
+/**
+ * @file FileLock.hpp
+ * @brief FileLockheader do projeto Traveling Dragon.
+ */
+
+#ifndef FILELOCK_HPP
+#define FILELOCK_HPP
+
+#include <cstddef> // Para size_t
+#include <cstdint> // Para intptr_t (handle ou descritor do arquivo)
+#include <string>  // Para usar std::string (caminho do arquivo)
+
+/**
+ * @brief Trava de arquivo entre processos (e entre threads com objetos diferentes).
+ *
+ * Usada quando vários jogos (gabinetes) na mesma máquina, ou em uma pasta
+ * compartilhada, usam o mesmo cadastro de jogadores. A trava pode ser
+ * compartilhada (vários leitores) ou exclusiva (um só escritor); o sistema a
+ * solta sozinho se o processo que a segura cair, então uma queda nunca deixa
+ * os outros jogos esperando para sempre.
+ *
+ * O arquivo da trava também guarda alguns bytes (`ler` e `gravar`, sempre no
+ * início dele), para o que precisa ser combinado entre os processos enquanto a
+ * trava exclusiva está com um deles, como o próximo número de sequência do diário.
+ *
+ * No Windows usa LockFileEx; nos outros sistemas, flock. As duas travam por
+ * arquivo aberto: dois FileLock do mesmo arquivo se excluem mesmo no mesmo
+ * processo, mas um mesmo FileLock não deve ser travado por duas threads ao mesmo tempo.
+ */
+class FileLock {
+public:
+    /**
+     * @brief Tipo de trava.
+     */
+    enum Modo {
+        COMPARTILHADA = 0, ///< @brief Vários processos ao mesmo tempo (leitura).
+        EXCLUSIVA = 1      ///< @brief Um processo só (escrita).
+    };
+
+    /**
+     * @brief Construtor da classe FileLock. Não abre nada (veja `abrir`).
+     */
+    FileLock() : descritor(-1), travada(false) {}
+
+    /**
+     * @brief Destrutor da classe FileLock. Solta a trava e fecha o arquivo.
+     */
+    ~FileLock() { fechar(); }
+
+    FileLock(const FileLock&) = delete;            ///< @brief Não copiável (possui o arquivo).
+    FileLock& operator=(const FileLock&) = delete; ///< @brief Não copiável (possui o arquivo).
+
+    /**
+     * @brief Abre (ou cria) o arquivo da trava, fechando o anterior.
+     * @param caminho Caminho do arquivo (a pasta precisa existir).
+     * @return false se o arquivo não pôde ser aberto.
+     */
+    bool abrir(const std::string& caminho);
+
+    /**
+     * @brief Solta a trava (se estiver com ela) e fecha o arquivo.
+     */
+    void fechar();
+
+    /**
+     * @brief Informa se o arquivo da trava está aberto.
+     * @return true se `abrir` teve sucesso.
+     */
+    bool isAberto() const { return descritor != -1; }
+
+    /**
+     * @brief Espera a trava ficar livre e fica com ela.
+     * @param modo Compartilhada ou exclusiva.
+     * @return false se o arquivo não está aberto ou o sistema recusou a trava.
+     */
+    bool travar(Modo modo);
+
+    /**
+     * @brief Tenta ficar com a trava sem esperar.
+     * @param modo Compartilhada ou exclusiva.
+     * @return false se outro a segura (ou o arquivo não está aberto).
+     */
+    bool tentarTravar(Modo modo);
+
+    /**
+     * @brief Solta a trava.
+     */
+    void destravar();
+
+    /**
+     * @brief Informa se a trava está com este objeto.
+     * @return true entre `travar` e `destravar`.
+     */
+    bool isTravada() const { return travada; }
+
+    /**
+     * @brief Lê bytes do início do arquivo da trava.
+     * @param destino Recebe os bytes.
+     * @param bytes Quantidade de bytes.
+     * @return false se o arquivo tem menos bytes que isso (ex: recém-criado).
+     */
+    bool ler(void* destino, size_t bytes) const;
+
+    /**
+     * @brief Grava bytes no início do arquivo da trava (só com a trava exclusiva).
+     * @param origem Os bytes.
+     * @param bytes Quantidade de bytes.
+     * @param sincronizar true para esperar os bytes estarem no disco.
+     * @return false se a gravação falhou.
+     */
+    bool gravar(const void* origem, size_t bytes, bool sincronizar);
+
+private:
+    intptr_t descritor; ///< @brief HANDLE (Windows) ou descritor do arquivo; -1 se fechado.
+    bool travada;       ///< @brief Flag: true enquanto a trava está com este objeto.
+
+    /**
+     * @brief Pede a trava ao sistema.
+     * @param modo Compartilhada ou exclusiva.
+     * @param esperar true para esperar a trava ficar livre.
+     * @return true se a trava foi obtida.
+     */
+    bool pedir(Modo modo, bool esperar);
+};
+
+#endif // FILELOCK_HPP
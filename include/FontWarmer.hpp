@@ -0,0 +1,52 @@
+/**
+ * @file FontWarmer.hpp
+ * @brief FontWarmerheader do projeto Traveling Dragon.
+ */
+
+#ifndef FONTWARMER_HPP
+#define FONTWARMER_HPP
+
+#include <allegro5/allegro.h>      // Para bitmaps temporários e al_get_time
+#include <allegro5/allegro_font.h> // Para ALLEGRO_FONT e desenho de texto
+
+/**
+ * @brief Pré-aquece o cache de glifos das fontes TTF no carregamento.
+ *
+ * O add-on TTF do Allegro só rasteriza (FreeType) e envia para a placa de vídeo
+ * cada glifo na primeira vez em que ele é desenhado. Sem pré-aquecimento, o
+ * primeiro frame que mostra um texto novo (um dígito da pontuação, "Novo recorde
+ * geral!") trava enquanto isso acontece. Esta classe desenha todos os caracteres
+ * que o jogo usa em um bitmap descartável logo depois de carregar a fonte, então
+ * durante o jogo todo desenho de texto já encontra os glifos prontos.
+ */
+class FontWarmer {
+public:
+    /// @brief Todos os caracteres que o jogo pode desenhar: ASCII visível e as letras acentuadas do português.
+    static const char* const CARACTERES_DO_JOGO;
+
+    /**
+     * @brief Rasteriza os glifos de todos os caracteres informados.
+     * @param font A fonte a aquecer (nula é ignorada).
+     * @param caracteres Texto UTF-8 com os caracteres desejados.
+     * @return O tempo gasto, em milissegundos.
+     */
+    static double preaquecer(ALLEGRO_FONT* font, const char* caracteres = CARACTERES_DO_JOGO);
+
+    /**
+     * @brief Mede quanto custa desenhar um texto, em um bitmap descartável.
+     * Usado para confirmar no log que, depois do aquecimento, o primeiro uso não trava.
+     * @param font A fonte usada.
+     * @param texto O texto desenhado.
+     * @return O tempo do desenho, em milissegundos.
+     */
+    static double medirDesenho(ALLEGRO_FONT* font, const char* texto);
+
+private:
+    /**
+     * @brief Desenha um texto em um bitmap pequeno descartável, sem mexer no alvo atual.
+     * @return O tempo do desenho, em milissegundos.
+     */
+    static double desenharDescartavel(ALLEGRO_FONT* font, const char* texto);
+};
+
+#endif // FONTWARMER_HPP
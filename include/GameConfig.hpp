@@ -0,0 +1,119 @@
+/**
+ * @file GameConfig.hpp
+ * @brief GameConfigheader do projeto Traveling Dragon.
+ */
+
+#ifndef GAMECONFIG_HPP
+#define GAMECONFIG_HPP
+
+#include <string> // Para usar std::string (caminho do arquivo)
+
+/**
+ * @brief Configurações do jogo que persistem entre execuções.
+ *
+ * Os valores ficam em um arquivo de texto simples, uma opção por linha no
+ * formato `chave=valor`. Linhas desconhecidas ou inválidas são ignoradas e a
+ * opção correspondente mantém o valor padrão, então um arquivo antigo ou
+ * editado à mão nunca impede o jogo de abrir.
+ */
+class GameConfig {
+public:
+    /// @brief Menor escala de renderização aceita (metade da resolução em cada eixo).
+    static const float ESCALA_MINIMA;
+    /// @brief Maior escala de renderização (resolução cheia).
+    static const float ESCALA_MAXIMA;
+    /// @brief Passo usado pela tela de configurações e pelo modo dinâmico.
+    static const float PASSO_ESCALA;
+
+    /**
+     * @brief Construtor da classe GameConfig.
+     * Inicia todas as opções com os valores padrão.
+     * @param caminho Caminho do arquivo de configurações.
+     */
+    explicit GameConfig(const std::string& caminho);
+
+    /**
+     * @brief Lê o arquivo de configurações, se ele existir.
+     * @return true se o arquivo foi lido, false se não existe (os padrões continuam valendo).
+     */
+    bool carregar();
+
+    /**
+     * @brief Grava as configurações atuais no arquivo (cria a pasta se necessário).
+     * @return true se o arquivo foi gravado.
+     */
+    bool salvar() const;
+
+    /**
+     * @brief Retorna a escala de renderização escolhida.
+     * @return Fração da resolução da tela usada para desenhar a cena (0.5 a 1.0).
+     */
+    float getEscalaRender() const { return escalaRender; }
+
+    /**
+     * @brief Define a escala de renderização, limitada e arredondada para o passo.
+     * @param escala A nova escala.
+     */
+    void setEscalaRender(float escala);
+
+    /**
+     * @brief Informa se a escala é ajustada automaticamente durante o jogo.
+     * @return true se o modo dinâmico está ligado.
+     */
+    bool isEscalaDinamica() const { return escalaDinamica; }
+
+    /**
+     * @brief Liga ou desliga o ajuste automático da escala.
+     * @param ligado true para ligar o modo dinâmico.
+     */
+    void setEscalaDinamica(bool ligado) { escalaDinamica = ligado; }
+
+    /**
+     * @brief Retorna o tempo de frame que o modo dinâmico tenta manter.
+     * @return O tempo alvo em milissegundos.
+     */
+    double getTempoAlvoMs() const { return tempoAlvoMs; }
+
+    /**
+     * @brief Retorna a memória máxima dos assets de nível mantidos em cache.
+     * @return O orçamento em megabytes.
+     */
+    int getOrcamentoNiveisMb() const { return orcamentoNiveisMb; }
+
+    /**
+     * @brief Retorna a memória total dos assets acima da qual um aviso é emitido.
+     * @return O orçamento em megabytes.
+     */
+    int getOrcamentoMemoriaMb() const { return orcamentoMemoriaMb; }
+
+    /**
+     * @brief Retorna a política de sincronia do diário de jogadores.
+     * @return 0 = sem fsync, 1 = fsync por grupo de registros, 2 = fsync por registro.
+     */
+    int getSincroniaJogadores() const { return sincroniaJogadores; }
+
+    /**
+     * @brief Retorna o caminho do socket do serviço de ranking compartilhado entre os gabinetes.
+     * @return O caminho (vazio: o jogo não envia partidas a nenhum serviço).
+     */
+    const std::string& getServidorRanking() const { return servidorRanking; }
+
+    /**
+     * @brief Limita uma escala ao intervalo aceito e a arredonda para o passo mais próximo.
+     * @param escala A escala a ajustar.
+     * @return A escala ajustada.
+     */
+    static float ajustarEscala(float escala);
+
+private:
+    std::string caminhoArquivo; ///< @brief Caminho do arquivo de configurações.
+    float escalaRender;         ///< @brief Fração da resolução usada para desenhar a cena.
+    bool escalaDinamica;        ///< @brief Flag: true se a escala acompanha o tempo de frame.
+    double tempoAlvoMs;         ///< @brief Tempo de frame alvo do modo dinâmico, em milissegundos.
+    int orcamentoNiveisMb;      ///< @brief Memória máxima dos níveis carregados, em megabytes.
+    int orcamentoMemoriaMb;     ///< @brief Memória total dos assets antes do aviso, em megabytes.
+    int sincroniaJogadores;     ///< @brief Política de sincronia do diário de jogadores (MatchJournal::Sincronia).
+    std::string servidorRanking; ///< @brief Caminho do socket do serviço de ranking (vazio: desligado).
+};
+
+#endif // GAMECONFIG_HPP
@@ -7,6 +7,7 @@
 #define GAMEENGINE_HPP
 
 #include <allegro5/allegro.h>          // Para funcionalidades básicas do Allegro (display, queue, timer)
+#include <chrono>                      // Para medir o tempo até o menu (antes do al_init)
 #include <vector>                      // Para usar std::vector (listas de assets, jogadores)
 #include <string>                      // Para usar std::string (nomes, caminhos)
 #include "PlayerManager.hpp"           // Gerenciador de jogadores e ranking
@@ -17,6 +18,19 @@
 #include "ResolutionSelector.hpp"      // Seleção de resolução da janela
 #include "ConfigScreen.hpp"            // Tela de configurações
 #include "Utils.hpp"                   // Save do ranking
+#include "TextureAtlas.hpp"            // Atlas com os sprites do gameplay
+#include "ScaledAssetCache.hpp"        // Imagens pré-redimensionadas para a resolução atual
+#include "PostProcessor.hpp"           // Desfoque em baixa resolução das transições
+#include "FontWarmer.hpp"              // Pré-aquecimento dos glifos das fontes
+#include "RenderStats.hpp"             // Contadores de desenho do HUD de depuração
+#include "GameConfig.hpp"              // Configurações persistentes (escala de renderização)
+#include "RenderScaleController.hpp"   // Ajuste dinâmico da escala de renderização
+#include "AssetLoader.hpp"             // Carregamento dos assets em threads trabalhadoras
+#include "LevelAssetManager.hpp"       // Assets de nível carregados sob demanda
+#include "AssetArchive.hpp"            // Pacote único com todos os assets
+#include "MemoryTracker.hpp"           // Memória ocupada pelos assets, por categoria e nível
+#include "MatchHistory.hpp"            // Histórico de todas as partidas
+#include "SaveQueue.hpp"               // Gravações em disco fora da thread do jogo
 
 
 /**
@@ -32,14 +46,21 @@ public:
      * @brief Construtor da classe GameEngine.
      *
      * Inicializa o motor do jogo, configurando as dimensões da janela e o modo de exibição.
-     * Realiza a inicialização básica do Allegro e seus add-ons.
+     * O Allegro só é inicializado em `run()`, que também mostra o seletor de resolução.
      *
-     * @param w Largura inicial da tela/janela.
+     * @param w Largura inicial da tela/janela (destacada no seletor; usada direto no modo benchmark).
      * @param h Altura inicial da tela/janela.
      * @param mode O modo de exibição da janela (WINDOWED, FULLSCREEN, BORDERLESS), padrão é WINDOWED.
      */
     GameEngine(int w, int h, WindowMode mode = WINDOWED);
 
+    /**
+     * @brief Liga o modo benchmark: sem seletor nem menu, o jogo carrega, entra direto na
+     * partida, mede o tempo até o primeiro frame de jogo e fecha.
+     * @param ligado true para ligar.
+     */
+    void setModoBenchmark(bool ligado) { modoBenchmark = ligado; }
+
     /**
      * @brief Destrutor da classe GameEngine.
      *
@@ -76,6 +97,7 @@ private:
     ALLEGRO_BITMAP* gameOverBackground; ///< @brief Imagem de fundo específica para a tela de Game Over.
     ALLEGRO_BITMAP* birdBmp;        ///< @brief Bitmap (folha de sprites) do personagem pássaro.
     ALLEGRO_BITMAP* pipeBmp;        ///< @brief Bitmap da imagem dos canos (obstáculos).
+    TextureAtlas* spriteAtlas;      ///< @brief Atlas que guarda os canos de todos os níveis e o pássaro em uma única textura.
 
     Menu* menu;                         ///< @brief Objeto que gerencia a tela do menu principal.
     Scenario* scenario;                 ///< @brief Objeto que gerencia o cenário de jogo (gameplay).
@@ -84,7 +106,8 @@ private:
     ConfigScreen* configScreen;         ///< @brief Objeto que gerencia a tela de configurações.
 
     PlayerManager* playerManager;       ///< @brief Objeto que gerencia o carregamento, salvamento e busca de jogadores.
-    Player* currentPlayer;              ///< @brief Ponteiro para o jogador atualmente ativo na sessão.
+    PlayerManager::Id currentPlayer;    ///< @brief Id do jogador ativo na sessão (sobrevive a novos cadastros, ao contrário de um ponteiro).
+    LeaderboardClient* placarRemoto;    ///< @brief Envio das partidas ao serviço de ranking dos gabinetes (nulo se não configurado).
 
     /**
      * @brief Enumeração para os possíveis estados globais do jogo.
@@ -99,6 +122,8 @@ private:
         INICIANDO_JOGO  ///< @brief Estado temporário para iniciar uma nova partida ou nível.
     };
     Estado estadoAtual; ///< @brief A variável que armazena o estado atual do jogo.
+    Estado ultimoEstadoDesenhado; ///< @brief Estado que estava ativo no último frame efetivamente desenhado.
+    bool forcarRedesenho;         ///< @brief Flag: true se o próximo frame deve ser desenhado mesmo sem mudanças (ex: janela exposta).
 
     int lastScore;                      ///< @brief Pontuação alcançada na última partida jogada.
     int lastRecordPessoal;              ///< @brief O recorde pessoal do jogador na última partida (para exibição).
@@ -106,8 +131,19 @@ private:
     bool lastBateuRecordePessoal;       ///< @brief Flag: true se o jogador bateu seu recorde pessoal na última partida.
     bool lastBateuRecordeGeral;         ///< @brief Flag: true se o jogador bateu o recorde geral na última partida.
 
+    MatchHistory historico;             ///< @brief Todas as partidas terminadas (data/historico.dat).
+    SaveQueue gravador;                 ///< @brief Thread que grava os blocos do histórico no disco.
+    double inicioPartidaAtual;          ///< @brief Momento (al_get_time) em que a partida atual começou.
+    int batidasPartida;                 ///< @brief Batidas de asa na partida atual.
+    size_t historicoPartidas;           ///< @brief Partidas do último jogador no histórico (0: nada a exibir no HUD).
+    double historicoMedia;              ///< @brief Média das pontuações do último jogador, calculada no fim da partida.
+    int historicoMediana;               ///< @brief Mediana das pontuações do último jogador.
+    int historicoP90;                   ///< @brief Percentil 90 das pontuações do último jogador.
+    /// @brief Partidas pendentes no histórico que disparam o envio de um bloco ao `gravador`.
+    static constexpr size_t LOTE_HISTORICO = 32;
+
     ALLEGRO_AUDIO_STREAM* musicaMenuRankingGameOver; ///< @brief Stream de áudio para a música das telas de menu, ranking e game over.
-    ALLEGRO_AUDIO_STREAM* musicaEmJogo;              ///< @brief Stream de áudio para a música tocada durante o gameplay (OBS: pode estar em desuso, ver `musicLevels`).
+    ALLEGRO_AUDIO_STREAM* musicaEmJogo;              ///< @brief Stream de áudio para a música tocada durante o gameplay (OBS: pode estar em desuso, ver `niveis`).
     ALLEGRO_AUDIO_STREAM* musicaAtualTocando;        ///< @brief Ponteiro para o stream de áudio da música que está sendo tocada no momento.
 
     ALLEGRO_SAMPLE* somHover;       ///< @brief Sample de áudio para o efeito sonoro de mouse sobre botões.
@@ -124,10 +160,31 @@ private:
     float transitionBlurTimer;      ///< @brief Timer para controlar a duração do efeito de blur durante a transição.
 
     ALLEGRO_BITMAP* renderTarget;   ///< @brief Bitmap temporário usado como buffer de renderização para aplicar efeitos antes de desenhar no display.
-
-    std::vector<ALLEGRO_BITMAP*> backgroundsLevels; ///< @brief Vetor de bitmaps para os diferentes fundos de cenário por nível.
-    std::vector<ALLEGRO_BITMAP*> pipesLevels;       ///< @brief Vetor de bitmaps para as diferentes imagens de canos por nível.
-    std::vector<ALLEGRO_AUDIO_STREAM*> musicLevels; ///< @brief Vetor de streams de áudio para as músicas de cada nível.
+    PostProcessor* postProcessor;   ///< @brief Aplica o desfoque das transições lendo o `renderTarget`.
+
+    AssetArchive pacote;                    ///< @brief Pacote de assets (assets.tdpk); sem ele, os arquivos soltos de assets/.
+    GameConfig config;                      ///< @brief Configurações persistentes do jogo (data/config.txt).
+    RenderScaleController controleEscala;   ///< @brief Ajusta a escala para manter o tempo de frame no modo dinâmico.
+    float escalaRender;                     ///< @brief Fração da resolução em que a cena está sendo desenhada agora.
+    ALLEGRO_BITMAP* cenaReduzida;           ///< @brief Região de `renderTarget` com o tamanho da escala atual (sub-bitmap).
+    double inicioQuadroAnterior;            ///< @brief Momento (al_get_time) em que o frame anterior começou a ser desenhado.
+
+    std::chrono::steady_clock::time_point inicioExecucao; ///< @brief Momento em que `run()` começou (base do tempo até o menu).
+    double msCarregamento;          ///< @brief Duração de `loadGameAssets()`, em milissegundos.
+    bool menuJaMostrado;            ///< @brief Flag: true depois que o primeiro frame foi apresentado (tempo até o menu já registrado).
+    double msNoSeletor;             ///< @brief Tempo em que o seletor de resolução ficou esperando o jogador (não conta nas medições).
+    double msAteMenu;               ///< @brief Tempo até o menu interativo, sem o tempo no seletor.
+    std::chrono::steady_clock::time_point inicioPartida; ///< @brief Momento do clique em "Jogar" da primeira partida.
+    bool jogoJaMostrado;            ///< @brief Flag: true depois que o primeiro frame de jogo foi apresentado.
+    bool modoBenchmark;             ///< @brief Flag: true para medir o tempo até o primeiro frame de jogo e sair.
+    ALLEGRO_FONT* fontSeletor;      ///< @brief Fonte do seletor de resolução (tamanho fixo, carregada uma vez).
+
+    /// @brief Tempo máximo por frame gasto com envios para a placa de vídeo (tela de carregamento e níveis durante o jogo).
+    static constexpr double ORCAMENTO_ENVIO_MS = 8.0;
+
+    AssetLoader* carregador;        ///< @brief Threads de carregamento (tela inicial e níveis durante o jogo).
+    LevelAssetManager* niveis;      ///< @brief Fundos, canos e músicas de cada nível, carregados sob demanda.
+    MemoryTracker memoria;          ///< @brief Memória de todos os assets carregados (HUD e data/memoria.txt).
 
     int currentLevel;               ///< @brief O nível atual do jogo (começando de 0).
     /// @brief Duração em segundos do efeito de blur durante a transição entre níveis.
@@ -136,18 +193,63 @@ private:
     float scaleX;                   ///< @brief Fator de escalonamento horizontal aplicado à renderização.
     float scaleY;                   ///< @brief Fator de escalonamento vertical aplicado à renderização.
 
+    bool debugHudVisivel;           ///< @brief Flag: true se o HUD de depuração (F3) está sendo exibido.
+    double fpsMedido;               ///< @brief Último FPS medido (frames realmente desenhados por segundo).
+    double fpsInicioJanela;         ///< @brief Momento (al_get_time) em que a janela de medição de FPS começou.
+    int fpsQuadrosJanela;           ///< @brief Frames desenhados desde o início da janela de medição.
+
     /**
      * @brief Inicializa todos os add-ons necessários do Allegro.
-     * Isso inclui inicialização de teclado, mouse, áudio, primitivas, imagens, fontes, etc.
+     * Isso inclui inicialização de teclado, mouse, áudio, primitivas, imagens, fontes, etc.,
+     * e cria o único display do jogo (no tamanho do seletor de resolução).
      */
     void initializeAllegroAddons();
 
+    /**
+     * @brief Aplica uma resolução e um modo de janela ao display já existente.
+     * Recria o bitmap de renderização e o pós-processamento no tamanho novo; os assets
+     * que dependem da resolução precisam ser carregados depois (`loadGameAssets`).
+     * @param modo A resolução e o modo escolhidos.
+     */
+    void aplicarModoVideo(const ResolutionConfig& modo);
+
+    /**
+     * @brief Mostra o seletor de resolução no display do jogo, contando o tempo de espera.
+     * @return A configuração escolhida, ou `std::nullopt` se o jogador cancelou.
+     */
+    std::optional<ResolutionConfig> escolherResolucao();
+
+    /**
+     * @brief Troca a resolução durante o jogo (pedido na tela de configurações).
+     * Mostra o seletor no mesmo display e, se uma opção for escolhida, recarrega os
+     * assets no tamanho novo; cancelando, volta ao modo anterior.
+     */
+    void trocarResolucao();
+
+    /**
+     * @brief Libera os objetos das telas (menu, cenário, game over, ranking e configurações).
+     */
+    void destruirTelas();
+
     /**
      * @brief Carrega todos os assets (imagens, fontes, sons) necessários para o jogo.
      * Este método é chamado na inicialização para preparar os recursos.
      */
     void loadGameAssets();
 
+    /**
+     * @brief Desenha a tela de carregamento (texto animado, barra e porcentagem) no display.
+     * @param progresso Fração dos assets já carregados (0 a 1).
+     * @param segundos Tempo desde o início do carregamento, usado na animação.
+     */
+    void renderTelaCarregamento(float progresso, double segundos);
+
+    /**
+     * @brief Cria um cenário novo no primeiro nível, com os assets dele já carregados.
+     * @return O cenário criado.
+     */
+    Scenario* criarCenarioPrimeiroNivel();
+
     /**
      * @brief Libera a memória de todos os assets carregados.
      * Este método é chamado no destrutor para evitar vazamentos de memória.
@@ -208,12 +310,68 @@ private:
      */
     void renderRanking(float deltaTime);
 
+    /**
+     * @brief Retorna o jogador ativo na sessão.
+     * O ponteiro deve ser usado na hora: um novo cadastro pode invalidá-lo.
+     * @return O jogador, ou nullptr se nenhum apelido foi escolhido.
+     */
+    Player* jogadorAtual();
+
     /**
      * @brief Renderiza a tela de configurações.
      * @param deltaTime O tempo decorrido para possíveis animações de fundo.
      */
     void renderConfigScreen(float deltaTime);
 
+    /**
+     * @brief Informa se o frame atual precisa ser desenhado e apresentado.
+     *
+     * As telas estáticas (Game Over, Ranking, Configurações) só mudam quando seus dados
+     * ou o hover mudam; enquanto nada muda, o frame anterior continua na tela e o jogo
+     * não desenha nem troca buffers.
+     *
+     * @return true se algo mudou desde o último frame desenhado.
+     */
+    bool telaPrecisaRedesenhar();
+
+    /**
+     * @brief Calcula a intensidade do efeito de transição (desfoque + fade) no frame atual.
+     * @return 0 quando não há efeito (a cena vai direto para o display) até 1 (totalmente escuro).
+     */
+    float intensidadeEfeito() const;
+
+    /**
+     * @brief Troca a escala de renderização, recriando a região de `renderTarget` usada pela cena.
+     *
+     * O `renderTarget` tem sempre a resolução cheia; abaixo de 1.0 a cena é desenhada
+     * no canto dele (um sub-bitmap), então mudar a escala não aloca textura nova.
+     *
+     * @param escala A nova escala (0.5 a 1.0).
+     */
+    void aplicarEscalaRender(float escala);
+
+    /**
+     * @brief Desenha o HUD de depuração (F3) no canto da tela.
+     * Mostra o FPS, as chamadas de desenho e os lotes do último frame, a memória dos assets
+     * e a latência das gravações em disco (medida à parte do tempo de frame).
+     */
+    void renderDebugHud();
+
+    /**
+     * @brief Entrega ao `gravador` as partidas do histórico ainda não gravadas, como um bloco.
+     */
+    void enviarHistorico();
+
+    /**
+     * @brief Passa ao menu os apelidos cadastrados que começam com o que está sendo digitado.
+     */
+    void atualizarSugestoes();
+
+    /**
+     * @brief Passa à tela de Game Over a posição do jogador no ranking compartilhado (cópia local, sem esperar o serviço).
+     */
+    void atualizarPosicaoGeral();
+
     /**
      * @brief Função estática de comparação usada para ordenar jogadores por pontuação.
      * Essencial para a exibição correta do ranking.
@@ -12,13 +12,15 @@
 #include <allegro5/allegro_audio.h>    // Para tocar efeitos sonoros
 #include <string>                       // Para usar std::string para textos
 #include <array>                        // Para usar std::array para definir retângulos de botões
+#include <cstddef>                      // Para size_t (posição no ranking compartilhado)
+#include "OutlinedTextCache.hpp"        // Para desenhar os rótulos dos botões com contorno
 
 /**
  * @brief Gerencia e exibe a tela de "Game Over" do jogo.
  *
  * Esta classe é responsável por mostrar a pontuação do jogador,
- * os recordes (pessoal e geral) e oferecer opções para reiniciar
- * o jogo ou voltar ao menu principal.
+ * os recordes (pessoal e geral), quantas partidas e jogadores ele superou,
+ * e oferecer opções para reiniciar o jogo ou voltar ao menu principal.
  */
 class GameOverScreen {
 public:
@@ -28,9 +30,10 @@ public:
      * Inicializa a tela de Game Over com as fontes e o bitmap de fundo.
      *
      * @param f Ponteiro para a fonte Allegro a ser usada.
+     * @param fLarge Ponteiro para a fonte grande dos títulos e pontuações (não pertence à tela).
      * @param gameOverBackground Ponteiro para o bitmap de fundo específico da tela de Game Over.
      */
-    GameOverScreen(ALLEGRO_FONT* f, ALLEGRO_BITMAP* gameOverBackground);
+    GameOverScreen(ALLEGRO_FONT* f, ALLEGRO_FONT* fLarge, ALLEGRO_BITMAP* gameOverBackground);
 
     /**
      * @brief Destrutor da classe GameOverScreen.
@@ -52,6 +55,21 @@ public:
      */
     void render(int score, int recordPessoal, int recordGeral, bool r1, bool r2);
 
+    /**
+     * @brief Informa se a imagem da tela mudou desde o último desenho.
+     *
+     * Consulta o mouse (atualizando o hover dos botões e tocando o som de hover) e
+     * compara os valores exibidos com os da última composição.
+     *
+     * @param score A pontuação final da partida atual.
+     * @param recordPessoal O maior recorde pessoal do jogador.
+     * @param recordGeral O maior recorde geral entre todos os jogadores.
+     * @param r1 true se o recorde pessoal foi batido na partida.
+     * @param r2 true se o recorde geral foi batido na partida.
+     * @return true se a tela precisa ser recomposta.
+     */
+    bool precisaRedesenhar(int score, int recordPessoal, int recordGeral, bool r1, bool r2);
+
     /**
      * @brief Processa um evento do Allegro específico para a tela de Game Over.
      *
@@ -68,6 +86,20 @@ public:
      */
     void setHoverSound(ALLEGRO_SAMPLE* som);
 
+    /**
+     * @brief Define as porcentagens exibidas abaixo dos recordes ("Melhor que X% das partidas").
+     * @param partidas Porcentagem das partidas registradas que ficaram abaixo da pontuação (negativa para esconder).
+     * @param jogadores Porcentagem dos recordes dos jogadores que ficaram abaixo dela (negativa para esconder).
+     */
+    void setPercentis(double partidas, double jogadores);
+
+    /**
+     * @brief Define a posição exibida no ranking compartilhado entre os gabinetes ("Posicao geral: N de M").
+     * @param posicao A posição, a partir de 1 (0 para esconder).
+     * @param total Quantos apelidos o ranking compartilhado tem.
+     */
+    void setPosicaoGeral(size_t posicao, size_t total);
+
 private:
     ALLEGRO_FONT* font;             ///< @brief Fonte padrão para textos na tela.
     ALLEGRO_FONT* fontLarge;        ///< @brief Fonte maior, usada para destaque (ex: pontuações).
@@ -80,6 +112,7 @@ private:
 
     std::array<float, 4> replayBtn; ///< @brief Define a área e posição do botão "Reiniciar" (x, y, largura, altura).
     std::array<float, 4> menuBtn;   ///< @brief Define a área e posição do botão "Menu".
+    OutlinedTextCache textCache;    ///< @brief Cache dos rótulos dos botões já rasterizados com contorno.
 
     /**
      * @brief Desenha um botão na tela com um texto e um estilo que pode mudar ao passar o mouse.
@@ -107,6 +140,34 @@ private:
     // @note `previousHoverStates` parece ser redundante com `lastHoverReplay` e `lastHoverMenu`.
     // Considerar remover ou unificar.
     std::array<bool, 2> previousHoverStates;
+
+    ALLEGRO_BITMAP* quadroCache;    ///< @brief A tela inteira já composta, reaproveitada enquanto nada mudar.
+    bool sujo;                      ///< @brief Flag: true se `quadroCache` precisa ser recomposto.
+    int ultimoScore;                ///< @brief Pontuação exibida na última composição.
+    int ultimoRecordPessoal;        ///< @brief Recorde pessoal exibido na última composição.
+    int ultimoRecordGeral;          ///< @brief Recorde geral exibido na última composição.
+    bool ultimoR1;                  ///< @brief Aviso de recorde pessoal exibido na última composição.
+    bool ultimoR2;                  ///< @brief Aviso de recorde geral exibido na última composição.
+    double percentilPartidas;       ///< @brief Porcentagem das partidas superadas (negativa: não exibida).
+    double percentilJogadores;      ///< @brief Porcentagem dos jogadores superados (negativa: não exibida).
+    size_t posicaoGeral;            ///< @brief Posição no ranking compartilhado (0: não exibida).
+    size_t totalGeral;              ///< @brief Apelidos no ranking compartilhado.
+
+    /**
+     * @brief Calcula a posição dos botões (depende apenas do tamanho da tela).
+     */
+    void calcularLayout();
+
+    /**
+     * @brief Lê o mouse, atualiza o hover dos botões e toca o som ao entrar em um botão.
+     * @return true se o hover de algum botão mudou.
+     */
+    bool atualizarHover();
+
+    /**
+     * @brief Desenha o fundo, os textos e os botões no alvo atual.
+     */
+    void compor(int score, int recordPessoal, int recordGeral, bool r1, bool r2);
 };
 
 #endif // GAMEOVERSCREEN_HPP
\ No newline at end of file
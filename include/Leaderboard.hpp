@@ -0,0 +1,185 @@
+/**
+ * @file Leaderboard.hpp
+ * @brief Leaderboardheader do projeto Traveling Dragon.
+ */
+
+#ifndef LEADERBOARD_HPP
+#define LEADERBOARD_HPP
+
+#include <cstddef> // Para size_t
+#include <cstdint> // Para tipos de tamanho fixo dos nós
+#include <random>  // Para sortear a altura dos nós
+#include <vector>  // Para usar std::vector (nós, ligações e resultados)
+
+/**
+ * @brief Ranking dos jogadores mantido sempre ordenado, atualizado só quando uma pontuação muda.
+ *
+ * É uma skiplist indexável: os jogadores ficam em uma lista encadeada em ordem
+ * (maior pontuação primeiro; no empate, o menor Id, ou seja, o cadastro mais antigo),
+ * com níveis de atalhos por cima. Cada atalho guarda quantos jogadores ele pula,
+ * então a posição de um jogador e o jogador de uma posição saem em O(log n), sem
+ * ordenar nada. As N primeiras posições são os N primeiros nós da lista (O(N)) e o
+ * recorde geral é o primeiro nó (O(1)).
+ *
+ * Os nós ficam em vetores indexados pelo Id do jogador (o Id do PlayerManager), sem
+ * uma alocação por jogador; a altura de um nó é sorteada uma vez e mantida quando a
+ * pontuação dele muda. Cada atalho guarda também a pontuação e a posição (no vetor de
+ * ligações) do nó para onde aponta: a descida compara e avança lendo só as ligações,
+ * um acesso à memória por passo.
+ */
+class Leaderboard {
+public:
+    /// @brief Altura máxima de um nó (com 1/4 de chance por nível, sobra para muito mais que 10^6 jogadores).
+    static constexpr int ALTURA_MAXIMA = 16;
+
+    /**
+     * @brief Construtor da classe Leaderboard. Começa vazio.
+     */
+    Leaderboard();
+
+    /**
+     * @brief Remove todos os jogadores.
+     */
+    void limpar();
+
+    /**
+     * @brief Monta o ranking inteiro de uma vez, em O(n log n) (ordenação) + O(n) (ligações).
+     * @param pontuacoes A pontuação de cada jogador, indexada pelo Id.
+     */
+    void reconstruir(const std::vector<int>& pontuacoes);
+
+    /**
+     * @brief Insere um jogador ou muda a pontuação dele (O(log n)).
+     * @param id O Id do jogador (0 ou maior).
+     * @param pontuacao A pontuação que define a posição.
+     */
+    void atualizar(int32_t id, int pontuacao);
+
+    /**
+     * @brief Informa se um jogador está no ranking.
+     * @param id O Id do jogador.
+     * @return true se ele foi inserido.
+     */
+    bool contem(int32_t id) const;
+
+    /**
+     * @brief Retorna quantos jogadores estão no ranking.
+     * @return O número de jogadores.
+     */
+    size_t getQuantidade() const { return quantidade; }
+
+    /**
+     * @brief Calcula a posição de um jogador (O(log n)).
+     * @param id O Id do jogador.
+     * @return A posição, a partir de 1 (0 se o jogador não está no ranking).
+     */
+    size_t getPosicao(int32_t id) const;
+
+    /**
+     * @brief Encontra o jogador de uma posição (O(log n)).
+     * @param posicao A posição, a partir de 1.
+     * @return O Id do jogador, ou -1 se a posição não existe.
+     */
+    int32_t getJogadorNaPosicao(size_t posicao) const;
+
+    /**
+     * @brief Lista os jogadores a partir de uma posição, em ordem (O(log n + quantidade)).
+     * @param posicao A primeira posição, a partir de 1.
+     * @param quantidade Quantos jogadores, no máximo.
+     * @return Os Ids, em ordem de posição.
+     */
+    std::vector<int32_t> listar(size_t posicao, size_t quantidade) const;
+
+    /**
+     * @brief Lista as primeiras posições (O(quantidade)).
+     * @param quantidade Quantos jogadores, no máximo.
+     * @return Os Ids, do primeiro colocado em diante.
+     */
+    std::vector<int32_t> melhores(size_t quantidade) const { return listar(1, quantidade); }
+
+    /**
+     * @brief Retorna o recorde geral (O(1)).
+     * @return A pontuação do primeiro colocado (0 com o ranking vazio).
+     */
+    int getRecorde() const;
+
+    /**
+     * @brief Retorna a pontuação com que um jogador está no ranking.
+     * @param id O Id do jogador.
+     * @return A pontuação (0 se ele não está no ranking).
+     */
+    int getPontuacao(int32_t id) const;
+
+private:
+    /**
+     * @brief Um atalho de um nó em um nível.
+     */
+    struct Ligacao {
+        uint32_t proximo = 0;      ///< @brief Nó seguinte neste nível (Id + 1; 0 = fim da lista).
+        uint32_t baseProximo = 0;  ///< @brief Posição das ligações do nó seguinte em `ligacoes`.
+        int pontosProximo = 0;     ///< @brief Pontuação do nó seguinte (cópia, para comparar sem buscá-lo).
+        uint32_t salto = 0;        ///< @brief Quantas posições o atalho avança (até o fim, se não há seguinte).
+    };
+
+    // Os nós são numerados com Id + 1: o nó 0 é a cabeça, com a altura máxima
+    std::vector<int> pontos;              ///< @brief Pontuação de cada nó.
+    std::vector<uint8_t> alturas;         ///< @brief Altura de cada nó (0 = jogador fora do ranking).
+    std::vector<uint32_t> inicioLigacoes; ///< @brief Posição das ligações de cada nó em `ligacoes`.
+    std::vector<Ligacao> ligacoes;        ///< @brief Ligações de todos os nós, uma por nível.
+    int alturaAtual;                      ///< @brief Altura do nó mais alto da lista (1 com a lista vazia).
+    size_t quantidade;                    ///< @brief Jogadores no ranking.
+    std::minstd_rand sorteio;             ///< @brief Sorteio das alturas (semente fixa: o ranking é reproduzível).
+
+    /**
+     * @brief Compara dois nós na ordem do ranking.
+     * @return true se o nó `a` (com `pontosA`) vem antes do `b` (mais pontos, ou os mesmos pontos e Id menor).
+     */
+    static bool antes(int pontosA, uint32_t a, int pontosB, uint32_t b) {
+        return pontosA != pontosB ? pontosA > pontosB : a < b;
+    }
+
+    /**
+     * @brief Aponta uma ligação para um nó, copiando a pontuação e a posição dele.
+     * @param ligacao A ligação.
+     * @param no O nó.
+     */
+    void apontar(Ligacao& ligacao, uint32_t no) const {
+        ligacao.proximo = no;
+        ligacao.baseProximo = inicioLigacoes[no];
+        ligacao.pontosProximo = pontos[no];
+    }
+
+    /**
+     * @brief Desce pela lista até o último nó de cada nível que vem antes de um nó.
+     * @param no O nó procurado (a pontuação dele é a de `pontos`).
+     * @param anteriores Recebe, por nível, a posição das ligações do último nó antes dele.
+     * @param posicoes Se não for nulo, recebe a posição no ranking de cada um desses nós.
+     */
+    void procurar(uint32_t no, uint32_t* anteriores, size_t* posicoes) const;
+
+    /**
+     * @brief Garante que o nó de um Id existe, sorteando a altura dele.
+     * @param no O nó (Id + 1).
+     */
+    void criarNo(uint32_t no);
+
+    /**
+     * @brief Sorteia a altura de um nó novo.
+     * @return Um valor de 1 a ALTURA_MAXIMA (cada nível com 1/4 de chance).
+     */
+    int sortearAltura();
+
+    /**
+     * @brief Liga um nó na lista, na posição da pontuação dele.
+     * @param no O nó.
+     */
+    void inserir(uint32_t no);
+
+    /**
+     * @brief Desliga um nó da lista.
+     * @param no O nó.
+     */
+    void remover(uint32_t no);
+};
+
+#endif // LEADERBOARD_HPP
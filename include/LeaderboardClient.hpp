@@ -0,0 +1,218 @@
+/**
+ * @file LeaderboardClient.hpp
+ * @brief LeaderboardClientheader do projeto Traveling Dragon.
+ */
+
+#ifndef LEADERBOARDCLIENT_HPP
+#define LEADERBOARDCLIENT_HPP
+
+#include <allegro5/allegro.h> // Para a thread de envio, o mutex e as variáveis de condição
+#include <cstddef>            // Para size_t
+#include <cstdint>            // Para uint64_t (números de sequência)
+#include <deque>              // Para usar std::deque (fila de saída)
+#include <string>             // Para usar std::string (caminhos, apelidos)
+#include <vector>             // Para usar std::vector (lotes e primeiras posições)
+#include "FileLock.hpp"       // Trava do arquivo de pendentes entre os jogos
+#include "LocalSocket.hpp"    // Conexão com o serviço de ranking
+
+/**
+ * @brief Envia as partidas de um jogo para o serviço de ranking (LeaderboardServer) sem nunca travar o jogo.
+ *
+ * `enviar` só põe a partida em uma fila limitada e acorda a thread de envio; ela espera
+ * um instante para juntar as partidas de uma rajada e manda o lote inteiro com as
+ * consultas em uma só ida e volta (veja o protocolo no LeaderboardServer). Com a fila
+ * cheia, a partida mais antiga é descartada (e contada), em vez de o jogo esperar.
+ *
+ * Sem o serviço (desligado, caiu ou não respondeu a tempo), o lote vai para o arquivo
+ * de pendentes e a thread tenta de novo com espera crescente (de 250 ms até 8 s). O
+ * arquivo é enviado antes da fila na próxima conexão e apagado quando o serviço
+ * confirma, inclusive em uma próxima execução do jogo. Cada execução tem a sua
+ * origem e numera as partidas em ordem, então um lote reenviado depois de uma
+ * confirmação perdida não conta nada duas vezes. Vários jogos na mesma pasta
+ * dividem o arquivo de pendentes com a trava `<pendentes>.lock`.
+ *
+ * As telas leem as primeiras posições e a posição dos apelidos acompanhados de uma
+ * cópia local, atualizada pela thread a cada lote e a cada poucos segundos: a leitura
+ * só copia essa cópia, sem esperar o serviço.
+ */
+class LeaderboardClient {
+public:
+    /**
+     * @brief Uma linha das primeiras posições.
+     */
+    struct Colocacao {
+        std::string apelido; ///< @brief Apelido.
+        int pontuacao = 0;   ///< @brief Maior pontuação do apelido.
+    };
+
+    /**
+     * @brief Contadores do envio, para o HUD de depuração e o console.
+     */
+    struct Estatisticas {
+        int enviadas = 0;            ///< @brief Partidas entregues a `enviar`.
+        int confirmadas = 0;         ///< @brief Partidas confirmadas pelo serviço (inclusive as de execuções anteriores).
+        int descartadas = 0;         ///< @brief Partidas perdidas por fila (ou arquivo de pendentes) cheia.
+        int lotes = 0;               ///< @brief Lotes confirmados.
+        int falhas = 0;              ///< @brief Tentativas de envio que falharam.
+        int pendentes = 0;           ///< @brief Partidas esperando envio (fila e arquivo).
+        bool conectado = false;      ///< @brief true se a última tentativa chegou ao serviço.
+        double ultimaLatenciaMs = 0; ///< @brief Ida e volta do último lote.
+    };
+
+    /// @brief Limite padrão de partidas na fila de saída.
+    static constexpr size_t LIMITE_PADRAO = 1024;
+    /// @brief Limite de partidas no arquivo de pendentes.
+    static constexpr int LIMITE_ARQUIVO = 100000;
+    /// @brief Primeiras posições mantidas na cópia local.
+    static constexpr int MELHORES = 10;
+    /// @brief Apelidos acompanhados no máximo (o mais antigo sai).
+    static constexpr size_t MAXIMO_ACOMPANHADOS = 8;
+
+    /**
+     * @brief Construtor da classe LeaderboardClient. Cria a thread de envio, que já
+     * entrega o que ficou pendente de execuções anteriores.
+     * @param caminhoSocket Caminho do socket do serviço.
+     * @param caminhoPendentes Arquivo das partidas que esperam o serviço.
+     * @param limiteFila Partidas que podem esperar na fila de saída.
+     * @param esperaGrupoMs Tempo que a thread espera para juntar as partidas de uma rajada.
+     * @param intervaloAtualizacaoMs Intervalo entre atualizações da cópia local sem partidas novas.
+     */
+    LeaderboardClient(const std::string& caminhoSocket, const std::string& caminhoPendentes,
+                      size_t limiteFila = LIMITE_PADRAO, int esperaGrupoMs = 50, int intervaloAtualizacaoMs = 5000);
+
+    /**
+     * @brief Destrutor da classe LeaderboardClient. Tenta enviar o que resta uma última
+     * vez; o que não pôde ser enviado fica no arquivo de pendentes.
+     */
+    ~LeaderboardClient();
+
+    LeaderboardClient(const LeaderboardClient&) = delete;            ///< @brief Não copiável (possui a thread).
+    LeaderboardClient& operator=(const LeaderboardClient&) = delete; ///< @brief Não copiável (possui a thread).
+
+    /**
+     * @brief Entrega uma partida para envio e retorna na hora.
+     * @param apelido O apelido do jogador (também passa a ser acompanhado).
+     * @param pontuacao A pontuação da partida.
+     */
+    void enviar(const std::string& apelido, int pontuacao);
+
+    /**
+     * @brief Passa a manter na cópia local a posição de um apelido.
+     * @param apelido O apelido.
+     */
+    void acompanhar(const std::string& apelido);
+
+    /**
+     * @brief Retorna as primeiras posições da cópia local.
+     * @return Até MELHORES colocações, da primeira em diante (vazio antes da primeira resposta).
+     */
+    std::vector<Colocacao> getMelhores() const;
+
+    /**
+     * @brief Consulta na cópia local a posição de um apelido acompanhado.
+     * @param apelido O apelido.
+     * @param posicao Recebe a posição, a partir de 1.
+     * @param total Recebe quantos apelidos o ranking tem.
+     * @return false se a posição ainda não é conhecida (ou o apelido não está no ranking).
+     */
+    bool getPosicao(const std::string& apelido, size_t& posicao, size_t& total) const;
+
+    /**
+     * @brief Espera todas as partidas entregues até agora serem confirmadas.
+     * @param timeoutMs Tempo máximo de espera, em milissegundos.
+     * @return false se o tempo acabou antes (ex: serviço fora do ar).
+     */
+    bool aguardar(int timeoutMs);
+
+    /**
+     * @brief Retorna uma cópia dos contadores.
+     * @return As estatísticas.
+     */
+    Estatisticas getEstatisticas() const;
+
+private:
+    /**
+     * @brief Uma partida a enviar.
+     */
+    struct Partida {
+        std::string origem; ///< @brief Execução do jogo que a registrou.
+        uint64_t seq;       ///< @brief Número da partida na origem.
+        int pontuacao;      ///< @brief Pontuação.
+        std::string apelido; ///< @brief Apelido (sem quebras de linha).
+    };
+
+    /**
+     * @brief Posição conhecida de um apelido acompanhado.
+     */
+    struct Acompanhado {
+        std::string apelido;  ///< @brief Apelido.
+        size_t posicao = 0;   ///< @brief Posição, a partir de 1 (0: desconhecida).
+        size_t total = 0;     ///< @brief Apelidos no ranking na última resposta.
+    };
+
+    std::string caminhoSocket;    ///< @brief Caminho do socket do serviço.
+    std::string caminhoPendentes; ///< @brief Arquivo das partidas que esperam o serviço.
+    size_t limiteFila;            ///< @brief Partidas que podem esperar na fila.
+    int esperaGrupoMs;            ///< @brief Espera para juntar uma rajada, em milissegundos.
+    int intervaloAtualizacaoMs;   ///< @brief Intervalo entre atualizações sem partidas novas.
+    std::string origem;           ///< @brief Identificador desta execução.
+    uint64_t proximoSeq;          ///< @brief Número da próxima partida entregue.
+
+    std::deque<Partida> fila;     ///< @brief Partidas esperando a thread.
+    int pendentesArquivo;         ///< @brief Partidas no arquivo de pendentes (estimativa deste processo).
+    bool enviando;                ///< @brief Flag: true enquanto a thread tem um lote em mãos.
+    bool encerrando;              ///< @brief Flag: true quando a thread deve fazer a última tentativa e sair.
+    std::vector<Colocacao> melhores;       ///< @brief Cópia local das primeiras posições.
+    std::vector<Acompanhado> acompanhados; ///< @brief Cópia local das posições acompanhadas.
+    Estatisticas estatisticas;    ///< @brief Contadores.
+
+    LocalSocket conexao;          ///< @brief Conexão com o serviço (só a thread a usa).
+    FileLock travaPendentes;      ///< @brief Trava do arquivo de pendentes (só a thread a usa).
+    ALLEGRO_MUTEX* mutex;         ///< @brief Protege a fila, a cópia local, as flags e os contadores.
+    ALLEGRO_COND* haTrabalho;     ///< @brief Acorda a thread (partida nova ou encerramento).
+    ALLEGRO_COND* semPendencias;  ///< @brief Sinaliza quem espera em `aguardar`.
+    ALLEGRO_THREAD* thread;       ///< @brief Thread de envio (nula se não pôde ser criada).
+
+    /**
+     * @brief Lê o arquivo de pendentes (com a trava dele já obtida).
+     * @param lote Recebe as partidas, na ordem do arquivo.
+     */
+    void lerPendentes(std::vector<Partida>& lote) const;
+
+    /**
+     * @brief Acrescenta partidas ao arquivo de pendentes (com a trava dele já obtida), até LIMITE_ARQUIVO.
+     * @param partidas As partidas.
+     * @param existentes Partidas que já estavam no arquivo.
+     * @return Quantas partidas não couberam.
+     */
+    int guardarPendentes(const std::vector<Partida>& partidas, int existentes) const;
+
+    /**
+     * @brief Manda um lote com as consultas e lê as respostas (conectando se preciso).
+     * Não pode ser chamada com `mutex` travado.
+     * @param lote As partidas (pode estar vazio: só as consultas).
+     * @param consultados Apelidos cuja posição é pedida.
+     * @param novasMelhores Recebe as primeiras posições.
+     * @param posicoes Recebe a posição e o total de cada consultado.
+     * @return false se o serviço não confirmou o lote.
+     */
+    bool trocar(const std::vector<Partida>& lote, const std::vector<std::string>& consultados,
+                std::vector<Colocacao>& novasMelhores, std::vector<std::pair<size_t, size_t>>& posicoes);
+
+    /**
+     * @brief Uma tentativa de envio: pendentes do arquivo, depois a fila; o que falhar vai para o arquivo.
+     * Chamada pela thread, com `mutex` travado (ele é solto durante a troca).
+     * @return true se o serviço confirmou.
+     */
+    bool tentarEnvio();
+
+    /**
+     * @brief Laço da thread de envio.
+     * @param thread A thread atual (não usada).
+     * @param arg Ponteiro para o LeaderboardClient.
+     * @return Sempre nullptr.
+     */
+    static void* executarEnvio(ALLEGRO_THREAD* thread, void* arg);
+};
+
+#endif // LEADERBOARDCLIENT_HPP
@@ -0,0 +1,194 @@
+/**
+ * @file LeaderboardServer.hpp
+ * @brief LeaderboardServerheader do projeto Traveling Dragon.
+ */
+
+#ifndef LEADERBOARDSERVER_HPP
+#define LEADERBOARDSERVER_HPP
+
+#include <atomic>        // Para o pedido de parada vindo de outra thread (ou de um sinal)
+#include <cstdint>       // Para uint64_t (números de sequência) e int32_t (Ids do ranking)
+#include <string>        // Para usar std::string (caminhos, apelidos, linhas)
+#include <unordered_map> // Para os Ids dos apelidos e o último número de cada origem
+#include <vector>        // Para usar std::vector (conexões e apelidos)
+#include "Leaderboard.hpp" // Ranking mantido em ordem
+#include "LocalSocket.hpp" // Conexões com os jogos
+
+/**
+ * @brief Serviço de ranking compartilhado por vários jogos (gabinetes) da mesma máquina.
+ *
+ * Roda em um processo à parte (a ferramenta leaderboard_daemon) e atende os jogos por
+ * um socket local (LocalSocket), em uma única thread: um laço espera qualquer conexão
+ * ter bytes, lê tudo o que chegou e responde, sem uma thread por jogo. O ranking é o
+ * mesmo Leaderboard do cadastro, com a maior pontuação de cada apelido.
+ *
+ * O protocolo é de texto, uma linha por pedido, com o apelido sempre no fim (ele pode
+ * ter espaços):
+ * - `P <origem> <seq> <pontuacao> <apelido>`: uma partida, sem resposta. A origem é o
+ *   jogo que a enviou e seq cresce a cada partida dela; uma partida com seq menor ou
+ *   igual ao último visto da origem já foi contada e é ignorada, então reenviar um
+ *   lote que não foi confirmado nunca conta uma partida duas vezes.
+ * - `F`: fim de um lote; respondido com `K`, que confirma tudo o que veio antes.
+ * - `T <k>`: as k primeiras posições, respondidas com linhas `E <pontuacao> <apelido>` e `.`.
+ * - `R <apelido>`: respondido com `R <posicao> <total>` (posição 0 se o apelido não está no ranking).
+ *
+ * Um jogo manda um lote inteiro e as consultas de uma vez e lê as respostas depois:
+ * uma ida e volta por lote, não por partida. A resposta que o jogo ainda não leu fica
+ * na conexão e é enviada quando o socket aceita mais bytes, sem parar o laço.
+ *
+ * Com um arquivo, o ranking e o último número de cada origem são gravados nele (em um
+ * temporário renomeado por cima) quando mudam, no máximo a cada intervalo, e ao parar.
+ * Cada execução de um jogo é uma origem nova, então as origens sem partidas há mais de
+ * VALIDADE_ORIGEM_S são esquecidas; um reenvio tão atrasado conta de novo só nas
+ * estatísticas, já que o ranking guarda a maior pontuação de cada apelido.
+ */
+class LeaderboardServer {
+public:
+    /**
+     * @brief Contadores do serviço, mostrados pela ferramenta ao sair.
+     */
+    struct Estatisticas {
+        long long partidas = 0;  ///< @brief Partidas contadas.
+        long long repetidas = 0; ///< @brief Partidas ignoradas por já terem sido contadas (reenvios).
+        long long lotes = 0;     ///< @brief Lotes confirmados.
+        long long consultas = 0; ///< @brief Pedidos de primeiras posições e de posição.
+        long long invalidas = 0; ///< @brief Linhas que não seguem o protocolo.
+        int conexoes = 0;        ///< @brief Conexões aceitas.
+        int gravacoes = 0;       ///< @brief Vezes em que o arquivo foi gravado.
+        int origensEsquecidas = 0; ///< @brief Origens esquecidas por estarem sem partidas há muito tempo.
+    };
+
+    /// @brief Maior linha aceita; uma conexão que passa disso sem quebra de linha é fechada.
+    static constexpr size_t MAXIMO_LINHA = 4096;
+    /// @brief Maior quantidade de posições em uma consulta `T`.
+    static constexpr int MAXIMO_CONSULTA = 100;
+    /// @brief Maior resposta esperando o jogo ler; uma conexão que passa disso é fechada.
+    static constexpr size_t MAXIMO_SAIDA = 1024 * 1024;
+    /// @brief Tempo sem partidas depois do qual uma origem é esquecida (30 dias), em segundos.
+    static constexpr long long VALIDADE_ORIGEM_S = 30LL * 24 * 60 * 60;
+
+    /**
+     * @brief Construtor da classe LeaderboardServer. Não abre nada (veja `iniciar`).
+     * @param caminhoSocket Caminho do socket em que os jogos se conectam.
+     * @param caminhoArquivo Arquivo do ranking (vazio: só memória).
+     * @param intervaloGravacaoMs Menor intervalo entre duas gravações do arquivo.
+     */
+    explicit LeaderboardServer(const std::string& caminhoSocket, const std::string& caminhoArquivo = "",
+                               int intervaloGravacaoMs = 5000);
+
+    LeaderboardServer(const LeaderboardServer&) = delete;            ///< @brief Não copiável (possui as conexões).
+    LeaderboardServer& operator=(const LeaderboardServer&) = delete; ///< @brief Não copiável (possui as conexões).
+
+    /**
+     * @brief Lê o arquivo do ranking (se houver) e passa a aceitar conexões.
+     * @return false se o socket não pôde ser aberto.
+     */
+    bool iniciar();
+
+    /**
+     * @brief Atende os jogos até `parar` ser chamado; grava o arquivo ao sair.
+     */
+    void executar();
+
+    /**
+     * @brief Pede para `executar` terminar (pode ser chamado de outra thread ou de um sinal).
+     */
+    void parar() { parando = true; }
+
+    /**
+     * @brief Grava o ranking no arquivo (se houver um).
+     * @return false se a gravação falhou.
+     */
+    bool salvar();
+
+    /**
+     * @brief Retorna os contadores (só entre chamadas de `executar`).
+     * @return As estatísticas.
+     */
+    const Estatisticas& getEstatisticas() const { return estatisticas; }
+
+    /**
+     * @brief Retorna o ranking atual (só entre chamadas de `executar`).
+     * @return O ranking.
+     */
+    const Leaderboard& getRanking() const { return ranking; }
+
+    /**
+     * @brief Retorna quantas origens o serviço está acompanhando.
+     * @return O número de origens.
+     */
+    size_t getQuantidadeOrigens() const { return origens.size(); }
+
+    /**
+     * @brief Retorna o apelido de um Id do ranking.
+     * @param id O Id.
+     * @return O apelido.
+     */
+    const std::string& getApelido(int32_t id) const { return apelidos[id]; }
+
+private:
+    /**
+     * @brief Uma conexão de um jogo e os bytes dela que ainda não formam uma linha.
+     */
+    struct Conexao {
+        LocalSocket socket;  ///< @brief O socket.
+        std::string entrada; ///< @brief Bytes recebidos e ainda não processados.
+        std::string saida;   ///< @brief Resposta que o jogo ainda não leu.
+    };
+
+    /**
+     * @brief Último número de uma origem e quando ele chegou.
+     */
+    struct Origem {
+        uint64_t seq = 0;     ///< @brief Maior seq já contado.
+        long long vista = 0;  ///< @brief Última partida da origem, em segundos desde 1970.
+    };
+
+    std::string caminhoSocket;  ///< @brief Caminho do socket.
+    std::string caminhoArquivo; ///< @brief Arquivo do ranking (vazio: só memória).
+    int intervaloGravacaoMs;    ///< @brief Menor intervalo entre duas gravações.
+    LocalSocket escuta;         ///< @brief Socket que aceita as conexões.
+    std::vector<Conexao> conexoes; ///< @brief Jogos conectados.
+    Leaderboard ranking;        ///< @brief Maior pontuação de cada apelido, em ordem.
+    std::vector<std::string> apelidos; ///< @brief Apelido de cada Id do ranking.
+    std::unordered_map<std::string, int32_t> ids; ///< @brief Id de cada apelido.
+    std::unordered_map<std::string, Origem> origens; ///< @brief Maior seq já contado de cada origem.
+    bool alterado;              ///< @brief Flag: true se algo mudou desde a última gravação.
+    std::atomic<bool> parando;  ///< @brief Flag: true quando `executar` deve terminar.
+    Estatisticas estatisticas;  ///< @brief Contadores.
+
+    /**
+     * @brief Lê o arquivo do ranking.
+     * @return false se o arquivo não existe.
+     */
+    bool carregar();
+
+    /**
+     * @brief Conta uma pontuação para um apelido (só sobe a dele no ranking se for maior).
+     * @param apelido O apelido.
+     * @param pontuacao A pontuação.
+     */
+    void registrar(const std::string& apelido, int pontuacao);
+
+    /**
+     * @brief Processa uma linha do protocolo.
+     * @param linha A linha, sem a quebra.
+     * @param saida Recebe a resposta no fim.
+     */
+    void processar(const std::string& linha, std::string& saida);
+
+    /**
+     * @brief Lê o que chegou de uma conexão, processa as linhas completas e envia o que couber da resposta.
+     * @param conexao A conexão.
+     * @return false se a conexão acabou ou deve ser fechada.
+     */
+    bool atender(Conexao& conexao);
+
+    /**
+     * @brief Esquece as origens sem partidas há mais de VALIDADE_ORIGEM_S.
+     * @param agora Instante atual, em segundos desde 1970.
+     */
+    void esquecerOrigens(long long agora);
+};
+
+#endif // LEADERBOARDSERVER_HPP
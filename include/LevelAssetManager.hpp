@@ -0,0 +1,241 @@
+/**
+ * @file LevelAssetManager.hpp
+ * @brief LevelAssetManagerheader do projeto Traveling Dragon.
+ */
+
+#ifndef LEVELASSETMANAGER_HPP
+#define LEVELASSETMANAGER_HPP
+
+#include <allegro5/allegro.h>       // Para ALLEGRO_BITMAP
+#include <allegro5/allegro_audio.h> // Para ALLEGRO_AUDIO_STREAM
+#include <cstddef>                  // Para size_t
+#include <cstdint>                  // Para uint64_t (relógio de uso)
+#include <string>                   // Para usar std::string (caminhos dos assets)
+#include <vector>                   // Para usar std::vector (níveis)
+#include "AssetArchive.hpp"         // Pacote de onde os assets são lidos
+#include "AssetLoader.hpp"          // Threads que preparam os níveis em segundo plano
+#include "MemoryTracker.hpp"        // Contabilidade da memória de cada nível
+#include "ScaledAssetCache.hpp"     // Fundos e canos já no tamanho da tela
+
+/**
+ * @brief Carrega os assets de cada nível (fundo, cano e música) só quando são necessários.
+ *
+ * Em vez de manter todos os níveis na memória durante a sessão inteira, o gerenciador
+ * mantém apenas os níveis "ao alcance": o nível atual, o próximo (carregado em
+ * segundo plano enquanto o atual é jogado) e o primeiro, para onde o jogador volta
+ * ao reiniciar. Os outros níveis ficam na memória como cache enquanto o total couber
+ * no orçamento; quando não cabe, os usados há mais tempo são descarregados primeiro.
+ *
+ * A quantidade de níveis vem dos assets presentes (background1.png, background2.png, ...,
+ * no pacote ou em `assets/`), então um conjunto maior de níveis não exige mudar o código.
+ *
+ * Um nível cujo carregamento falhou é substituído pelo nível carregado mais próximo
+ * (de preferência um anterior): os getters devolvem os assets dele, e ele fica ao
+ * alcance enquanto estiver no lugar do outro.
+ */
+class LevelAssetManager {
+public:
+    /**
+     * @brief Um nível residente, do ponto de vista da política de descarte.
+     */
+    struct Residencia {
+        int nivel;          ///< @brief Índice do nível (começando de 0).
+        size_t bytes;       ///< @brief Memória ocupada pelo nível.
+        uint64_t ultimoUso; ///< @brief Momento (relógio interno) em que o nível foi pedido pela última vez.
+        bool alcancavel;    ///< @brief true se o nível pode ser pedido a qualquer momento (nunca é descartado).
+    };
+
+    /**
+     * @brief Números de residência mostrados no HUD de depuração e no log.
+     */
+    struct Estatisticas {
+        int residentes = 0;          ///< @brief Níveis carregados agora.
+        int carregando = 0;          ///< @brief Níveis sendo preparados em segundo plano.
+        size_t bytesResidentes = 0;  ///< @brief Memória dos níveis carregados.
+        size_t picoBytes = 0;        ///< @brief Maior valor de `bytesResidentes` na sessão.
+        int carregamentos = 0;       ///< @brief Níveis carregados desde o início.
+        int descartes = 0;           ///< @brief Níveis descarregados por falta de orçamento.
+        int esperas = 0;             ///< @brief Vezes em que o jogo precisou esperar um nível que não estava pronto.
+        double msEsperando = 0.0;    ///< @brief Tempo total dessas esperas, em milissegundos.
+    };
+
+    /**
+     * @brief Construtor da classe LevelAssetManager. Descobre quantos níveis existem.
+     * @param carregador Threads usadas para preparar os níveis (deve viver mais que este objeto).
+     * @param pacote Pacote de onde os assets são lidos (deve viver mais que este objeto).
+     * @param diretorioCache Pasta do cache de imagens redimensionadas.
+     * @param telaW Largura da tela (os fundos são reduzidos para cobri-la).
+     * @param telaH Altura da tela.
+     * @param orcamentoBytes Memória máxima para os níveis fora do alcance ficarem em cache.
+     * @param memoria Contabilidade onde os assets dos níveis são registrados (pode ser nula).
+     */
+    LevelAssetManager(AssetLoader& carregador, const AssetArchive& pacote, const std::string& diretorioCache,
+                      int telaW, int telaH, size_t orcamentoBytes, MemoryTracker* memoria = nullptr);
+
+    /**
+     * @brief Destrutor da classe LevelAssetManager. Libera todos os níveis carregados.
+     * O AssetLoader precisa ter sido destruído antes (nenhum trabalho pendente pode restar).
+     */
+    ~LevelAssetManager();
+
+    LevelAssetManager(const LevelAssetManager&) = delete;            ///< @brief Não copiável (possui bitmaps).
+    LevelAssetManager& operator=(const LevelAssetManager&) = delete; ///< @brief Não copiável (possui bitmaps).
+
+    /**
+     * @brief Retorna quantos níveis foram encontrados nos assets.
+     * @return O número de níveis.
+     */
+    int getTotalNiveis() const { return (int)niveis.size(); }
+
+    /**
+     * @brief Informa qual nível está sendo jogado.
+     * Pede o nível e o seguinte (em segundo plano) e descarta o que não couber no orçamento.
+     * @param nivel O nível atual (começando de 0).
+     */
+    void definirNivelAtual(int nivel);
+
+    /**
+     * @brief Garante que um nível (ou, se ele falhou, o seu substituto) está carregado, esperando se preciso.
+     * Normalmente o nível já foi pré-carregado e a chamada retorna na hora.
+     * @param nivel O nível desejado.
+     * @return true se há assets para o nível (false se ele não existe ou nenhum nível carregou).
+     */
+    bool garantirResidente(int nivel);
+
+    /**
+     * @brief Retorna o fundo de um nível carregado (o do substituto, se o nível falhou).
+     * @param nivel O nível desejado.
+     * @return O bitmap, ou nullptr se nem o nível nem um substituto está carregado.
+     */
+    ALLEGRO_BITMAP* getFundo(int nivel) const;
+
+    /**
+     * @brief Retorna o cano de um nível carregado (o do substituto, se o nível falhou).
+     * @param nivel O nível desejado.
+     * @return O bitmap, ou nullptr se nem o nível nem um substituto está carregado.
+     */
+    ALLEGRO_BITMAP* getCano(int nivel) const;
+
+    /**
+     * @brief Retorna a música de um nível carregado (a do substituto, se o nível falhou).
+     * @param nivel O nível desejado.
+     * @return A stream, ou nullptr se nem o nível nem um substituto está carregado.
+     */
+    ALLEGRO_AUDIO_STREAM* getMusica(int nivel) const;
+
+    /**
+     * @brief Retorna os números de residência atuais.
+     * @return As estatísticas.
+     */
+    const Estatisticas& getEstatisticas() const { return stats; }
+
+    /**
+     * @brief Retorna o orçamento de memória dos níveis.
+     * @return O orçamento, em bytes.
+     */
+    size_t getOrcamento() const { return orcamento; }
+
+    /**
+     * @brief Escolhe quais níveis descarregar para caber no orçamento.
+     *
+     * Só níveis fora do alcance são candidatos, do usado há mais tempo para o mais
+     * recente, até o total caber. Se nem assim couber, os alcançáveis ficam mesmo
+     * assim (o orçamento nunca impede o jogo de continuar).
+     *
+     * @param residentes Os níveis carregados.
+     * @param orcamento Memória máxima, em bytes.
+     * @return Os índices dos níveis a descarregar.
+     */
+    static std::vector<int> escolherDescartes(std::vector<Residencia> residentes, size_t orcamento);
+
+    /**
+     * @brief Escolhe o nível usado no lugar de outro.
+     *
+     * O próprio nível, se ele pode ser usado; senão, o anterior mais próximo que pode
+     * (o jogador já viu esse cenário); senão, o seguinte mais próximo.
+     *
+     * @param disponiveis Para cada nível, true se ele pode ser usado.
+     * @param nivel O nível desejado.
+     * @return O nível escolhido, ou -1 se nenhum pode ser usado.
+     */
+    static int escolherSubstituto(const std::vector<bool>& disponiveis, int nivel);
+
+private:
+    /**
+     * @brief Situação de um nível.
+     */
+    enum Estado {
+        VAZIO,      ///< @brief Não carregado.
+        CARREGANDO, ///< @brief Sendo preparado em segundo plano.
+        RESIDENTE,  ///< @brief Carregado e pronto para uso.
+        FALHOU      ///< @brief Algum arquivo não pôde ser carregado (não é tentado de novo).
+    };
+
+    /**
+     * @brief Os assets e a situação de um nível.
+     */
+    struct Nivel {
+        int numero = 0;                      ///< @brief Número do nível nos nomes dos arquivos (background<numero>.png).
+        std::string caminhoFundo;            ///< @brief Caminho do fundo original.
+        std::string caminhoCano;             ///< @brief Caminho do cano original.
+        std::string caminhoMusica;           ///< @brief Caminho da música.
+        Estado estado = VAZIO;               ///< @brief Situação atual.
+        ALLEGRO_BITMAP* fundo = nullptr;     ///< @brief Fundo reduzido para a tela.
+        ALLEGRO_BITMAP* cano = nullptr;      ///< @brief Cano reduzido pela escala dos sprites.
+        ALLEGRO_AUDIO_STREAM* musica = nullptr; ///< @brief Música do nível.
+        size_t bytes = 0;                    ///< @brief Memória do nível carregado.
+        uint64_t ultimoUso = 0;              ///< @brief Relógio interno do último pedido.
+    };
+
+    AssetLoader& carregador;    ///< @brief Threads que preparam os níveis.
+    const AssetArchive& pacote; ///< @brief Pacote de onde os assets são lidos.
+    ScaledAssetCache cache;     ///< @brief Cache em disco dos fundos e canos reduzidos.
+    std::vector<Nivel> niveis;  ///< @brief Todos os níveis encontrados.
+    int telaW;                  ///< @brief Largura da tela.
+    int telaH;                  ///< @brief Altura da tela.
+    size_t orcamento;           ///< @brief Memória máxima dos níveis, em bytes.
+    MemoryTracker* memoria;     ///< @brief Contabilidade de memória (pode ser nula).
+    int nivelAtual;             ///< @brief Nível sendo jogado.
+    uint64_t relogio;           ///< @brief Contador que ordena os pedidos (usado no descarte).
+    Estatisticas stats;         ///< @brief Números de residência.
+
+    /**
+     * @brief Agenda o carregamento de um nível, se ele ainda não foi carregado nem pedido.
+     * @param nivel O nível desejado.
+     */
+    void solicitar(int nivel);
+
+    /**
+     * @brief Libera os assets de um nível carregado.
+     * @param nivel O nível a descarregar.
+     */
+    void descarregar(int nivel);
+
+    /**
+     * @brief Descarrega níveis fora do alcance até o total caber no orçamento.
+     */
+    void aplicarOrcamento();
+
+    /**
+     * @brief Informa se um nível pode ser pedido a qualquer momento (atual, próximo ou o primeiro,
+     * ou o substituto de um deles).
+     * @param nivel O nível a verificar.
+     * @return true se o nível está ao alcance.
+     */
+    bool alcancavel(int nivel) const;
+
+    /**
+     * @brief Espera um nível que está sendo preparado, processando os trabalhos prontos.
+     * @param nivel O nível desejado.
+     */
+    void esperarCarregamento(int nivel);
+
+    /**
+     * @brief Retorna o nível cujos assets são usados no lugar de outro.
+     * @param nivel O nível desejado.
+     * @return O próprio nível se ele não falhou; senão, o residente mais próximo (-1 se não há).
+     */
+    int nivelUsado(int nivel) const;
+};
+
+#endif // LEVELASSETMANAGER_HPP
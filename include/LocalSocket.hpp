@@ -0,0 +1,135 @@
+/**
+ * @file LocalSocket.hpp
+ * @brief LocalSocketheader do projeto Traveling Dragon.
+ */
+
+#ifndef LOCALSOCKET_HPP
+#define LOCALSOCKET_HPP
+
+#include <cstddef> // Para size_t
+#include <cstdint> // Para intptr_t (SOCKET ou descritor)
+#include <string>  // Para usar std::string (caminho e bytes)
+#include <vector>  // Para usar std::vector (conjunto esperado por `esperar`)
+
+/**
+ * @brief Socket local (AF_UNIX, de fluxo) entre processos da mesma máquina.
+ *
+ * Usado pelo serviço de ranking (LeaderboardServer) e pelos jogos que enviam
+ * partidas para ele (LeaderboardClient). O endereço é um caminho de arquivo, como
+ * o de um cadastro, e nada sai da máquina. Os sockets ficam sempre em modo não
+ * bloqueante: `receber` devolve o que já chegou, `enviar` manda só o que cabe e
+ * `enviarTudo` e `conectar` esperam no máximo o tempo pedido, então quem chama
+ * nunca fica preso a um processo que parou de responder.
+ *
+ * No Windows (10 ou mais novo) usa o AF_UNIX do Winsock (afunix.h); nos outros
+ * sistemas, os sockets do sistema. Um objeto fechado tem descritor -1.
+ */
+class LocalSocket {
+public:
+    /**
+     * @brief Construtor da classe LocalSocket. Não abre nada.
+     */
+    LocalSocket() : descritor(-1) {}
+
+    /**
+     * @brief Destrutor da classe LocalSocket. Fecha o socket.
+     */
+    ~LocalSocket() { fechar(); }
+
+    LocalSocket(const LocalSocket&) = delete;            ///< @brief Não copiável (possui o socket).
+    LocalSocket& operator=(const LocalSocket&) = delete; ///< @brief Não copiável (possui o socket).
+
+    /**
+     * @brief Construtor de movimento: o socket passa para o novo objeto.
+     * @param outro O objeto que perde o socket.
+     */
+    LocalSocket(LocalSocket&& outro) noexcept : descritor(outro.descritor) { outro.descritor = -1; }
+
+    /**
+     * @brief Atribuição de movimento: fecha o socket atual e fica com o do outro.
+     * @param outro O objeto que perde o socket.
+     * @return Este objeto.
+     */
+    LocalSocket& operator=(LocalSocket&& outro) noexcept;
+
+    /**
+     * @brief Conecta a um servidor, fechando a conexão anterior.
+     * @param caminho Caminho do socket do servidor.
+     * @param timeoutMs Tempo máximo de espera, em milissegundos.
+     * @return false se não há servidor no caminho (ou ele não respondeu a tempo).
+     */
+    bool conectar(const std::string& caminho, int timeoutMs);
+
+    /**
+     * @brief Passa a aceitar conexões em um caminho.
+     * Um arquivo de socket deixado por um servidor que caiu é apagado; se outro
+     * servidor está respondendo no caminho, falha.
+     * @param caminho Caminho do socket (a pasta precisa existir).
+     * @return false se o caminho não pôde ser usado.
+     */
+    bool escutar(const std::string& caminho);
+
+    /**
+     * @brief Aceita uma conexão que está esperando (sem esperar por uma).
+     * @param conexao Recebe a conexão aceita.
+     * @return false se não havia conexão esperando.
+     */
+    bool aceitar(LocalSocket& conexao);
+
+    /**
+     * @brief Envia todos os bytes, esperando o outro lado ler se preciso.
+     * @param dados Os bytes.
+     * @param timeoutMs Tempo máximo de espera, em milissegundos.
+     * @return false se a conexão caiu ou o tempo acabou (a conexão deve ser fechada).
+     */
+    bool enviarTudo(const std::string& dados, int timeoutMs);
+    /**
+     * @brief Envia o que couber dos bytes, sem esperar.
+     * @param dados Os bytes.
+     * @param inicio Primeiro byte a enviar (os anteriores já foram).
+     * @return Quantos bytes foram enviados (0 se o outro lado ainda não leu nada), ou -1 se a conexão caiu.
+     */
+    int enviar(const std::string& dados, size_t inicio = 0);
+
+    /**
+     * @brief Acrescenta ao destino os bytes que já chegaram (sem esperar).
+     * @param destino Recebe os bytes no fim.
+     * @return Quantos bytes chegaram (0 se nenhum), ou -1 se a conexão foi fechada ou caiu.
+     */
+    int receber(std::string& destino);
+
+    /**
+     * @brief Espera até algum dos sockets ter bytes (ou uma conexão) para ler, ou espaço para escrever.
+     * @param sockets Os sockets (abertos).
+     * @param prontos Recebe, para cada socket, 1 se ele tem algo para ler (ou caiu) ou, se pedido, espaço para escrever.
+     * @param timeoutMs Tempo máximo de espera, em milissegundos.
+     * @param escrita Opcional: 1 para os sockets em que também se espera espaço para escrever.
+     * @return Quantos sockets estão prontos (0 se o tempo acabou, -1 em erro).
+     */
+    static int esperar(const std::vector<const LocalSocket*>& sockets, std::vector<char>& prontos, int timeoutMs,
+                       const std::vector<char>* escrita = nullptr);
+
+    /**
+     * @brief Fecha o socket.
+     */
+    void fechar();
+
+    /**
+     * @brief Informa se o socket está aberto.
+     * @return true depois de `conectar`, `escutar` ou `aceitar` com sucesso.
+     */
+    bool isAberto() const { return descritor != -1; }
+
+private:
+    intptr_t descritor; ///< @brief SOCKET (Windows) ou descritor do socket; -1 se fechado.
+
+    /**
+     * @brief Espera o socket ficar pronto para ler ou escrever.
+     * @param escrita true para esperar espaço para escrever; false para esperar bytes.
+     * @param timeoutMs Tempo máximo de espera, em milissegundos.
+     * @return true se ficou pronto.
+     */
+    bool esperarPronto(bool escrita, int timeoutMs) const;
+};
+
+#endif // LOCALSOCKET_HPP
@@ -0,0 +1,42 @@
+/**
+ * @file Lz4Block.hpp
+ * @brief Lz4Blockheader do projeto Traveling Dragon.
+ */
+
+#ifndef LZ4BLOCK_HPP
+#define LZ4BLOCK_HPP
+
+#include <cstddef> // Para size_t
+#include <vector>  // Para usar std::vector (dados comprimidos)
+
+/**
+ * @brief Compressão no formato de bloco do LZ4, usada no cache de imagens decodificadas.
+ *
+ * O formato é o bloco padrão do LZ4 (sequências de literais + cópias de até 64 KB
+ * atrás), então os arquivos podem ser lidos por qualquer implementação do LZ4. O
+ * compressor é o guloso simples com uma tabela de hash: comprime menos que o LZ4
+ * original, mas a descompressão, que é o que roda a cada inicialização, é a mesma.
+ */
+class Lz4Block {
+public:
+    /**
+     * @brief Comprime um bloco de bytes.
+     * @param dados Bytes a comprimir.
+     * @param tamanho Quantidade de bytes.
+     * @return O bloco comprimido (pode ser maior que o original para dados aleatórios).
+     */
+    static std::vector<unsigned char> comprimir(const unsigned char* dados, size_t tamanho);
+
+    /**
+     * @brief Descomprime um bloco, conferindo todos os limites (um arquivo corrompido só falha).
+     * @param origem Bloco comprimido.
+     * @param tamanhoOrigem Tamanho do bloco comprimido.
+     * @param destino Onde os bytes descomprimidos são escritos.
+     * @param tamanhoDestino Tamanho exato esperado depois de descomprimir.
+     * @return true se o bloco é válido e tem exatamente `tamanhoDestino` bytes.
+     */
+    static bool descomprimir(const unsigned char* origem, size_t tamanhoOrigem,
+                             unsigned char* destino, size_t tamanhoDestino);
+};
+
+#endif // LZ4BLOCK_HPP
@@ -0,0 +1,70 @@
+/**
+ * @file MappedFile.hpp
+ * @brief MappedFileheader do projeto Traveling Dragon.
+ */
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef> // Para size_t
+#include <string>  // Para usar std::string (caminho do arquivo)
+
+/**
+ * @brief Arquivo inteiro mapeado na memória, somente para leitura.
+ *
+ * Usado pelo pacote de assets e pelo banco de jogadores: abrir custa o mesmo para
+ * qualquer tamanho de arquivo, e as páginas só são lidas do disco quando acessadas.
+ * Os handles do sistema são fechados logo depois de mapear, pois o mapeamento
+ * continua válido até ser desfeito.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Construtor da classe MappedFile. Não mapeia nada (veja `abrir`).
+     */
+    MappedFile() : dados(nullptr), tamanho(0) {}
+
+    /**
+     * @brief Destrutor da classe MappedFile. Desfaz o mapeamento.
+     */
+    ~MappedFile() { fechar(); }
+
+    MappedFile(const MappedFile&) = delete;            ///< @brief Não copiável (possui o mapeamento).
+    MappedFile& operator=(const MappedFile&) = delete; ///< @brief Não copiável (possui o mapeamento).
+
+    /**
+     * @brief Mapeia um arquivo, desfazendo o mapeamento anterior.
+     * @param caminho Caminho do arquivo.
+     * @return false se o arquivo não existe, está vazio ou não pôde ser mapeado.
+     */
+    bool abrir(const std::string& caminho);
+
+    /**
+     * @brief Desfaz o mapeamento (os ponteiros obtidos de `getDados` deixam de valer).
+     */
+    void fechar();
+
+    /**
+     * @brief Informa se há um arquivo mapeado.
+     * @return true se `abrir` teve sucesso.
+     */
+    bool isAberto() const { return dados != nullptr; }
+
+    /**
+     * @brief Retorna o início do mapeamento.
+     * @return Ponteiro para o primeiro byte do arquivo (nullptr se nada foi mapeado).
+     */
+    const unsigned char* getDados() const { return dados; }
+
+    /**
+     * @brief Retorna o tamanho do arquivo mapeado.
+     * @return O tamanho, em bytes.
+     */
+    size_t getTamanho() const { return tamanho; }
+
+private:
+    const unsigned char* dados; ///< @brief Início do mapeamento (nullptr sem arquivo).
+    size_t tamanho;             ///< @brief Tamanho do arquivo mapeado.
+};
+
+#endif // MAPPEDFILE_HPP
@@ -0,0 +1,208 @@
+/**
+ * @file MatchHistory.hpp
+ * @brief MatchHistoryheader do projeto Traveling Dragon.
+ */
+
+#ifndef MATCHHISTORY_HPP
+#define MATCHHISTORY_HPP
+
+#include <cstddef> // Para size_t
+#include <cstdint> // Para tipos de tamanho fixo das colunas
+#include <string>  // Para usar std::string (caminho do arquivo e apelidos)
+#include <unordered_map> // Para achar o código de um apelido
+#include <vector>  // Para usar std::vector (colunas e resultados das consultas)
+
+/**
+ * @brief Histórico de todas as partidas, guardado em colunas, com consultas rápidas.
+ *
+ * Cada partida tem o jogador, a pontuação, o nível alcançado, a duração, a quantidade
+ * de batidas de asa e o instante em que terminou. O jogador é guardado pelo apelido,
+ * que é o mesmo em todos os jogos (gabinetes) que usam o arquivo; na memória, cada
+ * apelido vira um código (`cadastrarApelido`), válido só neste objeto. Na memória,
+ * cada campo é um vetor contíguo do menor tipo que comporta o valor (19 bytes por
+ * partida), então as consultas são laços simples sobre vetores, sem desvios, que o
+ * compilador vetoriza: média, percentis (mediana incluída), histograma por dia e
+ * melhores partidas, de um jogador ou de todos.
+ *
+ * No disco, o arquivo é uma sequência de blocos, cada um com as partidas gravadas em
+ * um `salvar`. O bloco começa com os apelidos das suas partidas; depois, cada coluna é
+ * gravada inteira, em sequência: jogador (posição na lista de apelidos do bloco) e
+ * instante como diferença para a partida anterior e todos os campos em varint com
+ * zigzag, o que deixa a maioria dos valores com 1 ou 2 bytes. Cada bloco tem um
+ * checksum; um bloco cortado no fim do arquivo (queda durante a gravação) é descartado.
+ * Os blocos são acrescentados e o fim estragado é cortado com a trava exclusiva
+ * `<arquivo>.lock`, então um jogo nunca corta o bloco que outro ainda está gravando.
+ */
+class MatchHistory {
+public:
+    /// @brief Jogador usado nas consultas para considerar as partidas de todos.
+    static constexpr int32_t TODOS = -1;
+    /// @brief Código de um apelido sem partidas no histórico (as consultas não encontram nada).
+    static constexpr int32_t NENHUM = -2;
+
+    /**
+     * @brief Uma partida terminada.
+     */
+    struct Partida {
+        int32_t jogador = 0;    ///< @brief Código do apelido do jogador (veja `cadastrarApelido`).
+        int32_t pontuacao = 0;  ///< @brief Pontuação final.
+        int nivel = 0;          ///< @brief Nível alcançado (1 = primeiro; guardado em 8 bits).
+        uint32_t duracaoMs = 0; ///< @brief Duração da partida, em milissegundos.
+        int batidas = 0;        ///< @brief Batidas de asa (guardadas em 16 bits, limitadas a 65535).
+        uint32_t instante = 0;  ///< @brief Fim da partida, em segundos desde 1970 (UTC).
+    };
+
+    /**
+     * @brief Construtor da classe MatchHistory. Não lê nada (veja `carregar`).
+     * @param caminho Caminho do arquivo do histórico.
+     */
+    explicit MatchHistory(const std::string& caminho);
+
+    /**
+     * @brief Lê todos os blocos válidos do arquivo, substituindo o que estiver na memória.
+     * Um bloco inválido no fim (gravação interrompida) é descartado e cortado do arquivo.
+     * @return false se o arquivo não existe.
+     */
+    bool carregar();
+
+    /**
+     * @brief Acrescenta ao arquivo, como um bloco novo, as partidas ainda não gravadas.
+     * @return true se não havia nada para gravar ou se o bloco foi gravado.
+     */
+    bool salvar();
+
+    /**
+     * @brief Monta, sem gravar, o bloco com as partidas ainda não gravadas e as considera gravadas.
+     * Para quem grava em outra thread: o bloco deve ser acrescentado ao fim do arquivo (`getCaminho`).
+     * @param bloco Recebe o bloco (cabeçalho e conteúdo).
+     * @return false se não havia partidas pendentes.
+     */
+    bool montarBloco(std::vector<unsigned char>& bloco);
+
+    /**
+     * @brief Retorna o caminho do arquivo do histórico.
+     * @return O caminho.
+     */
+    const std::string& getCaminho() const { return caminho; }
+
+    /**
+     * @brief Retorna o código de um apelido, criando um novo se ele ainda não está no histórico.
+     * @param apelido O apelido do jogador.
+     * @return O código, para `Partida::jogador` e as consultas.
+     */
+    int32_t cadastrarApelido(const std::string& apelido);
+
+    /**
+     * @brief Procura o código de um apelido.
+     * @param apelido O apelido do jogador.
+     * @return O código, ou NENHUM se o apelido não está no histórico.
+     */
+    int32_t getCodigo(const std::string& apelido) const;
+
+    /**
+     * @brief Retorna o apelido de um código.
+     * @param codigo Um código devolvido por `cadastrarApelido` ou `getCodigo`.
+     * @return O apelido.
+     */
+    const std::string& getApelido(int32_t codigo) const { return apelidos[(size_t)codigo]; }
+
+    /**
+     * @brief Registra uma partida na memória (gravada no próximo `salvar`).
+     * @param partida A partida; `jogador` deve ser um código de `cadastrarApelido`.
+     */
+    void registrar(const Partida& partida);
+
+    /**
+     * @brief Retorna quantas partidas estão no histórico.
+     * @return O número de partidas.
+     */
+    size_t getQuantidade() const { return pontuacoes.size(); }
+
+    /**
+     * @brief Retorna quantas partidas ainda não foram gravadas no arquivo.
+     * @return O número de partidas pendentes.
+     */
+    size_t getPendentes() const { return pontuacoes.size() - gravadas; }
+
+    /**
+     * @brief Monta uma partida a partir das colunas.
+     * @param i Posição da partida (menor que `getQuantidade`).
+     * @return A partida.
+     */
+    Partida getPartida(size_t i) const;
+
+    /**
+     * @brief Conta as partidas de um jogador.
+     * @param jogador Código do jogador, ou TODOS.
+     * @return O número de partidas.
+     */
+    size_t contar(int32_t jogador) const;
+
+    /**
+     * @brief Calcula a pontuação média.
+     * @param jogador Código do jogador, ou TODOS.
+     * @return A média (0 sem partidas).
+     */
+    double media(int32_t jogador) const;
+
+    /**
+     * @brief Calcula percentis da pontuação (percentil 50 = mediana), pelo método do posto mais próximo.
+     * @param jogador Código do jogador, ou TODOS.
+     * @param percentis Os percentis desejados, de 0 a 100.
+     * @return Um valor por percentil pedido, na mesma ordem (vazio sem partidas).
+     */
+    std::vector<int> calcularPercentis(int32_t jogador, const std::vector<double>& percentis) const;
+
+    /**
+     * @brief Conta as partidas por dia.
+     * @param jogador Código do jogador, ou TODOS.
+     * @param inicio Início do primeiro dia, em segundos desde 1970.
+     * @param dias Quantidade de dias.
+     * @return Um contador por dia (as partidas fora do intervalo não são contadas).
+     */
+    std::vector<int> histogramaDiario(int32_t jogador, uint32_t inicio, int dias) const;
+
+    /**
+     * @brief Encontra as melhores partidas (maiores pontuações; no empate, a mais antiga primeiro).
+     * @param jogador Código do jogador, ou TODOS.
+     * @param quantidade Quantas partidas devolver, no máximo.
+     * @return As posições das partidas, da melhor para a pior.
+     */
+    std::vector<size_t> melhores(int32_t jogador, size_t quantidade) const;
+
+private:
+    std::string caminho;              ///< @brief Caminho do arquivo do histórico.
+    std::vector<int32_t> jogadores;   ///< @brief Coluna: código do jogador.
+    std::vector<int32_t> pontuacoes;  ///< @brief Coluna: pontuação final.
+    std::vector<uint8_t> niveis;      ///< @brief Coluna: nível alcançado.
+    std::vector<uint32_t> duracoes;   ///< @brief Coluna: duração, em milissegundos.
+    std::vector<uint16_t> batidas;    ///< @brief Coluna: batidas de asa.
+    std::vector<uint32_t> instantes;  ///< @brief Coluna: fim da partida, em segundos desde 1970.
+    size_t gravadas;                  ///< @brief Quantas partidas (as primeiras) já estão no arquivo.
+    std::vector<std::string> apelidos; ///< @brief Apelido de cada código.
+    std::unordered_map<std::string, int32_t> codigos; ///< @brief Código de cada apelido.
+
+    /**
+     * @brief Copia as pontuações de um jogador (ou todas) para um vetor.
+     * @param jogador Código do jogador, ou TODOS.
+     * @return As pontuações, na ordem do histórico.
+     */
+    std::vector<int32_t> filtrarPontuacoes(int32_t jogador) const;
+
+    /**
+     * @brief Codifica as partidas pendentes como um bloco (cabeçalho e conteúdo), sem marcá-las como gravadas.
+     * @param bloco Recebe o bloco.
+     */
+    void codificarPendentes(std::vector<unsigned char>& bloco) const;
+
+    /**
+     * @brief Lê um bloco do arquivo e acrescenta as partidas dele às colunas.
+     * @param dados Início do conteúdo do bloco (depois do cabeçalho).
+     * @param tamanho Tamanho do conteúdo.
+     * @param linhas Quantidade de partidas no bloco.
+     * @return false se o conteúdo está malformado (as colunas voltam ao estado anterior).
+     */
+    bool decodificarBloco(const unsigned char* dados, size_t tamanho, uint32_t linhas);
+};
+
+#endif // MATCHHISTORY_HPP
@@ -0,0 +1,273 @@
+/**
+ * @file MatchJournal.hpp
+ * @brief MatchJournalheader do projeto Traveling Dragon.
+ */
+
+#ifndef MATCHJOURNAL_HPP
+#define MATCHJOURNAL_HPP
+
+#include <allegro5/allegro.h> // Para a thread de gravação, o mutex e a variável de condição
+#include <chrono>             // Para medir a latência das escritas
+#include <cstddef>            // Para size_t (limite da fila)
+#include <cstdint>            // Para uint64_t (números de sequência)
+#include <cstdio>             // Para FILE* (escrita com fflush + fsync)
+#include <string>             // Para usar std::string (caminhos e linhas)
+#include <vector>             // Para usar std::vector (registros lidos e fila)
+#include "FileLock.hpp"       // Trava entre os jogos que usam o mesmo diário
+
+/**
+ * @brief Diário (journal) só de acréscimo com os cadastros e as partidas dos jogadores.
+ *
+ * Em vez de regravar o arquivo de jogadores inteiro a cada partida, cada mudança vira
+ * uma linha curta acrescentada ao fim do diário:
+ *
+ *     <seq> C <apelido> <nome> <hash>      (cadastro)
+ *     <seq> P <apelido> <pontuacao> <hash> (partida terminada)
+ *
+ * Espaços, '%' e quebras de linha do apelido e do nome são escritos como "%XX"
+ * (apelidos como "Ana Maria" têm espaço), então cada linha tem sempre quatro campos.
+ * O hash (FNV-1a de 32 bits do resto da linha) detecta a última linha cortada por
+ * uma queda no meio da escrita; ela e o que vier depois são descartados. Uma linha
+ * inteira (com o hash certo) que não pode ser interpretada é só pulada.
+ * O número de sequência cresce sempre, e o snapshot (players.dat) guarda o último
+ * que ele já contém, então um registro nunca é aplicado duas vezes.
+ *
+ * Vários jogos (gabinetes) podem anotar no mesmo diário ao mesmo tempo. Cada escrita
+ * é feita com a trava exclusiva do arquivo `<diário>.lock` (FileLock), que guarda
+ * também o último número de sequência dado e o tamanho válido do diário: o número
+ * de cada registro é dado na hora da escrita, então é único entre todos os jogos.
+ * O diário é aberto, escrito e fechado a cada grupo (nenhum jogo o mantém aberto),
+ * para que qualquer um deles possa movê-lo na compactação, inclusive no Windows.
+ * Se o diário ficou maior que o tamanho guardado (um jogo caiu no meio de uma
+ * escrita), as linhas a mais são conferidas: as inteiras ficam, o resto é cortado.
+ *
+ * A escrita segue a política de sincronia: `SYNC_SEMPRE` faz fsync a cada registro,
+ * na hora; `SYNC_GRUPO` entrega os registros a uma thread que espera um instante,
+ * junta o que chegou e faz uma única escrita com um único fsync (group commit);
+ * `SYNC_NUNCA` escreve sem fsync e deixa o sistema decidir quando gravar.
+ * A fila da thread é limitada (`LIMITE_FILA`): com o disco travado, `anotar` espera
+ * em vez de acumular sem fim. O tempo entre anotar e o registro estar no disco é
+ * medido por escrita (`getUltimaLatenciaMs`, `getMaiorLatenciaMs`).
+ */
+class MatchJournal {
+public:
+    /**
+     * @brief Quando os registros são forçados para o disco.
+     */
+    enum Sincronia {
+        SYNC_NUNCA = 0,  ///< @brief Só escreve; o sistema grava quando quiser.
+        SYNC_GRUPO = 1,  ///< @brief Um fsync por grupo de registros, na thread de gravação.
+        SYNC_SEMPRE = 2  ///< @brief Um fsync por registro, antes de `anotar` retornar.
+    };
+
+    /// @brief Bytes de linhas que podem esperar a thread de gravação antes de `anotar` esperar.
+    static constexpr size_t LIMITE_FILA = 1024 * 1024;
+
+    /**
+     * @brief Uma linha do diário.
+     */
+    struct Registro {
+        uint64_t seq = 0;     ///< @brief Número de sequência (dado por `anotar`).
+        char tipo = 'P';      ///< @brief 'C' para cadastro, 'P' para partida.
+        std::string apelido;  ///< @brief Apelido do jogador.
+        std::string nome;     ///< @brief Nome do jogador (só no cadastro).
+        int pontuacao = 0;    ///< @brief Pontuação da partida (só na partida).
+    };
+
+    /**
+     * @brief Construtor da classe MatchJournal. Não abre o arquivo (veja `abrir`).
+     * @param caminho Caminho do arquivo do diário.
+     * @param sincronia Política de sincronia.
+     * @param esperaGrupoMs Tempo que a thread espera para juntar registros em um grupo.
+     */
+    MatchJournal(const std::string& caminho, Sincronia sincronia = SYNC_GRUPO, int esperaGrupoMs = 50);
+
+    /**
+     * @brief Destrutor da classe MatchJournal.
+     * Grava e sincroniza os registros pendentes antes de fechar (nada anotado se perde ao sair).
+     */
+    ~MatchJournal();
+
+    MatchJournal(const MatchJournal&) = delete;            ///< @brief Não copiável (possui thread e arquivo).
+    MatchJournal& operator=(const MatchJournal&) = delete; ///< @brief Não copiável (possui thread e arquivo).
+
+    /**
+     * @brief Abre o diário para acréscimo, descartando uma última linha incompleta.
+     * @param ultimoSeq Maior número de sequência já usado que este jogo conhece (os novos
+     * registros continuam dele, ou do número guardado na trava, se este for maior).
+     * @return true se o arquivo e a trava foram abertos.
+     */
+    bool abrir(uint64_t ultimoSeq);
+
+    /**
+     * @brief Acrescenta um registro ao diário.
+     * Com `SYNC_GRUPO` só entrega o registro à thread de gravação e retorna na hora.
+     * @param registro O registro (o número de sequência é dado na escrita).
+     * @return false se o diário não está aberto.
+     */
+    bool anotar(const Registro& registro);
+
+    /**
+     * @brief Grava e sincroniza agora todos os registros pendentes, em qualquer política.
+     */
+    void sincronizar();
+
+    /**
+     * @brief Grava os registros pendentes, move o diário para `destino` e começa um diário vazio.
+     * Usado pela compactação: o arquivo movido (com os registros de todos os jogos) é
+     * dobrado no snapshot em segundo plano.
+     * @param destino Novo caminho do diário atual.
+     * @return true se o arquivo foi movido.
+     */
+    bool rotacionar(const std::string& destino);
+
+    /**
+     * @brief Informa se o diário está aberto para acréscimo.
+     * @return true se `abrir` teve sucesso.
+     */
+    bool isAberto() const { return aberto; }
+
+    /**
+     * @brief Retorna quantas escritas (grupos de registros) foram feitas.
+     * @return O número de escritas.
+     */
+    int getEscritas() const { return escritas; }
+
+    /**
+     * @brief Retorna quantos fsync foram feitos.
+     * @return O número de sincronizações.
+     */
+    int getSincronizacoes() const { return sincronizacoes; }
+
+    /**
+     * @brief Retorna quantos registros foram anotados desde a abertura.
+     * @return O número de registros.
+     */
+    int getAnotados() const { return anotados; }
+
+    /**
+     * @brief Retorna a latência da última escrita: do registro mais antigo dela até estar no disco.
+     * @return A latência, em milissegundos (0 antes da primeira escrita).
+     */
+    double getUltimaLatenciaMs() const;
+
+    /**
+     * @brief Retorna a maior latência de uma escrita desde a abertura.
+     * @return A latência, em milissegundos.
+     */
+    double getMaiorLatenciaMs() const;
+
+    /**
+     * @brief Lê os registros válidos de um diário, parando na primeira linha cortada ou estragada
+     * (hash que não confere). Linhas inteiras que não podem ser interpretadas são puladas.
+     * @param caminho Caminho do arquivo.
+     * @param saida Recebe os registros, na ordem do arquivo (acrescentados ao fim).
+     * @param bytesValidos Se não for nulo, recebe o tamanho da parte válida do arquivo.
+     * @param inicio Byte onde a leitura começa (sempre o começo de uma linha).
+     * @return false se o arquivo não existe.
+     */
+    static bool ler(const std::string& caminho, std::vector<Registro>& saida, uint64_t* bytesValidos = nullptr,
+                    uint64_t inicio = 0);
+
+    /**
+     * @brief Monta a linha de um registro (com o hash e a quebra de linha).
+     * @param registro O registro.
+     * @return A linha pronta para o arquivo.
+     */
+    static std::string formatar(const Registro& registro);
+
+    /**
+     * @brief Interpreta uma linha do diário (sem a quebra de linha).
+     * @param linha A linha.
+     * @param saida Recebe o registro.
+     * @return false se o hash não confere ou a linha está malformada.
+     */
+    static bool interpretar(const std::string& linha, Registro& saida);
+
+    /**
+     * @brief Força os dados já escritos em um arquivo para o disco (fflush + fsync).
+     * @param arquivo O arquivo aberto.
+     * @return true se a sincronização funcionou.
+     */
+    static bool sincronizarArquivo(FILE* arquivo);
+
+private:
+    /**
+     * @brief O que os jogos combinam pelo arquivo da trava.
+     */
+    struct Estado {
+        uint64_t seq = 0;     ///< @brief Último número de sequência dado.
+        uint64_t tamanho = 0; ///< @brief Bytes do diário escritos por inteiro.
+    };
+
+    std::string caminho;         ///< @brief Caminho do arquivo do diário.
+    Sincronia sincronia;         ///< @brief Política de sincronia.
+    int esperaGrupoMs;           ///< @brief Espera para juntar um grupo, em milissegundos.
+    FileLock trava;              ///< @brief Trava `<diário>.lock`, com o Estado compartilhado.
+    bool aberto;                 ///< @brief Flag: true depois que `abrir` teve sucesso.
+    uint64_t ultimoSeqConhecido; ///< @brief Sequência passada a `abrir` (usada se o Estado sumir).
+    bool semSincronia;           ///< @brief Flag: true se algo foi escrito sem fsync desde o último.
+    std::vector<Registro> fila;  ///< @brief Registros anotados ainda não escritos.
+    size_t bytesFila;            ///< @brief Tamanho aproximado das linhas da fila.
+    bool encerrando;             ///< @brief Flag: true quando a thread deve gravar o resto e sair.
+    int escritas;                ///< @brief Escritas feitas.
+    int sincronizacoes;          ///< @brief fsync feitos.
+    int anotados;                ///< @brief Registros anotados.
+    std::chrono::steady_clock::time_point inicioFila; ///< @brief Momento em que a linha mais antiga da fila foi anotada.
+    double ultimaLatenciaMs;     ///< @brief Latência da última escrita.
+    double maiorLatenciaMs;      ///< @brief Maior latência de uma escrita.
+
+    ALLEGRO_MUTEX* mutex;        ///< @brief Protege a fila, a sequência e a flag de encerramento.
+    ALLEGRO_MUTEX* mutexArquivo; ///< @brief Protege a trava e o arquivo (sempre travado antes de `mutex`).
+    ALLEGRO_COND* haRegistros;   ///< @brief Sinaliza a thread de gravação que a fila tem linhas.
+    ALLEGRO_COND* filaLivre;     ///< @brief Sinaliza `anotar` que a fila cheia foi esvaziada.
+    ALLEGRO_THREAD* escritor;    ///< @brief Thread de gravação (só com `SYNC_GRUPO`).
+
+    /**
+     * @brief Escreve a fila no arquivo e sincroniza conforme a política.
+     * Não pode ser chamada com `mutex` travado.
+     * @param forcarSync true para fazer fsync mesmo com `SYNC_NUNCA`.
+     */
+    void descarregar(bool forcarSync);
+
+    /**
+     * @brief Escreve um grupo de registros com a trava exclusiva, dando os números de sequência.
+     * Precisa de `mutexArquivo` travado.
+     * @param lote Os registros.
+     * @param sincronizarAgora true para fazer fsync mesmo com `SYNC_NUNCA`.
+     * @param destino Se não for nulo, o diário é movido para ele depois da escrita.
+     * @return false se a trava, a escrita ou a mudança de nome falhou.
+     */
+    bool escreverComTrava(const std::vector<Registro>& lote, bool sincronizarAgora, const std::string* destino);
+
+    /**
+     * @brief Lê o Estado guardado na trava (precisa da trava exclusiva).
+     * @param estado Recebe o Estado.
+     * @return false se a trava ainda não tem um Estado válido (arquivo novo ou estragado).
+     */
+    bool lerEstado(Estado& estado) const;
+
+    /**
+     * @brief Grava o Estado na trava (precisa da trava exclusiva).
+     * @param estado O Estado.
+     * @param sincronizar true para esperar ele estar no disco.
+     */
+    void gravarEstado(const Estado& estado, bool sincronizar);
+
+    /**
+     * @brief Confere o fim do diário quando ele não tem o tamanho do Estado: mantém as linhas
+     * inteiras escritas depois dele, corta uma linha incompleta e atualiza o Estado.
+     * @param estado O Estado (atualizado).
+     */
+    void conferirFim(Estado& estado);
+
+    /**
+     * @brief Laço da thread de gravação.
+     * @param thread A thread atual (não usada).
+     * @param arg Ponteiro para o MatchJournal.
+     * @return Sempre nullptr.
+     */
+    static void* executarEscritor(ALLEGRO_THREAD* thread, void* arg);
+};
+
+#endif // MATCHJOURNAL_HPP
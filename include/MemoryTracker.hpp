@@ -0,0 +1,210 @@
+/**
+ * @file MemoryTracker.hpp
+ * @brief MemoryTrackerheader do projeto Traveling Dragon.
+ */
+
+#ifndef MEMORYTRACKER_HPP
+#define MEMORYTRACKER_HPP
+
+#include <allegro5/allegro.h>       // Para ALLEGRO_BITMAP e o formato dos pixels
+#include <allegro5/allegro_audio.h> // Para ALLEGRO_SAMPLE e ALLEGRO_AUDIO_STREAM
+#include <cstddef>                  // Para size_t
+#include <map>                      // Para std::map (uso por nível, em ordem)
+#include <string>                   // Para usar std::string (nomes dos assets)
+#include <unordered_map>            // Para std::unordered_map (assets registrados)
+
+/**
+ * @brief Contabiliza a memória ocupada pelos assets carregados, por categoria e por nível.
+ *
+ * Cada asset é registrado ao ser criado e removido antes de ser destruído. O tamanho
+ * é o dos dados decodificados: largura x altura x bytes por pixel nas imagens,
+ * amostras x canais x bytes por amostra nos sons e os buffers de decodificação nas
+ * músicas (o arquivo da música continua no pacote e não é contado). Sub-bitmaps não
+ * ocupam memória própria e contam zero.
+ *
+ * Além dos totais atuais, guarda os picos (o maior valor já visto) e avisa no console
+ * quando o total passa do orçamento. Não é protegido por trava: deve ser usado só
+ * na thread principal (as etapas `naThreadPrincipal` do AssetLoader).
+ */
+class MemoryTracker {
+public:
+    /**
+     * @brief Tipo de asset contabilizado.
+     */
+    enum Categoria {
+        IMAGEM,        ///< @brief Bitmaps (fundos, canos, páginas do atlas).
+        SOM,           ///< @brief Efeitos sonoros lidos inteiros para a memória.
+        MUSICA,        ///< @brief Buffers das músicas tocadas por stream.
+        NUM_CATEGORIAS ///< @brief Quantidade de categorias.
+    };
+
+    /// @brief Nível usado para os assets que não pertencem a nenhum nível (menus, sons, pássaro).
+    static constexpr int GLOBAL = 0;
+
+    /**
+     * @brief Memória atual e maior valor já atingido.
+     */
+    struct Uso {
+        size_t atual = 0; ///< @brief Bytes em uso agora.
+        size_t pico = 0;  ///< @brief Maior valor de `atual` desde o início.
+    };
+
+    /**
+     * @brief Construtor da classe MemoryTracker.
+     * @param orcamentoBytes Total acima do qual um aviso é emitido (0 = sem orçamento).
+     */
+    explicit MemoryTracker(size_t orcamentoBytes = 0);
+
+    /**
+     * @brief Registra um asset com um tamanho já calculado.
+     * Registrar de novo o mesmo ponteiro substitui o registro anterior.
+     * @param asset Ponteiro que identifica o asset (nulo é ignorado).
+     * @param categoria Tipo do asset.
+     * @param nivel Número do nível dono do asset (GLOBAL para os demais).
+     * @param bytes Memória ocupada.
+     * @param nome Nome mostrado no relatório (normalmente o caminho do arquivo).
+     */
+    void registrar(const void* asset, Categoria categoria, int nivel, size_t bytes, const std::string& nome);
+
+    /**
+     * @brief Registra um bitmap, calculando o tamanho pelo formato dos pixels.
+     * @param bitmap O bitmap (nulo é ignorado).
+     * @param nivel Número do nível dono do bitmap.
+     * @param nome Nome mostrado no relatório.
+     */
+    void registrarBitmap(ALLEGRO_BITMAP* bitmap, int nivel, const std::string& nome);
+
+    /**
+     * @brief Registra um efeito sonoro, calculando o tamanho pelas amostras decodificadas.
+     * @param sample O som (nulo é ignorado).
+     * @param nivel Número do nível dono do som.
+     * @param nome Nome mostrado no relatório.
+     */
+    void registrarSample(ALLEGRO_SAMPLE* sample, int nivel, const std::string& nome);
+
+    /**
+     * @brief Registra uma música, calculando o tamanho pelos buffers da stream.
+     * @param stream A música (nula é ignorada).
+     * @param nivel Número do nível dono da música.
+     * @param nome Nome mostrado no relatório.
+     */
+    void registrarStream(ALLEGRO_AUDIO_STREAM* stream, int nivel, const std::string& nome);
+
+    /**
+     * @brief Remove um asset que vai ser destruído. Ponteiros não registrados são ignorados.
+     * @param asset O ponteiro usado no registro.
+     */
+    void remover(const void* asset);
+
+    /**
+     * @brief Retorna o uso somado de todos os assets.
+     * @return O uso total.
+     */
+    const Uso& getTotal() const { return total; }
+
+    /**
+     * @brief Retorna o uso de uma categoria.
+     * @param categoria A categoria desejada.
+     * @return O uso da categoria.
+     */
+    const Uso& getCategoria(Categoria categoria) const { return categorias[categoria]; }
+
+    /**
+     * @brief Retorna o uso de um nível.
+     * @param nivel Número do nível (GLOBAL para os assets comuns).
+     * @return O uso do nível (zerado se ele nunca teve assets).
+     */
+    Uso getNivel(int nivel) const;
+
+    /**
+     * @brief Retorna quantos assets estão registrados agora.
+     * @return O número de assets.
+     */
+    int getQuantidade() const { return (int)registros.size(); }
+
+    /**
+     * @brief Retorna o orçamento de memória.
+     * @return O orçamento, em bytes (0 = sem orçamento).
+     */
+    size_t getOrcamento() const { return orcamento; }
+
+    /**
+     * @brief Define o orçamento de memória e já verifica o total atual.
+     * @param orcamentoBytes O novo orçamento, em bytes (0 = sem orçamento).
+     */
+    void setOrcamento(size_t orcamentoBytes);
+
+    /**
+     * @brief Informa se o total atual está acima do orçamento.
+     * @return true se o orçamento foi ultrapassado.
+     */
+    bool isOrcamentoExcedido() const { return excedido; }
+
+    /**
+     * @brief Grava um relatório com os totais, os níveis e todos os assets registrados.
+     * @param caminho Arquivo de destino (a pasta é criada se necessário).
+     * @return true se o arquivo foi gravado.
+     */
+    bool salvarRelatorio(const std::string& caminho) const;
+
+    /**
+     * @brief Calcula a memória de um bitmap.
+     * @param bitmap O bitmap.
+     * @return Largura x altura x bytes por pixel, ou 0 para nulo e sub-bitmaps.
+     */
+    static size_t bytesBitmap(ALLEGRO_BITMAP* bitmap);
+
+    /**
+     * @brief Calcula a memória das amostras decodificadas de um som.
+     * @param sample O som.
+     * @return O tamanho, em bytes (0 para nulo).
+     */
+    static size_t bytesSample(ALLEGRO_SAMPLE* sample);
+
+    /**
+     * @brief Calcula a memória dos buffers de uma música.
+     * @param stream A música.
+     * @return Buffers x amostras por buffer x canais x bytes por amostra (0 para nula).
+     */
+    static size_t bytesStream(ALLEGRO_AUDIO_STREAM* stream);
+
+    /**
+     * @brief Retorna o nome de uma categoria, sem acentos (usado no HUD e no relatório).
+     * @param categoria A categoria.
+     * @return O nome.
+     */
+    static const char* nomeCategoria(Categoria categoria);
+
+private:
+    /**
+     * @brief Um asset registrado.
+     */
+    struct Registro {
+        Categoria categoria; ///< @brief Tipo do asset.
+        int nivel;           ///< @brief Nível dono do asset.
+        size_t bytes;        ///< @brief Memória ocupada.
+        std::string nome;    ///< @brief Nome mostrado no relatório.
+    };
+
+    std::unordered_map<const void*, Registro> registros; ///< @brief Assets carregados agora.
+    Uso total;                          ///< @brief Soma de todos os assets.
+    Uso categorias[NUM_CATEGORIAS];     ///< @brief Soma por categoria.
+    std::map<int, Uso> niveis;          ///< @brief Soma por nível.
+    size_t orcamento;                   ///< @brief Total acima do qual o aviso é emitido.
+    bool excedido;                      ///< @brief Flag: true enquanto o total está acima do orçamento.
+
+    /**
+     * @brief Soma (ou subtrai) bytes em um uso, atualizando o pico.
+     * @param uso O uso a atualizar.
+     * @param bytes Quantidade de bytes.
+     * @param somar true para somar, false para subtrair.
+     */
+    static void ajustar(Uso& uso, size_t bytes, bool somar);
+
+    /**
+     * @brief Avisa quando o total passa do orçamento (uma vez por ultrapassagem).
+     */
+    void verificarOrcamento();
+};
+
+#endif // MEMORYTRACKER_HPP
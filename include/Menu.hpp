@@ -13,15 +13,22 @@
 #include <string>                       // Para usar std::string (apelido, mensagens)
 #include <array>                        // Para usar std::array (seções de botões)
 #include <vector>                       // Para usar std::vector (posições dos botões)
+#include "OutlinedTextCache.hpp"        // Para desenhar os rótulos dos botões com contorno
 
 /**
  * @brief Gerencia e exibe a tela de menu principal do jogo.
  *
  * Esta classe é responsável por mostrar as opções do menu (Jogar, Ranking, Configurações, Sair),
  * permitir a entrada de apelido para o jogador e lidar com a navegação e seleção de opções.
+ * Enquanto o apelido é digitado, mostra abaixo do campo os apelidos já cadastrados que
+ * começam com ele (passados pelo GameEngine); Tab completa com a sugestão marcada,
+ * as setas mudam a marcada e um clique escolhe uma delas.
  */
 class Menu {
 public:
+    /// @brief Quantas sugestões de apelido aparecem abaixo do campo.
+    static constexpr int MAX_SUGESTOES = 3;
+
     /**
      * @brief Construtor da classe Menu.
      *
@@ -106,6 +113,18 @@ public:
      */
     void setHoverSound(ALLEGRO_SAMPLE* som);
 
+    /**
+     * @brief Define os apelidos sugeridos para completar o que foi digitado.
+     * @param apelidos Até MAX_SUGESTOES apelidos, do mais forte para o mais fraco (vazio esconde a lista).
+     */
+    void setSugestoes(const std::vector<std::string>& apelidos);
+
+    /**
+     * @brief Retorna os apelidos sugeridos no momento.
+     * @return As sugestões.
+     */
+    const std::vector<std::string>& getSugestoes() const { return sugestoes; }
+
 private:
     ALLEGRO_FONT* font;             ///< @brief Fonte padrão usada para a maioria dos textos do menu.
     ALLEGRO_FONT* fontlarge;        ///< @brief Fonte maior, usada para títulos ou destaque visual.
@@ -121,6 +140,10 @@ private:
     std::string currentWarningMessage; ///< @brief A mensagem de aviso que está sendo exibida no momento.
     double warningDisplayTimer;        ///< @brief Timer para controlar por quanto tempo a mensagem de aviso permanece visível.
 
+    std::vector<std::string> sugestoes; ///< @brief Apelidos cadastrados que começam com o texto digitado.
+    int sugestaoMarcada;            ///< @brief Índice da sugestão que o Tab usa.
+    std::vector<std::array<float, 4>> areasSugestoes; ///< @brief Área (x1, y1, x2, y2) de cada sugestão no último desenho.
+
     float SCREEN_W, SCREEN_H;       ///< @brief Largura e altura da tela de exibição.
     float scale_x, scale_y;         ///< @brief Fatores de escala para ajustar elementos à resolução atual.
 
@@ -128,6 +151,7 @@ private:
     float buttonHeight;             ///< @brief Altura padrão dos botões do menu.
     ALLEGRO_FONT* buttonFont;       ///< @brief Fonte utilizada especificamente para o texto dos botões.
     std::vector<std::array<float, 2>> buttonPositions; ///< @brief Um vetor de pares (x, y) definindo as posições centrais de cada botão.
+    OutlinedTextCache textCache;    ///< @brief Cache dos rótulos dos botões já rasterizados com contorno.
 
     /// @brief Duração padrão para exibir mensagens de aviso na tela.
     static const double WARNING_DURATION;
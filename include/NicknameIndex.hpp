@@ -0,0 +1,130 @@
+/**
+ * @file NicknameIndex.hpp
+ * @brief NicknameIndexheader do projeto Traveling Dragon.
+ */
+
+#ifndef NICKNAMEINDEX_HPP
+#define NICKNAMEINDEX_HPP
+
+#include <cstddef>   // Para size_t
+#include <cstdint>   // Para os Ids de 32 bits
+#include <string>    // Para os prefixos
+#include <utility>   // Para std::pair (faixas da tabela)
+#include <vector>    // Para a tabela ordenada e a árvore
+#include "Player.hpp" // Os apelidos ficam nos jogadores; o índice guarda só os Ids
+
+/**
+ * @brief Índice de prefixos dos apelidos, para sugerir jogadores enquanto o apelido é digitado.
+ *
+ * Os Ids ficam em uma tabela ordenada pelo apelido: os apelidos que começam com um
+ * prefixo formam uma faixa contínua dela. A cada tecla, a faixa do prefixo novo é
+ * procurada dentro da faixa do prefixo anterior, comparando só o caractere novo
+ * (as faixas de cada tamanho de prefixo ficam guardadas, então apagar uma letra
+ * volta para a faixa anterior sem busca nenhuma).
+ *
+ * Por cima da tabela há uma árvore de segmentos com o jogador de maior pontuação de
+ * cada trecho: as N melhores sugestões de uma faixa saem em O(N log n), mesmo que o
+ * prefixo tenha milhões de apelidos. Mudar a pontuação de um jogador custa O(log n).
+ *
+ * Jogadores cadastrados depois da montagem ficam em uma lista curta de recentes,
+ * conferida inteira em cada consulta; quando ela passa de LIMITE_RECENTES, é
+ * intercalada na tabela (O(n), uma vez a cada LIMITE_RECENTES cadastros).
+ *
+ * Como no índice do banco binário, os apelidos não são copiados: as funções que
+ * precisam deles recebem o vetor de jogadores, indexado pelo Id.
+ */
+class NicknameIndex {
+public:
+    /// @brief Cadastros guardados fora da tabela antes de ela ser refeita.
+    static constexpr size_t LIMITE_RECENTES = 256;
+
+    /**
+     * @brief Construtor da classe NicknameIndex. Começa vazio.
+     */
+    NicknameIndex();
+
+    /**
+     * @brief Remove todos os apelidos.
+     */
+    void limpar();
+
+    /**
+     * @brief Monta o índice com todos os jogadores (O(n log n)).
+     * @param jogadores Os jogadores, indexados pelo Id.
+     */
+    void reconstruir(const std::vector<Player>& jogadores);
+
+    /**
+     * @brief Acrescenta um jogador cadastrado depois da montagem.
+     * @param id O Id do jogador.
+     * @param jogadores Os jogadores, indexados pelo Id (já com o novo).
+     */
+    void inserir(uint32_t id, const std::vector<Player>& jogadores);
+
+    /**
+     * @brief Muda a pontuação usada para ordenar as sugestões de um jogador (O(log n)).
+     * @param id O Id do jogador.
+     * @param pontuacao A pontuação nova.
+     */
+    void atualizar(uint32_t id, int pontuacao);
+
+    /**
+     * @brief Sugere os jogadores cujo apelido começa com um prefixo.
+     *
+     * Aproveita a consulta anterior: se o prefixo só ganhou ou perdeu letras no fim,
+     * só essas letras custam uma busca.
+     *
+     * @param prefixo O começo do apelido.
+     * @param quantos Quantas sugestões, no máximo.
+     * @param jogadores Os jogadores, indexados pelo Id.
+     * @return Os Ids, da maior pontuação para a menor (no empate, em ordem de apelido).
+     */
+    std::vector<uint32_t> sugerir(const std::string& prefixo, size_t quantos, const std::vector<Player>& jogadores);
+
+    /**
+     * @brief Retorna quantos apelidos estão no índice.
+     * @return A quantidade.
+     */
+    size_t getQuantidade() const { return ordem.size() + recentes.size(); }
+
+private:
+    /// @brief Posição vazia (na árvore) ou Id fora da tabela (em `posicaoDe`).
+    static constexpr uint32_t NENHUMA = 0xFFFFFFFFu;
+
+    std::vector<uint32_t> ordem;     ///< @brief Ids em ordem de apelido.
+    std::vector<uint32_t> posicaoDe; ///< @brief Posição de cada Id em `ordem` (NENHUMA se está nos recentes).
+    std::vector<int> pontos;         ///< @brief Pontuação de cada Id.
+    std::vector<uint32_t> arvore;    ///< @brief Árvore de segmentos: a posição de maior pontuação de cada trecho.
+    size_t folhas;                   ///< @brief Quantidade de folhas da árvore (potência de 2).
+    std::vector<uint32_t> recentes;  ///< @brief Ids cadastrados depois da última montagem da tabela.
+
+    std::string prefixoAnterior;                      ///< @brief Prefixo da última consulta.
+    std::vector<std::pair<uint32_t, uint32_t>> faixas; ///< @brief Faixa [início, fim) de cada tamanho do prefixo anterior.
+
+    /**
+     * @brief Compara duas posições da tabela pela pontuação (a posição menor ganha no empate).
+     * @return true se a posição `a` é uma sugestão melhor que a `b` (NENHUMA perde sempre).
+     */
+    bool melhor(uint32_t a, uint32_t b) const;
+
+    /**
+     * @brief Refaz a árvore inteira a partir da tabela (O(n)).
+     */
+    void montarArvore();
+
+    /**
+     * @brief Encontra a posição de maior pontuação em um trecho da tabela (O(log n)).
+     * @param inicio Primeira posição do trecho.
+     * @param fim Posição depois da última.
+     * @return A posição, ou NENHUMA com o trecho vazio.
+     */
+    uint32_t maisAlto(uint32_t inicio, uint32_t fim) const;
+
+    /**
+     * @brief Intercala os recentes na tabela e refaz a árvore.
+     * @param jogadores Os jogadores, indexados pelo Id.
+     */
+    void intercalarRecentes(const std::vector<Player>& jogadores);
+};
+
+#endif // NICKNAMEINDEX_HPP
@@ -0,0 +1,127 @@
+/**
+ * @file OutlinedTextCache.hpp
+ * @brief OutlinedTextCacheheader do projeto Traveling Dragon.
+ */
+
+#ifndef OUTLINEDTEXTCACHE_HPP
+#define OUTLINEDTEXTCACHE_HPP
+
+#include <allegro5/allegro.h>      // Para ALLEGRO_BITMAP e ALLEGRO_COLOR
+#include <allegro5/allegro_font.h> // Para ALLEGRO_FONT e desenho de texto
+#include <string>                  // Para usar std::string (texto e chave do cache)
+#include <unordered_map>           // Para indexar os bitmaps já rasterizados
+
+/**
+ * @brief Cache de textos com contorno já rasterizados em bitmaps.
+ *
+ * O contorno dos textos do jogo é feito desenhando a string deslocada em todas as
+ * posições de um quadrado (raio 3 = 48 cópias) e depois o preenchimento por cima.
+ * Esta classe faz esse trabalho uma única vez para cada combinação de
+ * (texto, fonte, cores, raio) e guarda o resultado em um bitmap; nos frames
+ * seguintes o texto custa apenas um desenho de bitmap. Quando o texto muda
+ * (ex: a pontuação sobe), só a nova string é rasterizada.
+ */
+class OutlinedTextCache {
+public:
+    /**
+     * @brief Construtor da classe OutlinedTextCache.
+     * @param capacidade Número máximo de textos mantidos no cache. Ao exceder, o menos usado é descartado.
+     */
+    explicit OutlinedTextCache(int capacidade = 32);
+
+    /**
+     * @brief Destrutor da classe OutlinedTextCache.
+     * Libera todos os bitmaps rasterizados.
+     */
+    ~OutlinedTextCache();
+
+    OutlinedTextCache(const OutlinedTextCache&) = delete;            ///< @brief Não copiável (possui bitmaps).
+    OutlinedTextCache& operator=(const OutlinedTextCache&) = delete; ///< @brief Não copiável (possui bitmaps).
+
+    /**
+     * @brief Desenha um texto com contorno, rasterizando-o apenas se ainda não estiver no cache.
+     *
+     * O resultado é equivalente a desenhar o texto com a cor de contorno em todos os
+     * deslocamentos de -raio a +raio (exceto o centro) e depois o texto com a cor principal.
+     *
+     * @param font Fonte usada no texto.
+     * @param corTexto Cor do preenchimento do texto.
+     * @param corContorno Cor do contorno do texto.
+     * @param raio Raio do contorno em pixels.
+     * @param x Posição X do texto (interpretada conforme `flags`, como em al_draw_text).
+     * @param y Posição Y do topo do texto.
+     * @param flags Alinhamento (ALLEGRO_ALIGN_LEFT, ALLEGRO_ALIGN_CENTER ou ALLEGRO_ALIGN_RIGHT).
+     * @param texto A string a ser desenhada.
+     */
+    void draw(ALLEGRO_FONT* font, ALLEGRO_COLOR corTexto, ALLEGRO_COLOR corContorno, int raio,
+              float x, float y, int flags, const std::string& texto);
+
+    /**
+     * @brief Retorna o bitmap de um texto com contorno sem desenhá-lo (para gravar em uma RenderQueue).
+     *
+     * Rasteriza o texto se ele ainda não estiver no cache, então não deve ser chamado
+     * com o desenho segurado pendente de envio para outro alvo.
+     *
+     * @param font Fonte usada no texto.
+     * @param corTexto Cor do preenchimento do texto.
+     * @param corContorno Cor do contorno do texto.
+     * @param raio Raio do contorno em pixels.
+     * @param x Posição X do texto (interpretada conforme `flags`, como em al_draw_text).
+     * @param y Posição Y do topo do texto.
+     * @param flags Alinhamento (ALLEGRO_ALIGN_LEFT, ALLEGRO_ALIGN_CENTER ou ALLEGRO_ALIGN_RIGHT).
+     * @param texto A string desejada.
+     * @param destinoX Recebe o X onde o bitmap deve ser desenhado.
+     * @param destinoY Recebe o Y onde o bitmap deve ser desenhado.
+     * @return O bitmap do texto, ou nullptr se não foi possível rasterizá-lo.
+     */
+    ALLEGRO_BITMAP* obter(ALLEGRO_FONT* font, ALLEGRO_COLOR corTexto, ALLEGRO_COLOR corContorno, int raio,
+                          float x, float y, int flags, const std::string& texto, float& destinoX, float& destinoY);
+
+    /**
+     * @brief Descarta todos os textos rasterizados.
+     * Deve ser chamado se a fonte usada for destruída enquanto o cache ainda existir.
+     */
+    void limpar();
+
+    /**
+     * @brief Retorna quantas vezes algum texto precisou ser rasterizado (falhas de cache).
+     * @return O número de rasterizações feitas desde a criação do cache.
+     */
+    int getRasterizacoes() const { return rasterizacoes; }
+
+private:
+    /**
+     * @brief Um texto já rasterizado.
+     */
+    struct Entrada {
+        ALLEGRO_BITMAP* bitmap;     ///< @brief Bitmap com o texto e o contorno.
+        int larguraTexto;           ///< @brief Largura do texto sem o contorno (usada no alinhamento).
+        unsigned long ultimoUso;    ///< @brief Marca de tempo lógica do último uso (para descartar o menos usado).
+    };
+
+    std::unordered_map<std::string, Entrada> entradas; ///< @brief Textos rasterizados, indexados pela chave completa.
+    int capacidade;                 ///< @brief Número máximo de entradas no cache.
+    unsigned long relogio;          ///< @brief Contador incrementado a cada desenho, usado como marca de tempo.
+    int rasterizacoes;              ///< @brief Quantidade de rasterizações feitas (para diagnóstico).
+
+    /**
+     * @brief Monta a chave única de um texto no cache.
+     * @return Uma string combinando fonte, cores, raio e o texto.
+     */
+    static std::string montarChave(ALLEGRO_FONT* font, ALLEGRO_COLOR corTexto, ALLEGRO_COLOR corContorno,
+                                   int raio, const std::string& texto);
+
+    /**
+     * @brief Rasteriza o texto com contorno em um novo bitmap transparente.
+     * @return A entrada criada (com bitmap nulo se a criação falhar).
+     */
+    Entrada rasterizar(ALLEGRO_FONT* font, ALLEGRO_COLOR corTexto, ALLEGRO_COLOR corContorno,
+                       int raio, const std::string& texto);
+
+    /**
+     * @brief Remove a entrada menos usada recentemente.
+     */
+    void descartarMenosUsada();
+};
+
+#endif // OUTLINEDTEXTCACHE_HPP
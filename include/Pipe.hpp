@@ -9,6 +9,7 @@
 #include "GameObject.hpp"           // A classe base para objetos no jogo (posição, dimensão)
 #include <allegro5/allegro_primitives.h> // Para desenhar formas geométricas (não estritamente necessário se usar só bitmap, mas bom ter)
 #include <allegro5/allegro_image.h>     // Para carregar e desenhar imagens (bitmaps)
+#include "RenderQueue.hpp"               // Lista de comandos onde os canos são gravados
 
 /**
  * @brief Representa um par de obstáculos (cano superior e inferior) no jogo.
@@ -18,6 +19,11 @@
  */
 class Pipe : public GameObject {
 public:
+    /// @brief Largura do asset original do cano, em pixels (usada para o tamanho e a colisão).
+    static const float SPRITE_WIDTH;
+    /// @brief Escala fixa em que o cano aparece na tela em relação ao asset original.
+    static const float SPRITE_SCALE;
+
     /**
      * @brief Construtor da classe Pipe.
      *
@@ -44,9 +50,11 @@ public:
     void update(float deltaTime);
 
     /**
-     * @brief Renderiza (desenha) o cano superior e o cano inferior na tela.
+     * @brief Grava o desenho do cano superior e do cano inferior na lista do frame.
+     * A parte de cada cano que fica acima ou abaixo da tela é recortada pela lista.
+     * @param fila Lista de comandos do frame.
      */
-    void render();
+    void render(RenderQueue& fila);
 
     /**
      * @brief Retorna a coordenada Y do topo do cano superior.
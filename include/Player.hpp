@@ -33,17 +33,27 @@ public:
      */
     Player(std::string nome, std::string apelido);
 
+    /**
+     * @brief Construtor que restaura um jogador salvo, já com as estatísticas.
+     *
+     * @param nome O nome completo do jogador.
+     * @param apelido O apelido do jogador.
+     * @param partidas O número de partidas jogadas.
+     * @param maiorPontuacao A maior pontuação alcançada.
+     */
+    Player(std::string nome, std::string apelido, int partidas, int maiorPontuacao);
+
     /**
      * @brief Retorna o apelido do jogador.
-     * @return Uma string constante contendo o apelido.
+     * @return Uma referência constante para o apelido (sem cópia, usada nas buscas e no ranking).
      */
-    std::string getApelido() const;
+    const std::string& getApelido() const;
 
     /**
      * @brief Retorna o nome completo do jogador.
-     * @return Uma string constante contendo o nome.
+     * @return Uma referência constante para o nome.
      */
-    std::string getNome() const;
+    const std::string& getNome() const;
 
     /**
      * @brief Retorna o número de partidas jogadas pelo jogador.
@@ -0,0 +1,166 @@
+/**
+ * @file PlayerDatabase.hpp
+ * @brief PlayerDatabaseheader do projeto Traveling Dragon.
+ */
+
+#ifndef PLAYERDATABASE_HPP
+#define PLAYERDATABASE_HPP
+
+#include <cstdint>         // Para tipos de tamanho fixo do formato
+#include <string>          // Para usar std::string (caminhos)
+#include <vector>          // Para usar std::vector (jogadores a gravar)
+#include "MappedFile.hpp"  // Mapeamento do arquivo do banco
+#include "Player.hpp"      // Jogadores gravados no banco
+
+/**
+ * @brief Banco binário de jogadores (o snapshot do PlayerManager), lido por mapeamento em memória.
+ *
+ * Formato (inteiros little-endian):
+ * - cabeçalho de 32 bytes: "TDPL", versão, quantidade de jogadores, tamanho da tabela
+ *   de textos, o último número de sequência do diário contido no banco (64 bits) e a
+ *   capacidade do índice de apelidos;
+ * - um registro de 16 bytes por jogador: offset do nome e do apelido na tabela de
+ *   textos, partidas e maior pontuação;
+ * - índice de apelidos: tabela de hash (FNV-1a, sondagem linear, capacidade potência
+ *   de 2) com a posição do jogador + 1 em cada posição ocupada (0 = vazia);
+ * - tabela de textos: cada texto uma única vez, terminado em '\0' (o jogo cadastra
+ *   o apelido também como nome, então os dois apontam para o mesmo texto).
+ *
+ * Abrir o banco só mapeia o arquivo e confere o cabeçalho: não há texto para
+ * interpretar, as estatísticas vêm prontas nos registros e o índice de apelidos
+ * já vem montado, então o custo não depende de quantas partidas foram jogadas.
+ */
+class PlayerDatabase {
+public:
+    /// @brief Versão do formato gravada no cabeçalho.
+    static const uint32_t VERSAO = 1;
+
+    /**
+     * @brief Construtor da classe PlayerDatabase. Não abre nada (veja `abrir`).
+     */
+    PlayerDatabase();
+
+    /**
+     * @brief Mapeia um banco e confere o cabeçalho.
+     * @param caminho Caminho do banco.
+     * @return false se o arquivo não existe ou não é um banco válido desta versão.
+     */
+    bool abrir(const std::string& caminho);
+
+    /**
+     * @brief Desfaz o mapeamento.
+     */
+    void fechar();
+
+    /**
+     * @brief Informa se há um banco aberto.
+     * @return true se `abrir` teve sucesso.
+     */
+    bool isAberto() const { return arquivo.isAberto(); }
+
+    /**
+     * @brief Retorna quantos jogadores o banco tem.
+     * @return O número de jogadores (0 se nada foi aberto).
+     */
+    uint32_t getQuantidade() const { return quantidade; }
+
+    /**
+     * @brief Retorna o último número de sequência do diário contido no banco.
+     * @return O número de sequência.
+     */
+    uint64_t getSeq() const { return seq; }
+
+    /**
+     * @brief Retorna a capacidade do índice de apelidos.
+     * @return A quantidade de posições (potência de 2, ou 0 sem jogadores).
+     */
+    uint32_t getCapacidadeIndice() const { return capacidadeIndice; }
+
+    /**
+     * @brief Copia o índice de apelidos para a memória (uma cópia só, sem refazer o hash).
+     * @param saida Recebe as posições (posição do jogador + 1, ou 0 se vazia).
+     */
+    void copiarIndice(std::vector<uint32_t>& saida) const;
+
+    /**
+     * @brief Retorna o nome de um jogador, direto do mapeamento.
+     * @param i Índice do jogador (menor que `getQuantidade`).
+     * @return O nome (vazio se o offset estiver fora da tabela).
+     */
+    const char* getNome(uint32_t i) const;
+
+    /**
+     * @brief Retorna o apelido de um jogador, direto do mapeamento.
+     * @param i Índice do jogador (menor que `getQuantidade`).
+     * @return O apelido (vazio se o offset estiver fora da tabela).
+     */
+    const char* getApelido(uint32_t i) const;
+
+    /**
+     * @brief Retorna as partidas jogadas por um jogador.
+     * @param i Índice do jogador (menor que `getQuantidade`).
+     * @return O número de partidas.
+     */
+    int getPartidas(uint32_t i) const;
+
+    /**
+     * @brief Retorna a maior pontuação de um jogador.
+     * @param i Índice do jogador (menor que `getQuantidade`).
+     * @return A maior pontuação.
+     */
+    int getMaiorPontuacao(uint32_t i) const;
+
+    /**
+     * @brief Grava um banco de forma atômica (arquivo temporário, fsync e renomeação).
+     * Uma queda no meio da gravação deixa o banco anterior intacto.
+     * @param caminho Caminho do banco (a pasta é criada se necessário).
+     * @param jogadores Os jogadores.
+     * @param seq Último número de sequência do diário contido nos jogadores.
+     * @return true se o banco foi gravado.
+     */
+    static bool gravar(const std::string& caminho, const std::vector<Player>& jogadores, uint64_t seq);
+
+    /**
+     * @brief Hash de um apelido, usado no índice gravado no banco.
+     * @param apelido O apelido.
+     * @return O hash (FNV-1a de 32 bits).
+     */
+    static uint32_t hashApelido(const std::string& apelido);
+
+    /**
+     * @brief Procura um apelido em um índice copiado com `copiarIndice`.
+     * @param indice As posições do índice.
+     * @param apelido O apelido procurado.
+     * @param jogadores Os jogadores, na ordem do banco (para conferir o apelido encontrado).
+     * @return A posição do jogador, ou -1 se o apelido não está no índice.
+     */
+    static int buscarNoIndice(const std::vector<uint32_t>& indice, const std::string& apelido,
+                              const std::vector<Player>& jogadores);
+
+    /**
+     * @brief Informa se um arquivo começa com a assinatura do banco binário.
+     * Usado para diferenciar o banco do arquivo de texto antigo na migração.
+     * @param caminho Caminho do arquivo.
+     * @return true se o arquivo existe e começa com "TDPL".
+     */
+    static bool reconhecer(const std::string& caminho);
+
+private:
+    MappedFile arquivo;               ///< @brief O banco mapeado.
+    uint32_t quantidade;              ///< @brief Quantidade de jogadores.
+    uint32_t tamanhoTabela;           ///< @brief Tamanho da tabela de textos, em bytes.
+    uint64_t seq;                     ///< @brief Último número de sequência contido no banco.
+    uint32_t capacidadeIndice;        ///< @brief Posições do índice de apelidos.
+    const unsigned char* registros;   ///< @brief Início dos registros no mapeamento.
+    const unsigned char* indice;      ///< @brief Início do índice de apelidos no mapeamento.
+    const char* tabela;               ///< @brief Início da tabela de textos no mapeamento.
+
+    /**
+     * @brief Retorna um texto da tabela, conferindo o offset.
+     * @param offset Offset do texto.
+     * @return O texto (vazio se o offset estiver fora da tabela).
+     */
+    const char* texto(uint32_t offset) const;
+};
+
+#endif // PLAYERDATABASE_HPP
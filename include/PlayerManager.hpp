@@ -8,18 +8,156 @@
 
 #include <vector>   // Para usar std::vector para armazenar jogadores
 #include <string>   // Para usar std::string para nomes de arquivos e dados
+#include <unordered_map> // Para o índice de apelidos (busca em tempo constante)
+#include <atomic>   // Para a flag da compactação em segundo plano
+#include <cstdint>  // Para uint64_t (números de sequência do diário)
+#include <allegro5/allegro.h> // Para a thread da compactação
 #include "Player.hpp" // Para ter a definição da classe Player
+#include "MatchJournal.hpp" // Diário de cadastros e partidas
+#include "FileLock.hpp"     // Trava do snapshot entre jogos que usam o mesmo cadastro
+#include "Leaderboard.hpp"  // Ranking mantido em ordem
+#include "ScoreHistogram.hpp" // Pontuações de todas as partidas e recordes dos jogadores
+#include "NicknameIndex.hpp"  // Sugestões de apelidos por prefixo
+#include "LeaderboardClient.hpp" // Envio das partidas ao serviço de ranking compartilhado
 
 /**
  * @brief Gerencia o armazenamento e a manipulação dos dados de todos os jogadores.
  *
  * A classe PlayerManager é responsável por carregar e salvar os dados dos jogadores
  * em um arquivo, além de permitir o cadastro, busca e acesso ao ranking de jogadores.
+ *
+ * Cada jogador recebe um Id (a posição dele no cadastro), que nunca muda, já que
+ * jogadores não são removidos. Os ponteiros devolvidos por `buscar` deixam de valer
+ * quando o vetor cresce em um cadastro; quem precisa guardar o jogador guarda o Id.
+ * A busca por apelido usa índices com hash, sem percorrer o vetor: o do banco binário,
+ * carregado pronto, e um na memória para os jogadores cadastrados depois dele.
+ *
+ * A persistência é feita em duas partes: o snapshot (o banco binário PlayerDatabase, com
+ * todos os jogadores até um número de sequência) e o diário (MatchJournal), onde cada
+ * cadastro e cada partida terminada é acrescentado como uma linha curta. Salvar uma
+ * partida custa O(1), não O(jogadores). De tempos em tempos, uma thread compacta o
+ * diário: ele é trocado por um vazio e o antigo é dobrado em um snapshot novo, gravado
+ * em um arquivo temporário e renomeado por cima do anterior. Ao carregar, o snapshot
+ * é mapeado na memória e os registros do diário posteriores a ele são reaplicados.
+ * O arquivo de texto das versões antigas é convertido na primeira carga.
+ *
+ * Vários jogos (gabinetes) podem usar o mesmo cadastro ao mesmo tempo, na mesma
+ * máquina ou em uma pasta compartilhada. Nenhum deles regrava o arquivo com a sua
+ * cópia do cadastro: todos acrescentam registros ao mesmo diário (veja MatchJournal),
+ * e as mudanças de jogos diferentes se juntam ao dobrar o diário. Cada partida
+ * soma 1 às partidas e só aumenta a maior pontuação, então a ordem entre os jogos
+ * não muda o resultado; dois cadastros do mesmo apelido ficam com o primeiro.
+ * A trava `<snapshot>.lock` é exclusiva na compactação (um jogo por vez troca o
+ * snapshot) e compartilhada na carga (vários jogos leem juntos, mas nunca um snapshot
+ * pela metade). Um jogo já aberto só vê as partidas dos outros na próxima carga.
+ *
+ * O ranking (Leaderboard) é montado de uma vez ao carregar e depois só é mexido quando
+ * um cadastro ou uma partida muda a maior pontuação de alguém: as telas consultam
+ * posições e as primeiras colocações sem ordenar o cadastro.
+ *
+ * Dois histogramas (ScoreHistogram) respondem "você superou X%" sem percorrer nada:
+ * um com a pontuação de cada partida registrada e outro com o recorde de cada
+ * jogador. O de recordes é remontado ao carregar, como o ranking; o de partidas é
+ * gravado ao lado do snapshot (extensão .hist) quando o diário é dobrado, com o
+ * número de sequência até onde vai, e as partidas do diário posteriores a ele são
+ * somadas ao carregar.
+ *
+ * As sugestões de apelido do menu vêm de um índice de prefixos (NicknameIndex),
+ * montado na primeira consulta (e não ao carregar, para não atrasar a abertura do
+ * jogo) e depois mantido a cada cadastro e recorde pessoal.
+ *
+ * Com um serviço de ranking configurado (LeaderboardClient), cada partida registrada
+ * também é entregue a ele, sem esperar: o ranking do cadastro continua sendo o deste
+ * jogo (ou da pasta compartilhada), e o do serviço junta os gabinetes que não dividem
+ * o cadastro.
  */
 class PlayerManager {
+public:
+    /// @brief Identificador estável de um jogador (posição no cadastro).
+    using Id = int;
+    /// @brief Id devolvido quando o jogador não existe.
+    static constexpr Id ID_INVALIDO = -1;
+
 private:
     std::vector<Player> jogadores; ///< @brief Vetor que armazena todos os objetos Player carregados ou cadastrados.
+    std::unordered_map<std::string, Id> indice; ///< @brief Apelido -> Id dos jogadores que não vieram do banco binário.
+    std::vector<uint32_t> indiceBanco; ///< @brief Índice de apelidos copiado do banco (jogadores do snapshot).
+    Leaderboard ranking;           ///< @brief Jogadores em ordem de maior pontuação (posição em O(log n)).
+    ScoreHistogram pontuacoesPartidas; ///< @brief Pontuação de cada partida registrada.
+    ScoreHistogram recordesJogadores;  ///< @brief Maior pontuação de cada jogador.
+    NicknameIndex apelidos;        ///< @brief Índice de prefixos dos apelidos (sugestões do menu).
+    bool apelidosProntos;          ///< @brief Flag: true depois que `apelidos` foi montado com o cadastro atual.
     std::string caminhoArquivo;    ///< @brief O caminho completo do arquivo onde os dados dos jogadores são persistidos.
+    std::string caminhoJournal;    ///< @brief Caminho do diário (o do arquivo de jogadores com extensão .journal).
+    std::string caminhoHistograma; ///< @brief Caminho do histograma de partidas (extensão .hist).
+    MatchJournal::Sincronia sincronia; ///< @brief Política de sincronia do diário.
+    MatchJournal* journal;         ///< @brief Diário aberto por `carregar` (nulo antes disso: só memória).
+    int registrosDesdeCompactacao; ///< @brief Registros anotados desde a última compactação.
+    ALLEGRO_THREAD* compactador;   ///< @brief Thread da última compactação (nula se nenhuma foi iniciada).
+    FileLock travaSnapshot;        ///< @brief Trava do snapshot entre os jogos (extensão .lock depois da do snapshot).
+    std::atomic<bool> compactando; ///< @brief Flag: true enquanto uma compactação está rodando.
+    LeaderboardClient* placarRemoto; ///< @brief Serviço de ranking que recebe as partidas (nulo: nenhum).
+    std::vector<MatchJournal::Registro> foraDoDiario; ///< @brief Mudanças ainda não gravadas porque o diário não abriu.
+
+    /// @brief Quantidade de registros no diário que dispara uma compactação.
+    static const int LIMITE_COMPACTACAO = 500;
+
+    /**
+     * @brief Lê um snapshot: o banco binário ou o arquivo de texto antigo (nome apelido partidas maior).
+     * Um banco binário inválido é movido para `<caminho>.corrompido`.
+     * @param caminho Caminho do snapshot.
+     * @param jogadores Recebe os jogadores.
+     * @param indice Recebe o índice de apelidos.
+     * @param seq Recebe o último número de sequência contido no snapshot (0 em arquivos antigos).
+     * @return false se o arquivo não pôde ser aberto.
+     */
+    static bool lerSnapshot(const std::string& caminho, std::vector<Player>& jogadores,
+                            std::unordered_map<std::string, Id>& indice, uint64_t& seq);
+
+    /**
+     * @brief Converte o arquivo de texto antigo em banco binário.
+     * O texto pode estar no próprio caminho do banco ou ao lado dele, com extensão .txt.
+     */
+    void migrarTexto();
+
+    /**
+     * @brief Aplica um registro do diário a um conjunto de jogadores (sem anotá-lo de novo).
+     * Um apelido que não está em nenhum dos índices vira um jogador novo, no índice da memória.
+     * @param jogadores Os jogadores.
+     * @param indice O índice de apelidos na memória.
+     * @param indiceBanco O índice copiado do banco binário (vazio fora da carga).
+     * @param registro O registro.
+     */
+    static void aplicar(std::vector<Player>& jogadores, std::unordered_map<std::string, Id>& indice,
+                        const std::vector<uint32_t>& indiceBanco, const MatchJournal::Registro& registro);
+
+    /**
+     * @brief Dobra um diário já fechado no snapshot e no histograma de partidas e apaga o diário.
+     * Só mexe nos arquivos, então pode rodar em outra thread. O histograma é gravado
+     * antes do snapshot: se o jogo cair entre os dois, ele fica à frente e o número de
+     * sequência dele evita contar as mesmas partidas de novo.
+     * @param caminhoSnapshot Caminho do snapshot.
+     * @param caminhoHistograma Caminho do histograma de partidas.
+     * @param caminhoDiario Caminho do diário a dobrar.
+     * @return true se o snapshot novo foi gravado.
+     */
+    static bool dobrarJournal(const std::string& caminhoSnapshot, const std::string& caminhoHistograma,
+                              const std::string& caminhoDiario);
+
+    /**
+     * @brief Corpo da thread de compactação.
+     * @param thread A thread atual (não usada).
+     * @param arg Ponteiro para o PlayerManager.
+     * @return Sempre nullptr.
+     */
+    static void* executarCompactacao(ALLEGRO_THREAD* thread, void* arg);
+
+    /**
+     * @brief Anota um registro no diário e compacta quando ele fica grande. Se o diário
+     * não pôde ser aberto, guarda o registro e, ao fim de uma partida, grava o banco (`salvar`).
+     * @param registro O registro.
+     */
+    void anotar(const MatchJournal::Registro& registro);
 
 public:
     /**
@@ -27,43 +165,90 @@ public:
      *
      * Inicializa o gerenciador de jogadores com o caminho do arquivo de persistência.
      *
-     * @param caminho O caminho do arquivo (ex: "players.dat") onde os dados serão salvos/carregados.
+     * @param caminho O caminho do banco (ex: "players.dat") onde os dados serão salvos/carregados.
+     * @param sincronia Política de sincronia do diário de partidas.
+     */
+    PlayerManager(const std::string& caminho, MatchJournal::Sincronia sincronia = MatchJournal::SYNC_GRUPO);
+
+    /**
+     * @brief Destrutor da classe PlayerManager.
+     * Espera a compactação em andamento e grava no disco o que ainda estiver no diário.
      */
-    PlayerManager(const std::string& caminho);
+    ~PlayerManager();
+
+    PlayerManager(const PlayerManager&) = delete;            ///< @brief Não copiável (possui o diário e a thread).
+    PlayerManager& operator=(const PlayerManager&) = delete; ///< @brief Não copiável (possui o diário e a thread).
 
     /**
      * @brief Carrega os dados dos jogadores de um arquivo para a memória.
      *
      * Se o arquivo não existir ou estiver corrompido, o vetor de jogadores pode
-     * ser inicializado vazio ou com dados padrão.
+     * ser inicializado vazio ou com dados padrão. Os registros do diário posteriores
+     * ao snapshot são reaplicados, e o diário fica aberto para as próximas mudanças.
      */
     void carregar();
 
     /**
      * @brief Salva os dados atuais dos jogadores que estão na memória para o arquivo.
-     * Marca como `const` porque não altera o estado do PlayerManager, apenas o arquivo.
+     * Com o diário aberto, só garante que tudo o que foi anotado está no disco (cada
+     * mudança já foi anotada ao acontecer). Se ele não pôde ser aberto, aplica as
+     * mudanças deste jogo ao banco do disco, com a trava exclusiva do snapshot, e o grava inteiro.
+     */
+    void salvar();
+
+    /**
+     * @brief Registra uma partida terminada de um jogador e a anota no diário.
+     * @param id O Id do jogador.
+     * @param pontuacao A pontuação da partida.
+     * @return false se o Id não existe.
+     */
+    bool registrarPartida(Id id, int pontuacao);
+
+    /**
+     * @brief Inicia uma compactação do diário em segundo plano (se nenhuma estiver rodando).
      */
-    void salvar() const;
+    void compactar();
+
+    /**
+     * @brief Espera a última compactação iniciada terminar.
+     */
+    void aguardarCompactacao();
 
     /**
      * @brief Cadastra um novo jogador no sistema.
      *
-     * Se um jogador com o mesmo apelido já existir, ele pode ser atualizado ou
-     * um aviso pode ser gerado, dependendo da implementação.
+     * Se um jogador com o mesmo apelido já existir, nada é cadastrado e o Id
+     * do jogador existente é retornado.
      *
      * @param nome O nome completo do jogador a ser cadastrado.
      * @param apelido O apelido único do jogador.
+     * @return O Id do jogador.
      */
-    void cadastrar(const std::string& nome, const std::string& apelido);
+    Id cadastrar(const std::string& nome, const std::string& apelido);
 
     /**
      * @brief Busca um jogador pelo seu apelido.
+     * O ponteiro vale até o próximo cadastro; para guardar o jogador, use `buscarId`.
      * @param apelido O apelido do jogador a ser buscado.
      * @return Um ponteiro para o objeto Player encontrado, ou `nullptr` se nenhum jogador
      * com o apelido especificado for encontrado.
      */
     Player* buscar(const std::string& apelido);
 
+    /**
+     * @brief Busca o Id de um jogador pelo seu apelido.
+     * @param apelido O apelido do jogador a ser buscado.
+     * @return O Id do jogador, ou `ID_INVALIDO` se ele não existir.
+     */
+    Id buscarId(const std::string& apelido) const;
+
+    /**
+     * @brief Retorna o jogador de um Id.
+     * @param id O Id do jogador.
+     * @return Um ponteiro para o jogador, ou `nullptr` se o Id não existir.
+     */
+    Player* getJogador(Id id);
+
     /**
      * @brief Imprime o ranking de todos os jogadores cadastrados no console.
      * A ordem é geralmente decrescente pela maior pontuação.
@@ -78,6 +263,46 @@ public:
      */
     const std::vector<Player>& getJogadores() const;
 
+    /**
+     * @brief Retorna o ranking, sempre em ordem (maior pontuação primeiro; no empate, o cadastro mais antigo).
+     * Os Ids do ranking são os do PlayerManager.
+     * @return O ranking.
+     */
+    const Leaderboard& getRanking() const { return ranking; }
+
+    /**
+     * @brief Retorna o histograma com a pontuação de todas as partidas registradas.
+     * @return O histograma.
+     */
+    const ScoreHistogram& getPontuacoesPartidas() const { return pontuacoesPartidas; }
+
+    /**
+     * @brief Retorna o histograma com a maior pontuação de cada jogador.
+     * @return O histograma.
+     */
+    const ScoreHistogram& getRecordesJogadores() const { return recordesJogadores; }
+
+    /**
+     * @brief Sugere jogadores cujo apelido começa com um prefixo, para completar o que está sendo digitado.
+     * Chamadas seguidas com o prefixo ganhando ou perdendo uma letra custam só essa letra.
+     * @param prefixo O começo do apelido.
+     * @param quantos Quantas sugestões, no máximo.
+     * @return Os Ids, da maior pontuação para a menor.
+     */
+    std::vector<Id> sugerirApelidos(const std::string& prefixo, size_t quantos);
+
+    /**
+     * @brief Retorna o diário de partidas (para as estatísticas de gravação).
+     * @return O diário, ou nullptr antes de `carregar`.
+     */
+    const MatchJournal* getJournal() const { return journal; }
+
+    /**
+     * @brief Define o serviço de ranking que recebe cada partida registrada.
+     * @param cliente O cliente do serviço (nulo para nenhum); precisa viver mais que os registros.
+     */
+    void setPlacarRemoto(LeaderboardClient* cliente) { placarRemoto = cliente; }
+
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+/**
+ * @file PostProcessor.hpp
+ * @brief PostProcessorheader do projeto Traveling Dragon.
+ */
+
+#ifndef POSTPROCESSOR_HPP
+#define POSTPROCESSOR_HPP
+
+#include <allegro5/allegro.h> // Para ALLEGRO_BITMAP, blenders e desenho de bitmaps
+
+/**
+ * @brief Efeito de desfoque das transições, calculado em baixa resolução.
+ *
+ * A cena (desenhada em resolução cheia em um bitmap) é reduzida em cadeia para
+ * 1/2 e depois 1/4 da resolução; o desfoque gaussiano separável (horizontal e
+ * depois vertical) roda nesse bitmap pequeno, que tem 1/16 dos pixels da tela.
+ * Na composição final a cena nítida e a desfocada são misturadas de acordo com a
+ * intensidade do efeito, já escurecidas para o fade da transição.
+ */
+class PostProcessor {
+public:
+    /**
+     * @brief Tempo gasto em cada passada do último efeito aplicado, em milissegundos.
+     * É o tempo de CPU para enviar os comandos; a placa de vídeo executa de forma assíncrona.
+     */
+    struct Tempos {
+        double reduzir;   ///< @brief Redução 1 -> 1/2 -> 1/4.
+        double desfoqueH; ///< @brief Passada horizontal do desfoque.
+        double desfoqueV; ///< @brief Passada vertical do desfoque.
+        double compor;    ///< @brief Composição final no alvo.
+    };
+
+    /**
+     * @brief Construtor da classe PostProcessor.
+     * @param largura Largura da cena em resolução cheia.
+     * @param altura Altura da cena em resolução cheia.
+     */
+    PostProcessor(int largura, int altura);
+
+    /**
+     * @brief Destrutor da classe PostProcessor.
+     * Libera os bitmaps intermediários.
+     */
+    ~PostProcessor();
+
+    PostProcessor(const PostProcessor&) = delete;            ///< @brief Não copiável (possui bitmaps).
+    PostProcessor& operator=(const PostProcessor&) = delete; ///< @brief Não copiável (possui bitmaps).
+
+    /**
+     * @brief Informa se todos os bitmaps intermediários foram criados.
+     * @return false se o efeito não pode ser aplicado (o chamador deve usar o fallback).
+     */
+    bool isValido() const { return metade && quarto && quartoTemp; }
+
+    /**
+     * @brief Aplica o desfoque com fade e desenha o resultado no alvo atual.
+     *
+     * @param cena Bitmap com a cena em resolução cheia.
+     * @param intensidade 0 = cena nítida e sem fade, 1 = totalmente desfocada e preta.
+     * @param larguraDestino Largura da área de destino no alvo atual.
+     * @param alturaDestino Altura da área de destino no alvo atual.
+     */
+    void aplicar(ALLEGRO_BITMAP* cena, float intensidade, float larguraDestino, float alturaDestino);
+
+    /**
+     * @brief Retorna os tempos de cada passada do último efeito aplicado.
+     * @return Referência para os tempos, em milissegundos.
+     */
+    const Tempos& getTempos() const { return tempos; }
+
+private:
+    ALLEGRO_BITMAP* metade;     ///< @brief Cena reduzida para 1/2 da resolução.
+    ALLEGRO_BITMAP* quarto;     ///< @brief Cena reduzida para 1/4 (e resultado final do desfoque).
+    ALLEGRO_BITMAP* quartoTemp; ///< @brief Resultado intermediário da passada horizontal.
+    Tempos tempos;              ///< @brief Tempos do último efeito aplicado.
+
+    /**
+     * @brief Faz uma passada do desfoque gaussiano em uma direção.
+     *
+     * Usa 5 amostras com filtragem linear (equivale a um kernel de 9 pixels),
+     * somadas com blending aditivo.
+     *
+     * @param origem Bitmap lido.
+     * @param destino Bitmap escrito.
+     * @param dx Passo horizontal entre amostras (1 na passada horizontal, 0 na vertical).
+     * @param dy Passo vertical entre amostras (0 na passada horizontal, 1 na vertical).
+     */
+    static void passadaDesfoque(ALLEGRO_BITMAP* origem, ALLEGRO_BITMAP* destino, float dx, float dy);
+};
+
+#endif // POSTPROCESSOR_HPP
@@ -10,19 +10,26 @@
 #include <allegro5/allegro.h>      // Para funcionalidades básicas do Allegro
 #include <vector>                  // Para usar std::vector para a lista de jogadores
 #include <string>                  // Para usar std::string para nomes e textos
-#include <algorithm>               // Para usar std::sort na ordenação do ranking
 #include "PlayerManager.hpp"       // Para acessar os dados dos jogadores
 #include "Player.hpp"              // Para ter a definição da classe Player
 
 /**
  * @brief Gerencia e exibe a tela de ranking de pontuações do jogo.
  *
- * Esta classe é responsável por buscar os dados dos jogadores, ordená-los
- * por pontuação e exibi-los em um formato de ranking na tela, permitindo
- * também a rolagem visual do fundo.
+ * Esta classe é responsável por buscar no ranking do PlayerManager (já em ordem)
+ * só as linhas da janela visível e exibi-las na tela, com a posição do jogador atual.
+ * A janela rola pelas setas, PgUp/PgDn, Home/End e pela roda do mouse, e a tecla M
+ * pula para a posição do jogador; cada composição custa o mesmo com qualquer
+ * quantidade de jogadores (uma busca no ranking e LINHAS_VISIVEIS linhas).
  */
 class RankingScreen {
 public:
+    /// @brief Quantas linhas do ranking cabem no painel.
+    static constexpr size_t LINHAS_VISIVEIS = 10;
+
+    /// @brief Quantas linhas cada passo da roda do mouse rola.
+    static constexpr size_t LINHAS_POR_RODA = 3;
+
     /**
      * @brief Construtor da classe RankingScreen.
      *
@@ -36,6 +43,12 @@ public:
      */
     RankingScreen(ALLEGRO_FONT* font, ALLEGRO_BITMAP* rankingBackground, PlayerManager* pm, int screenW, int screenH);
 
+    /**
+     * @brief Destrutor da classe RankingScreen.
+     * Libera o bitmap com a tela já composta.
+     */
+    ~RankingScreen();
+
     /**
      * @brief Renderiza todos os elementos visuais da tela de ranking.
      *
@@ -47,6 +60,23 @@ public:
      */
     void render(Player* currentPlayer, float deltaTime);
 
+    /**
+     * @brief Informa se a imagem da tela mudou desde o último desenho.
+     *
+     * A tela é composta uma vez em um bitmap e reaproveitada; ela só precisa ser
+     * desenhada de novo quando o jogador destacado muda ou quando os dados do ranking
+     * são invalidados.
+     *
+     * @param currentPlayer O jogador que será destacado (pode ser nullptr).
+     * @return true se a tela precisa ser recomposta.
+     */
+    bool precisaRedesenhar(Player* currentPlayer) const;
+
+    /**
+     * @brief Marca a tela como desatualizada (ex: o ranking mudou depois de uma partida).
+     */
+    void invalidar() { sujo = true; }
+
     /**
      * @brief Atualiza a lógica interna da tela de ranking.
      * Principalmente usada para animar a rolagem do fundo.
@@ -57,13 +87,14 @@ public:
     /**
      * @brief Processa um evento do Allegro específico para a tela de ranking.
      *
-     * Lida com eventos de teclado, como o pressionamento de uma tecla para
-     * retornar ao menu principal.
+     * As teclas de navegação e a roda do mouse rolam a janela; M pula para a posição
+     * do jogador atual; qualquer outra tecla retorna ao menu principal.
      *
      * @param ev O evento Allegro a ser processado.
+     * @param currentPlayer O jogador atual, usado para pular até a posição dele. Pode ser nullptr.
      * @return Um código inteiro indicando a ação desejada: 0 (nenhuma), 1 (voltar ao menu).
      */
-    int handleEvent(ALLEGRO_EVENT ev);
+    int handleEvent(ALLEGRO_EVENT ev, Player* currentPlayer = nullptr);
 
     /**
      * @brief Reseta o estado interno da tela de ranking.
@@ -72,6 +103,30 @@ public:
      */
     void resetState();
 
+    /**
+     * @brief Retorna a posição (a partir de 0) da primeira linha visível.
+     * @return O índice da primeira linha da janela.
+     */
+    size_t getPrimeiraLinha() const { return primeiraLinha; }
+
+    /**
+     * @brief Ajusta o início de uma janela para que ela não passe do fim do ranking.
+     * @param inicio O índice desejado da primeira linha (a partir de 0).
+     * @param total Quantos jogadores há no ranking.
+     * @param linhas Quantas linhas cabem na janela.
+     * @return O início ajustado (0 se todos cabem na janela).
+     */
+    static size_t limitarInicio(size_t inicio, size_t total, size_t linhas);
+
+    /**
+     * @brief Calcula o início da janela que mostra uma posição no meio.
+     * @param posicao A posição no ranking (a partir de 1).
+     * @param total Quantos jogadores há no ranking.
+     * @param linhas Quantas linhas cabem na janela.
+     * @return O índice da primeira linha da janela.
+     */
+    static size_t inicioParaPosicao(size_t posicao, size_t total, size_t linhas);
+
 private:
     ALLEGRO_FONT* font;         ///< @brief Fonte utilizada para desenhar o texto do ranking.
     ALLEGRO_BITMAP* background; ///< @brief (Pode ser uma imagem geral de fundo, se não for a rankingBackground).
@@ -82,6 +137,23 @@ private:
 
     float scrollOffset;         ///< @brief Posição de rolagem do fundo para criar um efeito de movimento contínuo.
     bool waitingForKeyPress;    ///< @brief Flag que indica se a tela está aguardando um pressionamento de tecla para sair.
+
+    ALLEGRO_BITMAP* quadroCache;  ///< @brief A tela inteira já composta, reaproveitada enquanto nada mudar.
+    bool sujo;                    ///< @brief Flag: true se `quadroCache` precisa ser recomposto.
+    Player* jogadorDesenhado;     ///< @brief Jogador destacado na última composição.
+    size_t primeiraLinha;         ///< @brief Índice (a partir de 0) da primeira posição visível.
+
+    /**
+     * @brief Move a janela, marcando a tela para recompor se ela mudou de lugar.
+     * @param inicio O índice desejado da primeira linha.
+     */
+    void rolarPara(size_t inicio);
+
+    /**
+     * @brief Desenha fundo, painel, cabeçalhos e linhas do ranking no alvo atual.
+     * @param currentPlayer O jogador a ser destacado (pode ser nullptr).
+     */
+    void compor(Player* currentPlayer);
 };
 
 #endif // RANKINGSCREEN_HPP
\ No newline at end of file
@@ -0,0 +1,164 @@
+/**
+ * @file RenderQueue.hpp
+ * @brief RenderQueueheader do projeto Traveling Dragon.
+ */
+
+#ifndef RENDERQUEUE_HPP
+#define RENDERQUEUE_HPP
+
+#include <allegro5/allegro.h> // Para ALLEGRO_BITMAP, ALLEGRO_COLOR e desenho de bitmaps
+#include <vector>             // Para usar std::vector (lista de comandos do frame)
+
+/**
+ * @brief Lista de comandos de desenho de um frame, enviada de uma vez no final.
+ *
+ * Em vez de desenhar na hora, os objetos do cenário gravam aqui o que querem
+ * desenhar. Ao gravar, cada comando é comparado com a área visível: o que está
+ * totalmente fora é descartado e o que está parcialmente fora tem o retângulo de
+ * origem recortado, então a placa de vídeo só recebe pixels que aparecem.
+ * No envio, os comandos são ordenados por camada, modo de mistura e textura, e
+ * desenhados com o desenho segurado, o que junta tudo da mesma textura em um lote.
+ *
+ * A ordem entre camadas é sempre respeitada; dentro de uma camada a ordem pode
+ * mudar, então objetos que se sobrepõem devem ficar em camadas diferentes.
+ */
+class RenderQueue {
+public:
+    /**
+     * @brief Camadas do cenário, da mais ao fundo para a mais à frente.
+     */
+    enum Camada {
+        CAMADA_FUNDO = 0,      ///< @brief Imagem de fundo.
+        CAMADA_OBSTACULOS = 1, ///< @brief Canos.
+        CAMADA_PERSONAGEM = 2, ///< @brief O dragão.
+        CAMADA_HUD = 3         ///< @brief Pontuação e textos.
+    };
+
+    /**
+     * @brief Como o comando é misturado com o que já está no alvo.
+     */
+    enum Mistura {
+        MISTURA_ALFA = 0,   ///< @brief Mistura padrão do Allegro (alpha pré-multiplicado).
+        MISTURA_ADITIVA = 1 ///< @brief Soma a cor ao alvo (brilhos, partículas).
+    };
+
+    /**
+     * @brief Construtor da classe RenderQueue.
+     * @param larguraVisivel Largura da área visível (coordenadas de tela).
+     * @param alturaVisivel Altura da área visível (coordenadas de tela).
+     */
+    RenderQueue(float larguraVisivel, float alturaVisivel);
+
+    /**
+     * @brief Grava o desenho de uma região de bitmap em um retângulo de destino.
+     *
+     * Equivale a al_draw_scaled_bitmap. O comando é descartado se o destino estiver
+     * fora da área visível e recortado (origem e destino) se estiver parcialmente fora.
+     *
+     * @param bitmap Bitmap (ou sub-bitmap) a desenhar; nulo é ignorado.
+     * @param camada Camada do comando.
+     * @param sx X da região de origem.
+     * @param sy Y da região de origem.
+     * @param sw Largura da região de origem.
+     * @param sh Altura da região de origem.
+     * @param dx X do destino.
+     * @param dy Y do destino.
+     * @param dw Largura do destino.
+     * @param dh Altura do destino.
+     * @param flags ALLEGRO_FLIP_HORIZONTAL e/ou ALLEGRO_FLIP_VERTICAL.
+     * @param mistura Modo de mistura do comando.
+     */
+    void desenharEscalado(ALLEGRO_BITMAP* bitmap, int camada,
+                          float sx, float sy, float sw, float sh,
+                          float dx, float dy, float dw, float dh,
+                          int flags = 0, Mistura mistura = MISTURA_ALFA);
+
+    /**
+     * @brief Grava o desenho de um bitmap inteiro escalado e rotacionado em torno do centro.
+     *
+     * Equivale a al_draw_scaled_rotated_bitmap com o pivô no centro do bitmap. É
+     * descartado se o círculo que contém o bitmap rotacionado estiver fora da área
+     * visível; não há recorte (a rotação tornaria o recorte inexato).
+     *
+     * @param bitmap Bitmap a desenhar; nulo é ignorado.
+     * @param camada Camada do comando.
+     * @param centroX X do centro do desenho na tela.
+     * @param centroY Y do centro do desenho na tela.
+     * @param largura Largura final na tela.
+     * @param altura Altura final na tela.
+     * @param angulo Ângulo em radianos.
+     */
+    void desenharRotacionado(ALLEGRO_BITMAP* bitmap, int camada, float centroX, float centroY,
+                             float largura, float altura, float angulo);
+
+    /**
+     * @brief Grava um retângulo preenchido (usado pelos fallbacks sem sprite).
+     * Retângulos sempre quebram o lote, pois não podem ser desenhados com o desenho segurado.
+     */
+    void desenharRetangulo(int camada, float x1, float y1, float x2, float y2, ALLEGRO_COLOR cor);
+
+    /**
+     * @brief Ordena e desenha todos os comandos gravados no alvo atual e esvazia a lista.
+     */
+    void enviar();
+
+    /**
+     * @brief Retorna quantos comandos foram enviados no último `enviar()`.
+     * @return O número de comandos desenhados.
+     */
+    int getEnviados() const { return enviados; }
+
+    /**
+     * @brief Retorna quantos comandos foram descartados por estarem fora da tela desde o último `enviar()`.
+     * @return O número de comandos descartados.
+     */
+    int getDescartados() const { return descartadosUltimoEnvio; }
+
+    /**
+     * @brief Recorta um intervalo de destino [d, d + tamanho] ao intervalo visível [0, limite].
+     *
+     * A origem correspondente é ajustada na mesma proporção; com `espelhado`, o corte do
+     * início do destino sai do fim da origem (o desenho está invertido nesse eixo).
+     *
+     * @param d Início do destino (atualizado).
+     * @param tamanho Tamanho do destino (atualizado).
+     * @param s Início da origem (atualizado).
+     * @param tamanhoOrigem Tamanho da origem (atualizado).
+     * @param limite Tamanho da área visível nesse eixo.
+     * @param espelhado true se o desenho está invertido nesse eixo.
+     * @return false se não sobrou nada visível.
+     */
+    static bool recortarEixo(float& d, float& tamanho, float& s, float& tamanhoOrigem, float limite, bool espelhado);
+
+private:
+    /**
+     * @brief Um comando de desenho gravado.
+     */
+    struct Comando {
+        ALLEGRO_BITMAP* bitmap;  ///< @brief Bitmap desenhado (nulo para retângulo).
+        ALLEGRO_BITMAP* textura; ///< @brief Textura raiz do bitmap, usada na ordenação.
+        int camada;              ///< @brief Camada do comando.
+        Mistura mistura;         ///< @brief Modo de mistura.
+        float sx, sy, sw, sh;    ///< @brief Região de origem (ou retângulo x1, y1, x2, y2 nos comandos sem bitmap).
+        float cx, cy;            ///< @brief Pivô dentro da região de origem.
+        float dx, dy;            ///< @brief Posição do pivô na tela.
+        float escalaX, escalaY;  ///< @brief Escala aplicada à região de origem.
+        float angulo;            ///< @brief Rotação em radianos.
+        int flags;               ///< @brief Flags de espelhamento.
+        ALLEGRO_COLOR cor;       ///< @brief Tinta do bitmap ou cor do retângulo.
+    };
+
+    std::vector<Comando> comandos; ///< @brief Comandos do frame atual (a capacidade é reaproveitada entre frames).
+    float larguraVisivel;          ///< @brief Largura da área visível.
+    float alturaVisivel;           ///< @brief Altura da área visível.
+    int enviados;                  ///< @brief Comandos desenhados no último envio.
+    int descartados;               ///< @brief Comandos descartados no frame atual.
+    int descartadosUltimoEnvio;    ///< @brief Comandos descartados no frame do último envio.
+
+    /**
+     * @brief Aplica o blender correspondente ao modo de mistura.
+     */
+    static void aplicarMistura(Mistura mistura);
+};
+
+#endif // RENDERQUEUE_HPP
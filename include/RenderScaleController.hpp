@@ -0,0 +1,91 @@
+/**
+ * @file RenderScaleController.hpp
+ * @brief RenderScaleControllerheader do projeto Traveling Dragon.
+ */
+
+#ifndef RENDERSCALECONTROLLER_HPP
+#define RENDERSCALECONTROLLER_HPP
+
+/**
+ * @brief Ajusta a escala de renderização para manter um tempo de frame alvo.
+ *
+ * Recebe a duração de cada frame desenhado e, a cada janela de frames, compara a
+ * média com o alvo: se o jogo está lento a escala cai um passo; se está folgado por
+ * várias janelas seguidas, ela sobe um passo. Depois de uma queda, a escala que
+ * falhou só volta a ser tentada após uma espera maior, para não ficar oscilando
+ * entre dois valores.
+ */
+class RenderScaleController {
+public:
+    /// @brief Quantidade de frames em cada janela de medição.
+    static const int FRAMES_POR_JANELA = 30;
+    /// @brief Janelas folgadas seguidas necessárias para subir a escala.
+    static const int JANELAS_PARA_SUBIR = 4;
+    /// @brief Janelas extras de espera antes de tentar de novo uma escala que falhou.
+    static const int JANELAS_ESPERA_APOS_FALHA = 20;
+
+    /**
+     * @brief Construtor da classe RenderScaleController.
+     * @param minimo Menor escala permitida.
+     * @param maximo Maior escala permitida.
+     * @param passo Quanto a escala muda em cada ajuste.
+     * @param alvoMs Tempo de frame que se quer manter, em milissegundos.
+     */
+    RenderScaleController(float minimo, float maximo, float passo, double alvoMs);
+
+    /**
+     * @brief Define a escala atual e descarta as medições em andamento.
+     * @param escala A escala inicial (limitada ao intervalo).
+     */
+    void setEscala(float escala);
+
+    /**
+     * @brief Retorna a escala atual.
+     * @return A escala de renderização.
+     */
+    float getEscala() const { return escala; }
+
+    /**
+     * @brief Define o tempo de frame alvo.
+     * @param ms O novo alvo em milissegundos.
+     */
+    void setAlvoMs(double ms) { alvoMs = ms; }
+
+    /**
+     * @brief Retorna a média de tempo de frame da última janela completa.
+     * @return A média em milissegundos (0 antes da primeira janela).
+     */
+    double getMediaMs() const { return mediaMs; }
+
+    /**
+     * @brief Registra a duração de um frame desenhado.
+     *
+     * Durações muito longas (janela arrastada, tela estática que não redesenha)
+     * não dizem nada sobre o custo de desenho e são descartadas.
+     *
+     * @param duracaoMs Tempo entre este frame e o anterior, em milissegundos.
+     * @return true se a escala mudou com este frame.
+     */
+    bool registrarQuadro(double duracaoMs);
+
+    /**
+     * @brief Descarta a janela de medição em andamento (ex: ao sair do gameplay).
+     */
+    void reiniciarMedicao();
+
+private:
+    float minimo;          ///< @brief Menor escala permitida.
+    float maximo;          ///< @brief Maior escala permitida.
+    float passo;           ///< @brief Tamanho de cada ajuste.
+    double alvoMs;         ///< @brief Tempo de frame alvo.
+    float escala;          ///< @brief Escala atual.
+
+    double somaJanela;     ///< @brief Soma das durações da janela em andamento.
+    int framesJanela;      ///< @brief Frames registrados na janela em andamento.
+    double mediaMs;        ///< @brief Média da última janela completa.
+    int janelasFolgadas;   ///< @brief Janelas seguidas abaixo do alvo.
+    float escalaQueFalhou; ///< @brief Última escala que ficou acima do alvo (0 se nenhuma).
+    int esperaFalha;       ///< @brief Janelas que ainda faltam para tentar `escalaQueFalhou` de novo.
+};
+
+#endif // RENDERSCALECONTROLLER_HPP
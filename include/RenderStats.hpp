@@ -0,0 +1,78 @@
+/**
+ * @file RenderStats.hpp
+ * @brief RenderStatsheader do projeto Traveling Dragon.
+ */
+
+#ifndef RENDERSTATS_HPP
+#define RENDERSTATS_HPP
+
+#include <allegro5/allegro.h> // Para ALLEGRO_BITMAP e al_hold_bitmap_drawing
+
+/**
+ * @brief Contadores de desenho por frame, usados no HUD de depuração (F3).
+ *
+ * Cada desenho instrumentado conta como uma chamada. Um "lote" é uma sequência de
+ * desenhos que o Allegro consegue enviar de uma vez: isso só acontece enquanto o
+ * desenho está segurado (al_hold_bitmap_drawing) e a textura raiz não muda.
+ * Fora disso, cada desenho é um lote próprio.
+ */
+class RenderStats {
+public:
+    /**
+     * @brief Fecha o frame anterior e zera os contadores do frame atual.
+     * Deve ser chamado uma vez no início de cada frame renderizado.
+     */
+    static void iniciarQuadro();
+
+    /**
+     * @brief Registra o desenho de um bitmap (ou sub-bitmap).
+     * @param bitmap O bitmap desenhado; o lote é decidido pela textura raiz dele.
+     */
+    static void registrarDesenho(ALLEGRO_BITMAP* bitmap);
+
+    /**
+     * @brief Registra um desenho que sempre quebra o lote (primitivas, texto fora do cache, limpeza de tela).
+     */
+    static void registrarPrimitiva();
+
+    /**
+     * @brief Registra um desenho descartado por estar fora da área visível.
+     */
+    static void registrarDescarte() { ++descartes; }
+
+    /**
+     * @brief Liga ou desliga o desenho segurado, mantendo os contadores coerentes.
+     * Use no lugar de chamar al_hold_bitmap_drawing diretamente.
+     * @param segurar true para começar a agrupar desenhos, false para enviá-los.
+     */
+    static void segurarDesenho(bool segurar);
+
+    /**
+     * @brief Retorna o número de desenhos do último frame completo.
+     * @return As chamadas de desenho registradas no frame anterior.
+     */
+    static int getDesenhos() { return desenhosQuadroAnterior; }
+
+    /**
+     * @brief Retorna o número de lotes do último frame completo.
+     * @return Os lotes enviados à placa de vídeo no frame anterior.
+     */
+    static int getLotes() { return lotesQuadroAnterior; }
+
+    /**
+     * @brief Retorna o número de desenhos descartados (fora da tela) no último frame completo.
+     * @return Os desenhos que nem chegaram à placa de vídeo no frame anterior.
+     */
+    static int getDescartes() { return descartesQuadroAnterior; }
+
+private:
+    static int desenhos;                    ///< @brief Desenhos registrados no frame atual.
+    static int lotes;                       ///< @brief Lotes registrados no frame atual.
+    static int desenhosQuadroAnterior;      ///< @brief Desenhos do último frame completo.
+    static int lotesQuadroAnterior;         ///< @brief Lotes do último frame completo.
+    static int descartes;                   ///< @brief Desenhos descartados no frame atual.
+    static int descartesQuadroAnterior;     ///< @brief Desenhos descartados no último frame completo.
+    static ALLEGRO_BITMAP* texturaAtual;    ///< @brief Textura raiz do lote em andamento (nulo se não há lote aberto).
+};
+
+#endif // RENDERSTATS_HPP
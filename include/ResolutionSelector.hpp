@@ -6,6 +6,8 @@
 #ifndef RESOLUTION_SELECTOR_HPP
 #define RESOLUTION_SELECTOR_HPP
 
+#include <allegro5/allegro.h>      // Para ALLEGRO_DISPLAY e ALLEGRO_EVENT_QUEUE
+#include <allegro5/allegro_font.h> // Para ALLEGRO_FONT
 #include <string>     // Para usar std::string
 #include <optional>   // Para usar std::optional, que permite retornar um valor ou a ausência dele
 
@@ -31,12 +33,20 @@ struct ResolutionConfig {
  * @brief Exibe uma interface para o usuário selecionar a resolução e o modo de janela.
  *
  * Esta função interage com o usuário para que ele escolha as configurações de vídeo
- * preferidas antes de iniciar o jogo principal.
+ * preferidas. Ela roda dentro do display do jogo (que é colocado em uma janela do
+ * tamanho do seletor) e usa a fila de eventos dele, então pode ser chamada de novo
+ * durante o jogo para trocar a resolução sem reinicializar o Allegro. Quem chama
+ * aplica o modo escolhido no display depois.
  *
+ * @param display O display do jogo.
+ * @param queue A fila de eventos do jogo (com teclado, mouse e o display registrados).
+ * @param font Fonte usada nas opções.
+ * @param atual Configuração destacada ao abrir (a que está em uso).
  * @return Um `std::optional<ResolutionConfig>`. Se o usuário selecionar uma configuração,
  * retorna um objeto `ResolutionConfig`. Se o usuário cancelar ou fechar o seletor,
  * retorna `std::nullopt` (indicando que nenhuma configuração foi selecionada).
  */
-std::optional<ResolutionConfig> showResolutionSelector();
+std::optional<ResolutionConfig> showResolutionSelector(ALLEGRO_DISPLAY* display, ALLEGRO_EVENT_QUEUE* queue,
+                                                       ALLEGRO_FONT* font, const ResolutionConfig& atual);
 
 #endif
\ No newline at end of file
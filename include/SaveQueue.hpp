@@ -0,0 +1,125 @@
+/**
+ * @file SaveQueue.hpp
+ * @brief SaveQueueheader do projeto Traveling Dragon.
+ */
+
+#ifndef SAVEQUEUE_HPP
+#define SAVEQUEUE_HPP
+
+#include <allegro5/allegro.h> // Para a thread de gravação, o mutex e as variáveis de condição
+#include <chrono>             // Para medir a latência das gravações
+#include <cstddef>            // Para size_t
+#include <deque>              // Para usar std::deque (fila de tarefas)
+#include <string>             // Para usar std::string (caminhos)
+#include <vector>             // Para usar std::vector (bytes de cada tarefa)
+
+/**
+ * @brief Fila de gravações em disco executadas por uma thread, fora da thread do jogo.
+ *
+ * Quem grava só entrega os bytes a acrescentar em um arquivo e segue em frente; a
+ * thread escreve e faz o fsync. Quando várias gravações chegam juntas, a thread espera
+ * um instante e junta todas: as do mesmo arquivo viram uma única escrita e um único
+ * fsync. A fila é limitada em bytes: cheia, quem entrega espera a thread esvaziá-la
+ * (e a espera é contada), em vez de a memória crescer sem limite com um disco lento.
+ *
+ * O tempo entre entregar uma gravação e ela estar no disco é medido por lote e fica
+ * nas estatísticas, separado do tempo de frame. `descarregar` (e o destrutor) espera
+ * tudo o que foi entregue estar gravado: nada se perde ao sair do jogo.
+ */
+class SaveQueue {
+public:
+    /**
+     * @brief Contadores da fila, para o HUD de depuração e o console.
+     */
+    struct Estatisticas {
+        int tarefas = 0;              ///< @brief Gravações entregues.
+        int lotes = 0;                ///< @brief Lotes gravados pela thread (cada um com um fsync por arquivo).
+        int esperas = 0;              ///< @brief Vezes em que quem entregou esperou a fila ter espaço.
+        int falhas = 0;               ///< @brief Gravações que não puderam ser feitas.
+        double ultimaLatenciaMs = 0;  ///< @brief Da entrega ao fsync, no último lote.
+        double maiorLatenciaMs = 0;   ///< @brief Maior latência de um lote.
+    };
+
+    /// @brief Limite padrão de bytes esperando na fila.
+    static constexpr size_t LIMITE_PADRAO = 4 * 1024 * 1024;
+
+    /**
+     * @brief Construtor da classe SaveQueue. A thread só é criada na primeira gravação.
+     * @param limiteBytes Bytes que podem esperar na fila antes de quem entrega ter de esperar.
+     * @param esperaGrupoMs Tempo que a thread espera para juntar as gravações de uma rajada.
+     */
+    explicit SaveQueue(size_t limiteBytes = LIMITE_PADRAO, int esperaGrupoMs = 50);
+
+    /**
+     * @brief Destrutor da classe SaveQueue. Grava tudo o que ainda estiver na fila.
+     */
+    ~SaveQueue();
+
+    SaveQueue(const SaveQueue&) = delete;            ///< @brief Não copiável (possui a thread).
+    SaveQueue& operator=(const SaveQueue&) = delete; ///< @brief Não copiável (possui a thread).
+
+    /**
+     * @brief Entrega bytes para serem acrescentados ao fim de um arquivo (a pasta é criada se preciso).
+     * A thread acrescenta com a trava exclusiva `<caminho>.lock` (a mesma do MatchHistory).
+     * Retorna assim que os bytes entram na fila, a não ser que ela esteja cheia.
+     * @param caminho Caminho do arquivo.
+     * @param dados Os bytes.
+     */
+    void acrescentar(const std::string& caminho, std::vector<unsigned char> dados);
+
+    /**
+     * @brief Espera todas as gravações entregues até agora estarem no disco.
+     */
+    void descarregar();
+
+    /**
+     * @brief Retorna uma cópia dos contadores.
+     * @return As estatísticas.
+     */
+    Estatisticas getEstatisticas() const;
+
+private:
+    /// @brief Relógio usado na latência.
+    using Relogio = std::chrono::steady_clock;
+
+    /**
+     * @brief Uma gravação entregue.
+     */
+    struct Tarefa {
+        std::string caminho;              ///< @brief Arquivo de destino.
+        std::vector<unsigned char> dados; ///< @brief Bytes a acrescentar.
+        Relogio::time_point entrada;      ///< @brief Momento da entrega.
+    };
+
+    size_t limiteBytes;          ///< @brief Bytes que podem esperar na fila.
+    int esperaGrupoMs;           ///< @brief Espera para juntar uma rajada, em milissegundos.
+    std::deque<Tarefa> fila;     ///< @brief Gravações esperando a thread.
+    size_t bytesNaFila;          ///< @brief Soma dos bytes na fila.
+    bool gravando;               ///< @brief Flag: true enquanto a thread grava um lote.
+    bool encerrando;             ///< @brief Flag: true quando a thread deve gravar o resto e sair.
+    Estatisticas estatisticas;   ///< @brief Contadores (protegidos por `mutex`).
+
+    ALLEGRO_MUTEX* mutex;        ///< @brief Protege a fila, as flags e os contadores.
+    ALLEGRO_COND* haTarefas;     ///< @brief Sinaliza a thread que a fila tem gravações.
+    ALLEGRO_COND* filaLivre;     ///< @brief Sinaliza quem espera que a fila esvaziou (ou ganhou espaço).
+    ALLEGRO_THREAD* escritor;    ///< @brief Thread de gravação (nula até a primeira gravação).
+    bool semThread;              ///< @brief Flag: true se a thread não pôde ser criada (grava na hora).
+
+    /**
+     * @brief Grava um lote: as tarefas seguidas do mesmo arquivo viram uma escrita e um fsync.
+     * Não pode ser chamada com `mutex` travado.
+     * @param lote As tarefas, na ordem de entrega.
+     * @return Quantas tarefas falharam.
+     */
+    static int gravarLote(const std::vector<Tarefa>& lote);
+
+    /**
+     * @brief Laço da thread de gravação.
+     * @param thread A thread atual (não usada).
+     * @param arg Ponteiro para a SaveQueue.
+     * @return Sempre nullptr.
+     */
+    static void* executarEscritor(ALLEGRO_THREAD* thread, void* arg);
+};
+
+#endif // SAVEQUEUE_HPP
@@ -0,0 +1,193 @@
+/**
+ * @file ScaledAssetCache.hpp
+ * @brief ScaledAssetCacheheader do projeto Traveling Dragon.
+ */
+
+#ifndef SCALEDASSETCACHE_HPP
+#define SCALEDASSETCACHE_HPP
+
+#include <allegro5/allegro.h> // Para ALLEGRO_BITMAP e acesso aos pixels
+#include <atomic>             // Para std::atomic (contadores usados por várias threads)
+#include <cstdint>            // Para tipos de tamanho fixo (hash e pixels)
+#include <string>             // Para usar std::string (caminhos e chaves)
+#include <vector>             // Para usar std::vector (buffers de pixels)
+#include "AssetArchive.hpp"   // Leitura dos originais direto do pacote de assets
+
+/**
+ * @brief Carrega imagens já redimensionadas para o tamanho exato em que aparecem na tela.
+ *
+ * Os assets originais são muito maiores que a tela (fundos de 2304x1296, canos de
+ * 538x3310 desenhados a 25%). Em vez de reduzi-los a cada frame na placa de vídeo,
+ * esta classe faz a redução uma única vez no carregamento, com filtro de área
+ * (média de todos os pixels cobertos), e grava o resultado em disco. Nas próximas
+ * execuções com a mesma resolução, a imagem reduzida é lida direto do cache.
+ *
+ * A chave do cache combina o hash do conteúdo do arquivo original com o tamanho
+ * pedido, então trocar o asset ou a resolução gera uma entrada nova automaticamente
+ * (e o PNG volta a ser decodificado). Os pixels são gravados já decodificados, com
+ * compressão LZ4 quando ela economiza espaço, e lidos de volta com uma única leitura.
+ *
+ * O trabalho é dividido em duas etapas: `preparar*` (ler, decodificar e reduzir,
+ * só na memória comum) pode rodar em qualquer thread; `criarBitmap` (envio para a
+ * placa de vídeo) precisa rodar na thread que tem o display.
+ */
+class ScaledAssetCache {
+public:
+    /**
+     * @brief Imagem RGBA (8 bits por canal) já reduzida, pronta para ir para a placa de vídeo.
+     */
+    struct Pixels {
+        std::vector<unsigned char> rgba; ///< @brief Pixels, linha a linha (largura * altura * 4 bytes).
+        int largura = 0;                 ///< @brief Largura da imagem.
+        int altura = 0;                  ///< @brief Altura da imagem.
+    };
+
+    /**
+     * @brief Construtor da classe ScaledAssetCache.
+     * @param diretorio Pasta onde os arquivos de cache são gravados (criada se não existir).
+     * @param pacote Pacote de onde os originais são lidos (nulo = só arquivos soltos).
+     */
+    explicit ScaledAssetCache(const std::string& diretorio, const AssetArchive* pacote = nullptr);
+
+    /**
+     * @brief Carrega uma imagem reduzida para cobrir a tela inteira, mantendo a proporção.
+     *
+     * Corresponde ao desenho "preencher" usado nos fundos: escala = max(telaW/w, telaH/h).
+     *
+     * @param caminho Caminho do asset original.
+     * @param telaW Largura da tela.
+     * @param telaH Altura da tela.
+     * @return O bitmap redimensionado, ou nullptr se o asset não puder ser carregado.
+     */
+    ALLEGRO_BITMAP* carregarPreenchendo(const std::string& caminho, int telaW, int telaH);
+
+    /**
+     * @brief Carrega uma imagem reduzida por um fator fixo (ex: 0.25 para os canos).
+     * @param caminho Caminho do asset original.
+     * @param escala Fator aplicado à largura e à altura originais.
+     * @return O bitmap redimensionado, ou nullptr se o asset não puder ser carregado.
+     */
+    ALLEGRO_BITMAP* carregarComEscala(const std::string& caminho, float escala);
+
+    /**
+     * @brief Versão de `carregarPreenchendo` que para antes do envio à placa de vídeo.
+     * Pode ser chamada de uma thread de carregamento.
+     * @param caminho Caminho do asset original.
+     * @param telaW Largura da tela.
+     * @param telaH Altura da tela.
+     * @param saida Recebe os pixels reduzidos.
+     * @return true se a imagem foi preparada.
+     */
+    bool prepararPreenchendo(const std::string& caminho, int telaW, int telaH, Pixels& saida);
+
+    /**
+     * @brief Versão de `carregarComEscala` que para antes do envio à placa de vídeo.
+     * Pode ser chamada de uma thread de carregamento.
+     * @param caminho Caminho do asset original.
+     * @param escala Fator aplicado à largura e à altura originais.
+     * @param saida Recebe os pixels reduzidos.
+     * @return true se a imagem foi preparada.
+     */
+    bool prepararComEscala(const std::string& caminho, float escala, Pixels& saida);
+
+    /**
+     * @brief Cria um bitmap (com os parâmetros atuais, normalmente de vídeo) a partir de pixels preparados.
+     * Deve ser chamada na thread do display.
+     * @param pixels Imagem preparada.
+     * @return O bitmap criado, ou nullptr em caso de falha.
+     */
+    static ALLEGRO_BITMAP* criarBitmap(const Pixels& pixels);
+
+    /**
+     * @brief Retorna quantas imagens foram lidas direto do cache em disco.
+     * @return O número de acertos de cache.
+     */
+    int getAcertos() const { return acertos; }
+
+    /**
+     * @brief Retorna quantas imagens precisaram ser redimensionadas (e gravadas no cache).
+     * @return O número de imagens geradas.
+     */
+    int getGeradas() const { return geradas; }
+
+    /**
+     * @brief Retorna o tempo total gasto com as imagens lidas do cache (hash + leitura + descompressão).
+     * Somado entre as threads, então pode passar do tempo real de carregamento.
+     * @return O tempo, em milissegundos.
+     */
+    double getMsAcertos() const { return usAcertos / 1000.0; }
+
+    /**
+     * @brief Retorna o tempo total gasto com as imagens geradas (decodificação do PNG + redução + gravação).
+     * @return O tempo, em milissegundos.
+     */
+    double getMsGeradas() const { return usGeradas / 1000.0; }
+
+    /**
+     * @brief Calcula o hash FNV-1a de 64 bits de um bloco de bytes.
+     * @param dados Ponteiro para os bytes.
+     * @param tamanho Quantidade de bytes.
+     * @return O hash calculado.
+     */
+    static uint64_t hashFnv1a(const unsigned char* dados, size_t tamanho);
+
+    /**
+     * @brief Redimensiona uma imagem RGBA (8 bits por canal) usando filtro de área.
+     *
+     * Cada pixel de destino é a média ponderada de todos os pixels de origem que ele
+     * cobre. A origem vem do Allegro com a cor pré-multiplicada pelo alpha, e os quatro
+     * canais são somados com o mesmo peso, sem dividir pelo alpha no fim: a saída
+     * continua pré-multiplicada (cor nunca maior que o alpha), pronta para o bitmap,
+     * e as bordas semitransparentes não escurecem nem ficam com contorno claro.
+     *
+     * @param origem Pixels de origem, com alpha pré-multiplicado (largura * altura * 4 bytes).
+     * @param larguraOrigem Largura da origem.
+     * @param alturaOrigem Altura da origem.
+     * @param larguraDestino Largura desejada.
+     * @param alturaDestino Altura desejada.
+     * @return Os pixels redimensionados, com alpha pré-multiplicado (larguraDestino * alturaDestino * 4 bytes).
+     */
+    static std::vector<unsigned char> reamostrar(const std::vector<unsigned char>& origem,
+                                                 int larguraOrigem, int alturaOrigem,
+                                                 int larguraDestino, int alturaDestino);
+
+private:
+    std::string diretorio;    ///< @brief Pasta dos arquivos de cache.
+    const AssetArchive* pacote; ///< @brief Pacote dos originais (pode ser nulo).
+    std::atomic<int> acertos; ///< @brief Imagens lidas do cache.
+    std::atomic<int> geradas; ///< @brief Imagens redimensionadas nesta execução.
+    std::atomic<long long> usAcertos; ///< @brief Tempo das imagens lidas do cache, em microssegundos.
+    std::atomic<long long> usGeradas; ///< @brief Tempo das imagens geradas, em microssegundos.
+
+    /**
+     * @brief Prepara (do cache ou do original) uma imagem no tamanho calculado.
+     * @param caminho Caminho do asset original.
+     * @param sufixoChave Parte da chave que descreve o ajuste pedido (ex: "fill1280x720").
+     * @param telaW Largura da tela (modo preencher) ou 0 para escala fixa.
+     * @param telaH Altura da tela (modo preencher) ou 0 para escala fixa.
+     * @param escala Fator de escala fixo (usado quando telaW/telaH são 0).
+     * @param saida Recebe os pixels reduzidos.
+     * @return true se a imagem foi preparada.
+     */
+    bool preparar(const std::string& caminho, const std::string& sufixoChave,
+                  int telaW, int telaH, float escala, Pixels& saida);
+
+    /**
+     * @brief Lê um arquivo de cache.
+     * @param arquivo Caminho do arquivo de cache.
+     * @param saida Recebe os pixels lidos.
+     * @return false se o arquivo não existir ou estiver inválido.
+     */
+    static bool lerCache(const std::string& arquivo, Pixels& saida);
+
+    /**
+     * @brief Grava os pixels redimensionados em um arquivo de cache.
+     * @param arquivo Caminho do arquivo de cache.
+     * @param pixels Pixels RGBA.
+     * @param largura Largura da imagem.
+     * @param altura Altura da imagem.
+     */
+    static void gravarCache(const std::string& arquivo, const std::vector<unsigned char>& pixels, int largura, int altura);
+};
+
+#endif // SCALEDASSETCACHE_HPP
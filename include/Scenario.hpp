@@ -8,6 +8,7 @@
 
 #include "Bird.hpp"          // Para usar a classe Bird (o personagem do jogador)
 #include "Pipe.hpp"          // Para usar a classe Pipe (os obstáculos)
+#include "OutlinedTextCache.hpp" // Para desenhar a pontuação com contorno sem redesenhá-la 49 vezes
 #include <allegro5/allegro_font.h> // Para renderizar texto (como a pontuação)
 #include <allegro5/allegro.h>      // Para funcionalidades básicas do Allegro
 #include <allegro5/allegro_audio.h> // Para tocar sons (ponto, morte)
@@ -164,6 +165,8 @@ private:
     ALLEGRO_SAMPLE* somPoint;       ///< @brief O sample de áudio para o som de pontuação.
     ALLEGRO_SAMPLE* somDie;         ///< @brief O sample de áudio para o som de morte do pássaro.
     bool scoredPointFlag;           ///< @brief Flag que é ativada quando um ponto é marcado, para tocar o som uma vez.
+    OutlinedTextCache textCache;    ///< @brief Cache do texto da pontuação já rasterizado com contorno.
+    RenderQueue filaDesenho;        ///< @brief Comandos de desenho do frame (fundo, canos, pássaro e pontuação).
 
     /**
      * @brief Verifica se houve colisão entre o pássaro e um cano específico.
@@ -0,0 +1,114 @@
+/**
+ * @file ScoreHistogram.hpp
+ * @brief ScoreHistogramheader do projeto Traveling Dragon.
+ */
+
+#ifndef SCOREHISTOGRAM_HPP
+#define SCOREHISTOGRAM_HPP
+
+#include <cstddef> // Para size_t
+#include <cstdint> // Para contagens de 64 bits
+#include <string>  // Para o caminho do arquivo
+#include <vector>  // Para os baldes
+
+/**
+ * @brief Histograma de pontuações com memória fixa, para responder "você superou X%".
+ *
+ * As pontuações de 0 a LIMITE_EXATO - 1 têm um balde cada (contagem exata); acima
+ * disso, cada potência de 2 é dividida em SUBDIVISOES baldes (erro relativo de até
+ * 1/SUBDIVISOES), até o maior int. São BALDES contadores no total, não importa
+ * quantas pontuações entraram.
+ *
+ * Os baldes ficam também em uma árvore de Fenwick: acrescentar, remover e contar
+ * quantas pontuações estão abaixo de um valor custam O(log BALDES), um número fixo
+ * de passos (uns 12) que não cresce com as partidas registradas.
+ */
+class ScoreHistogram {
+public:
+    /// @brief Pontuações abaixo deste valor são contadas uma a uma.
+    static constexpr int LIMITE_EXATO = 1024;
+    /// @brief Baldes por potência de 2 acima de LIMITE_EXATO.
+    static constexpr int SUBDIVISOES = 64;
+    /// @brief Total de baldes (exatos + 21 potências de 2, de 2^10 a 2^30).
+    static constexpr int BALDES = LIMITE_EXATO + 21 * SUBDIVISOES;
+
+    /**
+     * @brief Construtor da classe ScoreHistogram. Começa vazio.
+     */
+    ScoreHistogram();
+
+    /**
+     * @brief Zera todas as contagens.
+     */
+    void limpar();
+
+    /**
+     * @brief Conta uma pontuação (negativas contam como 0).
+     * @param pontuacao A pontuação.
+     */
+    void adicionar(int pontuacao);
+
+    /**
+     * @brief Descarta uma pontuação contada antes (ex: o recorde antigo de um jogador).
+     * @param pontuacao A pontuação.
+     */
+    void remover(int pontuacao);
+
+    /**
+     * @brief Retorna quantas pontuações foram contadas.
+     * @return O total.
+     */
+    uint64_t getTotal() const { return total; }
+
+    /**
+     * @brief Conta as pontuações menores que um valor.
+     * Exata abaixo de LIMITE_EXATO; acima, não conta as do mesmo balde.
+     * @param pontuacao O valor.
+     * @return Quantas pontuações estão abaixo dele.
+     */
+    uint64_t contarAbaixo(int pontuacao) const;
+
+    /**
+     * @brief Calcula a porcentagem das pontuações que ficaram abaixo de um valor.
+     * @param pontuacao O valor.
+     * @return De 0 a 100 (0 com o histograma vazio).
+     */
+    double percentualAbaixo(int pontuacao) const;
+
+    /**
+     * @brief Grava as contagens (só os baldes não vazios) em um arquivo temporário e o renomeia por cima do anterior.
+     * @param caminho O arquivo.
+     * @param seq O número de sequência do diário até onde as contagens vão.
+     * @return true se o arquivo foi gravado.
+     */
+    bool gravar(const std::string& caminho, uint64_t seq) const;
+
+    /**
+     * @brief Lê as contagens gravadas por `gravar`, substituindo as atuais.
+     * @param caminho O arquivo.
+     * @param seq Recebe o número de sequência gravado (0 se o arquivo não existe ou é inválido).
+     * @return false se o arquivo não existe ou é inválido (o histograma fica vazio).
+     */
+    bool ler(const std::string& caminho, uint64_t& seq);
+
+    /**
+     * @brief Calcula o balde de uma pontuação.
+     * @param pontuacao A pontuação.
+     * @return O índice do balde, de 0 a BALDES - 1.
+     */
+    static int balde(int pontuacao);
+
+private:
+    std::vector<uint64_t> contagens; ///< @brief Pontuações em cada balde.
+    std::vector<uint64_t> arvore;    ///< @brief Árvore de Fenwick sobre `contagens` (índices a partir de 1).
+    uint64_t total;                  ///< @brief Soma de todas as contagens.
+
+    /**
+     * @brief Soma uma quantidade a um balde, na contagem e na árvore.
+     * @param indice O balde.
+     * @param quantidade O valor somado (pode ser negativo).
+     */
+    void somar(int indice, int64_t quantidade);
+};
+
+#endif // SCOREHISTOGRAM_HPP
@@ -0,0 +1,92 @@
+/**
+ * @file TextureAtlas.hpp
+ * @brief TextureAtlasheader do projeto Traveling Dragon.
+ */
+
+#ifndef TEXTUREATLAS_HPP
+#define TEXTUREATLAS_HPP
+
+#include <allegro5/allegro.h> // Para ALLEGRO_BITMAP e funções de desenho
+#include <vector>             // Para usar std::vector (páginas e sprites registrados)
+
+/**
+ * @brief Empacota vários sprites em poucas texturas grandes (atlas).
+ *
+ * Os sprites registrados são copiados para uma ou mais páginas e substituídos por
+ * sub-bitmaps dessas páginas. Como todos passam a compartilhar a mesma textura,
+ * o Allegro consegue agrupar os desenhos consecutivos em um único lote quando o
+ * desenho está "segurado" (al_hold_bitmap_drawing).
+ *
+ * O uso é em duas etapas: `adicionar()` registra o endereço de cada ponteiro de
+ * bitmap e `construir()` faz o empacotamento e troca os ponteiros pelos sub-bitmaps.
+ * A partir daí o atlas é dono de todos os sprites registrados.
+ */
+class TextureAtlas {
+public:
+    /**
+     * @brief Construtor da classe TextureAtlas.
+     * @param tamanhoMaximo Lado máximo de uma página (limitado também pelo que a placa de vídeo suporta).
+     * @param espacamento Pixels vazios entre sprites, para evitar que a filtragem misture vizinhos.
+     */
+    explicit TextureAtlas(int tamanhoMaximo = 4096, int espacamento = 1);
+
+    /**
+     * @brief Destrutor da classe TextureAtlas.
+     * Libera os sub-bitmaps, as páginas e os sprites que ficaram fora do atlas.
+     */
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;            ///< @brief Não copiável (possui bitmaps).
+    TextureAtlas& operator=(const TextureAtlas&) = delete; ///< @brief Não copiável (possui bitmaps).
+
+    /**
+     * @brief Registra um sprite para ser empacotado.
+     *
+     * O atlas passa a ser dono do bitmap apontado. Após `construir()`, `*slot`
+     * aponta para o sub-bitmap equivalente dentro do atlas.
+     *
+     * @param slot Endereço do ponteiro do bitmap (ignorado se nulo ou se apontar para nulo).
+     */
+    void adicionar(ALLEGRO_BITMAP** slot);
+
+    /**
+     * @brief Empacota todos os sprites registrados nas páginas do atlas.
+     *
+     * Os sprites são ordenados por altura e distribuídos em prateleiras. Sprites
+     * maiores que uma página continuam como bitmaps avulsos (ainda pertencentes ao atlas).
+     */
+    void construir();
+
+    /**
+     * @brief Retorna o número de páginas (texturas) criadas.
+     * @return A quantidade de páginas do atlas.
+     */
+    int getNumeroPaginas() const { return (int)paginas.size(); }
+
+    /**
+     * @brief Retorna uma página do atlas (usado na contabilidade de memória).
+     * @param i Índice da página.
+     * @return A textura da página.
+     */
+    ALLEGRO_BITMAP* getPagina(int i) const { return paginas[i]; }
+
+private:
+    /**
+     * @brief Um sprite registrado e sua posição calculada no atlas.
+     */
+    struct Item {
+        ALLEGRO_BITMAP** slot;  ///< @brief Ponteiro do dono, que será trocado pelo sub-bitmap.
+        ALLEGRO_BITMAP* origem; ///< @brief Bitmap original registrado.
+        int pagina;             ///< @brief Índice da página onde foi colocado (-1 se ficou avulso).
+        int x, y;               ///< @brief Posição do sprite dentro da página.
+    };
+
+    std::vector<Item> itens;                 ///< @brief Sprites registrados.
+    std::vector<ALLEGRO_BITMAP*> paginas;    ///< @brief Texturas do atlas.
+    std::vector<ALLEGRO_BITMAP*> subBitmaps; ///< @brief Sub-bitmaps entregues aos donos dos sprites.
+    std::vector<ALLEGRO_BITMAP*> avulsos;    ///< @brief Sprites que não couberam em nenhuma página.
+    int tamanhoMaximo;                       ///< @brief Lado máximo de uma página.
+    int espacamento;                         ///< @brief Espaço entre sprites dentro da página.
+};
+
+#endif // TEXTUREATLAS_HPP
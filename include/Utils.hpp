@@ -20,10 +20,53 @@ inline std::string getExecutableDirectory() {
 }
 
 /**
- * @brief Retorna o caminho completo para o arquivo de jogadores.
+ * @brief Retorna o caminho completo para o banco de jogadores.
+ * O players.txt das versões antigas, na mesma pasta, é migrado para ele na primeira carga.
  */
 inline std::string getSaveFilePath() {
-    return getExecutableDirectory() + "\\data\\players.txt";
+    return getExecutableDirectory() + "\\data\\players.dat";
+}
+
+/**
+ * @brief Retorna o caminho do histórico de partidas (todas as partidas, em colunas).
+ */
+inline std::string getHistoryFilePath() {
+    return getExecutableDirectory() + "\\data\\historico.dat";
+}
+
+/**
+ * @brief Retorna o caminho das partidas que esperam o serviço de ranking (enviadas quando ele voltar).
+ */
+inline std::string getRankingPendingPath() {
+    return getExecutableDirectory() + "\\data\\ranking_pendentes.txt";
+}
+
+/**
+ * @brief Retorna o caminho completo para o arquivo de configurações do jogo.
+ */
+inline std::string getConfigFilePath() {
+    return getExecutableDirectory() + "\\data\\config.txt";
+}
+
+/**
+ * @brief Retorna o caminho do relatório de memória dos assets (gravado com F4 e ao sair).
+ */
+inline std::string getMemoryReportPath() {
+    return getExecutableDirectory() + "\\data\\memoria.txt";
+}
+
+/**
+ * @brief Retorna o caminho do pacote de assets (gerado por `make pack` ao lado do executável).
+ */
+inline std::string getPackFilePath() {
+    return getExecutableDirectory() + "\\assets.tdpk";
+}
+
+/**
+ * @brief Retorna a pasta onde ficam as imagens pré-redimensionadas para a resolução escolhida.
+ */
+inline std::string getCacheDirectory() {
+    return getExecutableDirectory() + "\\cache";
 }
 
 #endif // UTILS_HPP
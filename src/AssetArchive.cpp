@@ -0,0 +1,285 @@
+/**
+ * @file AssetArchive.cpp
+ * @brief AssetArchiveimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "AssetArchive.hpp"
+#include <allegro5/allegro_memfile.h> // Para entregar os assets do pacote ao Allegro como arquivos em memória
+#include <allegro5/allegro_ttf.h>     // Para al_load_ttf_font_f
+#include <algorithm>                  // Para std::sort
+#include <cstring>                    // Para memcpy e memcmp
+#include <filesystem>                 // Para listar os assets ao construir o pacote
+#include <fstream>                    // Para ler e gravar os arquivos ao construir o pacote
+#include <iostream>                   // Para saída de avisos
+#include <vector>                     // Para usar std::vector (lista de arquivos ao construir)
+
+/// @brief Identificador no início do pacote.
+static const char PACOTE_MAGICO[4] = {'T', 'D', 'P', 'K'};
+/// @brief Versão do formato do pacote.
+static const uint32_t PACOTE_VERSAO = 1;
+/// @brief Tamanho do cabeçalho fixo.
+static const size_t TAMANHO_CABECALHO = 16;
+
+/**
+ * @brief Lê um inteiro do pacote (o formato é little-endian, como as máquinas em que o jogo roda).
+ */
+template <typename T>
+static T lerInteiro(const unsigned char* p) {
+    T valor;
+    memcpy(&valor, p, sizeof(T));
+    return valor;
+}
+
+/**
+ * @brief Retorna a extensão de um nome de asset, com o ponto (ex: ".png"), usada pelos decodificadores do Allegro.
+ */
+static std::string extensao(const std::string& nome) {
+    size_t ponto = nome.find_last_of('.');
+    return ponto == std::string::npos ? std::string() : nome.substr(ponto);
+}
+
+/**
+ * @brief Construtor da classe AssetArchive.
+ * Mapeia o arquivo inteiro somente para leitura.
+ * @param caminhoPacote Caminho do pacote.
+ */
+AssetArchive::AssetArchive(const std::string& caminhoPacote)
+    : base(nullptr), tamanhoMapeado(0)
+{
+    std::error_code erro;
+    if (!std::filesystem::exists(caminhoPacote, erro)) return; // Sem pacote: assets soltos
+    if (mapa.abrir(caminhoPacote)) {
+        base = mapa.getDados();
+        tamanhoMapeado = mapa.getTamanho();
+    }
+
+    if (!base) {
+        std::cerr << "AVISO: Nao foi possivel mapear " << caminhoPacote << ". Usando os assets soltos.\n";
+        return;
+    }
+    if (!lerIndice()) {
+        std::cerr << "AVISO: Pacote " << caminhoPacote << " invalido. Usando os assets soltos.\n";
+        fechar();
+        return;
+    }
+    std::cout << "Pacote de assets " << caminhoPacote << " aberto com " << indice.size() << " entradas.\n";
+}
+
+/**
+ * @brief Destrutor da classe AssetArchive.
+ */
+AssetArchive::~AssetArchive() {
+    fechar();
+}
+
+/**
+ * @brief Desfaz o mapeamento e limpa o índice.
+ */
+void AssetArchive::fechar() {
+    mapa.fechar();
+    base = nullptr;
+    tamanhoMapeado = 0;
+    indice.clear();
+}
+
+/**
+ * @brief Lê o cabeçalho e o índice, conferindo que toda entrada está dentro do arquivo.
+ * @return true se o pacote é válido.
+ */
+bool AssetArchive::lerIndice() {
+    if (tamanhoMapeado < TAMANHO_CABECALHO || memcmp(base, PACOTE_MAGICO, 4) != 0) return false;
+    if (lerInteiro<uint32_t>(base + 4) != PACOTE_VERSAO) return false;
+
+    uint32_t entradas = lerInteiro<uint32_t>(base + 8);
+    uint32_t tamanhoIndice = lerInteiro<uint32_t>(base + 12);
+    if (tamanhoIndice > tamanhoMapeado - TAMANHO_CABECALHO) return false;
+
+    const unsigned char* p = base + TAMANHO_CABECALHO;
+    const unsigned char* fim = p + tamanhoIndice;
+    for (uint32_t i = 0; i < entradas; ++i) {
+        if (fim - p < 20) return false;
+        Entrada e;
+        e.offset = lerInteiro<uint64_t>(p);
+        e.tamanho = lerInteiro<uint64_t>(p + 8);
+        uint32_t tamanhoNome = lerInteiro<uint32_t>(p + 16);
+        p += 20;
+        if ((uint64_t)(fim - p) < tamanhoNome) return false;
+        if (e.offset % ALINHAMENTO != 0 || e.offset > tamanhoMapeado || e.tamanho > tamanhoMapeado - e.offset) return false;
+
+        indice[std::string(reinterpret_cast<const char*>(p), tamanhoNome)] = e;
+        p += tamanhoNome;
+    }
+    return true;
+}
+
+/**
+ * @brief Localiza um asset no pacote.
+ * @return true se o asset está no pacote.
+ */
+bool AssetArchive::obter(const std::string& nome, const unsigned char*& dados, size_t& tamanho) const {
+    auto it = indice.find(nome);
+    if (it == indice.end()) return false;
+    dados = base + it->second.offset;
+    tamanho = (size_t)it->second.tamanho;
+    return true;
+}
+
+/**
+ * @brief Informa se um asset existe no pacote ou como arquivo solto.
+ * @return true se o asset pode ser aberto.
+ */
+bool AssetArchive::existe(const std::string& nome) const {
+    if (indice.count(nome)) return true;
+    std::error_code erro;
+    return std::filesystem::exists(nome, erro);
+}
+
+/**
+ * @brief Abre um asset como arquivo do Allegro.
+ * @return O arquivo aberto, ou nullptr.
+ */
+ALLEGRO_FILE* AssetArchive::abrir(const std::string& nome) const {
+    const unsigned char* dados;
+    size_t tamanho;
+    if (obter(nome, dados, tamanho)) {
+        // Só leitura: o mapeamento é somente leitura, então o const pode ser removido com segurança
+        return al_open_memfile(const_cast<unsigned char*>(dados), (int64_t)tamanho, "r");
+    }
+    return al_fopen(nome.c_str(), "rb");
+}
+
+/**
+ * @brief Carrega uma imagem do pacote ou do disco.
+ * @return O bitmap, ou nullptr.
+ */
+ALLEGRO_BITMAP* AssetArchive::carregarBitmap(const std::string& nome) const {
+    ALLEGRO_FILE* arquivo = abrir(nome);
+    if (!arquivo) return nullptr;
+    ALLEGRO_BITMAP* bitmap = al_load_bitmap_f(arquivo, extensao(nome).c_str());
+    al_fclose(arquivo);
+    return bitmap;
+}
+
+/**
+ * @brief Carrega um efeito sonoro do pacote ou do disco.
+ * @return O sample, ou nullptr.
+ */
+ALLEGRO_SAMPLE* AssetArchive::carregarSample(const std::string& nome) const {
+    ALLEGRO_FILE* arquivo = abrir(nome);
+    if (!arquivo) return nullptr;
+    ALLEGRO_SAMPLE* sample = al_load_sample_f(arquivo, extensao(nome).c_str());
+    al_fclose(arquivo);
+    return sample;
+}
+
+/**
+ * @brief Abre uma música em stream. A stream passa a ser dona do arquivo.
+ * @return A stream, ou nullptr.
+ */
+ALLEGRO_AUDIO_STREAM* AssetArchive::carregarMusica(const std::string& nome, size_t buffers, unsigned int amostras) const {
+    ALLEGRO_FILE* arquivo = abrir(nome);
+    if (!arquivo) return nullptr;
+    ALLEGRO_AUDIO_STREAM* stream = al_load_audio_stream_f(arquivo, extensao(nome).c_str(), buffers, amostras);
+    if (!stream) al_fclose(arquivo); // Só em caso de falha o arquivo continua sendo nosso
+    return stream;
+}
+
+/**
+ * @brief Carrega uma fonte TrueType. A fonte passa a ser dona do arquivo (inclusive em caso de falha).
+ * @return A fonte, ou nullptr.
+ */
+ALLEGRO_FONT* AssetArchive::carregarFonte(const std::string& nome, int tamanho, int flags) const {
+    ALLEGRO_FILE* arquivo = abrir(nome);
+    if (!arquivo) return nullptr;
+    return al_load_ttf_font_f(arquivo, nome.c_str(), tamanho, flags);
+}
+
+/**
+ * @brief Cria um pacote com todos os arquivos de uma pasta, em ordem alfabética.
+ * @return O número de entradas gravadas, ou -1 em caso de erro.
+ */
+int AssetArchive::construir(const std::string& diretorio, const std::string& saida) {
+    std::filesystem::path raiz(diretorio);
+    if (!raiz.has_filename()) raiz = raiz.parent_path(); // "assets/" -> "assets"
+
+    std::error_code erro;
+    std::vector<std::filesystem::path> arquivos;
+    for (auto it = std::filesystem::recursive_directory_iterator(raiz, erro);
+         !erro && it != std::filesystem::recursive_directory_iterator(); it.increment(erro)) {
+        if (it->is_regular_file()) arquivos.push_back(it->path());
+    }
+    if (erro) {
+        std::cerr << "Erro ao listar " << diretorio << ": " << erro.message() << "\n";
+        return -1;
+    }
+    std::sort(arquivos.begin(), arquivos.end());
+
+    // Nomes como o jogo os pede: "<pasta>/<caminho relativo>", sempre com '/'
+    std::vector<std::string> nomes;
+    std::vector<uint64_t> tamanhos;
+    uint64_t tamanhoIndice = 0;
+    for (const auto& arquivo : arquivos) {
+        nomes.push_back((raiz.filename() / arquivo.lexically_relative(raiz)).generic_string());
+        tamanhos.push_back((uint64_t)std::filesystem::file_size(arquivo, erro));
+        if (erro) {
+            std::cerr << "Erro ao ler " << arquivo.string() << ": " << erro.message() << "\n";
+            return -1;
+        }
+        tamanhoIndice += 20 + nomes.back().size();
+    }
+
+    // Offsets: os dados começam depois do índice, cada entrada alinhada
+    auto alinhar = [](uint64_t v) { return (v + ALINHAMENTO - 1) / ALINHAMENTO * ALINHAMENTO; };
+    std::vector<uint64_t> offsets;
+    uint64_t posicao = alinhar(TAMANHO_CABECALHO + tamanhoIndice);
+    for (uint64_t tamanho : tamanhos) {
+        offsets.push_back(posicao);
+        posicao = alinhar(posicao + tamanho);
+    }
+
+    std::string temporario = saida + ".tmp";
+    {
+        std::ofstream out(temporario, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Erro ao criar " << saida << ".\n";
+            return -1;
+        }
+
+        uint32_t cabecalho[3] = {PACOTE_VERSAO, (uint32_t)arquivos.size(), (uint32_t)tamanhoIndice};
+        out.write(PACOTE_MAGICO, 4);
+        out.write(reinterpret_cast<const char*>(cabecalho), sizeof(cabecalho));
+        for (size_t i = 0; i < arquivos.size(); ++i) {
+            uint32_t tamanhoNome = (uint32_t)nomes[i].size();
+            out.write(reinterpret_cast<const char*>(&offsets[i]), 8);
+            out.write(reinterpret_cast<const char*>(&tamanhos[i]), 8);
+            out.write(reinterpret_cast<const char*>(&tamanhoNome), 4);
+            out.write(nomes[i].data(), tamanhoNome);
+        }
+
+        static const char ZEROS[ALINHAMENTO] = {};
+        for (size_t i = 0; i < arquivos.size(); ++i) {
+            uint64_t atual = (uint64_t)out.tellp();
+            out.write(ZEROS, (std::streamsize)(offsets[i] - atual)); // Preenchimento até o alinhamento
+
+            std::ifstream in(arquivos[i], std::ios::binary);
+            if (in.is_open() && tamanhos[i] > 0) out << in.rdbuf(); // Arquivo vazio: nada a copiar
+            if (!in.is_open() || (uint64_t)out.tellp() != offsets[i] + tamanhos[i]) {
+                std::cerr << "Erro ao copiar " << arquivos[i].string() << " para o pacote.\n";
+                return -1;
+            }
+        }
+        if (!out) {
+            std::cerr << "Erro ao gravar " << saida << ".\n";
+            return -1;
+        }
+    }
+
+    std::filesystem::rename(temporario, saida, erro);
+    if (erro) {
+        std::cerr << "Erro ao finalizar " << saida << ": " << erro.message() << "\n";
+        std::filesystem::remove(temporario, erro);
+        return -1;
+    }
+    return (int)arquivos.size();
+}
@@ -0,0 +1,169 @@
+/**
+ * @file AssetLoader.cpp
+ * @brief AssetLoaderimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "AssetLoader.hpp"
+#include <iostream> // Para saída de avisos
+
+/// @brief Limite de threads trabalhadoras (o disco vira o gargalo antes disso).
+static const int MAX_TRABALHADORES = 4;
+
+/**
+ * @brief Construtor da classe AssetLoader.
+ * @param trabalhadores Quantidade de threads (0 = núcleos - 1, entre 1 e 4).
+ */
+AssetLoader::AssetLoader(int trabalhadores)
+    : mutex(al_create_mutex()), haTrabalho(al_create_cond()),
+      total(0), concluidos(0), encerrando(false)
+{
+    if (trabalhadores <= 0) {
+        trabalhadores = al_get_cpu_count() - 1; // Um núcleo fica para a thread principal
+    }
+    if (trabalhadores < 1) trabalhadores = 1;
+    if (trabalhadores > MAX_TRABALHADORES) trabalhadores = MAX_TRABALHADORES;
+
+    if (!mutex || !haTrabalho) {
+        std::cerr << "AVISO: Nao foi possivel criar a sincronizacao do carregamento. Carregando na thread principal.\n";
+        return;
+    }
+
+    for (int i = 0; i < trabalhadores; ++i) {
+        ALLEGRO_THREAD* thread = al_create_thread(&AssetLoader::executarTrabalhador, this);
+        if (!thread) {
+            std::cerr << "AVISO: Nao foi possivel criar a thread de carregamento " << i << ".\n";
+            break;
+        }
+        threads.push_back(thread);
+        al_start_thread(thread);
+    }
+}
+
+/**
+ * @brief Destrutor da classe AssetLoader.
+ * Avisa as threads para saírem e espera cada uma terminar o trabalho atual.
+ */
+AssetLoader::~AssetLoader() {
+    if (mutex) {
+        al_lock_mutex(mutex);
+        encerrando = true;
+        al_broadcast_cond(haTrabalho);
+        al_unlock_mutex(mutex);
+    }
+
+    for (ALLEGRO_THREAD* thread : threads) {
+        al_join_thread(thread, nullptr);
+        al_destroy_thread(thread);
+    }
+    threads.clear();
+
+    if (haTrabalho) al_destroy_cond(haTrabalho);
+    if (mutex) al_destroy_mutex(mutex);
+}
+
+/**
+ * @brief Laço das threads trabalhadoras.
+ * @param thread A thread atual (não usada; o encerramento vem pela flag `encerrando`).
+ * @param arg Ponteiro para o AssetLoader.
+ * @return Sempre nullptr.
+ */
+void* AssetLoader::executarTrabalhador(ALLEGRO_THREAD* thread, void* arg) {
+    AssetLoader* self = static_cast<AssetLoader*>(arg);
+
+    al_lock_mutex(self->mutex);
+    while (true) {
+        while (self->pendentes.empty() && !self->encerrando) {
+            al_wait_cond(self->haTrabalho, self->mutex);
+        }
+        if (self->pendentes.empty()) break; // Encerrando e sem nada pendente
+
+        Trabalho trabalho = std::move(self->pendentes.front());
+        self->pendentes.pop_front();
+
+        // A etapa pesada roda sem o mutex, em paralelo com as outras threads
+        al_unlock_mutex(self->mutex);
+        if (trabalho.emSegundoPlano) trabalho.emSegundoPlano();
+        al_lock_mutex(self->mutex);
+
+        self->prontos.push_back(std::move(trabalho));
+    }
+    al_unlock_mutex(self->mutex);
+    return nullptr;
+}
+
+/**
+ * @brief Agenda um trabalho.
+ * Sem threads (falha na criação), a etapa de segundo plano roda aqui mesmo.
+ */
+void AssetLoader::adicionar(std::function<void()> emSegundoPlano, std::function<void()> naThreadPrincipal) {
+    Trabalho trabalho{std::move(emSegundoPlano), std::move(naThreadPrincipal)};
+
+    if (threads.empty() || !trabalho.emSegundoPlano) {
+        // Sem etapa de segundo plano (ou sem threads): vai direto para a fila de prontos
+        if (trabalho.emSegundoPlano) trabalho.emSegundoPlano();
+        if (mutex) al_lock_mutex(mutex);
+        prontos.push_back(std::move(trabalho));
+        ++total;
+        if (mutex) al_unlock_mutex(mutex);
+        return;
+    }
+
+    al_lock_mutex(mutex);
+    pendentes.push_back(std::move(trabalho));
+    ++total;
+    al_signal_cond(haTrabalho);
+    al_unlock_mutex(mutex);
+}
+
+/**
+ * @brief Executa as etapas da thread principal dos trabalhos prontos, até o orçamento de tempo.
+ * @return Quantas etapas foram executadas.
+ */
+int AssetLoader::processarProntos(double orcamentoMs) {
+    double inicio = al_get_time();
+    int executados = 0;
+
+    while (true) {
+        if (mutex) al_lock_mutex(mutex);
+        if (prontos.empty()) {
+            if (mutex) al_unlock_mutex(mutex);
+            break;
+        }
+        Trabalho trabalho = std::move(prontos.front());
+        prontos.pop_front();
+        if (mutex) al_unlock_mutex(mutex);
+
+        if (trabalho.naThreadPrincipal) trabalho.naThreadPrincipal();
+        ++executados;
+
+        if (mutex) al_lock_mutex(mutex);
+        ++concluidos;
+        if (mutex) al_unlock_mutex(mutex);
+
+        if ((al_get_time() - inicio) * 1000.0 >= orcamentoMs) break;
+    }
+    return executados;
+}
+
+/**
+ * @brief Retorna a fração dos trabalhos concluídos.
+ * @return Valor de 0 a 1.
+ */
+float AssetLoader::getProgresso() const {
+    if (mutex) al_lock_mutex(mutex);
+    float progresso = total > 0 ? (float)concluidos / total : 1.0f;
+    if (mutex) al_unlock_mutex(mutex);
+    return progresso;
+}
+
+/**
+ * @brief Informa se todos os trabalhos foram concluídos.
+ * @return true se não há trabalhos pendentes nem prontos.
+ */
+bool AssetLoader::terminou() const {
+    if (mutex) al_lock_mutex(mutex);
+    bool fim = concluidos >= total;
+    if (mutex) al_unlock_mutex(mutex);
+    return fim;
+}
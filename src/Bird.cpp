@@ -159,26 +159,26 @@ void Bird::update(float deltaTime) {
 }
 
 /**
- * @brief Renderiza o pássaro na tela.
+ * @brief Grava o desenho do pássaro na lista de comandos do frame.
+ * @param fila Lista de comandos do frame.
  */
-void Bird::render() {
+void Bird::render(RenderQueue& fila) {
     ALLEGRO_BITMAP* currentBitmap = this->frames[this->currentFrame];
     if (currentBitmap) {
-        // Desenha o bitmap atual do pássaro, aplicando escala, rotação e posicionamento
-        al_draw_scaled_rotated_bitmap(
+        // Grava o bitmap atual do pássaro, com escala e rotação em torno do centro do objeto
+        fila.desenharRotacionado(
             currentBitmap,
-            al_get_bitmap_width(currentBitmap) / 2.0f, // Ponto de rotação X (centro do bitmap)
-            al_get_bitmap_height(currentBitmap) / 2.0f, // Ponto de rotação Y (centro do bitmap)
+            RenderQueue::CAMADA_PERSONAGEM,
             this->x + this->width / 2.0f, // Posição X central do objeto na tela
             this->y + this->height / 2.0f, // Posição Y central do objeto na tela
-            this->width / al_get_bitmap_width(currentBitmap), // Escala X
-            this->height / al_get_bitmap_height(currentBitmap), // Escala Y
-            rotacionar ? this->rotationAngle : 0.0f, // Ângulo de rotação (se a rotação estiver ativada)
-            0 // Flags (nenhuma neste caso)
+            this->width, // Largura final na tela
+            this->height, // Altura final na tela
+            rotacionar ? this->rotationAngle : 0.0f // Ângulo de rotação (se a rotação estiver ativada)
         );
     } else {
         // Fallback: se o bitmap não estiver disponível, desenha um retângulo magenta
-        al_draw_filled_rectangle(this->x, this->y, this->x + this->width, this->y + this->height, al_map_rgb(255, 0, 255));
+        fila.desenharRetangulo(RenderQueue::CAMADA_PERSONAGEM, this->x, this->y,
+                               this->x + this->width, this->y + this->height, al_map_rgb(255, 0, 255));
     }
 }
 
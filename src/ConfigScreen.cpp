@@ -5,8 +5,10 @@
 
 
 #include "ConfigScreen.hpp"
+#include "RenderStats.hpp" // Contagem de desenhos para o HUD de depuração
 #include <allegro5/allegro_primitives.h> // Necessário para desenho de formas primitivas
 #include <iostream> // Para saída de avisos
+#include <cstdio>   // Para snprintf (textos das opções)
 
 /**
  * @brief Construtor da classe ConfigScreen.
@@ -14,9 +16,11 @@
  * @param bg Ponteiro para o bitmap de fundo da tela.
  * @param screenW Largura da tela atual do jogo.
  * @param screenH Altura da tela atual do jogo.
+ * @param cfg Configurações editadas pela tela.
  */
-ConfigScreen::ConfigScreen(ALLEGRO_FONT* f, ALLEGRO_BITMAP* bg, int screenW, int screenH)
-    : font(f), background(bg), SCREEN_W(screenW), SCREEN_H(screenH), waitingForKeyPress(true)
+ConfigScreen::ConfigScreen(ALLEGRO_FONT* f, ALLEGRO_BITMAP* bg, int screenW, int screenH, GameConfig* cfg)
+    : font(f), background(bg), SCREEN_W(screenW), SCREEN_H(screenH), waitingForKeyPress(true),
+      config(cfg), quadroCache(nullptr), sujo(true)
 {
     // Dimensões de design para cálculo da escala
     const float DESIGN_W = 1280.0f;
@@ -37,6 +41,7 @@ ConfigScreen::ConfigScreen(ALLEGRO_FONT* f, ALLEGRO_BITMAP* bg, int screenW, int
  */
 ConfigScreen::~ConfigScreen() {
     // Não destruir font nem background (proprietários são outros)
+    if (quadroCache) al_destroy_bitmap(quadroCache); // O cache da tela composta é desta classe
 }
 
 /**
@@ -50,9 +55,35 @@ void ConfigScreen::update(float deltaTime) {
 
 /**
  * @brief Renderiza a tela de configurações.
- * Desenha o fundo e uma mensagem instruindo o usuário a voltar ao menu.
+ * A tela é composta em `quadroCache` só quando está suja; nos demais frames é um único desenho de bitmap.
  */
 void ConfigScreen::render() {
+    if (!quadroCache) {
+        quadroCache = al_create_bitmap(SCREEN_W, SCREEN_H);
+    }
+    if (!quadroCache) {
+        compor(); // Sem bitmap de cache: desenha direto, como antes
+        return;
+    }
+
+    if (sujo) {
+        ALLEGRO_STATE estado;
+        al_store_state(&estado, ALLEGRO_STATE_TARGET_BITMAP);
+        al_set_target_bitmap(quadroCache);
+        al_clear_to_color(al_map_rgb(0, 0, 0));
+        compor();
+        al_restore_state(&estado);
+        sujo = false;
+    }
+
+    al_draw_bitmap(quadroCache, 0, 0, 0);
+    RenderStats::registrarDesenho(quadroCache);
+}
+
+/**
+ * @brief Desenha o fundo, as opções atuais e as teclas de cada uma.
+ */
+void ConfigScreen::compor() {
     // Desenha o fundo da tela (o mesmo que a tela de ranking)
     if (background) {
         int bg_w = al_get_bitmap_width(background);
@@ -68,24 +99,75 @@ void ConfigScreen::render() {
     // Retorna se a fonte não estiver carregada para evitar erros de desenho
     if (!font) return;
 
-    // Desenha o texto centralizado para instruir o usuário a voltar ao menu
-    al_draw_text(font, al_map_rgb(255, 255, 255),
-        SCREEN_W / 2.0f, SCREEN_H / 2.0f,
-        ALLEGRO_ALIGN_CENTER,
-        "Aperte qualquer tecla para voltar");
+    float alturaLinha = al_get_font_line_height(font) * 1.5f;
+    float y = SCREEN_H / 2.0f - alturaLinha * 2.0f;
+
+    if (config) {
+        char linha[64];
+        // Escala de renderização em porcentagem da resolução da janela
+        snprintf(linha, sizeof(linha), "Escala de renderizacao: < %d%% >",
+                 (int)(config->getEscalaRender() * 100.0f + 0.5f));
+        al_draw_text(font, al_map_rgb(255, 255, 255), SCREEN_W / 2.0f, y, ALLEGRO_ALIGN_CENTER, linha);
+        y += alturaLinha;
+
+        snprintf(linha, sizeof(linha), "Escala dinamica: %s", config->isEscalaDinamica() ? "Ligada" : "Desligada");
+        al_draw_text(font, al_map_rgb(255, 255, 255), SCREEN_W / 2.0f, y, ALLEGRO_ALIGN_CENTER, linha);
+        y += alturaLinha;
+
+        snprintf(linha, sizeof(linha), "Resolucao: %dx%d (R para trocar)", SCREEN_W, SCREEN_H);
+        al_draw_text(font, al_map_rgb(255, 255, 255), SCREEN_W / 2.0f, y, ALLEGRO_ALIGN_CENTER, linha);
+        y += alturaLinha * 1.5f;
+
+        // Legenda das teclas em amarelo, como os avisos do menu
+        al_draw_text(font, al_map_rgb(255, 255, 0), SCREEN_W / 2.0f, y, ALLEGRO_ALIGN_CENTER,
+                     "Setas: escala   D: dinamica   ESC: voltar");
+    } else {
+        // Sem configurações para editar: mantém a tela antiga
+        al_draw_text(font, al_map_rgb(255, 255, 255),
+            SCREEN_W / 2.0f, SCREEN_H / 2.0f,
+            ALLEGRO_ALIGN_CENTER,
+            "Aperte qualquer tecla para voltar");
+    }
 }
 
 /**
  * @brief Lida com eventos de entrada na tela de configurações.
  * @param ev O evento Allegro a ser processado.
- * @return 1 se uma tecla for pressionada (sinal para voltar ao menu), 0 caso contrário.
+ * @return 1 para voltar ao menu, 2 se uma configuração mudou, 3 para trocar a resolução, 0 caso contrário.
  */
 int ConfigScreen::handleEvent(ALLEGRO_EVENT ev) {
-    if (ev.type == ALLEGRO_EVENT_KEY_DOWN) {
-        waitingForKeyPress = false; // Sinaliza que uma tecla foi pressionada
-        return 1; // Retorna 1 para indicar que a tela deve ser fechada
+    if (ev.type != ALLEGRO_EVENT_KEY_DOWN) {
+        return 0; // Nenhum evento relevante processado
+    }
+
+    if (!config) {
+        waitingForKeyPress = false; // Sem opções: qualquer tecla volta
+        return 1;
+    }
+
+    switch (ev.keyboard.keycode) {
+        case ALLEGRO_KEY_LEFT:
+            config->setEscalaRender(config->getEscalaRender() - GameConfig::PASSO_ESCALA);
+            sujo = true;
+            return 2;
+        case ALLEGRO_KEY_RIGHT:
+            config->setEscalaRender(config->getEscalaRender() + GameConfig::PASSO_ESCALA);
+            sujo = true;
+            return 2;
+        case ALLEGRO_KEY_D:
+            config->setEscalaDinamica(!config->isEscalaDinamica());
+            sujo = true;
+            return 2;
+        case ALLEGRO_KEY_R:
+            return 3; // O GameEngine abre o seletor e recria as telas
+        case ALLEGRO_KEY_ESCAPE:
+        case ALLEGRO_KEY_ENTER:
+        case ALLEGRO_KEY_BACKSPACE:
+            waitingForKeyPress = false; // Sinaliza que a tela deve ser fechada
+            return 1;
+        default:
+            return 0;
     }
-    return 0; // Nenhum evento relevante processado
 }
 
 /**
@@ -0,0 +1,143 @@
+/**
+ * @file FileLock.cpp
+ * @brief FileLockimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "FileLock.hpp"
+#include <iostream> // Para mensagens de erro
+
+#ifdef _WIN32
+#include <windows.h>  // Para CreateFile/LockFileEx
+#else
+#include <cerrno>     // Para EINTR (espera interrompida por sinal)
+#include <fcntl.h>    // Para open
+#include <sys/file.h> // Para flock
+#include <unistd.h>   // Para pread/pwrite/fsync/close
+#endif
+
+/**
+ * @brief Abre ou cria o arquivo da trava, permitindo que outros processos o abram também.
+ * @return true se o arquivo foi aberto.
+ */
+bool FileLock::abrir(const std::string& caminho) {
+    fechar();
+#ifdef _WIN32
+    HANDLE arquivo = CreateFileA(caminho.c_str(), GENERIC_READ | GENERIC_WRITE,
+                                 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                                 OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (arquivo == INVALID_HANDLE_VALUE) {
+        std::cerr << "Erro: não foi possível abrir a trava " << caminho << "\n";
+        return false;
+    }
+    descritor = (intptr_t)arquivo;
+#else
+    int fd = open(caminho.c_str(), O_RDWR | O_CREAT, 0666);
+    if (fd < 0) {
+        std::cerr << "Erro: não foi possível abrir a trava " << caminho << "\n";
+        return false;
+    }
+    descritor = fd;
+#endif
+    return true;
+}
+
+/**
+ * @brief Solta a trava e fecha o arquivo.
+ */
+void FileLock::fechar() {
+    if (descritor == -1) return;
+    destravar();
+#ifdef _WIN32
+    CloseHandle((HANDLE)descritor);
+#else
+    close((int)descritor);
+#endif
+    descritor = -1;
+}
+
+/**
+ * @brief Pede ao sistema a trava do arquivo inteiro.
+ * @return true se a trava foi obtida.
+ */
+bool FileLock::pedir(Modo modo, bool esperar) {
+    if (descritor == -1 || travada) return travada;
+#ifdef _WIN32
+    DWORD flags = (modo == EXCLUSIVA ? LOCKFILE_EXCLUSIVE_LOCK : 0) | (esperar ? 0 : LOCKFILE_FAIL_IMMEDIATELY);
+    OVERLAPPED posicao = {};
+    travada = LockFileEx((HANDLE)descritor, flags, 0, MAXDWORD, MAXDWORD, &posicao) != 0;
+#else
+    int operacao = (modo == EXCLUSIVA ? LOCK_EX : LOCK_SH) | (esperar ? 0 : LOCK_NB);
+    int resultado;
+    do {
+        resultado = flock((int)descritor, operacao);
+    } while (resultado != 0 && errno == EINTR); // Um sinal interrompe a espera, não a cancela
+    travada = resultado == 0;
+#endif
+    return travada;
+}
+
+/**
+ * @brief Espera a trava.
+ * @return true se a trava foi obtida.
+ */
+bool FileLock::travar(Modo modo) {
+    bool ok = pedir(modo, true);
+    if (!ok && descritor != -1) std::cerr << "Erro: o sistema recusou a trava de arquivo.\n";
+    return ok;
+}
+
+/**
+ * @brief Tenta a trava sem esperar.
+ * @return true se a trava foi obtida.
+ */
+bool FileLock::tentarTravar(Modo modo) {
+    return pedir(modo, false);
+}
+
+/**
+ * @brief Solta a trava.
+ */
+void FileLock::destravar() {
+    if (!travada) return;
+#ifdef _WIN32
+    OVERLAPPED posicao = {};
+    UnlockFileEx((HANDLE)descritor, 0, MAXDWORD, MAXDWORD, &posicao);
+#else
+    flock((int)descritor, LOCK_UN);
+#endif
+    travada = false;
+}
+
+/**
+ * @brief Lê bytes do início do arquivo.
+ * @return true se todos os bytes foram lidos.
+ */
+bool FileLock::ler(void* destino, size_t bytes) const {
+    if (descritor == -1) return false;
+#ifdef _WIN32
+    OVERLAPPED posicao = {}; // Offset 0, sem mexer na posição do handle
+    DWORD lidos = 0;
+    return ReadFile((HANDLE)descritor, destino, (DWORD)bytes, &lidos, &posicao) && lidos == bytes;
+#else
+    return pread((int)descritor, destino, bytes, 0) == (ssize_t)bytes;
+#endif
+}
+
+/**
+ * @brief Grava bytes no início do arquivo.
+ * @return true se todos os bytes foram gravados (e sincronizados, se pedido).
+ */
+bool FileLock::gravar(const void* origem, size_t bytes, bool sincronizar) {
+    if (descritor == -1) return false;
+#ifdef _WIN32
+    OVERLAPPED posicao = {};
+    DWORD gravados = 0;
+    bool ok = WriteFile((HANDLE)descritor, origem, (DWORD)bytes, &gravados, &posicao) && gravados == bytes;
+    if (ok && sincronizar) ok = FlushFileBuffers((HANDLE)descritor) != 0;
+#else
+    bool ok = pwrite((int)descritor, origem, bytes, 0) == (ssize_t)bytes;
+    if (ok && sincronizar) ok = fsync((int)descritor) == 0;
+#endif
+    return ok;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file FontWarmer.cpp
+ * @brief FontWarmerimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "FontWarmer.hpp"
+
+// ASCII de ' ' a '~' seguido das letras acentuadas do português (UTF-8)
+const char* const FontWarmer::CARACTERES_DO_JOGO =
+    " !\"#$%&'()*+,-./0123456789:;<=>?@"
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`"
+    "abcdefghijklmnopqrstuvwxyz{|}~"
+    "ÁÀÂÃÉÊÍÓÔÕÚÜÇáàâãéêíóôõúüçºª";
+
+/**
+ * @brief Desenha um texto em um bitmap descartável e mede o tempo.
+ * O glifo é rasterizado no cache da fonte mesmo que fique fora do bitmap, então 8x8 basta.
+ */
+double FontWarmer::desenharDescartavel(ALLEGRO_FONT* font, const char* texto) {
+    if (!font || !texto) return 0.0;
+
+    ALLEGRO_STATE estado;
+    al_store_state(&estado, ALLEGRO_STATE_TARGET_BITMAP);
+    ALLEGRO_BITMAP* rascunho = al_create_bitmap(8, 8);
+    if (!rascunho) {
+        al_restore_state(&estado);
+        return 0.0;
+    }
+
+    al_set_target_bitmap(rascunho);
+    double inicio = al_get_time();
+    al_draw_text(font, al_map_rgb(255, 255, 255), 0, 0, ALLEGRO_ALIGN_LEFT, texto);
+    double fim = al_get_time();
+
+    al_restore_state(&estado);
+    al_destroy_bitmap(rascunho);
+    return (fim - inicio) * 1000.0;
+}
+
+/**
+ * @brief Rasteriza os glifos de todos os caracteres informados.
+ * @return O tempo gasto, em milissegundos.
+ */
+double FontWarmer::preaquecer(ALLEGRO_FONT* font, const char* caracteres) {
+    return desenharDescartavel(font, caracteres);
+}
+
+/**
+ * @brief Mede o custo de desenhar um texto.
+ * @return O tempo do desenho, em milissegundos.
+ */
+double FontWarmer::medirDesenho(ALLEGRO_FONT* font, const char* texto) {
+    return desenharDescartavel(font, texto);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file GameConfig.cpp
+ * @brief GameConfigimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "GameConfig.hpp"
+#include <fstream>    // Para ler e gravar o arquivo de configurações
+#include <iostream>   // Para mensagens de aviso
+#include <filesystem> // Para garantir a criação da pasta de destino
+#include <cmath>      // Para std::round
+#include <cstdlib>    // Para std::strtod
+
+const float GameConfig::ESCALA_MINIMA = 0.5f;
+const float GameConfig::ESCALA_MAXIMA = 1.0f;
+const float GameConfig::PASSO_ESCALA = 0.05f;
+
+/**
+ * @brief Construtor da classe GameConfig.
+ * @param caminho Caminho do arquivo de configurações.
+ */
+GameConfig::GameConfig(const std::string& caminho)
+    : caminhoArquivo(caminho), escalaRender(1.0f), escalaDinamica(false), tempoAlvoMs(1000.0 / 60.0),
+      orcamentoNiveisMb(48), orcamentoMemoriaMb(256), sincroniaJogadores(1) {}
+
+/**
+ * @brief Limita a escala ao intervalo aceito e arredonda para o passo.
+ * @param escala A escala a ajustar.
+ * @return A escala ajustada.
+ */
+float GameConfig::ajustarEscala(float escala) {
+    // Arredondar para o passo evita recriar o alvo por diferenças minúsculas
+    float passos = std::round(escala / PASSO_ESCALA);
+    float ajustada = passos * PASSO_ESCALA;
+    if (ajustada < ESCALA_MINIMA) ajustada = ESCALA_MINIMA;
+    if (ajustada > ESCALA_MAXIMA) ajustada = ESCALA_MAXIMA;
+    return ajustada;
+}
+
+/**
+ * @brief Define a escala de renderização.
+ * @param escala A nova escala (será limitada e arredondada).
+ */
+void GameConfig::setEscalaRender(float escala) {
+    escalaRender = ajustarEscala(escala);
+}
+
+/**
+ * @brief Lê o arquivo de configurações.
+ * Cada linha tem o formato `chave=valor`; linhas vazias e começando com '#' são ignoradas.
+ * @return true se o arquivo foi aberto.
+ */
+bool GameConfig::carregar() {
+    std::ifstream arq(caminhoArquivo);
+    if (!arq.is_open()) {
+        return false; // Primeira execução: ficam os valores padrão
+    }
+
+    std::string linha;
+    while (std::getline(arq, linha)) {
+        if (linha.empty() || linha[0] == '#') continue;
+        size_t igual = linha.find('=');
+        if (igual == std::string::npos) continue;
+
+        std::string chave = linha.substr(0, igual);
+        std::string valor = linha.substr(igual + 1);
+        if (chave == "servidor_ranking") {
+            servidorRanking = valor; // Texto (caminho do socket), não número
+            continue;
+        }
+        char* fim = nullptr;
+        double numero = std::strtod(valor.c_str(), &fim);
+        if (fim == valor.c_str()) {
+            std::cerr << "AVISO: Valor invalido para '" << chave << "' em " << caminhoArquivo << "\n";
+            continue;
+        }
+
+        if (chave == "escala_render") {
+            setEscalaRender((float)numero);
+        } else if (chave == "escala_dinamica") {
+            escalaDinamica = numero != 0.0;
+        } else if (chave == "tempo_alvo_ms") {
+            if (numero > 1.0 && numero < 1000.0) tempoAlvoMs = numero;
+        } else if (chave == "orcamento_niveis_mb") {
+            if (numero >= 8.0 && numero <= 4096.0) orcamentoNiveisMb = (int)numero;
+        } else if (chave == "orcamento_memoria_mb") {
+            if (numero >= 16.0 && numero <= 8192.0) orcamentoMemoriaMb = (int)numero;
+        } else if (chave == "sincronia_jogadores") {
+            if (numero >= 0.0 && numero <= 2.0) sincroniaJogadores = (int)numero;
+        }
+        // Chaves desconhecidas são ignoradas (arquivo de uma versão mais nova)
+    }
+    return true;
+}
+
+/**
+ * @brief Grava as configurações no arquivo, sobrescrevendo o anterior.
+ * @return true se o arquivo foi gravado.
+ */
+bool GameConfig::salvar() const {
+    // Garante que o diretório onde o arquivo será salvo exista
+    std::error_code erro;
+    std::filesystem::create_directories(std::filesystem::path(caminhoArquivo).parent_path(), erro);
+
+    std::ofstream arq(caminhoArquivo);
+    if (!arq.is_open()) {
+        std::cerr << "Erro: não foi possível salvar as configurações em " << caminhoArquivo << "\n";
+        return false;
+    }
+
+    arq << "escala_render=" << escalaRender << "\n";
+    arq << "escala_dinamica=" << (escalaDinamica ? 1 : 0) << "\n";
+    arq << "tempo_alvo_ms=" << tempoAlvoMs << "\n";
+    arq << "orcamento_niveis_mb=" << orcamentoNiveisMb << "\n";
+    arq << "orcamento_memoria_mb=" << orcamentoMemoriaMb << "\n";
+    arq << "sincronia_jogadores=" << sincroniaJogadores << "\n";
+    arq << "servidor_ranking=" << servidorRanking << "\n";
+    return true;
+}
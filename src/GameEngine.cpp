@@ -11,7 +11,9 @@
 #include <allegro5/allegro_ttf.h>       // Para fontes TrueType
 #include <allegro5/allegro_image.h>     // Para carregar e manipular imagens
 #include <iostream>                     // Para saída de console (std::cerr, std::cout)
-#include <sstream>                      // Para manipular strings (construção de caminhos de arquivo)
+#include <cstdio>                       // Para snprintf (textos do HUD de depuração)
+#include <memory>                       // Para std::shared_ptr (pixels passados entre as etapas do carregamento)
+#include <ctime>                        // Para time (instante das partidas no histórico)
 
 /**
  * @brief Construtor da classe GameEngine.
@@ -28,15 +30,18 @@ GameEngine::GameEngine(int w, int h, WindowMode mode)
       resolucaoY(720.0f), resolucaoX(1280.0f), // Resolução de referência para escalonamento
       display(nullptr), queue(nullptr), timer(nullptr),
       font(nullptr), fontlarge(nullptr), bg(nullptr), rankingBackground(nullptr), gameOverBackground(nullptr), birdBmp(nullptr),
-      pipeBmp(nullptr),
+      pipeBmp(nullptr), spriteAtlas(nullptr),
       menu(nullptr), scenario(nullptr), gameOverScreen(nullptr),
       rankingScreen(nullptr), configScreen(nullptr),
-      playerManager(nullptr), currentPlayer(nullptr), estadoAtual(MENU),
+      playerManager(nullptr), currentPlayer(PlayerManager::ID_INVALIDO), placarRemoto(nullptr), estadoAtual(MENU),
+      ultimoEstadoDesenhado(MENU), forcarRedesenho(true),
       lastScore(0), lastRecordPessoal(0), lastRecordGeral(0),
       lastBateuRecordePessoal(false), lastBateuRecordeGeral(false),
+      historico(getHistoryFilePath()), inicioPartidaAtual(0.0), batidasPartida(0),
+      historicoPartidas(0), historicoMedia(0.0), historicoMediana(0), historicoP90(0),
 
       musicaMenuRankingGameOver(nullptr),
-      musicaEmJogo(nullptr), // OBS: Parece não ser utilizada diretamente, 'musicLevels' é o foco.
+      musicaEmJogo(nullptr), // OBS: Parece não ser utilizada diretamente, as músicas dos níveis ficam no LevelAssetManager.
       musicaAtualTocando(nullptr),
 
       somHover(nullptr),
@@ -51,15 +56,34 @@ GameEngine::GameEngine(int w, int h, WindowMode mode)
       fadeOutPhase(true), // OBS: Variável 'fadeOutPhase' não parece ser utilizada no código atual.
       isTransitionBlurActive(false),
       transitionBlurTimer(0.0f),
-      renderTarget(nullptr)
+      renderTarget(nullptr), postProcessor(nullptr),
+      pacote(getPackFilePath()),
+      config(getConfigFilePath()),
+      controleEscala(GameConfig::ESCALA_MINIMA, GameConfig::ESCALA_MAXIMA, GameConfig::PASSO_ESCALA, 1000.0 / 60.0),
+      escalaRender(1.0f), cenaReduzida(nullptr), inicioQuadroAnterior(0.0),
+      msCarregamento(0.0), menuJaMostrado(false), msNoSeletor(0.0), msAteMenu(0.0), jogoJaMostrado(false),
+      modoBenchmark(false), fontSeletor(nullptr), carregador(nullptr), niveis(nullptr),
+      debugHudVisivel(false), fpsMedido(0.0), fpsInicioJanela(0.0), fpsQuadrosJanela(0)
 {
     // Calcula os fatores de escalonamento para ajustar os elementos visuais à resolução atual.
     scaleX = (float)screenWidth / resolucaoX;
     scaleY = (float)screenHeight / resolucaoY;
 
-    // Instancia o gerenciador de jogadores e carrega os dados persistidos.
-    playerManager = new PlayerManager(getSaveFilePath());
+    // Lê as configurações salvas (escala de renderização); sem arquivo, ficam os padrões.
+    config.carregar();
+
+    // Instancia o gerenciador de jogadores e carrega os dados persistidos (snapshot + diário).
+    playerManager = new PlayerManager(getSaveFilePath(), (MatchJournal::Sincronia)config.getSincroniaJogadores());
     playerManager->carregar();
+    if (!config.getServidorRanking().empty()) {
+        // Ranking compartilhado entre os gabinetes: as partidas vão para o serviço em outra thread
+        placarRemoto = new LeaderboardClient(config.getServidorRanking(), getRankingPendingPath());
+        playerManager->setPlacarRemoto(placarRemoto);
+    }
+    historico.carregar(); // Sem arquivo, começa vazio
+    controleEscala.setAlvoMs(config.getTempoAlvoMs());
+    controleEscala.setEscala(config.getEscalaRender());
+    memoria.setOrcamento((size_t)config.getOrcamentoMemoriaMb() * 1024 * 1024);
 }
 
 /**
@@ -70,34 +94,69 @@ GameEngine::GameEngine(int w, int h, WindowMode mode)
  * objetos de telas e componentes do Allegro.
  */
 GameEngine::~GameEngine() {
-    // Primeiro, libera os recursos de jogo como imagens e sons.
-    destroyGameAssets();
+    // Primeiro, deleta os objetos de tela. O pássaro do cenário guarda sub-bitmaps do
+    // atlas, e o Allegro exige que eles sejam destruídos antes do bitmap pai.
+    destruirTelas();
 
-    // Depois, deleta os objetos de tela e gerenciadores.
-    if (menu) { delete menu; menu = nullptr; }
-    if (scenario) { delete scenario; scenario = nullptr; }
-    if (gameOverScreen) { delete gameOverScreen; gameOverScreen = nullptr; }
-    if (rankingScreen) { delete rankingScreen; rankingScreen = nullptr; }
-    if (configScreen) { delete configScreen; configScreen = nullptr; }
+    // Grava o relatório de memória (com os picos da sessão) enquanto os assets ainda estão registrados.
+    memoria.salvarRelatorio(getMemoryReportPath());
+
+    // Depois, libera os recursos de jogo como imagens e sons.
+    destroyGameAssets();
+    // Entrega as partidas do histórico que ainda não formaram um bloco completo e espera
+    // a thread de gravação terminar tudo: nada do que foi jogado se perde ao sair.
+    enviarHistorico();
+    gravador.descarregar();
+    SaveQueue::Estatisticas gravacoes = gravador.getEstatisticas();
+    if (gravacoes.tarefas > 0) {
+        std::cout << "Gravacoes do historico: " << gravacoes.tarefas << " bloco(s) em " << gravacoes.lotes
+                  << " lote(s), maior latencia " << gravacoes.maiorLatenciaMs << " ms, esperas " << gravacoes.esperas << ".\n";
+    }
     // O playerManager é deletado por último, pois pode ter sido usado por outras telas.
     if (playerManager) { delete playerManager; playerManager = nullptr; }
+    if (placarRemoto) {
+        // Última tentativa de envio; o que o serviço não receber fica em data/ranking_pendentes.txt
+        LeaderboardClient::Estatisticas envio = placarRemoto->getEstatisticas();
+        delete placarRemoto;
+        placarRemoto = nullptr;
+        std::cout << "Ranking compartilhado: " << envio.confirmadas << " partida(s) confirmada(s) em " << envio.lotes
+                  << " lote(s), " << envio.descartadas << " descartada(s), " << envio.falhas << " falha(s) de envio.\n";
+    }
 
     // Por último, destrói os componentes fundamentais do Allegro.
     if (timer) { al_destroy_timer(timer); timer = nullptr; }
     if (queue) { al_destroy_event_queue(queue); queue = nullptr; }
+    if (postProcessor) { delete postProcessor; postProcessor = nullptr; }
+    if (cenaReduzida) { al_destroy_bitmap(cenaReduzida); cenaReduzida = nullptr; } // Sub-bitmap antes do pai
     if (renderTarget) { al_destroy_bitmap(renderTarget); renderTarget = nullptr; }
+    if (fontSeletor) { al_destroy_font(fontSeletor); fontSeletor = nullptr; }
     if (display) { al_destroy_display(display); display = nullptr; }
 
     // Desinstala o subsistema de áudio do Allegro.
     al_uninstall_audio();
 }
 
+/**
+ * @brief Libera os objetos das telas.
+ * Usado no destrutor e ao trocar de resolução (as telas guardam o tamanho da tela e os assets).
+ */
+void GameEngine::destruirTelas() {
+    if (menu) { delete menu; menu = nullptr; }
+    if (scenario) { delete scenario; scenario = nullptr; }
+    if (gameOverScreen) { delete gameOverScreen; gameOverScreen = nullptr; }
+    if (rankingScreen) { delete rankingScreen; rankingScreen = nullptr; }
+    if (configScreen) { delete configScreen; configScreen = nullptr; }
+}
+
 /**
  * @brief Inicializa todos os add-ons necessários do Allegro.
  *
  * Este método configura o Allegro e seus subsistemas (teclado, mouse, áudio,
  * fontes, imagens, primitivas) e cria o display principal, a fila de eventos
  * e o timer do jogo. Em caso de falha, o programa é encerrado.
+ * É o único lugar que inicializa o Allegro: o seletor de resolução e o jogo usam
+ * o mesmo display, que nasce como uma janela comum e recebe o modo escolhido em
+ * `aplicarModoVideo`.
  */
 void GameEngine::initializeAllegroAddons() {
     // Tenta inicializar o Allegro principal.
@@ -136,29 +195,10 @@ void GameEngine::initializeAllegroAddons() {
     al_init_acodec_addon();
     al_reserve_samples(16); // Reserva 16 "slots" para samples de áudio.
 
-    // Define as flags do display baseado no modo de janela escolhido.
-    int flags = 0;
-    switch(windowMode) {
-        case WINDOWED:
-            flags = ALLEGRO_WINDOWED | ALLEGRO_RESIZABLE; // Janela redimensionável.
-            std::cout << "Modo de janela selecionado (WINDOWED).\n";
-            break;
-        case FULLSCREEN:
-            flags = ALLEGRO_FULLSCREEN_WINDOW; // Tela cheia exclusiva.
-            std::cout << "Modo de janela selecionado (FULLSCREEN).\n";
-            break;
-        case BORDERLESS:
-            flags = ALLEGRO_OPENGL | ALLEGRO_NOFRAME; // Sem borda, otimizado para OpenGL.
-            std::cout << "Modo de janela selecionado (BORDERLESS).\n";
-            break;
-        default: // Caso um modo inválido seja fornecido, usa o padrão.
-            flags = ALLEGRO_WINDOWED | ALLEGRO_RESIZABLE;
-            std::cout << "Modo de janela padrão selecionado.\n";
-            break;
-    }
-
-    // Configura as novas flags e tenta criar o display.
-    al_set_new_display_flags(flags);
+    // Cria o display como uma janela comum; tela cheia e sem borda são ligadas depois, com
+    // al_set_display_flag, então o mesmo display serve para o seletor e para qualquer modo.
+    // Os eventos de exposição avisam quando a janela precisa ser redesenhada mesmo com uma tela estática.
+    al_set_new_display_flags(ALLEGRO_WINDOWED | ALLEGRO_RESIZABLE | ALLEGRO_GENERATE_EXPOSE_EVENTS);
     display = al_create_display(screenWidth, screenHeight);
     if (!display) {
         std::cerr << "Falha ao criar display!\n";
@@ -166,16 +206,19 @@ void GameEngine::initializeAllegroAddons() {
     }
 
     // Carrega e define o ícone da janela, se disponível.
-    ALLEGRO_BITMAP* icon = al_load_bitmap("assets/icon.ico");
+    ALLEGRO_BITMAP* icon = pacote.carregarBitmap("assets/icon.ico");
     if (icon) {
         al_set_display_icon(display, icon);
         al_destroy_bitmap(icon); // Destrói o bitmap do ícone após configurá-lo.
     }
 
-    // Cria a fila de eventos, o timer para 60 FPS e um bitmap de renderização (buffer).
+    // Cria a fila de eventos e o timer para 60 FPS.
     queue = al_create_event_queue();
     timer = al_create_timer(1.0 / 60.0); // Timer para uma taxa de atualização de 60 frames por segundo (FPS).
-    renderTarget = al_create_bitmap(screenWidth, screenHeight); // Bitmap para renderização off-screen.
+
+    // Fonte do seletor de resolução: tamanho fixo, não depende da resolução escolhida.
+    fontSeletor = pacote.carregarFonte("assets/editundo.ttf", 20, 0);
+    if (fontSeletor) FontWarmer::preaquecer(fontSeletor); // Glifos prontos antes do primeiro frame do seletor
 
     // Registra as fontes de eventos na fila para que o jogo possa responder a eles.
     al_register_event_source(queue, al_get_display_event_source(display));
@@ -186,71 +229,324 @@ void GameEngine::initializeAllegroAddons() {
     std::cout << "Allegro inicializado com sucesso.\n";
 }
 
+/**
+ * @brief Aplica a resolução e o modo de janela ao display existente.
+ *
+ * Tela cheia usa uma janela do tamanho do monitor (ALLEGRO_FULLSCREEN_WINDOW), como antes;
+ * sem borda é uma janela sem moldura. As duas flags podem ser trocadas com o display
+ * aberto, então nenhum recurso do Allegro precisa ser recriado além dos que têm o
+ * tamanho da tela.
+ */
+void GameEngine::aplicarModoVideo(const ResolutionConfig& modo) {
+    screenWidth = modo.width;
+    screenHeight = modo.height;
+    windowMode = modo.mode;
+    scaleX = (float)screenWidth / resolucaoX;
+    scaleY = (float)screenHeight / resolucaoY;
+
+    switch (windowMode) {
+        case FULLSCREEN:
+            std::cout << "Modo de janela selecionado (FULLSCREEN).\n";
+            break;
+        case BORDERLESS:
+            std::cout << "Modo de janela selecionado (BORDERLESS).\n";
+            break;
+        default:
+            std::cout << "Modo de janela selecionado (WINDOWED).\n";
+            break;
+    }
+    al_set_display_flag(display, ALLEGRO_FRAMELESS, windowMode == BORDERLESS);
+    if (windowMode != FULLSCREEN) al_resize_display(display, screenWidth, screenHeight);
+    if (!al_set_display_flag(display, ALLEGRO_FULLSCREEN_WINDOW, windowMode == FULLSCREEN) && windowMode == FULLSCREEN) {
+        std::cerr << "AVISO: Nao foi possivel entrar em tela cheia. Usando janela.\n";
+        al_resize_display(display, screenWidth, screenHeight);
+    }
+    al_set_target_backbuffer(display);
+
+    // Bitmap para renderização off-screen, usado só quando há efeito de transição ou escala
+    // reduzida, no tamanho novo. A filtragem linear deixa a redução para o desfoque suave.
+    if (postProcessor) { delete postProcessor; postProcessor = nullptr; }
+    if (cenaReduzida) { al_destroy_bitmap(cenaReduzida); cenaReduzida = nullptr; } // Sub-bitmap antes do pai
+    if (renderTarget) { al_destroy_bitmap(renderTarget); renderTarget = nullptr; }
+    ALLEGRO_STATE estadoBitmap;
+    al_store_state(&estadoBitmap, ALLEGRO_STATE_NEW_BITMAP_PARAMETERS);
+    al_add_new_bitmap_flag(ALLEGRO_MIN_LINEAR | ALLEGRO_MAG_LINEAR);
+    renderTarget = al_create_bitmap(screenWidth, screenHeight);
+    al_restore_state(&estadoBitmap);
+    postProcessor = new PostProcessor(screenWidth, screenHeight);
+    aplicarEscalaRender(config.getEscalaRender()); // Região do renderTarget usada pela cena
+    forcarRedesenho = true;
+}
+
+/**
+ * @brief Mostra o seletor de resolução no display do jogo.
+ * O tempo em que o seletor espera o jogador é guardado para não entrar nas medições de inicialização.
+ * @return A configuração escolhida, ou `std::nullopt`.
+ */
+std::optional<ResolutionConfig> GameEngine::escolherResolucao() {
+    auto inicio = std::chrono::steady_clock::now();
+    auto escolha = showResolutionSelector(display, queue, fontSeletor, {screenWidth, screenHeight, windowMode});
+    msNoSeletor += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+    return escolha;
+}
+
+/**
+ * @brief Troca a resolução com o jogo aberto.
+ *
+ * O seletor roda no mesmo display e na mesma fila; com uma opção escolhida, as telas e
+ * os assets são liberados e carregados de novo no tamanho novo (do cache em disco, se
+ * a resolução já foi usada antes). Allegro, display, áudio, jogadores e configurações continuam.
+ */
+void GameEngine::trocarResolucao() {
+    config.salvar();
+    stopCurrentMusic();
+    al_stop_timer(timer); // Os ticks acumulados durante o seletor seriam processados de uma vez depois
+
+    ResolutionConfig atual = {screenWidth, screenHeight, windowMode};
+    auto escolha = escolherResolucao();
+    if (!escolha.has_value() ||
+        (escolha->width == atual.width && escolha->height == atual.height && escolha->mode == atual.mode)) {
+        aplicarModoVideo(atual); // Cancelado ou igual: só volta a janela ao modo anterior
+    } else {
+        destruirTelas();
+        destroyGameAssets();
+        aplicarModoVideo(*escolha);
+        loadGameAssets();
+        std::cout << "Resolucao trocada para " << screenWidth << "x" << screenHeight << " em "
+                  << msCarregamento << " ms.\n";
+    }
+
+    currentPlayer = PlayerManager::ID_INVALIDO; // O menu volta limpo, sem apelido digitado
+    estadoAtual = MENU;
+    if (menu) {
+        menu->resetAction();
+        menu->setInputActive(true);
+    }
+    if (configScreen) configScreen->resetState();
+    forcarRedesenho = true;
+    al_start_timer(timer);
+}
+
 /**
  * @brief Carrega todos os assets (imagens, fontes, sons) necessários para o jogo.
  *
  * Este método é chamado uma única vez na inicialização do GameEngine para carregar
  * todos os recursos gráficos e sonoros que serão utilizados pelas diferentes telas e componentes.
+ * As fontes são carregadas primeiro (a tela de carregamento precisa delas); o resto é
+ * distribuído no AssetLoader: a leitura e a redução das imagens e a leitura dos WAVs
+ * rodam nas threads trabalhadoras, enquanto os envios para a placa de vídeo e a abertura
+ * das músicas rodam aqui, um pouco por frame, com a tela de carregamento sendo animada.
+ * Dos níveis, só o primeiro e o segundo são carregados agora; os outros são carregados
+ * durante o jogo pelo LevelAssetManager, à medida que o jogador avança.
  */
 void GameEngine::loadGameAssets() {
+    double inicioCarregamento = al_get_time();
+
     // Carrega as fontes do jogo, escalando o tamanho com base na resolução.
-    font = al_load_ttf_font("assets/editundo.ttf", static_cast<int>(24 * scaleY), 0);
-    fontlarge = al_load_ttf_font("assets/editundo.ttf", static_cast<int>(42 * scaleY), 0);
+    font = pacote.carregarFonte("assets/editundo.ttf", static_cast<int>(24 * scaleY), 0);
+    fontlarge = pacote.carregarFonte("assets/editundo.ttf", static_cast<int>(42 * scaleY), 0);
     // Se a fonte grande não carregar, usa a fonte normal como alternativa.
     if (!fontlarge) {
         std::cerr << "Erro ao carregar fontlarge. Usando font como fallback.\n";
         fontlarge = font;
     }
 
-    // Carrega as imagens principais do jogo.
-    birdBmp = al_load_bitmap("assets/dragontest.png");
-    bg = al_load_bitmap("assets/menu_background.png");
-    rankingBackground = al_load_bitmap("assets/ranking_bg.png");
-    gameOverBackground = al_load_bitmap("assets/gameover_bg.png");
-
-    // Itera para carregar os assets específicos de cada nível (backgrounds, pipes e músicas).
-    for (int i = 1; i <= 7; ++i) {
-        std::stringstream pathBg, pathPipe, pathMusic;
-        pathBg << "assets/background" << i << ".png";
-        pathPipe << "assets/pipe" << i << ".png";
-        pathMusic << "assets/level" << i << ".ogg";
-
-        ALLEGRO_BITMAP* bgTemp = al_load_bitmap(pathBg.str().c_str());
-        ALLEGRO_BITMAP* pipeTemp = al_load_bitmap(pathPipe.str().c_str());
-        ALLEGRO_AUDIO_STREAM* musicTemp = al_load_audio_stream(pathMusic.str().c_str(), 4, 2048); // Stream de áudio com 4 buffers e buffer size de 2048.
-
-        // Verifica se todos os assets do nível foram carregados com sucesso antes de adicioná-los.
-        if (bgTemp && pipeTemp && musicTemp) {
-            backgroundsLevels.push_back(bgTemp);
-            pipesLevels.push_back(pipeTemp);
-            musicLevels.push_back(musicTemp);
-        } else {
-            std::cerr << "Erro ao carregar arquivos do nível " << i << ": "
-                      << (bgTemp ? "" : "background.png ") << (pipeTemp ? "" : "pipe.png ")
-                      << (musicTemp ? "" : "music.ogg ") << "\n";
-            // Em um jogo real, você poderia carregar assets padrão ou exibir uma mensagem de erro mais proeminente aqui.
+    // Os fundos e os canos são carregados já no tamanho em que aparecem na tela,
+    // a partir do cache em disco quando ele existe para esta resolução.
+    ScaledAssetCache cacheEscalado(getCacheDirectory(), &pacote);
+
+    ALLEGRO_BITMAP* passaroMemoria = nullptr;
+    double msFontes = 0.0;
+
+    // As threads continuam ativas depois da tela de carregamento, para os níveis seguintes.
+    carregador = new AssetLoader();
+    niveis = new LevelAssetManager(*carregador, pacote, getCacheDirectory(), screenWidth, screenHeight,
+                                   (size_t)config.getOrcamentoNiveisMb() * 1024 * 1024, &memoria);
+    {
+
+        // Imagem reduzida: os pixels são preparados em uma thread trabalhadora e enviados
+        // para a placa de vídeo aqui. Escala 0 = preencher a tela (fundos).
+        auto agendarImagem = [&](const std::string& caminho, float escala, ALLEGRO_BITMAP** destino) {
+            auto pixels = std::make_shared<ScaledAssetCache::Pixels>();
+            carregador->adicionar(
+                [&cacheEscalado, caminho, escala, pixels, this]() {
+                    if (escala > 0.0f) {
+                        cacheEscalado.prepararComEscala(caminho, escala, *pixels);
+                    } else {
+                        cacheEscalado.prepararPreenchendo(caminho, screenWidth, screenHeight, *pixels);
+                    }
+                },
+                [this, caminho, pixels, destino]() {
+                    *destino = ScaledAssetCache::criarBitmap(*pixels); // nullptr se a preparação falhou
+                    memoria.registrarBitmap(*destino, MemoryTracker::GLOBAL, caminho);
+                });
+        };
+
+        // Efeito sonoro: lido inteiro para a memória, não depende da thread principal
+        // (só o registro na contabilidade de memória, que não tem trava, fica para ela).
+        auto agendarSom = [&](const char* caminho, ALLEGRO_SAMPLE** destino) {
+            carregador->adicionar([this, caminho, destino]() { *destino = pacote.carregarSample(caminho); },
+                                  [this, caminho, destino]() { memoria.registrarSample(*destino, MemoryTracker::GLOBAL, caminho); });
+        };
+
+        // Música: a stream é aberta na thread principal, junto com o mixer.
+        auto agendarMusica = [&](const std::string& caminho, ALLEGRO_AUDIO_STREAM** destino) {
+            carregador->adicionar(nullptr, [this, caminho, destino]() {
+                *destino = pacote.carregarMusica(caminho, 4, 2048); // Stream de áudio com 4 buffers e buffer size de 2048.
+                memoria.registrarStream(*destino, MemoryTracker::GLOBAL, caminho);
+            });
+        };
+
+        // Rasteriza todos os glifos que o jogo usa, para que o primeiro frame com um texto
+        // novo (dígitos da pontuação, recordes) não trave esperando o FreeType.
+        carregador->adicionar(nullptr, [this, &msFontes]() {
+            msFontes = FontWarmer::preaquecer(font);
+            if (fontlarge != font) msFontes += FontWarmer::preaquecer(fontlarge);
+        });
+
+        // O pássaro é pequeno e desenhado ampliado, então não ganha nada sendo pré-redimensionado:
+        // é decodificado como bitmap de memória e só copiado para a placa de vídeo aqui.
+        carregador->adicionar(
+            [this, &passaroMemoria]() {
+                ALLEGRO_STATE estado;
+                al_store_state(&estado, ALLEGRO_STATE_NEW_BITMAP_PARAMETERS);
+                al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+                passaroMemoria = pacote.carregarBitmap("assets/dragontest.png");
+                al_restore_state(&estado);
+            },
+            [this, &passaroMemoria]() {
+                if (passaroMemoria) {
+                    birdBmp = al_clone_bitmap(passaroMemoria); // Clona com os parâmetros desta thread (vídeo)
+                    al_destroy_bitmap(passaroMemoria);
+                    passaroMemoria = nullptr;
+                }
+            });
+
+        agendarImagem("assets/menu_background.png", 0.0f, &bg);
+        agendarImagem("assets/ranking_bg.png", 0.0f, &rankingBackground);
+        agendarImagem("assets/gameover_bg.png", 0.0f, &gameOverBackground);
+
+        // O primeiro nível (e o segundo, pré-carregado) entram no mesmo carregamento.
+        niveis->definirNivelAtual(0);
+
+        // Carrega a música de fundo para os menus e os samples de efeito sonoro.
+        agendarMusica("assets/menu.ogg", &musicaMenuRankingGameOver);
+        agendarSom("assets/asas.wav", &somFlap);
+        agendarSom("assets/die.wav", &somDie);
+        agendarSom("assets/point.wav", &somPoint);
+        agendarSom("assets/newlevel.wav", &somTransition);
+        agendarSom("assets/hover_button.wav", &somHover);
+
+        // Tela de carregamento: a cada frame, faz alguns envios para a placa de vídeo (limitados
+        // para não travar a animação) e redesenha o progresso. Fechar a janela aqui só é atendido
+        // no fim do carregamento, pois as threads ainda estão usando os destinos acima.
+        while (!carregador->terminou()) {
+            double inicioQuadro = al_get_time();
+            carregador->processarProntos(ORCAMENTO_ENVIO_MS);
+
+            ALLEGRO_EVENT ev;
+            while (al_get_next_event(queue, &ev)) {
+                if (ev.type == ALLEGRO_EVENT_DISPLAY_CLOSE) fecharJogo = true;
+            }
+
+            renderTelaCarregamento(carregador->getProgresso(), al_get_time() - inicioCarregamento);
+            al_flip_display();
+
+            double restante = 1.0 / 60.0 - (al_get_time() - inicioQuadro);
+            if (restante > 0.0) al_rest(restante);
         }
+        std::cout << "Assets carregados por " << carregador->getTrabalhadores() << " thread(s); "
+                  << niveis->getTotalNiveis() << " nivel(is) encontrados.\n";
     }
 
-    // Carrega a música de fundo para os menus e os samples de efeito sonoro.
-    musicaMenuRankingGameOver = al_load_audio_stream("assets/menu.ogg", 4, 2048);
-    somFlap = al_load_sample("assets/asas.wav");
-    somDie = al_load_sample("assets/die.wav");
-    somPoint = al_load_sample("assets/point.wav");
-    somTransition = al_load_sample("assets/newlevel.wav");
-    somHover = al_load_sample("assets/hover_button.wav");
+    std::cout << "Fontes pre-aquecidas em " << msFontes << " ms; primeiro desenho de texto novo: "
+              << FontWarmer::medirDesenho(fontlarge, "Novo recorde geral! 0123456789") << " ms.\n";
+
+    // Com o cache frio todas as imagens são geradas; a diferença entre os dois tempos é o ganho do cache
+    std::cout << "Imagens redimensionadas: " << cacheEscalado.getAcertos() << " lidas do cache ("
+              << cacheEscalado.getMsAcertos() << " ms), " << cacheEscalado.getGeradas() << " geradas a partir do PNG ("
+              << cacheEscalado.getMsGeradas() << " ms).\n";
+
+    // O pássaro vai para o atlas de sprites fixos. Os canos não entram: eles são carregados
+    // e descarregados com o nível, então cada nível tem a sua própria textura de cano.
+    spriteAtlas = new TextureAtlas(4096);
+    spriteAtlas->adicionar(&birdBmp);
+    spriteAtlas->construir();
+    std::cout << "Atlas de sprites criado com " << spriteAtlas->getNumeroPaginas() << " pagina(s).\n";
+    // Na contabilidade entram as páginas; o pássaro só conta se ficou fora delas (sub-bitmap conta zero).
+    for (int i = 0; i < spriteAtlas->getNumeroPaginas(); ++i) {
+        memoria.registrarBitmap(spriteAtlas->getPagina(i), MemoryTracker::GLOBAL, "atlas de sprites");
+    }
+    memoria.registrarBitmap(birdBmp, MemoryTracker::GLOBAL, "assets/dragontest.png");
+    std::cout << "Memoria dos assets: " << memoria.getTotal().atual / (1024 * 1024) << " MB em "
+              << memoria.getQuantidade() << " asset(s).\n";
 
     // Instancia os objetos das diferentes telas do jogo e configura o som de hover para o menu.
     menu = new Menu(font, fontlarge, bg);
     menu->setHoverSound(somHover);
 
     rankingScreen = new RankingScreen(fontlarge, rankingBackground, playerManager, screenWidth, screenHeight);
-    gameOverScreen = new GameOverScreen(font, gameOverBackground);
+    gameOverScreen = new GameOverScreen(font, fontlarge, gameOverBackground);
     gameOverScreen->setHoverSound(somHover);
 
-    configScreen = new ConfigScreen(fontlarge, rankingBackground, screenWidth, screenHeight); // Cria a tela de configurações.
+    configScreen = new ConfigScreen(fontlarge, rankingBackground, screenWidth, screenHeight, &config); // Cria a tela de configurações.
     // O cenário é inicializado com os assets do primeiro nível (índice 0).
-    scenario = new Scenario(backgroundsLevels[0], birdBmp, pipesLevels[0], fontlarge, screenWidth, screenHeight, somPoint, somDie);
+    scenario = criarCenarioPrimeiroNivel();
+
+    msCarregamento = (al_get_time() - inicioCarregamento) * 1000.0;
+}
+
+/**
+ * @brief Desenha a tela de carregamento no display: texto animado, barra e porcentagem.
+ * @param progresso Fração dos assets já carregados (0 a 1).
+ * @param segundos Tempo desde o início do carregamento (anima os pontos).
+ */
+void GameEngine::renderTelaCarregamento(float progresso, double segundos) {
+    al_set_target_backbuffer(display);
+    al_clear_to_color(al_map_rgb(12, 10, 24));
+
+    float larguraBarra = 600.0f * scaleX;
+    float alturaBarra = 24.0f * scaleY;
+    float x = (screenWidth - larguraBarra) / 2.0f;
+    float y = screenHeight * 0.55f;
+
+    // Contorno e preenchimento da barra de progresso
+    al_draw_rectangle(x, y, x + larguraBarra, y + alturaBarra, al_map_rgb(230, 230, 230), 2.0f * scaleY);
+    if (progresso > 0.0f) {
+        al_draw_filled_rectangle(x + 4.0f * scaleX, y + 4.0f * scaleY,
+                                 x + 4.0f * scaleX + (larguraBarra - 8.0f * scaleX) * progresso,
+                                 y + alturaBarra - 4.0f * scaleY, al_map_rgb(255, 200, 60));
+    }
+
+    if (fontlarge) {
+        // "Carregando" com 0 a 3 pontos, trocando três vezes por segundo
+        static const char* const PONTOS[4] = {"", ".", "..", "..."};
+        char texto[32];
+        snprintf(texto, sizeof(texto), "Carregando%s", PONTOS[(int)(segundos * 3.0) % 4]);
+        float larguraTexto = (float)al_get_text_width(fontlarge, "Carregando...");
+        al_draw_text(fontlarge, al_map_rgb(255, 255, 255), (screenWidth - larguraTexto) / 2.0f,
+                     y - al_get_font_line_height(fontlarge) - 20.0f * scaleY, ALLEGRO_ALIGN_LEFT, texto);
+    }
+    if (font) {
+        char porcentagem[16];
+        snprintf(porcentagem, sizeof(porcentagem), "%d%%", (int)(progresso * 100.0f + 0.5f));
+        al_draw_text(font, al_map_rgb(200, 200, 200), screenWidth / 2.0f, y + alturaBarra + 12.0f * scaleY,
+                     ALLEGRO_ALIGN_CENTER, porcentagem);
+    }
+}
+
+/**
+ * @brief Cria um cenário novo no primeiro nível.
+ * Antes, garante que o nível está carregado e volta o gerenciador de níveis para ele.
+ * Se o nível falhou ao carregar, o cenário usa os assets do nível que o substitui.
+ * @return O cenário criado.
+ */
+Scenario* GameEngine::criarCenarioPrimeiroNivel() {
+    if (!niveis->garantirResidente(0)) {
+        std::cerr << "Erro: Nenhum nivel pode ser carregado; o cenario fica sem fundo e canos.\n";
+    }
+    niveis->definirNivelAtual(0);
+    return new Scenario(niveis->getFundo(0), birdBmp, niveis->getCano(0), fontlarge, screenWidth, screenHeight, somPoint, somDie);
 }
 
 /**
@@ -260,12 +556,21 @@ void GameEngine::loadGameAssets() {
  * todas as imagens, fontes e sons, prevenindo vazamentos de memória.
  */
 void GameEngine::destroyGameAssets() {
-    // Destrói os bitmaps principais, se não forem nulos.
-    if (birdBmp) { al_destroy_bitmap(birdBmp); birdBmp = nullptr; }
+    // O pássaro e os canos pertencem ao atlas: destruí-lo libera todos de uma vez.
+    if (spriteAtlas) {
+        for (int i = 0; i < spriteAtlas->getNumeroPaginas(); ++i) memoria.remover(spriteAtlas->getPagina(i));
+        memoria.remover(birdBmp);
+        delete spriteAtlas;
+        spriteAtlas = nullptr;
+    }
+    birdBmp = nullptr;
+
+    // Destrói os bitmaps principais, se não forem nulos (tirando-os antes da contabilidade de memória;
+    // os assets dos níveis saem junto com o gerenciador).
     if (pipeBmp) { al_destroy_bitmap(pipeBmp); pipeBmp = nullptr; }
-    if (bg) { al_destroy_bitmap(bg); bg = nullptr; }
-    if (rankingBackground) { al_destroy_bitmap(rankingBackground); rankingBackground = nullptr; }
-    if (gameOverBackground) { al_destroy_bitmap(gameOverBackground); gameOverBackground = nullptr; }
+    if (bg) { memoria.remover(bg); al_destroy_bitmap(bg); bg = nullptr; }
+    if (rankingBackground) { memoria.remover(rankingBackground); al_destroy_bitmap(rankingBackground); rankingBackground = nullptr; }
+    if (gameOverBackground) { memoria.remover(gameOverBackground); al_destroy_bitmap(gameOverBackground); gameOverBackground = nullptr; }
 
     // Destrói as fontes. É importante verificar se 'fontlarge' é diferente de 'font'
     // para não tentar destruir a mesma fonte duas vezes, caso 'fontlarge' tenha sido um fallback.
@@ -273,23 +578,20 @@ void GameEngine::destroyGameAssets() {
     if (fontlarge && fontlarge != font) { al_destroy_font(fontlarge); fontlarge = nullptr; }
 
     // Destrói os streams de áudio e limpa o vetor.
-    if (musicaMenuRankingGameOver) { al_destroy_audio_stream(musicaMenuRankingGameOver); musicaMenuRankingGameOver = nullptr; }
+    if (musicaMenuRankingGameOver) { memoria.remover(musicaMenuRankingGameOver); al_destroy_audio_stream(musicaMenuRankingGameOver); musicaMenuRankingGameOver = nullptr; }
     // OBS: 'musicaEmJogo' não parece ser usada. Se usada, adicionar al_destroy_audio_stream aqui.
-    for (auto& m : musicLevels) { al_destroy_audio_stream(m); }
-    musicLevels.clear(); // Limpa o vetor após destruir os streams.
 
-    // Destrói os bitmaps de backgrounds e pipes de cada nível e limpa os vetores.
-    for (auto& b : backgroundsLevels) { al_destroy_bitmap(b); }
-    backgroundsLevels.clear();
-    for (auto& p : pipesLevels) { al_destroy_bitmap(p); }
-    pipesLevels.clear();
+    // Encerra as threads antes de liberar os níveis: nenhum trabalho pode ficar usando o gerenciador.
+    if (carregador) { delete carregador; carregador = nullptr; }
+    // Libera os fundos, canos e músicas dos níveis que estiverem carregados.
+    if (niveis) { delete niveis; niveis = nullptr; }
 
     // Destrói os samples de som.
-    if (somFlap) { al_destroy_sample(somFlap); somFlap = nullptr; }
-    if (somDie) { al_destroy_sample(somDie); somDie = nullptr; }
-    if (somPoint) { al_destroy_sample(somPoint); somPoint = nullptr; }
-    if (somTransition) { al_destroy_sample(somTransition); somTransition = nullptr; }
-    if (somHover) { al_destroy_sample(somHover); somHover = nullptr; }
+    if (somFlap) { memoria.remover(somFlap); al_destroy_sample(somFlap); somFlap = nullptr; }
+    if (somDie) { memoria.remover(somDie); al_destroy_sample(somDie); somDie = nullptr; }
+    if (somPoint) { memoria.remover(somPoint); al_destroy_sample(somPoint); somPoint = nullptr; }
+    if (somTransition) { memoria.remover(somTransition); al_destroy_sample(somTransition); somTransition = nullptr; }
+    if (somHover) { memoria.remover(somHover); al_destroy_sample(somHover); somHover = nullptr; }
 }
 
 /**
@@ -337,6 +639,7 @@ void GameEngine::handleInput(ALLEGRO_EVENT& ev) {
         // No estado de Menu:
         if (estadoAtual == MENU) {
             menu->onClick(ev.mouse.x, ev.mouse.y); // Passa o clique para o objeto Menu.
+            atualizarSugestoes(); // O clique pode ter escolhido uma sugestão ou fechado o campo de apelido.
             int acao = menu->getSelectedAction(); // Obtém a ação selecionada no menu.
 
             if (acao == 1) { // Ação "Jogar"
@@ -344,12 +647,11 @@ void GameEngine::handleInput(ALLEGRO_EVENT& ev) {
                     menu->displayWarning("Digite seu apelido para jogar!"); // Exibe alerta se o apelido estiver vazio.
                 } else {
                     std::string nick = menu->getApelido();
-                    currentPlayer = playerManager->buscar(nick); // Tenta encontrar o jogador existente.
-                    if (!currentPlayer) {
-                        playerManager->cadastrar(nick, nick); // Se não existir, cadastra um novo.
-                        currentPlayer = playerManager->buscar(nick); // Busca novamente para obter o ponteiro.
-                    }
-                    if (currentPlayer) {
+                    // Encontra o jogador existente ou, se não existir, cadastra um novo.
+                    currentPlayer = playerManager->cadastrar(nick, nick);
+                    if (jogadorAtual()) {
+                        // A primeira partida marca o início da medição até o primeiro frame de jogo.
+                        if (!jogoJaMostrado) inicioPartida = std::chrono::steady_clock::now();
                         currentLevel = 0; // Reinicia o nível para o primeiro.
                         inLevelTransition = true; // Inicia a transição de nível.
                         transitionBlurTimer = 0.0f;
@@ -367,7 +669,7 @@ void GameEngine::handleInput(ALLEGRO_EVENT& ev) {
             } else if (acao == 2) { // Ação "Ranking"
                 std::string apelidoDigitado = menu->getApelido();
                 // Define o jogador atual para a tela de ranking, se um apelido foi digitado.
-                currentPlayer = apelidoDigitado.empty() ? nullptr : playerManager->buscar(apelidoDigitado);
+                currentPlayer = apelidoDigitado.empty() ? PlayerManager::ID_INVALIDO : playerManager->buscarId(apelidoDigitado);
 
                 rankingScreen->resetState(); // Reseta o estado da tela de ranking.
                 estadoAtual = RANKING; // Muda para o estado de ranking.
@@ -399,8 +701,10 @@ void GameEngine::handleInput(ALLEGRO_EVENT& ev) {
                 if (scenario) { delete scenario; scenario = nullptr; } // Deleta o cenário anterior.
 
                 // Cria um novo cenário, reiniciando o jogo.
-                scenario = new Scenario(backgroundsLevels[0], birdBmp, pipesLevels[0], fontlarge, screenWidth, screenHeight, somPoint, somDie);
+                scenario = criarCenarioPrimeiroNivel();
 
+                inicioPartidaAtual = al_get_time(); // Começa a contar a duração da partida nova.
+                batidasPartida = 0;
                 estadoAtual = JOGANDO; // Volta para o estado de jogo.
             } else if (acao == 2) { // Ação "Voltar ao Menu"
                 estadoAtual = MENU; // Volta para o menu principal.
@@ -411,6 +715,19 @@ void GameEngine::handleInput(ALLEGRO_EVENT& ev) {
     }
     // Se o evento for uma tecla pressionada.
     else if (ev.type == ALLEGRO_EVENT_KEY_DOWN) {
+        // F3 liga/desliga o HUD de depuração em qualquer tela.
+        if (ev.keyboard.keycode == ALLEGRO_KEY_F3) {
+            debugHudVisivel = !debugHudVisivel;
+            return;
+        }
+        // F4 grava o relatório de memória dos assets (data/memoria.txt).
+        if (ev.keyboard.keycode == ALLEGRO_KEY_F4) {
+            if (memoria.salvarRelatorio(getMemoryReportPath())) {
+                std::cout << "Relatorio de memoria gravado em " << getMemoryReportPath() << "\n";
+            }
+            return;
+        }
+
         if (estadoAtual == JOGANDO) { // Se estiver jogando.
             if (ev.keyboard.keycode == ALLEGRO_KEY_ESCAPE) { // Se a tecla ESC for pressionada.
                 estadoAtual = MENU; // Volta para o menu.
@@ -419,11 +736,12 @@ void GameEngine::handleInput(ALLEGRO_EVENT& ev) {
             } else if (ev.keyboard.keycode == ALLEGRO_KEY_SPACE) { // Se a tecla ESPAÇO for pressionada.
                 if (scenario) {
                     scenario->getBird().flap(); // Faz o pássaro "voar".
+                    ++batidasPartida;
                     if (somFlap) al_play_sample(somFlap, 1.0, 0.0, 1.0, ALLEGRO_PLAYMODE_ONCE, NULL); // Toca o som de "flap".
                 }
             }
         } else if (estadoAtual == RANKING) { // Se estiver na tela de Ranking.
-            int acaoRanking = rankingScreen->handleEvent(ev); // Lida com o evento na tela de ranking.
+            int acaoRanking = rankingScreen->handleEvent(ev, jogadorAtual()); // Lida com o evento na tela de ranking (rolagem e volta).
             if (acaoRanking == 1) { // Ação "Voltar"
                 estadoAtual = MENU; // Volta para o menu.
                 menu->resetAction();
@@ -432,10 +750,16 @@ void GameEngine::handleInput(ALLEGRO_EVENT& ev) {
         } else if (estadoAtual == CONFIG_SCREEN) { // Se estiver na tela de Configurações.
             int acaoConfig = configScreen->handleEvent(ev); // Lida com o evento na tela de configurações.
             if (acaoConfig == 1) { // Ação "Voltar"
+                config.salvar(); // Guarda as opções escolhidas para as próximas execuções.
                 estadoAtual = MENU; // Volta para o menu.
                 menu->resetAction();
                 menu->setInputActive(true);
                 configScreen->resetState(); // Reseta o estado da tela de configurações.
+            } else if (acaoConfig == 2) { // Alguma opção mudou: aplica na hora.
+                controleEscala.setEscala(config.getEscalaRender());
+                aplicarEscalaRender(config.getEscalaRender());
+            } else if (acaoConfig == 3) { // Trocar a resolução, sem reiniciar o jogo.
+                trocarResolucao();
             }
         }
     }
@@ -444,6 +768,7 @@ void GameEngine::handleInput(ALLEGRO_EVENT& ev) {
         if (estadoAtual == MENU) {
             // Repassa o caractere digitado para o menu processar (para o campo de apelido).
             menu->onChar(ev.keyboard.unichar, ev.keyboard.keycode);
+            atualizarSugestoes(); // Cada tecla estreita (ou alarga) as sugestões da anterior.
         }
     }
 }
@@ -459,6 +784,9 @@ void GameEngine::handleInput(ALLEGRO_EVENT& ev) {
  * @param deltaTime O tempo decorrido desde a última atualização, em segundos.
  */
 void GameEngine::update(double deltaTime) {
+    // Termina, na thread principal, os níveis que as threads de carregamento já prepararam.
+    if (carregador) carregador->processarProntos(ORCAMENTO_ENVIO_MS);
+
     // Ações diferentes para cada estado do jogo.
     switch (estadoAtual) {
         case MENU:
@@ -479,13 +807,13 @@ void GameEngine::update(double deltaTime) {
 
                 // Deleta e recria o cenário para garantir que ele esteja em seu estado inicial.
                 if (scenario) { delete scenario; scenario = nullptr; }
-                scenario = new Scenario(backgroundsLevels[0], birdBmp, pipesLevels[0], fontlarge, screenWidth, screenHeight, somPoint, somDie);
-                
                 stopCurrentMusic();
+                scenario = criarCenarioPrimeiroNivel();
+
                 // Inicia a música do primeiro nível.
-                if (!musicLevels.empty()) {
-                    al_rewind_audio_stream(musicLevels[0]);
-                    playMusic(musicLevels[0]);
+                if (niveis->getMusica(0)) {
+                    al_rewind_audio_stream(niveis->getMusica(0));
+                    playMusic(niveis->getMusica(0));
                 } else {
                     std::cerr << "Erro: Nenhuma música de nível disponível para iniciar o jogo.\n";
                 }
@@ -496,6 +824,8 @@ void GameEngine::update(double deltaTime) {
             // Quando a duração da transição de blur for atingida.
             if (transitionBlurTimer >= TRANSITION_BLUR_DURATION) {
                 estadoAtual = JOGANDO; // Muda para o estado de jogo ativo.
+                inicioPartidaAtual = al_get_time(); // A partida começa depois da transição inicial.
+                batidasPartida = 0;
                 isTransitionBlurActive = false; // Desativa o efeito de blur.
                 transitionBlurTimer = 0.0f; // Reseta o timer.
                 inLevelTransition = false; // Finaliza a transição de nível.
@@ -513,22 +843,32 @@ void GameEngine::update(double deltaTime) {
                 if (transitionBlurTimer >= TRANSITION_BLUR_DURATION) { // Quando a transição termina.
                     currentLevel++; // Avança para o próximo nível.
                     // Garante que o nível não exceda o número de níveis disponíveis.
-                    if (currentLevel >= (int)backgroundsLevels.size()) {
-                        currentLevel = (int)backgroundsLevels.size() - 1; // Fica no último nível.
+                    if (currentLevel >= niveis->getTotalNiveis()) {
+                        currentLevel = niveis->getTotalNiveis() - 1; // Fica no último nível.
                     }
 
+                    // O nível foi pré-carregado durante o anterior; só espera se ainda não terminou.
+                    // Se ele falhou ao carregar, os getters devolvem os assets do substituto;
+                    // se nem isso existe, o cenário continua com os assets atuais.
+                    bool temAssets = niveis->garantirResidente(currentLevel);
+
                     // Aumenta a velocidade do cenário e troca os assets para o novo nível.
                     scenario->increaseSpeedByPercent(10.0f);
-                    scenario->changeBackgroundAndPipe(backgroundsLevels[currentLevel], pipesLevels[currentLevel]);
+                    if (temAssets) {
+                        scenario->changeBackgroundAndPipe(niveis->getFundo(currentLevel), niveis->getCano(currentLevel));
+                    }
                     scenario->setCurrentLevel(currentLevel); // Atualiza o nível atual no cenário.
 
-                    // Configura os pipes como infinitos apenas no último cenário (nível 6).
-                    scenario->setInfinitePipes(currentLevel == 6);
+                    // Configura os pipes como infinitos apenas no último cenário.
+                    scenario->setInfinitePipes(currentLevel == niveis->getTotalNiveis() - 1);
 
                     stopCurrentMusic();
-                    if (currentLevel < (int)musicLevels.size()) {
-                         al_rewind_audio_stream(musicLevels[currentLevel]); // Rebobina a música do novo nível.
-                         playMusic(musicLevels[currentLevel]); // Toca a música do novo nível.
+                    // Com o cenário e a música trocados, o nível anterior pode ser descarregado
+                    // e o seguinte começa a ser pré-carregado.
+                    niveis->definirNivelAtual(currentLevel);
+                    if (niveis->getMusica(currentLevel)) {
+                         al_rewind_audio_stream(niveis->getMusica(currentLevel)); // Rebobina a música do novo nível.
+                         playMusic(niveis->getMusica(currentLevel)); // Toca a música do novo nível.
                     } else {
                         std::cerr << "Erro: Nenhuma música para o nível " << currentLevel << ".\n";
                     }
@@ -541,11 +881,11 @@ void GameEngine::update(double deltaTime) {
             }
 
             // Se não estiver em transição, gerencia a música do jogo ativo.
-            if (currentLevel < (int)musicLevels.size()) {
-                if (musicaAtualTocando != musicLevels[currentLevel] || !al_get_audio_stream_playing(musicLevels[currentLevel])) {
+            if (ALLEGRO_AUDIO_STREAM* musicaNivel = niveis->getMusica(currentLevel)) {
+                if (musicaAtualTocando != musicaNivel || !al_get_audio_stream_playing(musicaNivel)) {
                     stopCurrentMusic();
-                    al_rewind_audio_stream(musicLevels[currentLevel]);
-                    playMusic(musicLevels[currentLevel]);
+                    al_rewind_audio_stream(musicaNivel);
+                    playMusic(musicaNivel);
                 }
             } else {
                 std::cerr << "Erro: Índice de nível de música fora dos limites.\n";
@@ -553,7 +893,7 @@ void GameEngine::update(double deltaTime) {
             
             if (scenario) {
                 // Garante que os pipes sejam infinitos no último nível.
-                scenario->setInfinitePipes(currentLevel == 6);
+                scenario->setInfinitePipes(currentLevel == niveis->getTotalNiveis() - 1);
 
                 scenario->update((float)deltaTime); // Atualiza a lógica do cenário do jogo.
 
@@ -566,7 +906,7 @@ void GameEngine::update(double deltaTime) {
                     int expectedLevel = totalScore / 15;
 
                     // Se o jogador deveria estar em um nível mais avançado e ainda há níveis para avançar.
-                    if (expectedLevel > currentLevel && currentLevel + 1 < (int)backgroundsLevels.size()) {
+                    if (expectedLevel > currentLevel && currentLevel + 1 < niveis->getTotalNiveis()) {
                         inLevelTransition = true; // Inicia uma transição de nível.
                         transitionBlurTimer = 0.0f;
                         stopCurrentMusic();
@@ -579,25 +919,45 @@ void GameEngine::update(double deltaTime) {
 
                     lastScore = scenario->getScore(); // Pega a pontuação final da partida.
                     // Obtém o recorde pessoal do jogador atual (ou 0 se não houver jogador).
-                    lastRecordPessoal = currentPlayer ? currentPlayer->getMaiorPontuacao() : 0;
-
-                    // Encontra o maior score geral entre todos os jogadores.
-                    const auto& jogadores = playerManager->getJogadores();
-                    int maiorScore = 0;
-                    for (const auto& p : jogadores) {
-                        if (p.getMaiorPontuacao() > maiorScore) {
-                            maiorScore = p.getMaiorPontuacao();
-                        }
-                    }
-                    lastRecordGeral = maiorScore;
+                    Player* jogador = jogadorAtual();
+                    lastRecordPessoal = jogador ? jogador->getMaiorPontuacao() : 0;
+
+                    // O recorde geral é o primeiro do ranking (sem percorrer os jogadores).
+                    lastRecordGeral = playerManager->getRanking().getRecorde();
 
                     // Verifica se o jogador bateu o recorde pessoal ou geral.
                     lastBateuRecordePessoal = (lastScore > lastRecordPessoal);
                     lastBateuRecordeGeral = (lastScore > lastRecordGeral);
 
-                    if (currentPlayer) {
-                        currentPlayer->adicionarPartida(lastScore); // Adiciona a partida ao histórico do jogador.
-                        playerManager->salvar(); // Salva os dados atualizados dos jogadores.
+                    if (jogador) {
+                        // Adiciona a partida ao histórico do jogador e a anota no diário (sem regravar o arquivo inteiro).
+                        playerManager->registrarPartida(currentPlayer, lastScore);
+                        if (rankingScreen) rankingScreen->invalidar(); // O ranking composto ficou desatualizado.
+
+                        // "Melhor que X%": os histogramas já contam esta partida e o novo recorde do jogador.
+                        if (gameOverScreen) {
+                            gameOverScreen->setPercentis(playerManager->getPontuacoesPartidas().percentualAbaixo(lastScore),
+                                                         playerManager->getRecordesJogadores().percentualAbaixo(lastScore));
+                        }
+
+                        // Guarda a partida completa no histórico e guarda as estatísticas do jogador para o HUD (F3).
+                        // O histórico guarda o apelido: o Id do PlayerManager só vale neste jogo
+                        MatchHistory::Partida partida;
+                        partida.jogador = historico.cadastrarApelido(jogador->getApelido());
+                        partida.pontuacao = lastScore;
+                        partida.nivel = currentLevel + 1;
+                        partida.duracaoMs = (uint32_t)((al_get_time() - inicioPartidaAtual) * 1000.0);
+                        partida.batidas = batidasPartida;
+                        partida.instante = (uint32_t)time(nullptr);
+                        historico.registrar(partida);
+                        std::vector<int> percentis = historico.calcularPercentis(partida.jogador, {50.0, 90.0});
+                        historicoPartidas = historico.contar(partida.jogador);
+                        historicoMedia = historico.media(partida.jogador);
+                        historicoMediana = percentis[0];
+                        historicoP90 = percentis[1];
+                        if (historico.getPendentes() >= LOTE_HISTORICO) enviarHistorico(); // Grava em outra thread
+                    } else if (gameOverScreen) {
+                        gameOverScreen->setPercentis(-1.0, -1.0); // Sem jogador, nada para comparar.
                     }
 
                     estadoAtual = GAME_OVER; // Muda para o estado de Game Over.
@@ -617,6 +977,7 @@ void GameEngine::update(double deltaTime) {
                 playMusic(musicaMenuRankingGameOver);
             }
             // A tela de Game Over geralmente não precisa de 'update' complexo.
+            atualizarPosicaoGeral(); // A posição chega do serviço depois que a partida é confirmada
             break;
 
         case RANKING:
@@ -646,19 +1007,11 @@ void GameEngine::renderMenu(float deltaTime) {
 /**
  * @brief Renderiza o cenário de jogo (gameplay).
  * Desenha o pássaro, os canos, o fundo e a pontuação durante o jogo ativo.
- * Também aplica o efeito de blur durante as transições de nível.
+ * O efeito de blur das transições de nível é aplicado depois, sobre a cena pronta.
  */
 void GameEngine::renderGame() {
+    // O desfoque da transição é aplicado depois, pelo PostProcessor (ver run()).
     if (scenario) scenario->render();
-
-    // Se o efeito de blur da transição estiver ativo, desenha um retângulo semi-transparente.
-    if (isTransitionBlurActive) {
-        float alpha = transitionBlurTimer / TRANSITION_BLUR_DURATION;
-        // Limita o alpha para não exceder 1.0 ou ser negativo.
-        if (alpha > 1.0f) alpha = 1.0f;
-        if (alpha < 0.0f) alpha = 0.0f;
-        al_draw_filled_rectangle(0, 0, screenWidth, screenHeight, al_map_rgba_f(0, 0, 0, alpha));
-    }
 }
 
 /**
@@ -679,10 +1032,18 @@ void GameEngine::renderGameOver() {
  */
 void GameEngine::renderRanking(float deltaTime) {
     if (rankingScreen) {
-        rankingScreen->render(currentPlayer, deltaTime);
+        rankingScreen->render(jogadorAtual(), deltaTime);
     }
 }
 
+/**
+ * @brief Retorna o jogador ativo, buscado pelo Id a cada uso.
+ * @return O jogador, ou nullptr se não houver um.
+ */
+Player* GameEngine::jogadorAtual() {
+    return playerManager ? playerManager->getJogador(currentPlayer) : nullptr;
+}
+
 /**
  * @brief Renderiza a tela de Configurações.
  * @param deltaTime O tempo decorrido, usado para possíveis animações na tela de configurações.
@@ -693,6 +1054,192 @@ void GameEngine::renderConfigScreen(float deltaTime) {
     }
 }
 
+/**
+ * @brief Informa se o frame atual precisa ser desenhado.
+ * @return true se a tela mudou desde o último frame desenhado.
+ */
+bool GameEngine::telaPrecisaRedesenhar() {
+    // Troca de tela, janela exposta e HUD ligado (FPS muda sempre) exigem desenho
+    if (forcarRedesenho || debugHudVisivel || estadoAtual != ultimoEstadoDesenhado) {
+        return true;
+    }
+
+    switch (estadoAtual) {
+        case GAME_OVER:
+            return gameOverScreen && gameOverScreen->precisaRedesenhar(lastScore, lastRecordPessoal, lastRecordGeral,
+                                                                       lastBateuRecordePessoal, lastBateuRecordeGeral);
+        case RANKING:
+            return rankingScreen && rankingScreen->precisaRedesenhar(jogadorAtual());
+        case CONFIG_SCREEN:
+            return configScreen && configScreen->precisaRedesenhar();
+        default:
+            // Menu (cursor piscando, hover) e gameplay mudam a cada frame
+            return true;
+    }
+}
+
+/**
+ * @brief Calcula a intensidade do efeito de transição.
+ * No início do jogo a cena surge do preto (1 -> 0); entre níveis ela escurece (0 -> 1).
+ * @return A intensidade do efeito, entre 0 e 1.
+ */
+float GameEngine::intensidadeEfeito() const {
+    float intensidade = 0.0f;
+    if (estadoAtual == INICIANDO_JOGO) {
+        intensidade = 1.0f - (transitionBlurTimer / TRANSITION_BLUR_DURATION);
+    } else if (estadoAtual == JOGANDO && isTransitionBlurActive) {
+        intensidade = transitionBlurTimer / TRANSITION_BLUR_DURATION;
+    }
+    // Garante que o valor esteja entre 0.0 e 1.0.
+    if (intensidade < 0.0f) intensidade = 0.0f;
+    if (intensidade > 1.0f) intensidade = 1.0f;
+    return intensidade;
+}
+
+/**
+ * @brief Troca a escala de renderização.
+ * Cria um sub-bitmap no canto do `renderTarget` com o tamanho da nova escala.
+ * @param escala A nova escala (0.5 a 1.0).
+ */
+void GameEngine::aplicarEscalaRender(float escala) {
+    escala = GameConfig::ajustarEscala(escala);
+    if (cenaReduzida) { al_destroy_bitmap(cenaReduzida); cenaReduzida = nullptr; }
+    escalaRender = escala;
+    forcarRedesenho = true;
+    if (!renderTarget) return;
+
+    int largura = (int)(screenWidth * escala + 0.5f);
+    int altura = (int)(screenHeight * escala + 0.5f);
+    cenaReduzida = al_create_sub_bitmap(renderTarget, 0, 0, largura > 0 ? largura : 1, altura > 0 ? altura : 1);
+    if (!cenaReduzida) {
+        std::cerr << "AVISO: Nao foi possivel criar a area da escala de renderizacao. Usando resolucao cheia.\n";
+        escalaRender = 1.0f;
+    }
+}
+
+/**
+ * @brief Busca no índice de prefixos os apelidos que completam o texto digitado no menu.
+ * O próprio apelido digitado, se já existir, não aparece como sugestão.
+ */
+void GameEngine::atualizarSugestoes() {
+    std::vector<std::string> textos;
+    std::string prefixo = menu->getApelido();
+    if (menu->isInputActive() && !prefixo.empty()) {
+        for (PlayerManager::Id id : playerManager->sugerirApelidos(prefixo, Menu::MAX_SUGESTOES + 1)) {
+            const std::string& apelido = playerManager->getJogador(id)->getApelido();
+            if (apelido != prefixo && (int)textos.size() < Menu::MAX_SUGESTOES) textos.push_back(apelido);
+        }
+    }
+    menu->setSugestoes(textos);
+}
+
+/**
+ * @brief Copia para a tela de Game Over a posição do jogador atual no ranking compartilhado.
+ * Sem serviço, sem jogador ou antes da primeira resposta, a linha fica escondida.
+ */
+void GameEngine::atualizarPosicaoGeral() {
+    if (!gameOverScreen) return;
+    Player* jogador = jogadorAtual();
+    size_t posicao = 0;
+    size_t total = 0;
+    if (placarRemoto && jogador && placarRemoto->getPosicao(jogador->getApelido(), posicao, total)) {
+        gameOverScreen->setPosicaoGeral(posicao, total);
+    } else {
+        gameOverScreen->setPosicaoGeral(0, 0);
+    }
+}
+
+/**
+ * @brief Entrega o bloco das partidas pendentes do histórico à thread de gravação.
+ */
+void GameEngine::enviarHistorico() {
+    std::vector<unsigned char> bloco;
+    if (historico.montarBloco(bloco)) gravador.acrescentar(historico.getCaminho(), std::move(bloco));
+}
+
+/**
+ * @brief Desenha o HUD de depuração (F3).
+ * Os números de desenho são do frame anterior, já que o frame atual ainda está sendo montado.
+ */
+void GameEngine::renderDebugHud() {
+    if (!font) return;
+
+    char linha[96];
+    float y = 8.0f;
+    float alturaLinha = (float)al_get_font_line_height(font);
+
+    snprintf(linha, sizeof(linha), "FPS: %.1f", fpsMedido);
+    al_draw_text(font, al_map_rgb(255, 255, 0), 8, y, ALLEGRO_ALIGN_LEFT, linha);
+    y += alturaLinha;
+    snprintf(linha, sizeof(linha), "Desenhos: %d (fora da tela: %d)", RenderStats::getDesenhos(), RenderStats::getDescartes());
+    al_draw_text(font, al_map_rgb(255, 255, 0), 8, y, ALLEGRO_ALIGN_LEFT, linha);
+    y += alturaLinha;
+    snprintf(linha, sizeof(linha), "Lotes: %d", RenderStats::getLotes());
+    al_draw_text(font, al_map_rgb(255, 255, 0), 8, y, ALLEGRO_ALIGN_LEFT, linha);
+    y += alturaLinha;
+    if (config.isEscalaDinamica()) {
+        snprintf(linha, sizeof(linha), "Escala: %d%% (dinamica, media %.1f ms)",
+                 (int)(escalaRender * 100.0f + 0.5f), controleEscala.getMediaMs());
+    } else {
+        snprintf(linha, sizeof(linha), "Escala: %d%%", (int)(escalaRender * 100.0f + 0.5f));
+    }
+    al_draw_text(font, al_map_rgb(255, 255, 0), 8, y, ALLEGRO_ALIGN_LEFT, linha);
+    if (niveis) {
+        const LevelAssetManager::Estatisticas& n = niveis->getEstatisticas();
+        y += alturaLinha;
+        snprintf(linha, sizeof(linha), "Niveis: %d/%d na memoria, %.1f/%d MB (pico %.1f), esperas %d",
+                 n.residentes, niveis->getTotalNiveis(), n.bytesResidentes / (1024.0 * 1024.0),
+                 (int)(niveis->getOrcamento() / (1024 * 1024)), n.picoBytes / (1024.0 * 1024.0), n.esperas);
+        al_draw_text(font, al_map_rgb(255, 255, 0), 8, y, ALLEGRO_ALIGN_LEFT, linha);
+    }
+
+    // Memória de todos os assets; em vermelho acima do orçamento
+    y += alturaLinha;
+    snprintf(linha, sizeof(linha), "Memoria: %.1f/%d MB (pico %.1f)  img %.1f  som %.1f  mus %.2f",
+             memoria.getTotal().atual / (1024.0 * 1024.0), (int)(memoria.getOrcamento() / (1024 * 1024)),
+             memoria.getTotal().pico / (1024.0 * 1024.0),
+             memoria.getCategoria(MemoryTracker::IMAGEM).atual / (1024.0 * 1024.0),
+             memoria.getCategoria(MemoryTracker::SOM).atual / (1024.0 * 1024.0),
+             memoria.getCategoria(MemoryTracker::MUSICA).atual / (1024.0 * 1024.0));
+    al_draw_text(font, memoria.isOrcamentoExcedido() ? al_map_rgb(255, 80, 80) : al_map_rgb(255, 255, 0),
+                 8, y, ALLEGRO_ALIGN_LEFT, linha);
+
+    // Latência das gravações (do pedido ao fsync, nas threads de gravação), separada do tempo de frame
+    const MatchJournal* diario = playerManager ? playerManager->getJournal() : nullptr;
+    SaveQueue::Estatisticas gravacoes = gravador.getEstatisticas();
+    y += alturaLinha;
+    snprintf(linha, sizeof(linha), "Gravacao (ms): jogadores %.1f (max %.1f)  historico %.1f (max %.1f)",
+             diario ? diario->getUltimaLatenciaMs() : 0.0, diario ? diario->getMaiorLatenciaMs() : 0.0,
+             gravacoes.ultimaLatenciaMs, gravacoes.maiorLatenciaMs);
+    al_draw_text(font, al_map_rgb(255, 255, 0), 8, y, ALLEGRO_ALIGN_LEFT, linha);
+
+    // Estatísticas do último jogador no histórico (calculadas no fim da partida, não a cada frame)
+    if (historicoPartidas > 0) {
+        y += alturaLinha;
+        snprintf(linha, sizeof(linha), "Historico: %d partida(s)  media %.1f  mediana %d  p90 %d",
+                 (int)historicoPartidas, historicoMedia, historicoMediana, historicoP90);
+        al_draw_text(font, al_map_rgb(255, 255, 0), 8, y, ALLEGRO_ALIGN_LEFT, linha);
+    }
+
+    // Envio ao ranking compartilhado (pendentes e descartadas ficam vermelhas sem o serviço)
+    if (placarRemoto) {
+        LeaderboardClient::Estatisticas envio = placarRemoto->getEstatisticas();
+        y += alturaLinha;
+        snprintf(linha, sizeof(linha), "Ranking geral: %s  pendentes %d  descartadas %d  %.1f ms",
+                 envio.conectado ? "conectado" : "sem servico", envio.pendentes, envio.descartadas, envio.ultimaLatenciaMs);
+        al_draw_text(font, envio.conectado ? al_map_rgb(255, 255, 0) : al_map_rgb(255, 80, 80), 8, y, ALLEGRO_ALIGN_LEFT, linha);
+    }
+
+    // Tempos das passadas do desfoque, só enquanto uma transição está ativa
+    if (postProcessor && intensidadeEfeito() > 0.0f) {
+        const PostProcessor::Tempos& t = postProcessor->getTempos();
+        y += alturaLinha;
+        snprintf(linha, sizeof(linha), "Pos (ms): red %.2f  H %.2f  V %.2f  comp %.2f",
+                 t.reduzir, t.desfoqueH, t.desfoqueV, t.compor);
+        al_draw_text(font, al_map_rgb(255, 255, 0), 8, y, ALLEGRO_ALIGN_LEFT, linha);
+    }
+}
+
 /**
  * @brief O loop principal de execução do jogo.
  *
@@ -704,11 +1251,36 @@ void GameEngine::renderConfigScreen(float deltaTime) {
  * O loop continua até que a flag `fecharJogo` seja definida como true.
  */
 void GameEngine::run() {
+    inicioExecucao = std::chrono::steady_clock::now(); // al_get_time só vale depois do al_init
+    ResolutionConfig inicial = {screenWidth, screenHeight, windowMode};
+    screenWidth = 600; // O display nasce no tamanho do seletor
+    screenHeight = 550;
     initializeAllegroAddons(); // Inicializa o Allegro e seus add-ons.
+
+    // O seletor roda no display do jogo; no modo benchmark, a resolução inicial é usada direto.
+    std::optional<ResolutionConfig> escolha = inicial;
+    if (!modoBenchmark) {
+        escolha = escolherResolucao();
+    }
+    if (!escolha.has_value()) {
+        std::cout << "Resolução não selecionada. Encerrando o jogo.\n";
+        return;
+    }
+    aplicarModoVideo(*escolha);
     loadGameAssets();         // Carrega todos os recursos do jogo.
 
+    if (modoBenchmark) {
+        // Sem menu: a partida começa assim que o carregamento termina.
+        inicioPartida = std::chrono::steady_clock::now();
+        currentLevel = 0;
+        inLevelTransition = true;
+        estadoAtual = INICIANDO_JOGO;
+        menu->setInputActive(false);
+    }
+
     al_start_timer(timer); // Inicia o timer para controlar a taxa de quadros (FPS).
     bool redraw = false;   // Flag para indicar se a tela precisa ser redesenhada.
+    fpsInicioJanela = al_get_time(); // Começa a primeira janela de medição de FPS.
 
     // Loop principal do jogo. Continua executando enquanto a flag 'fecharJogo' for falsa.
     while (!fecharJogo) {
@@ -716,6 +1288,12 @@ void GameEngine::run() {
         // Espera por um evento na fila, o que economiza CPU quando não há eventos.
         al_wait_for_event(queue, &ev);
 
+        // Se a janela foi descoberta, reativada ou redimensionada, o conteúdo precisa ser redesenhado.
+        if (ev.type == ALLEGRO_EVENT_DISPLAY_EXPOSE || ev.type == ALLEGRO_EVENT_DISPLAY_SWITCH_IN ||
+            ev.type == ALLEGRO_EVENT_DISPLAY_RESIZE) {
+            forcarRedesenho = true;
+        }
+
         if (ev.type == ALLEGRO_EVENT_TIMER) {
             // Se for um evento do timer, é hora de atualizar a lógica do jogo.
             update(1.0 / 60.0); // Atualiza o jogo com base em um delta time de 60 FPS.
@@ -732,8 +1310,48 @@ void GameEngine::run() {
         // Isso evita redesenhar múltiplas vezes para o mesmo frame, otimizando a performance.
         if (redraw && al_is_event_queue_empty(queue)) {
             redraw = false; // Reseta a flag após o redesenho.
-            al_set_target_bitmap(renderTarget); // Redireciona o desenho para o bitmap temporário.
-            al_clear_to_color(al_map_rgb(0, 0, 0)); // Limpa o buffer temporário com preto.
+
+            // Tela estática sem mudanças: o frame anterior continua valendo, então não há
+            // nada para desenhar nem buffer para trocar (o jogo fica praticamente ocioso).
+            if (!telaPrecisaRedesenhar()) continue;
+            forcarRedesenho = false;
+            ultimoEstadoDesenhado = estadoAtual;
+
+            RenderStats::iniciarQuadro(); // Fecha a contagem de desenhos do frame anterior.
+
+            // No modo dinâmico, o intervalo entre frames do gameplay decide a escala. Nas outras
+            // telas o custo é bem menor (e elas nem redesenham sempre), então não entram na média.
+            double inicioQuadro = al_get_time();
+            if (config.isEscalaDinamica() && (estadoAtual == JOGANDO || estadoAtual == INICIANDO_JOGO)) {
+                if (inicioQuadroAnterior > 0.0 &&
+                    controleEscala.registrarQuadro((inicioQuadro - inicioQuadroAnterior) * 1000.0)) {
+                    aplicarEscalaRender(controleEscala.getEscala());
+                }
+            } else {
+                controleEscala.reiniciarMedicao();
+            }
+            inicioQuadroAnterior = inicioQuadro;
+
+            // Sem efeito e em resolução cheia, a cena é desenhada direto no display, sem cópia
+            // intermediária. Com transição ou escala reduzida, ela vai para o bitmap temporário
+            // (com uma transformação que encolhe as coordenadas de tela para a escala atual),
+            // que depois é desfocado ou ampliado uma única vez para o display.
+            float efeito = intensidadeEfeito();
+            ALLEGRO_BITMAP* alvoCena = cenaReduzida ? cenaReduzida : renderTarget;
+            bool usarPosProcessamento = efeito > 0.0f && alvoCena && postProcessor && postProcessor->isValido();
+            bool escalaReduzida = escalaRender < 1.0f && alvoCena;
+            bool usarAlvoCena = usarPosProcessamento || escalaReduzida;
+            ALLEGRO_TRANSFORM transformacao;
+            if (usarAlvoCena) {
+                al_set_target_bitmap(alvoCena); // Redireciona o desenho para o bitmap temporário.
+                al_identity_transform(&transformacao);
+                al_scale_transform(&transformacao, escalaRender, escalaRender);
+                al_use_transform(&transformacao);
+            } else {
+                al_set_target_backbuffer(display);
+            }
+            al_clear_to_color(al_map_rgb(0, 0, 0)); // Limpa o alvo com preto.
+            RenderStats::registrarPrimitiva();
 
             // Chama a função de renderização correta baseado no estado atual do jogo.
             switch (estadoAtual) {
@@ -743,18 +1361,12 @@ void GameEngine::run() {
 
                 case INICIANDO_JOGO: {
                     // Renderiza o cenário ou o menu se o cenário ainda não foi criado.
+                    // O fade-in com desfoque é aplicado depois, pelo PostProcessor.
                     if (scenario) {
                         scenario->render();
                     } else {
                         renderMenu(1.0f / 60.0f);
                     }
-
-                    // Desenha o efeito de fade-out/in da transição.
-                    float alpha = 1.0f - (transitionBlurTimer / TRANSITION_BLUR_DURATION);
-                    // Garante que o valor de alpha esteja entre 0.0 e 1.0.
-                    if (alpha < 0.0f) alpha = 0.0f;
-                    if (alpha > 1.0f) alpha = 1.0f;
-                    al_draw_filled_rectangle(0, 0, screenWidth, screenHeight, al_map_rgba_f(0, 0, 0, alpha));
                     break;
                 }
 
@@ -772,13 +1384,67 @@ void GameEngine::run() {
                     break;
             }
 
-            al_set_target_backbuffer(display); // Volta a renderizar para o display principal.
-            // Desenha o conteúdo do bitmap temporário na tela, aplicando escalonamento se necessário.
-            al_draw_scaled_bitmap(renderTarget, 0, 0,
-                                  al_get_bitmap_width(renderTarget),
-                                  al_get_bitmap_height(renderTarget),
-                                  0, 0, screenWidth, screenHeight, 0);
+            if (usarAlvoCena) {
+                al_identity_transform(&transformacao);
+                al_use_transform(&transformacao);   // Desfaz a escala do bitmap temporário.
+                al_set_target_backbuffer(display); // Volta a renderizar para o display principal.
+            }
+
+            if (usarPosProcessamento) {
+                // Reduz, desfoca em 1/4 da resolução e compõe com o fade direto no display.
+                postProcessor->aplicar(alvoCena, efeito, (float)screenWidth, (float)screenHeight);
+            } else {
+                if (escalaReduzida) {
+                    // Amplia a cena uma única vez para a resolução da janela (filtragem linear).
+                    al_draw_scaled_bitmap(alvoCena, 0, 0, al_get_bitmap_width(alvoCena), al_get_bitmap_height(alvoCena),
+                                          0, 0, screenWidth, screenHeight, 0);
+                    RenderStats::registrarDesenho(alvoCena);
+                }
+                if (efeito > 0.0f) {
+                    // Fallback sem pós-processamento: apenas o fade com um retângulo translúcido.
+                    al_draw_filled_rectangle(0, 0, screenWidth, screenHeight, al_map_rgba_f(0, 0, 0, efeito));
+                    RenderStats::registrarPrimitiva();
+                }
+            }
+
+            // Mede o FPS real a cada meio segundo (o HUD em si não entra na contagem de desenhos).
+            ++fpsQuadrosJanela;
+            double agora = al_get_time();
+            if (agora - fpsInicioJanela >= 0.5) {
+                fpsMedido = fpsQuadrosJanela / (agora - fpsInicioJanela);
+                fpsQuadrosJanela = 0;
+                fpsInicioJanela = agora;
+            }
+            if (debugHudVisivel) renderDebugHud();
+
             al_flip_display(); // Mostra o que foi desenhado na tela.
+
+            // O primeiro frame do menu marca o momento em que o jogo passa a responder ao jogador.
+            // O tempo que o seletor ficou esperando uma escolha não conta.
+            auto agoraRelogio = std::chrono::steady_clock::now();
+            if (!menuJaMostrado && estadoAtual == MENU) {
+                menuJaMostrado = true;
+                msAteMenu = std::chrono::duration<double, std::milli>(agoraRelogio - inicioExecucao).count() - msNoSeletor;
+                std::cout << "Tempo ate o menu interativo: " << msAteMenu << " ms (carregamento dos assets: "
+                          << msCarregamento << " ms).\n";
+            }
+
+            // Primeiro frame com o cenário na tela: o tempo de inicialização somado ao tempo entre
+            // o clique em "Jogar" e esse frame (o tempo que o jogador passou no menu não conta).
+            if (!jogoJaMostrado && scenario && (estadoAtual == INICIANDO_JOGO || estadoAtual == JOGANDO)) {
+                jogoJaMostrado = true;
+                double msPartida = std::chrono::duration<double, std::milli>(agoraRelogio - inicioPartida).count();
+                if (modoBenchmark) {
+                    double msTotal = std::chrono::duration<double, std::milli>(agoraRelogio - inicioExecucao).count();
+                    std::cout << "BENCHMARK tempo ate o primeiro frame de jogo: " << msTotal
+                              << " ms (carregamento dos assets: " << msCarregamento << " ms; inicio da partida: "
+                              << msPartida << " ms).\n";
+                    fecharJogo = true; // A medição terminou
+                } else {
+                    std::cout << "Tempo ate o primeiro frame de jogo: " << msAteMenu + msPartida << " ms ("
+                              << msAteMenu << " ms ate o menu + " << msPartida << " ms depois do clique em Jogar).\n";
+                }
+            }
         }
     }
 }
\ No newline at end of file
@@ -5,9 +5,9 @@
 
 
 #include "GameOverScreen.hpp"
+#include "RenderStats.hpp" // Contagem de desenhos para o HUD de depuração
 #include <allegro5/allegro_primitives.h> // Para desenho de formas primitivas
 #include <allegro5/allegro_font.h> // Para manipulação de fontes
-#include <allegro5/allegro_ttf.h> // Para carregamento de fontes TTF
 #include <algorithm> // Para std::max
 #include <array> // Para std::array
 #include <cstdio> // Para sprintf
@@ -16,10 +16,14 @@
 /**
  * @brief Construtor da classe GameOverScreen.
  * @param f Ponteiro para a fonte padrão a ser utilizada.
+ * @param fLarge Ponteiro para a fonte grande (a mesma do resto do jogo).
  * @param gameoverBackground Ponteiro para o bitmap de fundo da tela de game over.
  */
-GameOverScreen::GameOverScreen(ALLEGRO_FONT* f, ALLEGRO_BITMAP* gameoverBackground)
-    : font(f), gameOverBackground(gameoverBackground), scroll(0), selected(0), somHover(nullptr)
+GameOverScreen::GameOverScreen(ALLEGRO_FONT* f, ALLEGRO_FONT* fLarge, ALLEGRO_BITMAP* gameoverBackground)
+    : font(f), fontLarge(fLarge), gameOverBackground(gameoverBackground), scroll(0), selected(0), somHover(nullptr),
+      quadroCache(nullptr), sujo(true),
+      ultimoScore(0), ultimoRecordPessoal(0), ultimoRecordGeral(0), ultimoR1(false), ultimoR2(false),
+      percentilPartidas(-1.0), percentilJogadores(-1.0), posicaoGeral(0), totalGeral(0)
 {
     // Obtém as dimensões atuais da tela para escalabilidade
     SCREEN_W = static_cast<float>(al_get_display_width(al_get_current_display()));
@@ -32,16 +36,14 @@ GameOverScreen::GameOverScreen(ALLEGRO_FONT* f, ALLEGRO_BITMAP* gameoverBackgrou
     scale_x = SCREEN_W / DESIGN_W;
     scale_y = SCREEN_H / DESIGN_H;
 
-    // Tenta carregar uma fonte maior para os textos principais
-    fontLarge = al_load_ttf_font("assets/editundo.ttf", static_cast<int>(42 * scale_y), 0);
+    // A fonte grande é a mesma que o GameEngine carrega (e pré-aquece) no mesmo tamanho
     if (!fontLarge) {
-        std::cerr << "AVISO: Nao foi possivel carregar assets/editundo.ttf para fontLarge. Usando fonte padrao.\n";
-        fontLarge = font; // Fallback para a fonte padrão se a customizada não carregar
+        std::cerr << "AVISO: Fonte grande nao recebida pela GameOverScreen. Usando fonte padrao.\n";
+        fontLarge = font; // Fallback para a fonte padrão
     }
 
-    // Inicializa as áreas dos botões como vazias (serão calculadas em render)
-    replayBtn = {0,0,0,0};
-    menuBtn = {0,0,0,0};
+    // Calcula as áreas dos botões (fixas para o tamanho da tela)
+    calcularLayout();
 
     // Inicializa os estados anteriores de hover dos botões como falsos
     previousHoverStates = {false, false};
@@ -49,13 +51,11 @@ GameOverScreen::GameOverScreen(ALLEGRO_FONT* f, ALLEGRO_BITMAP* gameoverBackgrou
 
 /**
  * @brief Destrutor da classe GameOverScreen.
- * Libera a fonte grande se ela foi carregada separadamente da fonte padrão.
+ * As fontes pertencem ao GameEngine; aqui só são liberados os bitmaps desta tela.
  */
 GameOverScreen::~GameOverScreen() {
-    if (fontLarge && fontLarge != font) { // Garante que só destrói se foi carregada aqui e não é a mesma que `font`
-        al_destroy_font(fontLarge);
-        fontLarge = nullptr;
-    }
+    if (quadroCache) { al_destroy_bitmap(quadroCache); quadroCache = nullptr; }
+    textCache.limpar(); // Os bitmaps do cache dependem das fontes, então são liberados enquanto elas existem
 }
 
 /**
@@ -94,16 +94,8 @@ void GameOverScreen::drawButton(const std::string& text, const std::array<float,
         al_draw_filled_rounded_rectangle(rectLeft, rectTop, rectRight, rectBottom, 10 * scale_x, 10 * scale_y, bgColor);
     }
 
-    // Desenha o contorno preto do texto (efeito de sombra ou contorno)
-    for (int dx = -3; dx <= 3; ++dx) {
-        for (int dy = -3; dy <= 3; ++dy) {
-            if (dx == 0 && dy == 0) continue; // Pula o centro
-            al_draw_text(fontLarge, outline, cx + dx, cy + dy, ALLEGRO_ALIGN_CENTER, text.c_str());
-        }
-    }
-
-    // Desenha o texto principal do botão
-    al_draw_text(fontLarge, textColor, cx, cy, ALLEGRO_ALIGN_CENTER, text.c_str());
+    // Desenha o texto do botão com contorno (rasterizado uma vez por rótulo e estado de hover)
+    textCache.draw(fontLarge, textColor, outline, 3, cx, cy, ALLEGRO_ALIGN_CENTER, text);
 }
 
 /**
@@ -117,8 +109,78 @@ bool GameOverScreen::isMouseOver(const std::array<float, 4>& rect, float mx, flo
     return mx >= rect.at(0) && mx <= rect.at(2) && my >= rect.at(1) && my <= rect.at(3);
 }
 
+/**
+ * @brief Calcula a posição dos botões "Jogar novamente" e "Voltar ao menu".
+ * Os botões ficam lado a lado, centralizados na parte inferior da tela.
+ */
+void GameOverScreen::calcularLayout() {
+    float cx = SCREEN_W / 2.0f; // Centro X da tela
+    float btn_w = 300.0f * scale_x; // Largura dos botões
+    float btn_h = 60.0f * scale_y; // Altura dos botões
+    float button_gap = 90.0f * scale_y; // Espaçamento entre os botões
+
+    float total_btns_width = (btn_w * 2) + button_gap; // Largura total ocupada pelos dois botões e o espaçamento
+    float btn_y = SCREEN_H - (btn_h / 2.0f) - (60.0f * scale_y); // Posição Y dos botões (na parte inferior da tela)
+
+    // Calcula as coordenadas dos retângulos para cada botão
+    float first_btn_x1 = cx - (total_btns_width / 2.0f);
+    float first_btn_x2 = first_btn_x1 + btn_w;
+    float second_btn_x1 = first_btn_x2 + button_gap;
+    float second_btn_x2 = second_btn_x1 + btn_w;
+
+    replayBtn = {first_btn_x1, btn_y, first_btn_x2, btn_y + btn_h};
+    menuBtn = {second_btn_x1, btn_y, second_btn_x2, btn_y + btn_h};
+}
+
+/**
+ * @brief Lê o mouse e atualiza o hover dos botões.
+ * @return true se o hover de algum botão mudou desde a última leitura.
+ */
+bool GameOverScreen::atualizarHover() {
+    ALLEGRO_MOUSE_STATE mouse;
+    al_get_mouse_state(&mouse); // Obtém o estado atual do mouse
+    float mx = static_cast<float>(mouse.x);
+    float my = static_cast<float>(mouse.y);
+
+    // Verifica se o mouse está sobre os botões
+    bool hoverReplay = isMouseOver(replayBtn, mx, my);
+    bool hoverMenu = isMouseOver(menuBtn, mx, my);
+
+    // Toca o som de hover se o estado de hover mudou de false para true
+    if (hoverReplay && !previousHoverStates[0]) {
+        if (somHover) al_play_sample(somHover, 1.0, 0.0, 1.0, ALLEGRO_PLAYMODE_ONCE, nullptr);
+    }
+    if (hoverMenu && !previousHoverStates[1]) {
+        if (somHover) al_play_sample(somHover, 1.0, 0.0, 1.0, ALLEGRO_PLAYMODE_ONCE, nullptr);
+    }
+
+    bool mudou = hoverReplay != previousHoverStates[0] || hoverMenu != previousHoverStates[1];
+
+    // Atualiza os estados anteriores de hover
+    previousHoverStates[0] = hoverReplay;
+    previousHoverStates[1] = hoverMenu;
+    return mudou;
+}
+
+/**
+ * @brief Informa se a tela precisa ser recomposta.
+ * @return true se o hover ou algum dos valores exibidos mudou.
+ */
+bool GameOverScreen::precisaRedesenhar(int score, int recordPessoal, int recordGeral, bool r1, bool r2) {
+    if (atualizarHover()) sujo = true;
+    if (score != ultimoScore || recordPessoal != ultimoRecordPessoal || recordGeral != ultimoRecordGeral ||
+        r1 != ultimoR1 || r2 != ultimoR2) {
+        sujo = true;
+    }
+    return sujo || !quadroCache;
+}
+
 /**
  * @brief Renderiza a tela de Game Over com as informações de pontuação e botões.
+ *
+ * A tela é composta em `quadroCache` só quando algo muda (hover, pontuação, recordes);
+ * nos demais frames ela custa um único desenho de bitmap.
+ *
  * @param score A pontuação obtida na partida.
  * @param recordPessoal O recorde pessoal do jogador.
  * @param recordGeral O recorde geral do jogo.
@@ -126,6 +188,45 @@ bool GameOverScreen::isMouseOver(const std::array<float, 4>& rect, float mx, flo
  * @param r2 True se um novo recorde geral foi atingido.
  */
 void GameOverScreen::render(int score, int recordPessoal, int recordGeral, bool r1, bool r2) {
+    bool recompor = precisaRedesenhar(score, recordPessoal, recordGeral, r1, r2);
+
+    if (!quadroCache) {
+        quadroCache = al_create_bitmap((int)SCREEN_W, (int)SCREEN_H);
+    }
+    if (!quadroCache) {
+        compor(score, recordPessoal, recordGeral, r1, r2); // Sem bitmap de cache: desenha direto, como antes
+        return;
+    }
+
+    if (recompor) {
+        ALLEGRO_STATE estado;
+        al_store_state(&estado, ALLEGRO_STATE_TARGET_BITMAP);
+        al_set_target_bitmap(quadroCache);
+        al_clear_to_color(al_map_rgb(0, 0, 0));
+        compor(score, recordPessoal, recordGeral, r1, r2);
+        al_restore_state(&estado);
+
+        sujo = false;
+        ultimoScore = score;
+        ultimoRecordPessoal = recordPessoal;
+        ultimoRecordGeral = recordGeral;
+        ultimoR1 = r1;
+        ultimoR2 = r2;
+    }
+
+    al_draw_bitmap(quadroCache, 0, 0, 0);
+    RenderStats::registrarDesenho(quadroCache);
+}
+
+/**
+ * @brief Desenha o fundo, as pontuações, os avisos de recorde e os botões no alvo atual.
+ * @param score A pontuação obtida na partida.
+ * @param recordPessoal O recorde pessoal do jogador.
+ * @param recordGeral O recorde geral do jogo.
+ * @param r1 True se um novo recorde pessoal foi atingido.
+ * @param r2 True se um novo recorde geral foi atingido.
+ */
+void GameOverScreen::compor(int score, int recordPessoal, int recordGeral, bool r1, bool r2) {
     // Desenha o fundo da tela de game over ou um fundo sólido se não houver bitmap
     if (gameOverBackground) {
         int bg_w = al_get_bitmap_width(gameOverBackground);
@@ -165,6 +266,18 @@ void GameOverScreen::render(int score, int recordPessoal, int recordGeral, bool
         sprintf(buffer, "Recorde geral: %d", recordGeral);
         al_draw_text(fontLarge, al_map_rgb(255, 255, 255), cx, text_y + 80 * scale_y, ALLEGRO_ALIGN_CENTER, buffer);
 
+        // Exibe quantas partidas e quantos jogadores a pontuação superou (vindo dos histogramas do PlayerManager)
+        if (percentilPartidas >= 0.0 && percentilJogadores >= 0.0) {
+            sprintf(buffer, "Melhor que %d%% das partidas e %d%% dos jogadores", (int)percentilPartidas, (int)percentilJogadores);
+            al_draw_text(font, al_map_rgb(255, 255, 0), cx, text_y + 122 * scale_y, ALLEGRO_ALIGN_CENTER, buffer);
+        }
+
+        // Posição no ranking de todos os gabinetes (cópia local do serviço de ranking), logo acima dos botões
+        if (posicaoGeral > 0) {
+            sprintf(buffer, "Posicao geral: %d de %d", (int)posicaoGeral, (int)totalGeral);
+            al_draw_text(font, al_map_rgb(255, 255, 0), cx, replayBtn[1] - 36 * scale_y, ALLEGRO_ALIGN_CENTER, buffer);
+        }
+
         // Se um novo recorde pessoal foi batido, exibe a mensagem
         if (r1) {
             float ry = text_y + 160 * scale_y;
@@ -182,46 +295,9 @@ void GameOverScreen::render(int score, int recordPessoal, int recordGeral, bool
         }
     }
 
-    float btn_w = 300.0f * scale_x; // Largura dos botões
-    float btn_h = 60.0f * scale_y; // Altura dos botões
-    float button_gap = 90.0f * scale_y; // Espaçamento entre os botões
-
-    float total_btns_width = (btn_w * 2) + button_gap; // Largura total ocupada pelos dois botões e o espaçamento
-    float btn_y = SCREEN_H - (btn_h / 2.0f) - (60.0f * scale_y); // Posição Y dos botões (na parte inferior da tela)
-
-    // Calcula as coordenadas dos retângulos para cada botão
-    float first_btn_x1 = cx - (total_btns_width / 2.0f);
-    float first_btn_x2 = first_btn_x1 + btn_w;
-    float second_btn_x1 = first_btn_x2 + button_gap;
-    float second_btn_x2 = second_btn_x1 + btn_w;
-
-    replayBtn = {first_btn_x1, btn_y, first_btn_x2, btn_y + btn_h};
-    menuBtn = {second_btn_x1, btn_y, second_btn_x2, btn_y + btn_h};
-
-    ALLEGRO_MOUSE_STATE mouse;
-    al_get_mouse_state(&mouse); // Obtém o estado atual do mouse
-    float mx = static_cast<float>(mouse.x);
-    float my = static_cast<float>(mouse.y);
-
-    // Verifica se o mouse está sobre os botões
-    bool hoverReplay = isMouseOver(replayBtn, mx, my);
-    bool hoverMenu = isMouseOver(menuBtn, mx, my);
-
-    // Toca o som de hover se o estado de hover mudou de false para true
-    if (hoverReplay && !previousHoverStates[0]) {
-        if (somHover) al_play_sample(somHover, 1.0, 0.0, 1.0, ALLEGRO_PLAYMODE_ONCE, nullptr);
-    }
-    if (hoverMenu && !previousHoverStates[1]) {
-        if (somHover) al_play_sample(somHover, 1.0, 0.0, 1.0, ALLEGRO_PLAYMODE_ONCE, nullptr);
-    }
-
-    // Atualiza os estados anteriores de hover
-    previousHoverStates[0] = hoverReplay;
-    previousHoverStates[1] = hoverMenu;
-
     // Desenha os botões
-    drawButton("Jogar novamente", replayBtn, hoverReplay);
-    drawButton("Voltar ao menu", menuBtn, hoverMenu);
+    drawButton("Jogar novamente", replayBtn, previousHoverStates[0]);
+    drawButton("Voltar ao menu", menuBtn, previousHoverStates[1]);
 }
 
 /**
@@ -249,4 +325,26 @@ int GameOverScreen::handleEvent(ALLEGRO_EVENT* ev) {
  */
 void GameOverScreen::setHoverSound(ALLEGRO_SAMPLE* som) {
     somHover = som;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Define as porcentagens de partidas e jogadores superados.
+ * @param partidas Porcentagem das partidas (negativa para esconder).
+ * @param jogadores Porcentagem dos jogadores (negativa para esconder).
+ */
+void GameOverScreen::setPercentis(double partidas, double jogadores) {
+    if (partidas != percentilPartidas || jogadores != percentilJogadores) sujo = true; // O texto muda
+    percentilPartidas = partidas;
+    percentilJogadores = jogadores;
+}
+
+/**
+ * @brief Define a posição no ranking compartilhado.
+ * @param posicao A posição (0 para esconder).
+ * @param total Quantos apelidos o ranking tem.
+ */
+void GameOverScreen::setPosicaoGeral(size_t posicao, size_t total) {
+    if (posicao != posicaoGeral || total != totalGeral) sujo = true; // O texto muda
+    posicaoGeral = posicao;
+    totalGeral = total;
+}
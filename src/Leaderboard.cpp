@@ -0,0 +1,269 @@
+/**
+ * @file Leaderboard.cpp
+ * @brief Leaderboardimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "Leaderboard.hpp"
+#include <algorithm> // Para std::sort (reconstrução)
+
+/**
+ * @brief Construtor da classe Leaderboard.
+ */
+Leaderboard::Leaderboard() : alturaAtual(1), quantidade(0), sorteio(42) {
+    limpar();
+}
+
+/**
+ * @brief Remove todos os jogadores, deixando só a cabeça da lista.
+ */
+void Leaderboard::limpar() {
+    pontos.assign(1, 0);
+    alturas.assign(1, ALTURA_MAXIMA);
+    inicioLigacoes.assign(1, 0);
+    ligacoes.assign(ALTURA_MAXIMA, Ligacao());
+    alturaAtual = 1;
+    quantidade = 0;
+    sorteio.seed(42);
+}
+
+/**
+ * @brief Sorteia a altura de um nó: cada nível a mais com 1/4 de chance.
+ */
+int Leaderboard::sortearAltura() {
+    int altura = 1;
+    while (altura < ALTURA_MAXIMA && (sorteio() & 3) == 0) ++altura;
+    return altura;
+}
+
+/**
+ * @brief Cria os nós que faltam até o de um Id, com as ligações deles.
+ */
+void Leaderboard::criarNo(uint32_t no) {
+    while (alturas.size() <= no) {
+        int altura = sortearAltura();
+        pontos.push_back(0);
+        alturas.push_back(0); // Fora da lista até ser inserido
+        inicioLigacoes.push_back((uint32_t)ligacoes.size());
+        ligacoes.resize(ligacoes.size() + altura);
+    }
+    if (alturas[no] == 0) {
+        // A altura sorteada é a quantidade de ligações reservadas para o nó
+        uint32_t fim = no + 1 < inicioLigacoes.size() ? inicioLigacoes[no + 1] : (uint32_t)ligacoes.size();
+        alturas[no] = (uint8_t)(fim - inicioLigacoes[no]);
+    }
+}
+
+/**
+ * @brief Monta a lista inteira a partir das pontuações.
+ */
+void Leaderboard::reconstruir(const std::vector<int>& pontuacoes) {
+    limpar();
+    size_t n = pontuacoes.size();
+    pontos.resize(n + 1);
+    alturas.resize(n + 1);
+    inicioLigacoes.resize(n + 1);
+    size_t totalLigacoes = ligacoes.size();
+    for (size_t i = 0; i < n; ++i) {
+        pontos[i + 1] = pontuacoes[i];
+        int altura = sortearAltura();
+        alturas[i + 1] = (uint8_t)altura;
+        inicioLigacoes[i + 1] = (uint32_t)totalLigacoes;
+        totalLigacoes += altura;
+        if (altura > alturaAtual) alturaAtual = altura;
+    }
+    ligacoes.resize(totalLigacoes);
+
+    // Ordena chaves de 64 bits (pontuação invertida em cima, nó embaixo): sem buscar as pontuações a cada comparação
+    std::vector<uint64_t> ordem(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t crescente = (uint32_t)pontos[i + 1] ^ 0x80000000u; // Mesma ordem da pontuação, sem sinal
+        ordem[i] = ((uint64_t)~crescente << 32) | (uint32_t)(i + 1);
+    }
+    std::sort(ordem.begin(), ordem.end());
+
+    // Em cada nível, liga o último nó visto àquele que chega agora; o salto é a diferença de posições
+    uint32_t ultimo[ALTURA_MAXIMA] = {};
+    size_t posicaoUltimo[ALTURA_MAXIMA] = {};
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t no = (uint32_t)ordem[i];
+        size_t posicao = i + 1;
+        for (int nivel = 0; nivel < alturas[no]; ++nivel) {
+            Ligacao& anterior = ligacoes[inicioLigacoes[ultimo[nivel]] + nivel];
+            apontar(anterior, no);
+            anterior.salto = (uint32_t)(posicao - posicaoUltimo[nivel]);
+            ultimo[nivel] = no;
+            posicaoUltimo[nivel] = posicao;
+        }
+    }
+    for (int nivel = 0; nivel < ALTURA_MAXIMA; ++nivel) {
+        Ligacao& fim = ligacoes[inicioLigacoes[ultimo[nivel]] + nivel];
+        fim.proximo = 0;
+        fim.salto = (uint32_t)(n - posicaoUltimo[nivel]); // Até o fim da lista
+    }
+    quantidade = n;
+}
+
+/**
+ * @brief Insere um jogador ou muda a pontuação dele.
+ */
+void Leaderboard::atualizar(int32_t id, int pontuacao) {
+    if (id < 0) return;
+    uint32_t no = (uint32_t)id + 1;
+    if (contem(id)) {
+        if (pontos[no] == pontuacao) return; // Nada muda de lugar
+        remover(no);
+    } else {
+        criarNo(no);
+    }
+    pontos[no] = pontuacao;
+    inserir(no);
+}
+
+/**
+ * @brief Desce até o último nó antes de `no` em cada nível.
+ */
+void Leaderboard::procurar(uint32_t no, uint32_t* anteriores, size_t* posicoes) const {
+    int pontosNo = pontos[no];
+    uint32_t base = 0; // Cabeça
+    size_t posicao = 0;
+    for (int nivel = alturaAtual - 1; nivel >= 0; --nivel) {
+        const Ligacao* l = &ligacoes[base + nivel];
+        while (l->proximo != 0 && antes(l->pontosProximo, l->proximo, pontosNo, no)) {
+            posicao += l->salto;
+            base = l->baseProximo;
+            l = &ligacoes[base + nivel];
+        }
+        anteriores[nivel] = base;
+        if (posicoes) posicoes[nivel] = posicao;
+    }
+}
+
+/**
+ * @brief Liga um nó na lista, corrigindo os saltos dos atalhos que passam por cima dele.
+ */
+void Leaderboard::inserir(uint32_t no) {
+    uint32_t anteriores[ALTURA_MAXIMA];
+    size_t posicoes[ALTURA_MAXIMA]; // Posição de cada anterior
+    procurar(no, anteriores, posicoes);
+
+    int altura = alturas[no];
+    if (altura > alturaAtual) {
+        for (int nivel = alturaAtual; nivel < altura; ++nivel) {
+            anteriores[nivel] = 0;
+            posicoes[nivel] = 0;
+            ligacoes[nivel].salto = (uint32_t)quantidade; // A cabeça pulava a lista inteira
+        }
+        alturaAtual = altura;
+    }
+
+    uint32_t base = inicioLigacoes[no];
+    for (int nivel = 0; nivel < altura; ++nivel) {
+        Ligacao& anterior = ligacoes[anteriores[nivel] + nivel];
+        Ligacao& nova = ligacoes[base + nivel];
+        size_t distancia = posicoes[0] - posicoes[nivel]; // Do anterior deste nível até o anterior do nível 0
+        nova = anterior;
+        nova.salto = anterior.salto - (uint32_t)distancia;
+        apontar(anterior, no);
+        anterior.salto = (uint32_t)distancia + 1;
+    }
+    for (int nivel = altura; nivel < alturaAtual; ++nivel) {
+        ++ligacoes[anteriores[nivel] + nivel].salto; // Atalhos mais altos agora pulam um nó a mais
+    }
+    ++quantidade;
+}
+
+/**
+ * @brief Desliga um nó da lista, corrigindo os saltos.
+ */
+void Leaderboard::remover(uint32_t no) {
+    uint32_t anteriores[ALTURA_MAXIMA];
+    procurar(no, anteriores, nullptr);
+
+    uint32_t base = inicioLigacoes[no];
+    for (int nivel = 0; nivel < alturaAtual; ++nivel) {
+        Ligacao& anterior = ligacoes[anteriores[nivel] + nivel];
+        if (anterior.proximo == no) {
+            uint32_t salto = anterior.salto + ligacoes[base + nivel].salto - 1;
+            anterior = ligacoes[base + nivel]; // Passa a apontar para o seguinte do removido
+            anterior.salto = salto;
+        } else {
+            --anterior.salto;
+        }
+    }
+    while (alturaAtual > 1 && ligacoes[alturaAtual - 1].proximo == 0) --alturaAtual;
+    --quantidade;
+}
+
+/**
+ * @brief Informa se um jogador está no ranking.
+ */
+bool Leaderboard::contem(int32_t id) const {
+    // Só os nós inseridos têm altura; os criados para preencher Ids pulados ficam com 0
+    return id >= 0 && (size_t)id + 1 < alturas.size() && alturas[id + 1] != 0;
+}
+
+/**
+ * @brief Calcula a posição de um jogador: a do último nó antes dele, mais um.
+ */
+size_t Leaderboard::getPosicao(int32_t id) const {
+    if (!contem(id)) return 0;
+    uint32_t anteriores[ALTURA_MAXIMA];
+    size_t posicoes[ALTURA_MAXIMA];
+    procurar((uint32_t)id + 1, anteriores, posicoes);
+    return posicoes[0] + 1;
+}
+
+/**
+ * @brief Encontra o jogador de uma posição descendo pelos atalhos.
+ */
+int32_t Leaderboard::getJogadorNaPosicao(size_t posicao) const {
+    if (posicao == 0 || posicao > quantidade) return -1;
+    uint32_t base = 0;
+    uint32_t no = 0;
+    size_t percorrido = 0;
+    for (int nivel = alturaAtual - 1; nivel >= 0; --nivel) {
+        const Ligacao* l = &ligacoes[base + nivel];
+        while (l->proximo != 0 && percorrido + l->salto <= posicao) {
+            percorrido += l->salto;
+            no = l->proximo;
+            base = l->baseProximo;
+            l = &ligacoes[base + nivel];
+        }
+        if (percorrido == posicao) return (int32_t)no - 1;
+    }
+    return -1;
+}
+
+/**
+ * @brief Lista os jogadores a partir de uma posição, seguindo o nível 0.
+ */
+std::vector<int32_t> Leaderboard::listar(size_t posicao, size_t quantos) const {
+    std::vector<int32_t> saida;
+    int32_t primeiro = getJogadorNaPosicao(posicao);
+    if (primeiro < 0) return saida;
+
+    saida.reserve(std::min(quantos, quantidade - posicao + 1));
+    saida.push_back(primeiro);
+    const Ligacao* l = &ligacoes[inicioLigacoes[primeiro + 1]];
+    while (l->proximo != 0 && saida.size() < quantos) {
+        saida.push_back((int32_t)l->proximo - 1);
+        l = &ligacoes[l->baseProximo];
+    }
+    return saida;
+}
+
+/**
+ * @brief Retorna a pontuação do primeiro colocado (guardada na ligação da cabeça).
+ */
+int Leaderboard::getRecorde() const {
+    return ligacoes[0].proximo != 0 ? ligacoes[0].pontosProximo : 0;
+}
+
+/**
+ * @brief Retorna a pontuação de um jogador no ranking.
+ */
+int Leaderboard::getPontuacao(int32_t id) const {
+    if (!contem(id)) return 0;
+    return pontos[id + 1];
+}
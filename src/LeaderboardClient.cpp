@@ -0,0 +1,442 @@
+/**
+ * @file LeaderboardClient.cpp
+ * @brief LeaderboardClientimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "LeaderboardClient.hpp"
+#include "MatchJournal.hpp" // Para sincronizarArquivo (fflush + fsync)
+#include <algorithm>        // Para std::min
+#include <chrono>           // Para as esperas e a latência
+#include <cstdio>           // Para acrescentar com FILE*
+#include <cstdlib>          // Para std::strtoll e std::strtoull
+#include <filesystem>       // Para a pasta e o tamanho do arquivo de pendentes
+#include <fstream>          // Para ler o arquivo de pendentes
+#include <iostream>         // Para mensagens de aviso
+#include <iterator>         // Para std::make_move_iterator (partidas tiradas da fila)
+#include <random>           // Para a origem desta execução
+#include <sstream>          // Para montar a origem em hexadecimal
+
+/// @brief Relógio usado nas esperas e na latência.
+using Relogio = std::chrono::steady_clock;
+
+namespace {
+
+/// @brief Tempo máximo para conectar, mandar um lote e receber as respostas.
+const int TIMEOUT_MS = 2000;
+/// @brief Primeira espera depois de uma falha; dobra a cada falha seguida.
+const int ESPERA_INICIAL_MS = 250;
+/// @brief Maior espera entre duas tentativas.
+const int ESPERA_MAXIMA_MS = 8000;
+
+/**
+ * @brief Troca as quebras de linha de um apelido por espaços (o protocolo é uma linha por pedido).
+ */
+std::string limparApelido(const std::string& apelido) {
+    std::string limpo = apelido;
+    for (char& c : limpo) {
+        if (c == '\n' || c == '\r') c = ' ';
+    }
+    return limpo;
+}
+
+/**
+ * @brief Espera uma variável de condição até um instante (ou um sinal).
+ */
+void esperarAte(ALLEGRO_COND* cond, ALLEGRO_MUTEX* mutex, Relogio::time_point instante) {
+    double segundos = std::chrono::duration<double>(instante - Relogio::now()).count();
+    if (segundos <= 0.0) return;
+    ALLEGRO_TIMEOUT limite;
+    al_init_timeout(&limite, segundos);
+    al_wait_cond_until(cond, mutex, &limite);
+}
+
+} // namespace
+
+/**
+ * @brief Construtor da classe LeaderboardClient.
+ */
+LeaderboardClient::LeaderboardClient(const std::string& caminhoSocket, const std::string& caminhoPendentes,
+                                     size_t limiteFila, int esperaGrupoMs, int intervaloAtualizacaoMs)
+    : caminhoSocket(caminhoSocket), caminhoPendentes(caminhoPendentes), limiteFila(limiteFila),
+      esperaGrupoMs(esperaGrupoMs), intervaloAtualizacaoMs(intervaloAtualizacaoMs), proximoSeq(1),
+      pendentesArquivo(0), enviando(false), encerrando(false), mutex(al_create_mutex()),
+      haTrabalho(al_create_cond()), semPendencias(al_create_cond()), thread(nullptr)
+{
+    // A origem distingue esta execução das outras (deste e dos outros jogos) para o serviço
+    std::random_device aleatorio;
+    uint64_t semente = (uint64_t)std::chrono::system_clock::now().time_since_epoch().count();
+    semente ^= ((uint64_t)aleatorio() << 32) ^ aleatorio();
+    std::ostringstream texto;
+    texto << std::hex << semente;
+    origem = texto.str();
+
+    // Partidas de execuções anteriores que não chegaram ao serviço
+    std::ifstream pendentes(caminhoPendentes);
+    std::string linha;
+    while (std::getline(pendentes, linha)) pendentesArquivo += !linha.empty();
+    std::error_code erro;
+    std::filesystem::create_directories(std::filesystem::path(caminhoPendentes).parent_path(), erro);
+    travaPendentes.abrir(caminhoPendentes + ".lock");
+    estatisticas.pendentes = pendentesArquivo;
+
+    if (!mutex || !haTrabalho || !semPendencias) {
+        std::cerr << "AVISO: Nao foi possivel criar a sincronizacao do envio ao ranking. Envio desligado.\n";
+        return;
+    }
+    thread = al_create_thread(&LeaderboardClient::executarEnvio, this);
+    if (!thread) {
+        std::cerr << "AVISO: Nao foi possivel criar a thread de envio ao ranking. Envio desligado.\n";
+        return;
+    }
+    al_start_thread(thread);
+}
+
+/**
+ * @brief Destrutor da classe LeaderboardClient. A thread faz a última tentativa antes de sair.
+ */
+LeaderboardClient::~LeaderboardClient() {
+    if (thread) {
+        al_lock_mutex(mutex);
+        encerrando = true;
+        al_signal_cond(haTrabalho);
+        al_unlock_mutex(mutex);
+        al_join_thread(thread, nullptr);
+        al_destroy_thread(thread);
+    }
+    if (semPendencias) al_destroy_cond(semPendencias);
+    if (haTrabalho) al_destroy_cond(haTrabalho);
+    if (mutex) al_destroy_mutex(mutex);
+}
+
+/**
+ * @brief Põe uma partida na fila de saída e acorda a thread.
+ */
+void LeaderboardClient::enviar(const std::string& apelido, int pontuacao) {
+    if (!thread || apelido.empty()) return;
+    Partida partida;
+    partida.origem = origem;
+    partida.pontuacao = pontuacao;
+    partida.apelido = limparApelido(apelido);
+
+    al_lock_mutex(mutex);
+    partida.seq = proximoSeq++;
+    ++estatisticas.enviadas;
+    if (fila.size() >= limiteFila) {
+        fila.pop_front(); // Fila cheia: perde a mais antiga, o jogo não espera
+        ++estatisticas.descartadas;
+    }
+    fila.push_back(std::move(partida));
+    al_signal_cond(haTrabalho);
+    al_unlock_mutex(mutex);
+
+    acompanhar(apelido);
+}
+
+/**
+ * @brief Passa a manter a posição de um apelido na cópia local.
+ */
+void LeaderboardClient::acompanhar(const std::string& apelido) {
+    if (!mutex || apelido.empty()) return;
+    std::string limpo = limparApelido(apelido);
+    al_lock_mutex(mutex);
+    bool encontrado = false;
+    for (const Acompanhado& a : acompanhados) encontrado = encontrado || a.apelido == limpo;
+    if (!encontrado) {
+        if (acompanhados.size() >= MAXIMO_ACOMPANHADOS) acompanhados.erase(acompanhados.begin());
+        Acompanhado novo;
+        novo.apelido = limpo;
+        acompanhados.push_back(novo);
+    }
+    al_unlock_mutex(mutex);
+}
+
+/**
+ * @brief Retorna as primeiras posições da cópia local.
+ */
+std::vector<LeaderboardClient::Colocacao> LeaderboardClient::getMelhores() const {
+    if (!mutex) return {};
+    al_lock_mutex(mutex);
+    std::vector<Colocacao> copia = melhores;
+    al_unlock_mutex(mutex);
+    return copia;
+}
+
+/**
+ * @brief Consulta a posição de um apelido acompanhado na cópia local.
+ * @return true se a posição é conhecida.
+ */
+bool LeaderboardClient::getPosicao(const std::string& apelido, size_t& posicao, size_t& total) const {
+    if (!mutex) return false;
+    std::string limpo = limparApelido(apelido);
+    bool conhecida = false;
+    al_lock_mutex(mutex);
+    for (const Acompanhado& a : acompanhados) {
+        if (a.apelido == limpo && a.posicao > 0) {
+            posicao = a.posicao;
+            total = a.total;
+            conhecida = true;
+        }
+    }
+    al_unlock_mutex(mutex);
+    return conhecida;
+}
+
+/**
+ * @brief Espera a fila e o arquivo de pendentes esvaziarem.
+ * @return true se tudo foi confirmado a tempo.
+ */
+bool LeaderboardClient::aguardar(int timeoutMs) {
+    if (!thread) return false;
+    Relogio::time_point prazo = Relogio::now() + std::chrono::milliseconds(timeoutMs);
+    al_lock_mutex(mutex);
+    while ((!fila.empty() || pendentesArquivo > 0 || enviando) && Relogio::now() < prazo) {
+        esperarAte(semPendencias, mutex, prazo);
+    }
+    bool vazio = fila.empty() && pendentesArquivo == 0 && !enviando;
+    al_unlock_mutex(mutex);
+    return vazio;
+}
+
+/**
+ * @brief Retorna uma cópia dos contadores.
+ */
+LeaderboardClient::Estatisticas LeaderboardClient::getEstatisticas() const {
+    if (mutex) al_lock_mutex(mutex);
+    Estatisticas copia = estatisticas;
+    copia.pendentes = (int)fila.size() + pendentesArquivo;
+    if (mutex) al_unlock_mutex(mutex);
+    return copia;
+}
+
+/**
+ * @brief Lê o arquivo de pendentes: linhas `<origem> <seq> <pontuacao> <apelido>`.
+ */
+void LeaderboardClient::lerPendentes(std::vector<Partida>& lote) const {
+    std::ifstream arq(caminhoPendentes);
+    std::string linha;
+    while (std::getline(arq, linha)) {
+        if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+        size_t espaco1 = linha.find(' ');
+        if (espaco1 == std::string::npos || espaco1 == 0) continue;
+        const char* inicio = linha.c_str() + espaco1 + 1;
+        char* fim = nullptr;
+        Partida partida;
+        partida.seq = std::strtoull(inicio, &fim, 10);
+        if (fim == inicio || *fim != ' ' || partida.seq == 0) continue;
+        inicio = fim + 1;
+        partida.pontuacao = (int)std::strtoll(inicio, &fim, 10);
+        if (fim == inicio || *fim != ' ' || fim[1] == '\0') continue; // Linha cortada por uma queda
+        partida.origem = linha.substr(0, espaco1);
+        partida.apelido = fim + 1;
+        lote.push_back(std::move(partida));
+    }
+}
+
+/**
+ * @brief Acrescenta partidas ao arquivo de pendentes.
+ * @return Quantas não couberam (ou não puderam ser gravadas).
+ */
+int LeaderboardClient::guardarPendentes(const std::vector<Partida>& partidas, int existentes) const {
+    int cabem = std::max(0, LIMITE_ARQUIVO - existentes);
+    int gravar = std::min((int)partidas.size(), cabem);
+    if (gravar == 0) return (int)partidas.size();
+
+    std::string conteudo;
+    for (int i = 0; i < gravar; ++i) {
+        const Partida& p = partidas[i];
+        conteudo += p.origem + " " + std::to_string(p.seq) + " " + std::to_string(p.pontuacao) + " " + p.apelido + "\n";
+    }
+    FILE* arq = fopen(caminhoPendentes.c_str(), "ab");
+    bool ok = arq != nullptr && fwrite(conteudo.data(), 1, conteudo.size(), arq) == conteudo.size();
+    if (arq) {
+        ok = MatchJournal::sincronizarArquivo(arq) && ok;
+        ok = fclose(arq) == 0 && ok;
+    }
+    if (!ok) {
+        std::cerr << "Erro: falha ao guardar partidas pendentes do ranking em " << caminhoPendentes << "\n";
+        return (int)partidas.size();
+    }
+    return (int)partidas.size() - gravar;
+}
+
+/**
+ * @brief Manda o lote e as consultas e lê as respostas.
+ * Uma conexão reaproveitada que caiu (ex: o serviço reiniciou) é refeita uma vez.
+ * @return true se o serviço confirmou o lote.
+ */
+bool LeaderboardClient::trocar(const std::vector<Partida>& lote, const std::vector<std::string>& consultados,
+                               std::vector<Colocacao>& novasMelhores, std::vector<std::pair<size_t, size_t>>& posicoes) {
+    std::string pedido;
+    pedido.reserve(lote.size() * 40 + 64);
+    for (const Partida& p : lote) {
+        pedido += "P " + p.origem + " " + std::to_string(p.seq) + " " + std::to_string(p.pontuacao) + " " + p.apelido + "\n";
+    }
+    pedido += "F\nT " + std::to_string(MELHORES) + "\n";
+    for (const std::string& apelido : consultados) pedido += "R " + apelido + "\n";
+
+    for (int tentativa = 0; tentativa < 2; ++tentativa) {
+        bool reaproveitada = conexao.isAberto();
+        if (!reaproveitada && !conexao.conectar(caminhoSocket, TIMEOUT_MS)) return false;
+        novasMelhores.clear();
+        posicoes.clear();
+
+        bool confirmado = false;
+        bool fimMelhores = false;
+        bool ok = conexao.enviarTudo(pedido, TIMEOUT_MS);
+        Relogio::time_point prazo = Relogio::now() + std::chrono::milliseconds(TIMEOUT_MS);
+        std::string entrada;
+        size_t inicio = 0;
+        std::vector<const LocalSocket*> sockets(1, &conexao);
+        std::vector<char> prontos;
+        while (ok) {
+            // Respostas na ordem dos pedidos: K, as primeiras posições até ".", uma linha R por consultado
+            size_t fim;
+            while ((fim = entrada.find('\n', inicio)) != std::string::npos) {
+                std::string linha = entrada.substr(inicio, fim - inicio);
+                inicio = fim + 1;
+                if (linha == "K") {
+                    confirmado = true;
+                } else if (linha == ".") {
+                    fimMelhores = true;
+                } else if (linha.size() > 2 && linha[0] == 'E' && linha[1] == ' ') {
+                    char* resto = nullptr;
+                    Colocacao c;
+                    c.pontuacao = (int)std::strtoll(linha.c_str() + 2, &resto, 10);
+                    if (*resto == ' ') c.apelido = resto + 1;
+                    novasMelhores.push_back(c);
+                } else if (linha.size() > 2 && linha[0] == 'R' && linha[1] == ' ') {
+                    char* resto = nullptr;
+                    size_t posicao = (size_t)std::strtoull(linha.c_str() + 2, &resto, 10);
+                    size_t total = (size_t)std::strtoull(resto, nullptr, 10);
+                    posicoes.emplace_back(posicao, total);
+                }
+            }
+            if (confirmado && fimMelhores && posicoes.size() >= consultados.size()) return true;
+
+            int restante = (int)std::chrono::duration_cast<std::chrono::milliseconds>(prazo - Relogio::now()).count();
+            ok = restante > 0 && LocalSocket::esperar(sockets, prontos, restante) > 0 && conexao.receber(entrada) >= 0;
+        }
+        conexao.fechar();
+        if (!reaproveitada) break; // Conexão nova que falhou: o serviço não está respondendo
+    }
+    return false;
+}
+
+/**
+ * @brief Uma tentativa de envio (com `mutex` travado na entrada e na saída).
+ * @return true se o serviço confirmou.
+ */
+bool LeaderboardClient::tentarEnvio() {
+    std::deque<Partida> retiradas;
+    retiradas.swap(fila); // O(1) com o mutex travado: `enviar` nunca espera a cópia do lote
+    std::vector<std::string> consultados;
+    for (const Acompanhado& a : acompanhados) consultados.push_back(a.apelido);
+    enviando = true;
+    al_unlock_mutex(mutex);
+    std::vector<Partida> lote(std::make_move_iterator(retiradas.begin()), std::make_move_iterator(retiradas.end()));
+    retiradas.clear();
+
+    // As pendentes vão antes da fila (são mais antigas), com a trava segura até a confirmação:
+    // outro jogo que as envie junto espera, e nenhuma partida de uma origem chega fora de ordem
+    std::vector<Partida> doArquivo;
+    std::error_code erro;
+    uintmax_t tamanho = std::filesystem::file_size(caminhoPendentes, erro);
+    if (!erro && tamanho > 0) {
+        travaPendentes.travar(FileLock::EXCLUSIVA);
+        lerPendentes(doArquivo);
+    }
+    std::vector<Partida> tudo;
+    tudo.reserve(doArquivo.size() + lote.size());
+    tudo.insert(tudo.end(), doArquivo.begin(), doArquivo.end());
+    tudo.insert(tudo.end(), lote.begin(), lote.end());
+
+    std::vector<Colocacao> novasMelhores;
+    std::vector<std::pair<size_t, size_t>> posicoes;
+    Relogio::time_point inicio = Relogio::now();
+    bool ok = trocar(tudo, consultados, novasMelhores, posicoes);
+    double ms = std::chrono::duration<double, std::milli>(Relogio::now() - inicio).count();
+
+    int noArquivo = (int)doArquivo.size();
+    int perdidas = 0;
+    if (ok && !doArquivo.empty()) {
+        std::filesystem::remove(caminhoPendentes, erro);
+        noArquivo = 0;
+    } else if (!ok && !lote.empty()) {
+        if (!travaPendentes.isTravada()) travaPendentes.travar(FileLock::EXCLUSIVA);
+        perdidas = guardarPendentes(lote, noArquivo);
+        noArquivo += (int)lote.size() - perdidas;
+    }
+    travaPendentes.destravar();
+
+    al_lock_mutex(mutex);
+    enviando = false;
+    pendentesArquivo = noArquivo;
+    estatisticas.conectado = ok;
+    if (ok) {
+        estatisticas.confirmadas += (int)tudo.size();
+        if (!tudo.empty()) ++estatisticas.lotes;
+        estatisticas.ultimaLatenciaMs = ms;
+        melhores = novasMelhores;
+        // Os acompanhados podem ter mudado durante a troca: casa pelo apelido
+        for (size_t i = 0; i < consultados.size() && i < posicoes.size(); ++i) {
+            for (Acompanhado& a : acompanhados) {
+                if (a.apelido != consultados[i]) continue;
+                a.posicao = posicoes[i].first;
+                a.total = posicoes[i].second;
+            }
+        }
+    } else {
+        ++estatisticas.falhas;
+        estatisticas.descartadas += perdidas;
+    }
+    if (fila.empty() && pendentesArquivo == 0) al_broadcast_cond(semPendencias);
+    return ok;
+}
+
+/**
+ * @brief Laço da thread de envio: junta as partidas de uma rajada, envia e, sem o
+ * serviço, tenta de novo com espera crescente. Sem partidas, só atualiza a cópia local.
+ */
+void* LeaderboardClient::executarEnvio(ALLEGRO_THREAD* thread, void* arg) {
+    (void)thread;
+    LeaderboardClient* cliente = static_cast<LeaderboardClient*>(arg);
+    int esperaMs = 0; // 0: a última tentativa deu certo
+    Relogio::time_point proximaTentativa = Relogio::now(); // Já entrega as pendentes e busca o ranking
+    Relogio::time_point proximaAtualizacao = Relogio::now();
+
+    al_lock_mutex(cliente->mutex);
+    while (true) {
+        bool temPartidas = !cliente->fila.empty() || cliente->pendentesArquivo > 0;
+        if (cliente->encerrando) {
+            if (temPartidas) cliente->tentarEnvio(); // Última tentativa; o que falhar fica no arquivo
+            break;
+        }
+        Relogio::time_point acordar = temPartidas ? proximaTentativa : std::max(proximaTentativa, proximaAtualizacao);
+        if (Relogio::now() < acordar) {
+            esperarAte(cliente->haTrabalho, cliente->mutex, acordar);
+            continue;
+        }
+        if (!cliente->fila.empty() && cliente->esperaGrupoMs > 0) {
+            // Junta o resto da rajada; cada partida nova acorda a thread, que volta a esperar até o fim do prazo
+            Relogio::time_point fimGrupo = Relogio::now() + std::chrono::milliseconds(cliente->esperaGrupoMs);
+            while (!cliente->encerrando && cliente->fila.size() < cliente->limiteFila && Relogio::now() < fimGrupo) {
+                esperarAte(cliente->haTrabalho, cliente->mutex, fimGrupo);
+            }
+            if (cliente->encerrando) continue;
+        }
+
+        bool ok = cliente->tentarEnvio();
+        Relogio::time_point agora = Relogio::now();
+        if (ok) {
+            esperaMs = 0;
+            proximaTentativa = agora;
+            proximaAtualizacao = agora + std::chrono::milliseconds(cliente->intervaloAtualizacaoMs);
+        } else {
+            esperaMs = esperaMs == 0 ? ESPERA_INICIAL_MS : std::min(esperaMs * 2, ESPERA_MAXIMA_MS);
+            proximaTentativa = agora + std::chrono::milliseconds(esperaMs);
+        }
+    }
+    al_unlock_mutex(cliente->mutex);
+    return nullptr;
+}
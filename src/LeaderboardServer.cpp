@@ -0,0 +1,322 @@
+/**
+ * @file LeaderboardServer.cpp
+ * @brief LeaderboardServerimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "LeaderboardServer.hpp"
+#include "MatchJournal.hpp" // Para sincronizarArquivo (fflush + fsync)
+#include <chrono>           // Para o intervalo entre gravações
+#include <cstdio>           // Para gravar com FILE*
+#include <cstdlib>          // Para std::strtoll e std::strtoull
+#include <ctime>            // Para o instante em que cada origem foi vista
+#include <filesystem>       // Para a pasta do socket e a troca do arquivo
+#include <fstream>          // Para ler o arquivo do ranking
+#include <iostream>         // Para mensagens de erro
+
+/// @brief Relógio usado no intervalo entre gravações.
+using Relogio = std::chrono::steady_clock;
+
+namespace {
+
+/**
+ * @brief Lê o próximo campo de uma linha (até o próximo espaço) e avança a posição.
+ * @return false se a linha acabou antes do campo.
+ */
+bool lerCampo(const std::string& linha, size_t& pos, std::string& campo) {
+    if (pos >= linha.size()) return false;
+    size_t fim = linha.find(' ', pos);
+    if (fim == std::string::npos) fim = linha.size();
+    campo.assign(linha, pos, fim - pos);
+    pos = fim + 1;
+    return !campo.empty();
+}
+
+/**
+ * @brief Lê um número inteiro seguido de espaço (ou do fim da linha) e avança a posição.
+ * @return false se não há um número na posição.
+ */
+bool lerNumero(const std::string& linha, size_t& pos, long long& numero) {
+    if (pos >= linha.size()) return false;
+    const char* inicio = linha.c_str() + pos;
+    char* fim = nullptr;
+    numero = std::strtoll(inicio, &fim, 10);
+    if (fim == inicio || (*fim != ' ' && *fim != '\0')) return false;
+    pos += (size_t)(fim - inicio) + 1;
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Construtor da classe LeaderboardServer.
+ */
+LeaderboardServer::LeaderboardServer(const std::string& caminhoSocket, const std::string& caminhoArquivo,
+                                     int intervaloGravacaoMs)
+    : caminhoSocket(caminhoSocket), caminhoArquivo(caminhoArquivo), intervaloGravacaoMs(intervaloGravacaoMs),
+      alterado(false), parando(false) {}
+
+/**
+ * @brief Lê o arquivo do ranking e abre o socket.
+ * @return true se o socket está aceitando conexões.
+ */
+bool LeaderboardServer::iniciar() {
+    if (!caminhoArquivo.empty()) carregar(); // Sem arquivo ainda: começa vazio
+    std::error_code erro;
+    std::filesystem::path pasta = std::filesystem::path(caminhoSocket).parent_path();
+    if (!pasta.empty()) std::filesystem::create_directories(pasta, erro);
+    return escuta.escutar(caminhoSocket);
+}
+
+/**
+ * @brief Laço de atendimento: espera bytes de qualquer conexão, responde e grava de tempos em tempos.
+ */
+void LeaderboardServer::executar() {
+    Relogio::time_point ultimaGravacao = Relogio::now();
+    std::vector<const LocalSocket*> sockets;
+    std::vector<char> escrita;
+    std::vector<char> prontos;
+    while (!parando) {
+        sockets.clear();
+        escrita.clear();
+        sockets.push_back(&escuta);
+        escrita.push_back(0);
+        for (const Conexao& conexao : conexoes) {
+            sockets.push_back(&conexao.socket);
+            escrita.push_back(!conexao.saida.empty()); // Com resposta pendente, espera também o jogo ler
+        }
+        if (LocalSocket::esperar(sockets, prontos, 100, &escrita) < 0) { // 100 ms: o pedido de parada é visto logo
+            std::cerr << "Erro: falha ao esperar as conexoes do ranking.\n";
+            break;
+        }
+
+        // As conexões de trás para a frente: fechar uma não muda o índice das anteriores
+        for (size_t i = conexoes.size(); i-- > 0;) {
+            if (prontos[i + 1] && !atender(conexoes[i])) conexoes.erase(conexoes.begin() + (long)i);
+        }
+        if (prontos[0]) {
+            Conexao nova;
+            while (escuta.aceitar(nova.socket)) {
+                conexoes.push_back(std::move(nova));
+                nova.entrada.clear();
+                ++estatisticas.conexoes;
+            }
+        }
+
+        if (alterado && !caminhoArquivo.empty() &&
+            Relogio::now() - ultimaGravacao >= std::chrono::milliseconds(intervaloGravacaoMs)) {
+            salvar();
+            ultimaGravacao = Relogio::now();
+        }
+    }
+
+    conexoes.clear();
+    escuta.fechar();
+    std::error_code erro;
+    std::filesystem::remove(caminhoSocket, erro); // Sem servidor, o caminho não deve parecer ocupado
+    if (alterado) salvar();
+}
+
+/**
+ * @brief Lê o que chegou de uma conexão, responde às linhas completas e envia o que couber da resposta.
+ * @return false se a conexão deve ser fechada.
+ */
+bool LeaderboardServer::atender(Conexao& conexao) {
+    if (conexao.socket.receber(conexao.entrada) < 0) return false;
+
+    std::string& saida = conexao.saida;
+    std::string linha;
+    size_t inicio = 0;
+    size_t fim;
+    while ((fim = conexao.entrada.find('\n', inicio)) != std::string::npos) {
+        linha.assign(conexao.entrada, inicio, fim - inicio);
+        if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+        processar(linha, saida);
+        inicio = fim + 1;
+    }
+    conexao.entrada.erase(0, inicio);
+    if (conexao.entrada.size() > MAXIMO_LINHA) {
+        ++estatisticas.invalidas; // Não é um jogo falando o protocolo
+        return false;
+    }
+
+    // Sem esperar: o que o jogo ainda não leu fica para quando o socket aceitar mais bytes
+    if (saida.empty()) return true;
+    int enviados = conexao.socket.enviar(saida);
+    if (enviados < 0) return false;
+    saida.erase(0, (size_t)enviados);
+    return saida.size() <= MAXIMO_SAIDA; // Um jogo que pergunta e nunca lê não prende a memória do serviço
+}
+
+/**
+ * @brief Processa uma linha do protocolo, acrescentando a resposta (se houver) à saída.
+ */
+void LeaderboardServer::processar(const std::string& linha, std::string& saida) {
+    char pedido = linha.empty() ? '\0' : linha[0];
+    if (linha.size() > 1 && linha[1] != ' ') pedido = '\0';
+    size_t pos = 2;
+
+    switch (pedido) {
+        case 'P': {
+            std::string origem;
+            long long seq = 0;
+            long long pontuacao = 0;
+            if (!lerCampo(linha, pos, origem) || !lerNumero(linha, pos, seq) || !lerNumero(linha, pos, pontuacao) ||
+                seq <= 0 || pontuacao < 0 || pontuacao > 2000000000 || pos >= linha.size()) {
+                ++estatisticas.invalidas;
+                return;
+            }
+            Origem& ultima = origens[origem];
+            ultima.vista = (long long)time(nullptr);
+            if ((uint64_t)seq <= ultima.seq) {
+                ++estatisticas.repetidas; // Reenvio de um lote que já tinha sido contado
+                return;
+            }
+            ultima.seq = (uint64_t)seq;
+            registrar(linha.substr(pos), (int)pontuacao);
+            ++estatisticas.partidas;
+            alterado = true;
+            return;
+        }
+        case 'F':
+            if (linha.size() != 1) break;
+            saida += "K\n";
+            ++estatisticas.lotes;
+            return;
+        case 'T': {
+            long long k = 0;
+            if (!lerNumero(linha, pos, k)) break;
+            if (k > MAXIMO_CONSULTA) k = MAXIMO_CONSULTA;
+            if (k > 0) {
+                for (int32_t id : ranking.melhores((size_t)k)) {
+                    saida += "E " + std::to_string(ranking.getPontuacao(id)) + " " + apelidos[id] + "\n";
+                }
+            }
+            saida += ".\n";
+            ++estatisticas.consultas;
+            return;
+        }
+        case 'R': {
+            if (linha.size() < 3) break;
+            std::unordered_map<std::string, int32_t>::const_iterator it = ids.find(linha.substr(2));
+            size_t posicao = it == ids.end() ? 0 : ranking.getPosicao(it->second);
+            saida += "R " + std::to_string(posicao) + " " + std::to_string(ranking.getQuantidade()) + "\n";
+            ++estatisticas.consultas;
+            return;
+        }
+        default:
+            break;
+    }
+    ++estatisticas.invalidas;
+    if (pedido == 'T') saida += ".\n"; // Quem perguntou ainda espera o fim da lista
+    if (pedido == 'R') saida += "R 0 " + std::to_string(ranking.getQuantidade()) + "\n";
+}
+
+/**
+ * @brief Conta uma pontuação para um apelido, cadastrando-o no ranking na primeira vez.
+ */
+void LeaderboardServer::registrar(const std::string& apelido, int pontuacao) {
+    std::unordered_map<std::string, int32_t>::iterator it = ids.find(apelido);
+    if (it == ids.end()) {
+        int32_t id = (int32_t)apelidos.size();
+        apelidos.push_back(apelido);
+        ids.emplace(apelido, id);
+        ranking.atualizar(id, pontuacao);
+    } else if (pontuacao > ranking.getPontuacao(it->second)) {
+        ranking.atualizar(it->second, pontuacao); // Só o recorde do apelido conta
+    }
+}
+
+/**
+ * @brief Esquece as origens sem partidas há mais de VALIDADE_ORIGEM_S.
+ */
+void LeaderboardServer::esquecerOrigens(long long agora) {
+    for (std::unordered_map<std::string, Origem>::iterator it = origens.begin(); it != origens.end();) {
+        if (agora - it->second.vista > VALIDADE_ORIGEM_S) {
+            it = origens.erase(it);
+            ++estatisticas.origensEsquecidas;
+            alterado = true; // O arquivo ainda tem a origem
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * @brief Lê o arquivo do ranking: linhas `O <origem> <seq> <instante>` e `J <pontuacao> <apelido>`.
+ * Uma linha `O` sem o instante (arquivo da versão anterior) conta como vista agora.
+ * @return true se o arquivo foi aberto.
+ */
+bool LeaderboardServer::carregar() {
+    std::ifstream arq(caminhoArquivo);
+    if (!arq.is_open()) return false;
+
+    long long agora = (long long)time(nullptr);
+    std::string linha;
+    std::string origem;
+    int invalidas = 0;
+    while (std::getline(arq, linha)) {
+        if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+        size_t pos = 2;
+        long long numero = 0;
+        long long vista = agora;
+        if (linha.size() > 2 && linha[0] == 'O' && linha[1] == ' ' && lerCampo(linha, pos, origem) &&
+            lerNumero(linha, pos, numero) && numero >= 0 && (pos >= linha.size() || lerNumero(linha, pos, vista))) {
+            Origem& ultima = origens[origem];
+            if ((uint64_t)numero > ultima.seq) ultima.seq = (uint64_t)numero;
+            if (vista > ultima.vista) ultima.vista = vista;
+        } else if (linha.size() > 2 && linha[0] == 'J' && linha[1] == ' ' && lerNumero(linha, pos, numero) &&
+                   numero >= 0 && pos < linha.size()) {
+            registrar(linha.substr(pos), (int)numero);
+        } else if (!linha.empty()) {
+            ++invalidas;
+        }
+    }
+    if (invalidas > 0) {
+        std::cerr << "AVISO: " << invalidas << " linha(s) invalida(s) ignorada(s) em " << caminhoArquivo << "\n";
+    }
+    esquecerOrigens(agora);
+    return true;
+}
+
+/**
+ * @brief Grava o ranking em um temporário e o renomeia por cima do arquivo.
+ * @return true se o arquivo foi gravado.
+ */
+bool LeaderboardServer::salvar() {
+    if (caminhoArquivo.empty()) return true;
+
+    esquecerOrigens((long long)time(nullptr)); // Sem isso o arquivo cresceria a cada execução de um jogo
+    std::string conteudo;
+    for (const std::pair<const std::string, Origem>& origem : origens) {
+        conteudo += "O " + origem.first + " " + std::to_string(origem.second.seq) + " " +
+                    std::to_string(origem.second.vista) + "\n";
+    }
+    for (int32_t id = 0; id < (int32_t)apelidos.size(); ++id) {
+        conteudo += "J " + std::to_string(ranking.getPontuacao(id)) + " " + apelidos[id] + "\n";
+    }
+
+    // Garante que o diretório exista
+    std::error_code erro;
+    std::filesystem::create_directories(std::filesystem::path(caminhoArquivo).parent_path(), erro);
+
+    std::string temporario = caminhoArquivo + ".tmp";
+    FILE* arq = fopen(temporario.c_str(), "wb");
+    if (!arq) {
+        std::cerr << "Erro: não foi possível salvar o ranking em " << caminhoArquivo << "\n";
+        return false;
+    }
+    bool ok = fwrite(conteudo.data(), 1, conteudo.size(), arq) == conteudo.size();
+    ok = MatchJournal::sincronizarArquivo(arq) && ok;
+    ok = fclose(arq) == 0 && ok;
+
+    if (ok) std::filesystem::rename(temporario, caminhoArquivo, erro);
+    if (!ok || erro) {
+        std::cerr << "Erro: não foi possível salvar o ranking em " << caminhoArquivo << "\n";
+        std::filesystem::remove(temporario, erro);
+        return false;
+    }
+    alterado = false;
+    ++estatisticas.gravacoes;
+    return true;
+}
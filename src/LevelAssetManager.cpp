@@ -0,0 +1,310 @@
+/**
+ * @file LevelAssetManager.cpp
+ * @brief LevelAssetManagerimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "LevelAssetManager.hpp"
+#include "Pipe.hpp"   // Para Pipe::SPRITE_SCALE (tamanho em que os canos são desenhados)
+#include <algorithm>  // Para std::sort e std::max
+#include <iostream>   // Para saída de avisos e do log de residência
+#include <memory>     // Para std::shared_ptr (pixels passados entre as etapas do carregamento)
+#include <sstream>    // Para montar os caminhos dos assets
+
+/// @brief Limite de níveis procurados nos assets.
+static const int MAX_NIVEIS = 99;
+
+/**
+ * @brief Construtor da classe LevelAssetManager.
+ * Procura background1.png, background2.png, ... até o primeiro que faltar; os níveis
+ * sem cano ou música são pulados, como antes (o índice 0 é o primeiro nível completo).
+ */
+LevelAssetManager::LevelAssetManager(AssetLoader& carregador, const AssetArchive& pacote, const std::string& diretorioCache,
+                                     int telaW, int telaH, size_t orcamentoBytes, MemoryTracker* memoria)
+    : carregador(carregador), pacote(pacote), cache(diretorioCache, &pacote), telaW(telaW), telaH(telaH),
+      orcamento(orcamentoBytes), memoria(memoria), nivelAtual(0), relogio(0)
+{
+    for (int i = 1; i <= MAX_NIVEIS; ++i) {
+        std::stringstream pathBg, pathPipe, pathMusic;
+        pathBg << "assets/background" << i << ".png";
+        pathPipe << "assets/pipe" << i << ".png";
+        pathMusic << "assets/level" << i << ".ogg";
+
+        if (!pacote.existe(pathBg.str())) break; // Fim dos níveis
+
+        // Um nível incompleto é pulado e os seguintes continuam valendo
+        bool temCano = pacote.existe(pathPipe.str());
+        bool temMusica = pacote.existe(pathMusic.str());
+        if (!temCano || !temMusica) {
+            std::cerr << "Erro ao carregar arquivos do nível " << i << ": "
+                      << (temCano ? "" : "pipe.png ") << (temMusica ? "" : "music.ogg ") << "\n";
+            continue;
+        }
+
+        Nivel nivel;
+        nivel.numero = i;
+        nivel.caminhoFundo = pathBg.str();
+        nivel.caminhoCano = pathPipe.str();
+        nivel.caminhoMusica = pathMusic.str();
+        niveis.push_back(nivel);
+    }
+
+    if (niveis.empty()) {
+        std::cerr << "Erro: Nenhum nivel encontrado nos assets.\n";
+    }
+}
+
+/**
+ * @brief Destrutor da classe LevelAssetManager.
+ */
+LevelAssetManager::~LevelAssetManager() {
+    for (int i = 0; i < (int)niveis.size(); ++i) {
+        descarregar(i);
+    }
+    std::cout << "Niveis: " << stats.carregamentos << " carregamento(s), " << stats.descartes
+              << " descarte(s), pico de " << stats.picoBytes / (1024 * 1024) << " MB, "
+              << stats.esperas << " espera(s) (" << stats.msEsperando << " ms). Imagens: "
+              << cache.getAcertos() << " do cache (" << cache.getMsAcertos() << " ms), "
+              << cache.getGeradas() << " geradas (" << cache.getMsGeradas() << " ms).\n";
+}
+
+/**
+ * @brief Informa se um nível pode ser pedido a qualquer momento.
+ * @return true para o nível atual, o próximo e o primeiro (destino do "Reiniciar").
+ */
+bool LevelAssetManager::alcancavel(int nivel) const {
+    return nivel == nivelUsado(nivelAtual) || nivel == nivelUsado(nivelAtual + 1) || nivel == nivelUsado(0) ||
+           nivel == nivelAtual || nivel == nivelAtual + 1 || nivel == 0;
+}
+
+/**
+ * @brief Retorna o nível cujos assets são usados no lugar de outro.
+ * @return O próprio nível, ou o residente mais próximo se ele falhou.
+ */
+int LevelAssetManager::nivelUsado(int nivel) const {
+    if (nivel < 0 || nivel >= (int)niveis.size()) return -1;
+    if (niveis[nivel].estado != FALHOU) return nivel;
+    std::vector<bool> residentes(niveis.size());
+    for (size_t i = 0; i < niveis.size(); ++i) residentes[i] = niveis[i].estado == RESIDENTE;
+    return escolherSubstituto(residentes, nivel);
+}
+
+/**
+ * @brief Define o nível atual, pede ele e o próximo, e aplica o orçamento.
+ */
+void LevelAssetManager::definirNivelAtual(int nivel) {
+    nivelAtual = nivel;
+    solicitar(nivel);
+    solicitar(nivel + 1); // Pré-carrega o próximo enquanto este é jogado
+    aplicarOrcamento();
+}
+
+/**
+ * @brief Agenda o carregamento de um nível: os pixels em uma thread, os envios na thread principal.
+ */
+void LevelAssetManager::solicitar(int nivel) {
+    if (nivel < 0 || nivel >= (int)niveis.size()) return;
+
+    Nivel& n = niveis[nivel];
+    n.ultimoUso = ++relogio;
+    if (n.estado != VAZIO) return; // Já carregado, carregando ou sem conserto
+
+    n.estado = CARREGANDO;
+    ++stats.carregando;
+
+    auto fundo = std::make_shared<ScaledAssetCache::Pixels>();
+    auto cano = std::make_shared<ScaledAssetCache::Pixels>();
+    std::string caminhoFundo = n.caminhoFundo;
+    std::string caminhoCano = n.caminhoCano;
+
+    carregador.adicionar(
+        [this, caminhoFundo, caminhoCano, fundo, cano]() {
+            cache.prepararPreenchendo(caminhoFundo, telaW, telaH, *fundo);
+            cache.prepararComEscala(caminhoCano, Pipe::SPRITE_SCALE, *cano);
+        },
+        [this, nivel, fundo, cano]() {
+            Nivel& n = niveis[nivel];
+            --stats.carregando;
+
+            n.fundo = ScaledAssetCache::criarBitmap(*fundo);
+            n.cano = ScaledAssetCache::criarBitmap(*cano);
+            n.musica = pacote.carregarMusica(n.caminhoMusica, 4, 2048); // Stream de áudio com 4 buffers e buffer size de 2048.
+
+            if (!n.fundo || !n.cano || !n.musica) {
+                std::cerr << "Erro ao carregar arquivos do nível " << n.numero << ": "
+                          << (n.fundo ? "" : "background.png ") << (n.cano ? "" : "pipe.png ")
+                          << (n.musica ? "" : "music.ogg ") << "\n";
+                if (n.fundo) { al_destroy_bitmap(n.fundo); n.fundo = nullptr; }
+                if (n.cano) { al_destroy_bitmap(n.cano); n.cano = nullptr; }
+                if (n.musica) { al_destroy_audio_stream(n.musica); n.musica = nullptr; }
+                n.estado = FALHOU;
+                return;
+            }
+
+            n.bytes = MemoryTracker::bytesBitmap(n.fundo) + MemoryTracker::bytesBitmap(n.cano)
+                    + MemoryTracker::bytesStream(n.musica);
+            if (memoria) {
+                memoria->registrarBitmap(n.fundo, n.numero, n.caminhoFundo);
+                memoria->registrarBitmap(n.cano, n.numero, n.caminhoCano);
+                memoria->registrarStream(n.musica, n.numero, n.caminhoMusica);
+            }
+            n.estado = RESIDENTE;
+            ++stats.residentes;
+            ++stats.carregamentos;
+            stats.bytesResidentes += n.bytes;
+            stats.picoBytes = std::max(stats.picoBytes, stats.bytesResidentes);
+            aplicarOrcamento();
+        });
+}
+
+/**
+ * @brief Espera um nível (ou o substituto dele) terminar de carregar.
+ * @return true se há assets para o nível.
+ */
+bool LevelAssetManager::garantirResidente(int nivel) {
+    if (nivel < 0 || nivel >= (int)niveis.size()) return false;
+
+    // Cada volta que falha marca mais um nível como FALHOU, então o laço sempre termina
+    std::vector<bool> disponiveis(niveis.size());
+    while (true) {
+        for (size_t i = 0; i < niveis.size(); ++i) disponiveis[i] = niveis[i].estado != FALHOU;
+        int escolhido = escolherSubstituto(disponiveis, nivel);
+        if (escolhido < 0) {
+            std::cerr << "Erro: Nenhum nivel pode ser carregado para o nivel " << niveis[nivel].numero << ".\n";
+            return false;
+        }
+        solicitar(escolhido);
+        esperarCarregamento(escolhido);
+        if (niveis[escolhido].estado == RESIDENTE) {
+            if (escolhido != nivel) {
+                std::cerr << "AVISO: Nivel " << niveis[nivel].numero << " falhou; usando o nivel "
+                          << niveis[escolhido].numero << " no lugar.\n";
+            }
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Espera um nível que está sendo preparado, processando os trabalhos prontos.
+ */
+void LevelAssetManager::esperarCarregamento(int nivel) {
+    if (niveis[nivel].estado != CARREGANDO) return;
+
+    // O pré-carregamento não terminou a tempo: espera (e registra, para aparecer no HUD)
+    double inicio = al_get_time();
+    while (niveis[nivel].estado == CARREGANDO) {
+        if (carregador.processarProntos(1000.0) == 0) al_rest(0.001);
+    }
+    double ms = (al_get_time() - inicio) * 1000.0;
+    ++stats.esperas;
+    stats.msEsperando += ms;
+    std::cerr << "AVISO: Esperou " << ms << " ms pelo nivel " << niveis[nivel].numero << ".\n";
+}
+
+/**
+ * @brief Libera os assets de um nível carregado.
+ */
+void LevelAssetManager::descarregar(int nivel) {
+    Nivel& n = niveis[nivel];
+    if (n.estado != RESIDENTE) return;
+
+    if (memoria) {
+        memoria->remover(n.fundo);
+        memoria->remover(n.cano);
+        memoria->remover(n.musica);
+    }
+    if (n.fundo) { al_destroy_bitmap(n.fundo); n.fundo = nullptr; }
+    if (n.cano) { al_destroy_bitmap(n.cano); n.cano = nullptr; }
+    if (n.musica) { al_destroy_audio_stream(n.musica); n.musica = nullptr; }
+
+    stats.bytesResidentes -= n.bytes;
+    --stats.residentes;
+    n.bytes = 0;
+    n.estado = VAZIO;
+}
+
+/**
+ * @brief Descarrega níveis fora do alcance até caber no orçamento.
+ */
+void LevelAssetManager::aplicarOrcamento() {
+    std::vector<Residencia> residentes;
+    for (int i = 0; i < (int)niveis.size(); ++i) {
+        if (niveis[i].estado == RESIDENTE) {
+            residentes.push_back({i, niveis[i].bytes, niveis[i].ultimoUso, alcancavel(i)});
+        }
+    }
+
+    for (int nivel : escolherDescartes(residentes, orcamento)) {
+        descarregar(nivel);
+        ++stats.descartes;
+        std::cout << "Nivel " << niveis[nivel].numero << " descarregado (" << stats.bytesResidentes / (1024 * 1024)
+                  << " MB de " << orcamento / (1024 * 1024) << " MB em uso).\n";
+    }
+}
+
+/**
+ * @brief Escolhe os níveis a descarregar, do usado há mais tempo para o mais recente.
+ * @return Os índices dos níveis a descarregar.
+ */
+std::vector<int> LevelAssetManager::escolherDescartes(std::vector<Residencia> residentes, size_t orcamento) {
+    size_t total = 0;
+    for (const Residencia& r : residentes) total += r.bytes;
+
+    std::vector<int> descartes;
+    if (total <= orcamento) return descartes;
+
+    std::sort(residentes.begin(), residentes.end(), [](const Residencia& a, const Residencia& b) {
+        return a.ultimoUso < b.ultimoUso;
+    });
+    for (const Residencia& r : residentes) {
+        if (total <= orcamento) break;
+        if (r.alcancavel) continue; // Pode ser pedido a qualquer momento
+        descartes.push_back(r.nivel);
+        total -= r.bytes;
+    }
+    return descartes;
+}
+
+/**
+ * @brief Escolhe o próprio nível, o anterior mais próximo ou o seguinte mais próximo que pode ser usado.
+ * @return O nível escolhido, ou -1.
+ */
+int LevelAssetManager::escolherSubstituto(const std::vector<bool>& disponiveis, int nivel) {
+    int total = (int)disponiveis.size();
+    if (nivel < 0 || nivel >= total) return -1;
+    for (int i = nivel; i >= 0; --i) {
+        if (disponiveis[i]) return i;
+    }
+    for (int i = nivel + 1; i < total; ++i) {
+        if (disponiveis[i]) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Retorna o fundo de um nível carregado (ou do substituto).
+ * @return O bitmap, ou nullptr.
+ */
+ALLEGRO_BITMAP* LevelAssetManager::getFundo(int nivel) const {
+    int usado = nivelUsado(nivel);
+    return usado < 0 ? nullptr : niveis[usado].fundo;
+}
+
+/**
+ * @brief Retorna o cano de um nível carregado (ou do substituto).
+ * @return O bitmap, ou nullptr.
+ */
+ALLEGRO_BITMAP* LevelAssetManager::getCano(int nivel) const {
+    int usado = nivelUsado(nivel);
+    return usado < 0 ? nullptr : niveis[usado].cano;
+}
+
+/**
+ * @brief Retorna a música de um nível carregado (ou do substituto).
+ * @return A stream, ou nullptr.
+ */
+ALLEGRO_AUDIO_STREAM* LevelAssetManager::getMusica(int nivel) const {
+    int usado = nivelUsado(nivel);
+    return usado < 0 ? nullptr : niveis[usado].musica;
+}
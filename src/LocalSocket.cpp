@@ -0,0 +1,348 @@
+/**
+ * @file LocalSocket.cpp
+ * @brief LocalSocketimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "LocalSocket.hpp"
+#include <chrono>     // Para os prazos de `conectar` e `enviarTudo`
+#include <cstring>    // Para std::memset e std::strncpy (endereço)
+#include <filesystem> // Para apagar o arquivo de um socket abandonado
+#include <iostream>   // Para mensagens de erro
+
+#ifdef _WIN32
+#include <winsock2.h> // Para o Winsock (link com -lws2_32)
+#include <afunix.h>   // Para sockaddr_un (Windows 10 ou mais novo)
+#else
+#include <cerrno>       // Para EAGAIN/EINPROGRESS/EINTR
+#include <fcntl.h>      // Para O_NONBLOCK e FD_CLOEXEC
+#include <poll.h>       // Para poll
+#include <sys/socket.h> // Para socket/connect/send/recv
+#include <sys/un.h>     // Para sockaddr_un
+#include <unistd.h>     // Para close
+#endif
+
+/// @brief Relógio usado nos prazos.
+using Relogio = std::chrono::steady_clock;
+
+namespace {
+
+#ifdef _WIN32
+/**
+ * @brief Inicia o Winsock uma vez por processo.
+ * @return true se o Winsock está pronto.
+ */
+bool iniciarWinsock() {
+    static const bool pronto = [] {
+        WSADATA dados;
+        return WSAStartup(MAKEWORD(2, 2), &dados) == 0;
+    }();
+    return pronto;
+}
+
+/// @brief Informa se a última operação só não terminou porque o socket não bloqueia.
+bool deveEsperar() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+
+/// @brief Fecha um socket do sistema.
+void fecharSocket(intptr_t s) { closesocket((SOCKET)s); }
+
+/// @brief Tamanho de um valor de getsockopt.
+using TamanhoOpcao = int;
+#else
+/// @brief Informa se a última operação só não terminou porque o socket não bloqueia.
+bool deveEsperar() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+
+/// @brief Fecha um socket do sistema.
+void fecharSocket(intptr_t s) { close((int)s); }
+
+/// @brief Tamanho de um valor de getsockopt.
+using TamanhoOpcao = socklen_t;
+#endif
+
+/**
+ * @brief Cria um socket AF_UNIX de fluxo, não bloqueante e que não passa para processos filhos.
+ * @return O socket, ou -1 se não pôde ser criado.
+ */
+intptr_t criarSocket() {
+#ifdef _WIN32
+    if (!iniciarWinsock()) return -1;
+    SOCKET s = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s == INVALID_SOCKET) return -1;
+    u_long naoBloqueia = 1;
+    ioctlsocket(s, FIONBIO, &naoBloqueia);
+    return (intptr_t)s;
+#else
+    int s = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s < 0) return -1;
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL) | O_NONBLOCK);
+    fcntl(s, F_SETFD, FD_CLOEXEC);
+    return s;
+#endif
+}
+
+/**
+ * @brief Monta o endereço de um caminho.
+ * @return false se o caminho não cabe no endereço.
+ */
+bool montarEndereco(const std::string& caminho, sockaddr_un& endereco) {
+    std::memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if (caminho.empty() || caminho.size() >= sizeof(endereco.sun_path)) {
+        std::cerr << "Erro: caminho de socket invalido (vazio ou longo demais): " << caminho << "\n";
+        return false;
+    }
+    std::strncpy(endereco.sun_path, caminho.c_str(), sizeof(endereco.sun_path) - 1);
+    return true;
+}
+
+/**
+ * @brief Milissegundos que faltam até um prazo (0 se já passou).
+ */
+int restanteMs(Relogio::time_point prazo) {
+    auto resto = std::chrono::duration_cast<std::chrono::milliseconds>(prazo - Relogio::now()).count();
+    return resto > 0 ? (int)resto : 0;
+}
+
+} // namespace
+
+/**
+ * @brief Atribuição de movimento.
+ */
+LocalSocket& LocalSocket::operator=(LocalSocket&& outro) noexcept {
+    if (this != &outro) {
+        fechar();
+        descritor = outro.descritor;
+        outro.descritor = -1;
+    }
+    return *this;
+}
+
+/**
+ * @brief Conecta a um servidor.
+ * @return true se a conexão foi aceita a tempo.
+ */
+bool LocalSocket::conectar(const std::string& caminho, int timeoutMs) {
+    fechar();
+    sockaddr_un endereco;
+    if (!montarEndereco(caminho, endereco)) return false;
+    Relogio::time_point prazo = Relogio::now() + std::chrono::milliseconds(timeoutMs);
+
+    while (true) {
+        descritor = criarSocket();
+        if (descritor == -1) return false;
+#ifdef _WIN32
+        if (connect((SOCKET)descritor, (const sockaddr*)&endereco, sizeof(endereco)) == 0) return true;
+        bool andamento = deveEsperar();
+        bool filaCheia = false;
+#else
+        int resultado;
+        do {
+            resultado = connect((int)descritor, (const sockaddr*)&endereco, sizeof(endereco));
+        } while (resultado != 0 && errno == EINTR);
+        if (resultado == 0) return true;
+        bool andamento = errno == EINPROGRESS;
+        bool filaCheia = errno == EAGAIN; // Fila de conexões do servidor cheia: tenta de novo
+#endif
+        if (andamento) {
+            int erro = 0;
+            TamanhoOpcao tamanho = sizeof(erro);
+            if (esperarPronto(true, restanteMs(prazo)) &&
+                getsockopt(descritor, SOL_SOCKET, SO_ERROR, (char*)&erro, &tamanho) == 0 && erro == 0) {
+                return true;
+            }
+        }
+        fechar();
+        if (!filaCheia || restanteMs(prazo) == 0) return false;
+        esperarPronto(false, 1); // Sem socket aberto: só deixa passar 1 ms
+    }
+}
+
+/**
+ * @brief Passa a aceitar conexões em um caminho.
+ * @return true se o socket está escutando.
+ */
+bool LocalSocket::escutar(const std::string& caminho) {
+    fechar();
+    sockaddr_un endereco;
+    if (!montarEndereco(caminho, endereco)) return false;
+
+    // Um arquivo de socket sem servidor sobra quando o anterior cai; com servidor, o caminho está em uso
+    LocalSocket sonda;
+    if (sonda.conectar(caminho, 200)) {
+        std::cerr << "Erro: outro servidor ja responde em " << caminho << "\n";
+        return false;
+    }
+    std::error_code erro;
+    std::filesystem::remove(caminho, erro);
+
+    descritor = criarSocket();
+    if (descritor == -1 || bind(descritor, (const sockaddr*)&endereco, sizeof(endereco)) != 0 ||
+        listen(descritor, SOMAXCONN) != 0) {
+        std::cerr << "Erro: nao foi possivel escutar em " << caminho << "\n";
+        fechar();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Aceita uma conexão que está esperando.
+ * @return true se uma conexão foi aceita.
+ */
+bool LocalSocket::aceitar(LocalSocket& conexao) {
+    if (descritor == -1) return false;
+#ifdef _WIN32
+    SOCKET s = accept((SOCKET)descritor, nullptr, nullptr);
+    if (s == INVALID_SOCKET) return false;
+    u_long naoBloqueia = 1;
+    ioctlsocket(s, FIONBIO, &naoBloqueia);
+    conexao.fechar();
+    conexao.descritor = (intptr_t)s;
+#else
+    int s = accept((int)descritor, nullptr, nullptr);
+    if (s < 0) return false;
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL) | O_NONBLOCK);
+    fcntl(s, F_SETFD, FD_CLOEXEC);
+    conexao.fechar();
+    conexao.descritor = s;
+#endif
+    return true;
+}
+
+/**
+ * @brief Envia todos os bytes, esperando o outro lado ler se preciso.
+ * @return true se tudo foi enviado.
+ */
+bool LocalSocket::enviarTudo(const std::string& dados, int timeoutMs) {
+    Relogio::time_point prazo = Relogio::now() + std::chrono::milliseconds(timeoutMs);
+    size_t enviados = 0;
+    while (true) {
+        int n = enviar(dados, enviados);
+        if (n < 0) return false;
+        enviados += (size_t)n;
+        if (enviados == dados.size()) return true;
+        if (!esperarPronto(true, restanteMs(prazo))) return false; // O outro lado parou de ler
+    }
+}
+
+/**
+ * @brief Envia o que couber dos bytes, sem esperar.
+ * @return Bytes enviados, ou -1 se a conexão caiu.
+ */
+int LocalSocket::enviar(const std::string& dados, size_t inicio) {
+    if (descritor == -1) return -1;
+    size_t enviados = inicio;
+    while (enviados < dados.size()) {
+        size_t resto = dados.size() - enviados;
+#ifdef _WIN32
+        int n = send((SOCKET)descritor, dados.data() + enviados, (int)resto, 0);
+#else
+        int flags = 0;
+#ifdef MSG_NOSIGNAL
+        flags = MSG_NOSIGNAL; // Um leitor que caiu vira erro, não SIGPIPE
+#endif
+        ssize_t n = send((int)descritor, dados.data() + enviados, resto, flags);
+        if (n < 0 && errno == EINTR) continue;
+#endif
+        if (n > 0) {
+            enviados += (size_t)n;
+        } else if (n < 0 && deveEsperar()) {
+            break; // O resto fica para quando o outro lado ler
+        } else {
+            return -1;
+        }
+    }
+    return (int)(enviados - inicio);
+}
+
+/**
+ * @brief Acrescenta ao destino os bytes que já chegaram.
+ * @return Bytes recebidos, ou -1 se a conexão acabou.
+ */
+int LocalSocket::receber(std::string& destino) {
+    if (descritor == -1) return -1;
+    char bloco[16384];
+    int total = 0;
+    while (true) {
+#ifdef _WIN32
+        int n = recv((SOCKET)descritor, bloco, (int)sizeof(bloco), 0);
+#else
+        ssize_t n = recv((int)descritor, bloco, sizeof(bloco), 0);
+        if (n < 0 && errno == EINTR) continue;
+#endif
+        if (n > 0) {
+            destino.append(bloco, (size_t)n);
+            total += (int)n;
+        } else if (n < 0 && deveEsperar()) {
+            return total; // Nada mais por enquanto
+        } else {
+            return total > 0 ? total : -1; // Fechada: o fim é informado na próxima chamada
+        }
+    }
+}
+
+/**
+ * @brief Espera até algum dos sockets ter algo para ler (ou, nos pedidos, espaço para escrever).
+ * @return Quantos estão prontos, 0 no fim do tempo ou -1 em erro.
+ */
+int LocalSocket::esperar(const std::vector<const LocalSocket*>& sockets, std::vector<char>& prontos, int timeoutMs,
+                         const std::vector<char>* escrita) {
+    prontos.assign(sockets.size(), 0);
+#ifdef _WIN32
+    std::vector<WSAPOLLFD> lista(sockets.size());
+#else
+    std::vector<pollfd> lista(sockets.size());
+#endif
+    for (size_t i = 0; i < sockets.size(); ++i) {
+        lista[i].fd = sockets[i]->descritor;
+        lista[i].events = POLLIN;
+        if (escrita && (*escrita)[i]) lista[i].events |= POLLOUT;
+        lista[i].revents = 0;
+    }
+#ifdef _WIN32
+    int n = WSAPoll(lista.data(), (ULONG)lista.size(), timeoutMs);
+#else
+    int n = poll(lista.data(), (nfds_t)lista.size(), timeoutMs);
+    if (n < 0 && errno == EINTR) return 0; // Um sinal (ex: pedido de parada) conta como fim do tempo
+#endif
+    if (n <= 0) return n;
+    for (size_t i = 0; i < sockets.size(); ++i) {
+        prontos[i] = (lista[i].revents & (POLLIN | POLLOUT | POLLHUP | POLLERR)) != 0;
+    }
+    return n;
+}
+
+/**
+ * @brief Espera o socket ficar pronto para ler ou escrever.
+ * @return true se ficou pronto antes do fim do tempo.
+ */
+bool LocalSocket::esperarPronto(bool escrita, int timeoutMs) const {
+#ifdef _WIN32
+    if (descritor == -1) {
+        Sleep(timeoutMs);
+        return false;
+    }
+    WSAPOLLFD item = {};
+    item.fd = (SOCKET)descritor;
+    item.events = escrita ? POLLOUT : POLLIN;
+    return WSAPoll(&item, 1, timeoutMs) > 0;
+#else
+    pollfd item = {};
+    item.fd = (int)descritor; // -1: poll só espera o tempo
+    item.events = escrita ? POLLOUT : POLLIN;
+    int n;
+    do {
+        n = poll(&item, 1, timeoutMs);
+    } while (n < 0 && errno == EINTR);
+    return n > 0 && descritor != -1;
+#endif
+}
+
+/**
+ * @brief Fecha o socket.
+ */
+void LocalSocket::fechar() {
+    if (descritor == -1) return;
+    fecharSocket(descritor);
+    descritor = -1;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file Lz4Block.cpp
+ * @brief Lz4Blockimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "Lz4Block.hpp"
+#include <cstdint> // Para uint32_t
+#include <cstring> // Para memcpy
+
+/// @brief Menor cópia que o formato representa.
+static const size_t TAMANHO_MINIMO_COPIA = 4;
+/// @brief Os últimos bytes do bloco são sempre literais (regra do formato).
+static const size_t ULTIMOS_LITERAIS = 5;
+/// @brief Uma cópia precisa começar pelo menos este número de bytes antes do fim (regra do formato).
+static const size_t LIMITE_COPIA = 12;
+/// @brief Distância máxima de uma cópia.
+static const size_t DISTANCIA_MAXIMA = 65535;
+/// @brief Bits da tabela de hash do compressor (4096 posições).
+static const int BITS_TABELA = 12;
+
+/**
+ * @brief Lê 4 bytes sem exigir alinhamento.
+ */
+static uint32_t ler32(const unsigned char* p) {
+    uint32_t valor;
+    memcpy(&valor, p, sizeof(valor));
+    return valor;
+}
+
+/**
+ * @brief Escreve a parte de um comprimento que não coube nos 4 bits do token (bytes de 255 + resto).
+ */
+static void escreverComprimento(std::vector<unsigned char>& saida, size_t restante) {
+    while (restante >= 255) {
+        saida.push_back(255);
+        restante -= 255;
+    }
+    saida.push_back((unsigned char)restante);
+}
+
+/**
+ * @brief Lê um comprimento estendido, somando ao valor do token.
+ * @return false se os bytes acabarem antes do fim do comprimento.
+ */
+static bool lerComprimento(const unsigned char* origem, size_t tamanhoOrigem, size_t& i, size_t& comprimento) {
+    unsigned char b;
+    do {
+        if (i >= tamanhoOrigem) return false;
+        b = origem[i++];
+        comprimento += b;
+    } while (b == 255);
+    return true;
+}
+
+/**
+ * @brief Escreve uma sequência: literais e, se `copia` > 0, a cópia que vem depois deles.
+ */
+static void escreverSequencia(std::vector<unsigned char>& saida, const unsigned char* literais, size_t quantidade,
+                              size_t distancia, size_t copia) {
+    size_t posicaoToken = saida.size();
+    saida.push_back(0);
+
+    unsigned char token = (unsigned char)((quantidade >= 15 ? 15 : quantidade) << 4);
+    if (quantidade >= 15) escreverComprimento(saida, quantidade - 15);
+    saida.insert(saida.end(), literais, literais + quantidade);
+
+    if (copia > 0) {
+        saida.push_back((unsigned char)(distancia & 0xFF));
+        saida.push_back((unsigned char)(distancia >> 8));
+        size_t extra = copia - TAMANHO_MINIMO_COPIA;
+        token |= (unsigned char)(extra >= 15 ? 15 : extra);
+        if (extra >= 15) escreverComprimento(saida, extra - 15);
+    }
+    saida[posicaoToken] = token;
+}
+
+/**
+ * @brief Comprime procurando, em cada posição, a última ocorrência dos mesmos 4 bytes.
+ * @return O bloco comprimido.
+ */
+std::vector<unsigned char> Lz4Block::comprimir(const unsigned char* dados, size_t tamanho) {
+    std::vector<unsigned char> saida;
+    saida.reserve(tamanho + tamanho / 255 + 16);
+
+    size_t ancora = 0; // Início dos literais ainda não escritos
+    if (tamanho > LIMITE_COPIA) {
+        const size_t NENHUMA = (size_t)-1;
+        std::vector<size_t> tabela((size_t)1 << BITS_TABELA, NENHUMA);
+        size_t limite = tamanho - LIMITE_COPIA;
+        size_t fimCopia = tamanho - ULTIMOS_LITERAIS;
+
+        size_t i = 0;
+        while (i < limite) {
+            uint32_t sequencia = ler32(dados + i);
+            uint32_t h = (sequencia * 2654435761u) >> (32 - BITS_TABELA);
+            size_t candidato = tabela[h];
+            tabela[h] = i;
+
+            if (candidato == NENHUMA || i - candidato > DISTANCIA_MAXIMA || ler32(dados + candidato) != sequencia) {
+                ++i;
+                continue;
+            }
+
+            size_t copia = TAMANHO_MINIMO_COPIA;
+            while (i + copia < fimCopia && dados[candidato + copia] == dados[i + copia]) ++copia;
+
+            escreverSequencia(saida, dados + ancora, i - ancora, i - candidato, copia);
+            i += copia;
+            ancora = i;
+        }
+    }
+
+    escreverSequencia(saida, dados + ancora, tamanho - ancora, 0, 0); // Últimos literais
+    return saida;
+}
+
+/**
+ * @brief Descomprime um bloco conferindo cada comprimento e distância.
+ * @return true se o bloco produziu exatamente `tamanhoDestino` bytes.
+ */
+bool Lz4Block::descomprimir(const unsigned char* origem, size_t tamanhoOrigem,
+                            unsigned char* destino, size_t tamanhoDestino) {
+    size_t i = 0, o = 0;
+    while (i < tamanhoOrigem) {
+        unsigned char token = origem[i++];
+
+        size_t literais = token >> 4;
+        if (literais == 15 && !lerComprimento(origem, tamanhoOrigem, i, literais)) return false;
+        if (literais > tamanhoOrigem - i || literais > tamanhoDestino - o) return false;
+        if (literais > 0) memcpy(destino + o, origem + i, literais);
+        i += literais;
+        o += literais;
+
+        if (i == tamanhoOrigem) break; // A última sequência só tem literais
+
+        if (tamanhoOrigem - i < 2) return false;
+        size_t distancia = origem[i] | ((size_t)origem[i + 1] << 8);
+        i += 2;
+        if (distancia == 0 || distancia > o) return false;
+
+        size_t copia = token & 15;
+        if (copia == 15 && !lerComprimento(origem, tamanhoOrigem, i, copia)) return false;
+        copia += TAMANHO_MINIMO_COPIA;
+        if (copia > tamanhoDestino - o) return false;
+
+        if (distancia >= copia) {
+            memcpy(destino + o, destino + o - distancia, copia);
+        } else {
+            // Cópia sobreposta (ex: uma cor repetida): byte a byte, repetindo o padrão
+            for (size_t k = 0; k < copia; ++k) destino[o + k] = destino[o + k - distancia];
+        }
+        o += copia;
+    }
+    return o == tamanhoDestino;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file MappedFile.cpp
+ * @brief MappedFileimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#include <windows.h>  // Para CreateFileMapping/MapViewOfFile
+#else
+#include <fcntl.h>    // Para open
+#include <sys/mman.h> // Para mmap/munmap
+#include <sys/stat.h> // Para fstat
+#include <unistd.h>   // Para close
+#endif
+
+/**
+ * @brief Mapeia o arquivo inteiro somente para leitura.
+ * @return true se o arquivo foi mapeado.
+ */
+bool MappedFile::abrir(const std::string& caminho) {
+    fechar();
+#ifdef _WIN32
+    HANDLE arquivo = CreateFileA(caminho.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (arquivo == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER tamanhoArquivo;
+    if (GetFileSizeEx(arquivo, &tamanhoArquivo) && tamanhoArquivo.QuadPart > 0) {
+        HANDLE mapa = CreateFileMappingA(arquivo, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapa) {
+            dados = static_cast<const unsigned char*>(MapViewOfFile(mapa, FILE_MAP_READ, 0, 0, 0));
+            tamanho = dados ? (size_t)tamanhoArquivo.QuadPart : 0;
+            CloseHandle(mapa);
+        }
+    }
+    CloseHandle(arquivo);
+#else
+    int fd = open(caminho.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* mapa = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa != MAP_FAILED) {
+            dados = static_cast<const unsigned char*>(mapa);
+            tamanho = (size_t)info.st_size;
+        }
+    }
+    close(fd);
+#endif
+    return dados != nullptr;
+}
+
+/**
+ * @brief Desfaz o mapeamento.
+ */
+void MappedFile::fechar() {
+    if (dados) {
+#ifdef _WIN32
+        UnmapViewOfFile(dados);
+#else
+        munmap(const_cast<unsigned char*>(dados), tamanho);
+#endif
+    }
+    dados = nullptr;
+    tamanho = 0;
+}
@@ -0,0 +1,535 @@
+/**
+ * @file MatchHistory.cpp
+ * @brief MatchHistoryimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "MatchHistory.hpp"
+#include "FileLock.hpp"   // Para acrescentar e cortar os blocos sem atrapalhar os outros jogos
+#include "MappedFile.hpp" // Para ler o arquivo do histórico de uma vez
+#include <algorithm>      // Para std::nth_element, std::min e std::sort
+#include <cmath>          // Para std::ceil (posto dos percentis)
+#include <cstdio>         // Para acrescentar os blocos com FILE*
+#include <cstring>        // Para memcpy e memcmp
+#include <filesystem>     // Para criar a pasta e cortar um bloco incompleto
+#include <iostream>       // Para mensagens de aviso
+#include <queue>          // Para std::priority_queue (melhores partidas)
+#include <unordered_map>  // Para a posição de cada apelido no bloco
+
+/// @brief Identificador no início de cada bloco.
+static const char BLOCO_MAGICO[4] = {'T', 'D', 'H', '2'};
+/// @brief Identificador dos blocos da primeira versão, com o Id do PlayerManager no lugar do apelido (ignorados).
+static const char BLOCO_MAGICO_ANTIGO[4] = {'T', 'D', 'H', 'B'};
+/// @brief Tamanho do cabeçalho de cada bloco: magico, linhas, tamanho do conteúdo e checksum.
+static const size_t TAMANHO_CABECALHO = 16;
+/// @brief Segundos em um dia, para o histograma diário.
+static const uint32_t SEGUNDOS_DIA = 24 * 60 * 60;
+
+/**
+ * @brief Checksum FNV-1a de 32 bits do conteúdo de um bloco.
+ */
+static uint32_t checksum(const unsigned char* dados, size_t tamanho) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < tamanho; ++i) {
+        hash ^= dados[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Acrescenta um inteiro sem sinal em varint (7 bits por byte, o bit alto indica continuação).
+ */
+static void escreverVarint(std::vector<unsigned char>& saida, uint64_t valor) {
+    while (valor >= 0x80) {
+        saida.push_back((unsigned char)(valor | 0x80));
+        valor >>= 7;
+    }
+    saida.push_back((unsigned char)valor);
+}
+
+/**
+ * @brief Acrescenta um inteiro com sinal em varint, com zigzag (valores pequenos negativos ficam curtos).
+ */
+static void escreverVarintSinal(std::vector<unsigned char>& saida, int64_t valor) {
+    escreverVarint(saida, ((uint64_t)valor << 1) ^ (uint64_t)(valor >> 63));
+}
+
+/**
+ * @brief Lê um varint, conferindo o fim do bloco.
+ * @return false se o varint passa do fim ou tem mais de 10 bytes.
+ */
+static bool lerVarint(const unsigned char*& p, const unsigned char* fim, uint64_t& valor) {
+    valor = 0;
+    for (int deslocamento = 0; deslocamento < 64; deslocamento += 7) {
+        if (p >= fim) return false;
+        unsigned char byte = *p++;
+        valor |= (uint64_t)(byte & 0x7F) << deslocamento;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Lê um varint com zigzag.
+ * @return false se o varint é inválido.
+ */
+static bool lerVarintSinal(const unsigned char*& p, const unsigned char* fim, int64_t& valor) {
+    uint64_t bruto;
+    if (!lerVarint(p, fim, bruto)) return false;
+    valor = (int64_t)(bruto >> 1) ^ -(int64_t)(bruto & 1);
+    return true;
+}
+
+/**
+ * @brief Construtor da classe MatchHistory.
+ * @param caminho Caminho do arquivo do histórico.
+ */
+MatchHistory::MatchHistory(const std::string& caminho) : caminho(caminho), gravadas(0) {}
+
+/**
+ * @brief Retorna o código de um apelido, criando um novo se preciso.
+ */
+int32_t MatchHistory::cadastrarApelido(const std::string& apelido) {
+    auto it = codigos.find(apelido);
+    if (it != codigos.end()) return it->second;
+    int32_t codigo = (int32_t)apelidos.size();
+    apelidos.push_back(apelido);
+    codigos.emplace(apelido, codigo);
+    return codigo;
+}
+
+/**
+ * @brief Procura o código de um apelido.
+ */
+int32_t MatchHistory::getCodigo(const std::string& apelido) const {
+    auto it = codigos.find(apelido);
+    return it == codigos.end() ? NENHUM : it->second;
+}
+
+/**
+ * @brief Registra uma partida nas colunas.
+ */
+void MatchHistory::registrar(const Partida& partida) {
+    if (partida.jogador < 0 || (size_t)partida.jogador >= apelidos.size()) {
+        std::cerr << "Erro: partida com jogador fora do historico (" << partida.jogador << ") ignorada.\n";
+        return;
+    }
+    jogadores.push_back(partida.jogador);
+    pontuacoes.push_back(partida.pontuacao);
+    niveis.push_back((uint8_t)std::min(std::max(partida.nivel, 0), 255));
+    duracoes.push_back(partida.duracaoMs);
+    batidas.push_back((uint16_t)std::min(std::max(partida.batidas, 0), 65535));
+    instantes.push_back(partida.instante);
+}
+
+/**
+ * @brief Monta uma partida a partir das colunas.
+ */
+MatchHistory::Partida MatchHistory::getPartida(size_t i) const {
+    Partida p;
+    p.jogador = jogadores[i];
+    p.pontuacao = pontuacoes[i];
+    p.nivel = niveis[i];
+    p.duracaoMs = duracoes[i];
+    p.batidas = batidas[i];
+    p.instante = instantes[i];
+    return p;
+}
+
+/**
+ * @brief Lê os blocos do arquivo.
+ * @return false se o arquivo não existe.
+ */
+bool MatchHistory::carregar() {
+    jogadores.clear();
+    pontuacoes.clear();
+    niveis.clear();
+    duracoes.clear();
+    batidas.clear();
+    instantes.clear();
+    apelidos.clear();
+    codigos.clear();
+    gravadas = 0;
+
+    std::error_code erro;
+    if (!std::filesystem::exists(caminho, erro)) return false;
+
+    // Com a trava, nenhum outro jogo está no meio de um bloco: o que estiver estragado no fim é mesmo de uma queda
+    FileLock trava;
+    bool travado = trava.abrir(caminho + ".lock") && trava.travar(FileLock::EXCLUSIVA);
+    if (!travado) {
+        std::cerr << "AVISO: Nao foi possivel travar o historico " << caminho << "; o fim do arquivo nao sera corrigido.\n";
+    }
+
+    MappedFile arquivo;
+    size_t valido = 0;
+    size_t tamanho = 0;
+    size_t antigas = 0;
+    if (arquivo.abrir(caminho)) {
+        const unsigned char* base = arquivo.getDados();
+        tamanho = arquivo.getTamanho();
+        while (tamanho - valido >= TAMANHO_CABECALHO) {
+            const unsigned char* bloco = base + valido;
+            uint32_t linhas, bytes, soma;
+            memcpy(&linhas, bloco + 4, 4);
+            memcpy(&bytes, bloco + 8, 4);
+            memcpy(&soma, bloco + 12, 4);
+            bool antigo = memcmp(bloco, BLOCO_MAGICO_ANTIGO, 4) == 0;
+            if ((!antigo && memcmp(bloco, BLOCO_MAGICO, 4) != 0) || bytes > tamanho - valido - TAMANHO_CABECALHO) break;
+            const unsigned char* conteudo = bloco + TAMANHO_CABECALHO;
+            if (checksum(conteudo, bytes) != soma) break;
+            if (antigo) {
+                antigas += linhas; // Não dá para saber de quem são: o Id mudava de um jogo para outro
+            } else if (!decodificarBloco(conteudo, bytes, linhas)) {
+                break;
+            }
+            valido += TAMANHO_CABECALHO + bytes;
+        }
+    }
+    arquivo.fechar(); // Antes de cortar o arquivo (no Windows, um arquivo mapeado não pode mudar de tamanho)
+    gravadas = pontuacoes.size();
+
+    if (antigas > 0) {
+        std::cerr << "AVISO: " << antigas << " partida(s) do historico " << caminho
+                  << " sao da versao sem apelidos e foram ignoradas.\n";
+    }
+    if (valido < tamanho && travado) {
+        // Sem cortar, o próximo bloco seria gravado depois do pedaço estragado e nunca seria lido
+        std::cerr << "AVISO: Historico " << caminho << " tinha " << (tamanho - valido)
+                  << " byte(s) invalido(s) no fim; descartados.\n";
+        std::filesystem::resize_file(caminho, valido, erro);
+    }
+    return true;
+}
+
+/**
+ * @brief Decodifica as colunas de um bloco.
+ * @return false se o bloco está malformado.
+ */
+bool MatchHistory::decodificarBloco(const unsigned char* dados, size_t tamanho, uint32_t linhas) {
+    // Cada partida ocupa pelo menos 1 byte por coluna: limita a reserva em blocos estragados
+    if (linhas > tamanho) return false;
+
+    const unsigned char* p = dados;
+    const unsigned char* fim = dados + tamanho;
+    size_t inicio = pontuacoes.size();
+    size_t apelidosAntes = apelidos.size();
+    size_t total = inicio + linhas;
+    bool ok = true;
+    int64_t anterior = 0;
+    int64_t valor = 0;
+    uint64_t semSinal = 0;
+
+    // Apelidos do bloco: cada um vira o código deste histórico
+    std::vector<int32_t> codigoDoBloco;
+    ok = lerVarint(p, fim, semSinal) && semSinal <= linhas;
+    uint64_t quantidadeApelidos = ok ? semSinal : 0;
+    for (uint64_t i = 0; ok && i < quantidadeApelidos; ++i) {
+        ok = lerVarint(p, fim, semSinal) && semSinal <= (uint64_t)(fim - p);
+        if (ok) {
+            codigoDoBloco.push_back(cadastrarApelido(std::string((const char*)p, (size_t)semSinal)));
+            p += semSinal;
+        }
+    }
+
+    jogadores.reserve(total);
+    for (uint32_t i = 0; ok && i < linhas; ++i) {
+        ok = lerVarintSinal(p, fim, valor) && (valor += anterior) >= 0 && valor < (int64_t)codigoDoBloco.size();
+        anterior = valor;
+        if (ok) jogadores.push_back(codigoDoBloco[(size_t)valor]);
+    }
+    pontuacoes.reserve(total);
+    for (uint32_t i = 0; ok && i < linhas; ++i) {
+        ok = lerVarintSinal(p, fim, valor) && valor >= INT32_MIN && valor <= INT32_MAX;
+        if (ok) pontuacoes.push_back((int32_t)valor);
+    }
+    niveis.reserve(total);
+    for (uint32_t i = 0; ok && i < linhas; ++i) {
+        ok = lerVarint(p, fim, semSinal) && semSinal <= 255;
+        if (ok) niveis.push_back((uint8_t)semSinal);
+    }
+    duracoes.reserve(total);
+    for (uint32_t i = 0; ok && i < linhas; ++i) {
+        ok = lerVarint(p, fim, semSinal) && semSinal <= UINT32_MAX;
+        if (ok) duracoes.push_back((uint32_t)semSinal);
+    }
+    batidas.reserve(total);
+    for (uint32_t i = 0; ok && i < linhas; ++i) {
+        ok = lerVarint(p, fim, semSinal) && semSinal <= 65535;
+        if (ok) batidas.push_back((uint16_t)semSinal);
+    }
+    anterior = 0;
+    instantes.reserve(total);
+    for (uint32_t i = 0; ok && i < linhas; ++i) {
+        ok = lerVarintSinal(p, fim, valor) && (valor += anterior) >= 0 && valor <= UINT32_MAX;
+        anterior = valor;
+        if (ok) instantes.push_back((uint32_t)valor);
+    }
+
+    if (!ok || p != fim) {
+        // Desfaz o bloco pela metade: todas as colunas voltam ao mesmo tamanho
+        jogadores.resize(inicio);
+        pontuacoes.resize(inicio);
+        niveis.resize(inicio);
+        duracoes.resize(inicio);
+        batidas.resize(inicio);
+        instantes.resize(inicio);
+        for (size_t i = apelidosAntes; i < apelidos.size(); ++i) codigos.erase(apelidos[i]);
+        apelidos.resize(apelidosAntes);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Codifica as partidas pendentes como um bloco.
+ */
+void MatchHistory::codificarPendentes(std::vector<unsigned char>& bloco) const {
+    size_t total = pontuacoes.size();
+    uint32_t linhas = (uint32_t)(total - gravadas);
+
+    // O cabeçalho é preenchido depois do conteúdo, que dá o tamanho e o checksum
+    bloco.assign(TAMANHO_CABECALHO, 0);
+    bloco.reserve(TAMANHO_CABECALHO + (size_t)linhas * 8);
+
+    // Os apelidos das partidas, na ordem em que aparecem; a coluna do jogador guarda a posição nesta lista
+    std::unordered_map<int32_t, int64_t> posicaoNoBloco;
+    std::vector<int32_t> usados;
+    for (size_t i = gravadas; i < total; ++i) {
+        if (posicaoNoBloco.emplace(jogadores[i], (int64_t)usados.size()).second) usados.push_back(jogadores[i]);
+    }
+    escreverVarint(bloco, usados.size());
+    for (int32_t codigo : usados) {
+        escreverVarint(bloco, apelidos[(size_t)codigo].size());
+        bloco.insert(bloco.end(), apelidos[(size_t)codigo].begin(), apelidos[(size_t)codigo].end());
+    }
+
+    // Uma coluna depois da outra: valores parecidos ficam juntos
+    int64_t anterior = 0;
+    for (size_t i = gravadas; i < total; ++i) {
+        int64_t posicao = posicaoNoBloco[jogadores[i]];
+        escreverVarintSinal(bloco, posicao - anterior);
+        anterior = posicao;
+    }
+    for (size_t i = gravadas; i < total; ++i) escreverVarintSinal(bloco, pontuacoes[i]);
+    for (size_t i = gravadas; i < total; ++i) escreverVarint(bloco, niveis[i]);
+    for (size_t i = gravadas; i < total; ++i) escreverVarint(bloco, duracoes[i]);
+    for (size_t i = gravadas; i < total; ++i) escreverVarint(bloco, batidas[i]);
+    anterior = 0;
+    for (size_t i = gravadas; i < total; ++i) {
+        escreverVarintSinal(bloco, (int64_t)instantes[i] - anterior);
+        anterior = instantes[i];
+    }
+
+    uint32_t bytes = (uint32_t)(bloco.size() - TAMANHO_CABECALHO);
+    uint32_t soma = checksum(bloco.data() + TAMANHO_CABECALHO, bytes);
+    memcpy(bloco.data(), BLOCO_MAGICO, 4);
+    memcpy(bloco.data() + 4, &linhas, 4);
+    memcpy(bloco.data() + 8, &bytes, 4);
+    memcpy(bloco.data() + 12, &soma, 4);
+}
+
+/**
+ * @brief Monta o bloco das partidas pendentes para outra thread gravar.
+ * @return false se não havia partidas pendentes.
+ */
+bool MatchHistory::montarBloco(std::vector<unsigned char>& bloco) {
+    if (gravadas == pontuacoes.size()) return false;
+    codificarPendentes(bloco);
+    gravadas = pontuacoes.size();
+    return true;
+}
+
+/**
+ * @brief Grava as partidas pendentes como um bloco no fim do arquivo.
+ * @return true se o bloco foi gravado (ou se não havia nada pendente).
+ */
+bool MatchHistory::salvar() {
+    if (gravadas == pontuacoes.size()) return true;
+    std::vector<unsigned char> bloco;
+    codificarPendentes(bloco);
+
+    // Garante que o diretório onde o histórico será salvo exista
+    std::error_code erro;
+    std::filesystem::create_directories(std::filesystem::path(caminho).parent_path(), erro);
+
+    // Outros jogos acrescentam ao mesmo arquivo: com a trava, um bloco nunca fica no meio de outro
+    FileLock trava;
+    if (!trava.abrir(caminho + ".lock") || !trava.travar(FileLock::EXCLUSIVA)) {
+        std::cerr << "Erro: não foi possível travar o histórico " << caminho << "\n";
+        return false;
+    }
+    FILE* arq = fopen(caminho.c_str(), "ab");
+    if (!arq) {
+        std::cerr << "Erro: não foi possível gravar o histórico em " << caminho << "\n";
+        return false;
+    }
+    bool ok = fwrite(bloco.data(), 1, bloco.size(), arq) == bloco.size();
+    ok = fclose(arq) == 0 && ok;
+    if (!ok) {
+        std::cerr << "Erro: falha ao gravar o histórico em " << caminho << "\n";
+        return false;
+    }
+    gravadas = pontuacoes.size();
+    return true;
+}
+
+/**
+ * @brief Conta as partidas de um jogador.
+ */
+size_t MatchHistory::contar(int32_t jogador) const {
+    if (jogador == TODOS) return jogadores.size();
+    const int32_t* j = jogadores.data();
+    size_t n = jogadores.size();
+    size_t quantidade = 0;
+    for (size_t i = 0; i < n; ++i) quantidade += (j[i] == jogador); // Sem desvio: vetorizável
+    return quantidade;
+}
+
+/**
+ * @brief Calcula a pontuação média.
+ */
+double MatchHistory::media(int32_t jogador) const {
+    const int32_t* j = jogadores.data();
+    const int32_t* p = pontuacoes.data();
+    size_t n = pontuacoes.size();
+    int64_t soma = 0;
+    size_t quantidade = 0;
+    if (jogador == TODOS) {
+        for (size_t i = 0; i < n; ++i) soma += p[i];
+        quantidade = n;
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            int32_t mascara = -(int32_t)(j[i] == jogador); // Todos os bits ligados quando é o jogador
+            soma += p[i] & mascara;
+            quantidade += (j[i] == jogador);
+        }
+    }
+    return quantidade ? (double)soma / quantidade : 0.0;
+}
+
+/**
+ * @brief Copia as pontuações de um jogador (ou todas).
+ */
+std::vector<int32_t> MatchHistory::filtrarPontuacoes(int32_t jogador) const {
+    if (jogador == TODOS) return pontuacoes;
+
+    // Primeiro conta, depois copia sem desvio: escreve sempre e só avança quando é o
+    // jogador (a posição extra no fim recebe a última escrita descartada)
+    std::vector<int32_t> saida(contar(jogador) + 1);
+    const int32_t* j = jogadores.data();
+    const int32_t* p = pontuacoes.data();
+    int32_t* destino = saida.data();
+    size_t n = pontuacoes.size();
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        destino[k] = p[i];
+        k += (j[i] == jogador);
+    }
+    saida.pop_back();
+    return saida;
+}
+
+/**
+ * @brief Calcula percentis pelo posto mais próximo.
+ * Com poucos valores distintos (o normal em pontuações), conta cada valor em uma
+ * passada; senão, seleciona cada posto com nth_element, do menor para o maior, cada
+ * um só na parte que sobrou depois do anterior.
+ */
+std::vector<int> MatchHistory::calcularPercentis(int32_t jogador, const std::vector<double>& percentis) const {
+    // Com TODOS, a própria coluna serve enquanto nada precisa ser reordenado
+    std::vector<int32_t> valores;
+    if (jogador != TODOS) valores = filtrarPontuacoes(jogador);
+    const std::vector<int32_t>& origem = jogador == TODOS ? pontuacoes : valores;
+    std::vector<int> saida(percentis.size(), 0);
+    if (origem.empty()) return {};
+
+    // Posição (a partir de 0) de cada percentil na ordem crescente
+    size_t n = origem.size();
+    std::vector<size_t> posicoes(percentis.size());
+    std::vector<size_t> ordem(percentis.size());
+    for (size_t k = 0; k < percentis.size(); ++k) {
+        double limitado = std::min(std::max(percentis[k], 0.0), 100.0);
+        size_t posto = (size_t)std::ceil(limitado / 100.0 * n);
+        posicoes[k] = posto == 0 ? 0 : std::min(posto, n) - 1;
+        ordem[k] = k;
+    }
+    std::sort(ordem.begin(), ordem.end(), [&posicoes](size_t a, size_t b) { return posicoes[a] < posicoes[b]; });
+
+    int32_t menor = origem[0];
+    int32_t maior = origem[0];
+    for (int32_t v : origem) {
+        menor = std::min(menor, v);
+        maior = std::max(maior, v);
+    }
+
+    uint64_t faixa = (uint64_t)((int64_t)maior - menor) + 1;
+    if (faixa <= n) {
+        std::vector<uint32_t> contagem((size_t)faixa, 0);
+        for (int32_t v : origem) ++contagem[(uint32_t)(v - menor)];
+        size_t acumulado = 0; // Valores menores que o atual
+        size_t valor = 0;
+        for (size_t k : ordem) {
+            while (acumulado + contagem[valor] <= posicoes[k]) acumulado += contagem[valor++];
+            saida[k] = (int)(menor + (int64_t)valor);
+        }
+    } else {
+        if (jogador == TODOS) valores = pontuacoes;
+        size_t inicio = 0;
+        for (size_t k : ordem) {
+            std::nth_element(valores.begin() + inicio, valores.begin() + posicoes[k], valores.end());
+            saida[k] = valores[posicoes[k]];
+            inicio = posicoes[k];
+        }
+    }
+    return saida;
+}
+
+/**
+ * @brief Conta as partidas por dia em um intervalo.
+ */
+std::vector<int> MatchHistory::histogramaDiario(int32_t jogador, uint32_t inicio, int dias) const {
+    std::vector<int> contagem(dias > 0 ? dias : 0, 0);
+    const int32_t* j = jogadores.data();
+    const uint32_t* t = instantes.data();
+    size_t n = instantes.size();
+    uint32_t totalDias = (uint32_t)contagem.size();
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t dia = (t[i] - inicio) / SEGUNDOS_DIA; // Antes do início, a subtração dá a volta e fica fora
+        if (dia < totalDias && (jogador == TODOS || j[i] == jogador)) ++contagem[dia];
+    }
+    return contagem;
+}
+
+/**
+ * @brief Encontra as melhores partidas com um heap do tamanho pedido.
+ */
+std::vector<size_t> MatchHistory::melhores(int32_t jogador, size_t quantidade) const {
+    // Compara "a é melhor que b": mais pontos, ou os mesmos pontos mais cedo
+    auto melhor = [this](size_t a, size_t b) {
+        return pontuacoes[a] != pontuacoes[b] ? pontuacoes[a] > pontuacoes[b] : a < b;
+    };
+    // No topo do heap fica a pior das escolhidas, a primeira a sair
+    std::priority_queue<size_t, std::vector<size_t>, decltype(melhor)> escolhidas(melhor);
+    if (quantidade == 0) return {};
+
+    for (size_t i = 0; i < pontuacoes.size(); ++i) {
+        if (jogador != TODOS && jogadores[i] != jogador) continue;
+        if (escolhidas.size() < quantidade) {
+            escolhidas.push(i);
+        } else if (melhor(i, escolhidas.top())) {
+            escolhidas.pop();
+            escolhidas.push(i);
+        }
+    }
+
+    std::vector<size_t> saida;
+    saida.reserve(escolhidas.size());
+    while (!escolhidas.empty()) {
+        saida.push_back(escolhidas.top());
+        escolhidas.pop();
+    }
+    std::reverse(saida.begin(), saida.end()); // Saíram da pior para a melhor
+    return saida;
+}
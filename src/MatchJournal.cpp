@@ -0,0 +1,535 @@
+/**
+ * @file MatchJournal.cpp
+ * @brief MatchJournalimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "MatchJournal.hpp"
+#include <cinttypes>  // Para PRIx32/SCNx32 (hash no fim das linhas)
+#include <cctype>     // Para isxdigit (campos escapados)
+#include <cstdlib>    // Para strtoull e strtol (campos numéricos)
+#include <cstring>    // Para memcpy e memcmp (Estado na trava)
+#include <filesystem> // Para mover, medir e truncar o arquivo do diário
+#include <iostream>   // Para mensagens de aviso
+
+#ifdef _WIN32
+#include <io.h>       // Para _commit e _fileno
+#else
+#include <unistd.h>   // Para fsync e fileno
+#endif
+
+/**
+ * @brief Hash FNV-1a de 32 bits de um trecho de texto (detecta linhas cortadas).
+ * @param texto O texto.
+ * @return O hash.
+ */
+static uint32_t hashLinha(const std::string& texto) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : texto) {
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Escapa um campo de texto para a linha: espaço, '%' e quebras de linha viram
+ * "%XX", então um apelido como "Ana Maria" continua sendo um campo só.
+ * @param texto O apelido ou o nome.
+ * @return O campo escapado (igual ao texto quando não há o que escapar).
+ */
+static std::string escaparCampo(const std::string& texto) {
+    std::string campo;
+    for (unsigned char c : texto) {
+        if (c == ' ' || c == '%' || c == '\n' || c == '\r' || c == '\t') {
+            char codigo[4];
+            snprintf(codigo, sizeof(codigo), "%%%02X", c);
+            campo += codigo;
+        } else {
+            campo += (char)c;
+        }
+    }
+    return campo;
+}
+
+/**
+ * @brief Desfaz `escaparCampo`.
+ * @param campo O campo lido da linha.
+ * @param texto Recebe o texto.
+ * @return false se o campo tem um "%" sem dois dígitos hexadecimais depois.
+ */
+static bool desescaparCampo(const std::string& campo, std::string& texto) {
+    texto.clear();
+    for (size_t i = 0; i < campo.size(); ++i) {
+        if (campo[i] != '%') {
+            texto += campo[i];
+            continue;
+        }
+        unsigned int codigo = 0;
+        if (i + 2 >= campo.size() || !isxdigit((unsigned char)campo[i + 1]) || !isxdigit((unsigned char)campo[i + 2]) ||
+            sscanf(campo.c_str() + i + 1, "%2x", &codigo) != 1) {
+            return false;
+        }
+        texto += (char)codigo;
+        i += 2;
+    }
+    return true;
+}
+
+/**
+ * @brief Separa o hash do fim da linha e confere se ele bate com o resto.
+ * @param linha A linha (sem a quebra de linha).
+ * @param corpo Recebe a linha sem o hash.
+ * @return false se a linha não termina com o hash certo (linha cortada ou estragada).
+ */
+static bool conferirHash(const std::string& linha, std::string& corpo) {
+    size_t espaco = linha.rfind(' ');
+    if (espaco == std::string::npos || linha.size() - espaco != 9) return false;
+
+    corpo = linha.substr(0, espaco);
+    uint32_t hash = 0;
+    return sscanf(linha.c_str() + espaco + 1, "%8" SCNx32, &hash) == 1 && hash == hashLinha(corpo);
+}
+
+/// @brief Identificador no início do arquivo da trava.
+static const char TRAVA_MAGICO[4] = {'T', 'D', 'J', 'L'};
+/// @brief Versão do Estado gravado na trava.
+static const uint32_t TRAVA_VERSAO = 1;
+/// @brief Tamanho do Estado na trava: assinatura, versão, seq e tamanho do diário.
+static const size_t TRAVA_BYTES = 24;
+
+/**
+ * @brief Construtor da classe MatchJournal.
+ */
+MatchJournal::MatchJournal(const std::string& caminho, Sincronia sincronia, int esperaGrupoMs)
+    : caminho(caminho), sincronia(sincronia), esperaGrupoMs(esperaGrupoMs), aberto(false), ultimoSeqConhecido(0),
+      semSincronia(false), bytesFila(0), encerrando(false), escritas(0), sincronizacoes(0), anotados(0),
+      ultimaLatenciaMs(0.0), maiorLatenciaMs(0.0), mutex(al_create_mutex()), mutexArquivo(al_create_mutex()),
+      haRegistros(al_create_cond()), filaLivre(al_create_cond()), escritor(nullptr)
+{
+    if (!mutex || !mutexArquivo || !haRegistros || !filaLivre) {
+        std::cerr << "AVISO: Nao foi possivel criar a sincronizacao do diario de partidas.\n";
+    }
+}
+
+/**
+ * @brief Destrutor da classe MatchJournal. Grava o que faltar, sincroniza e solta a trava.
+ */
+MatchJournal::~MatchJournal() {
+    if (escritor) {
+        al_lock_mutex(mutex);
+        encerrando = true;
+        al_signal_cond(haRegistros);
+        al_unlock_mutex(mutex);
+        al_join_thread(escritor, nullptr);
+        al_destroy_thread(escritor);
+    }
+    if (aberto) descarregar(true);
+    trava.fechar();
+    if (filaLivre) al_destroy_cond(filaLivre);
+    if (haRegistros) al_destroy_cond(haRegistros);
+    if (mutexArquivo) al_destroy_mutex(mutexArquivo);
+    if (mutex) al_destroy_mutex(mutex);
+}
+
+/**
+ * @brief Lê o Estado da trava.
+ * @return false se não há um Estado válido.
+ */
+bool MatchJournal::lerEstado(Estado& estado) const {
+    unsigned char bytes[TRAVA_BYTES];
+    if (!trava.ler(bytes, sizeof(bytes))) return false;
+    uint32_t versao = 0;
+    memcpy(&versao, bytes + 4, 4);
+    if (memcmp(bytes, TRAVA_MAGICO, 4) != 0 || versao != TRAVA_VERSAO) return false;
+    memcpy(&estado.seq, bytes + 8, 8);
+    memcpy(&estado.tamanho, bytes + 16, 8);
+    return true;
+}
+
+/**
+ * @brief Grava o Estado na trava.
+ */
+void MatchJournal::gravarEstado(const Estado& estado, bool sincronizar) {
+    unsigned char bytes[TRAVA_BYTES];
+    memcpy(bytes, TRAVA_MAGICO, 4);
+    memcpy(bytes + 4, &TRAVA_VERSAO, 4);
+    memcpy(bytes + 8, &estado.seq, 8);
+    memcpy(bytes + 16, &estado.tamanho, 8);
+    if (!trava.gravar(bytes, sizeof(bytes), sincronizar)) {
+        std::cerr << "Erro: não foi possível atualizar a trava do diário " << caminho << ".lock\n";
+    }
+}
+
+/**
+ * @brief Acerta o Estado com o tamanho real do diário.
+ * Maior que o Estado: outro jogo caiu no meio de uma escrita (ou o sistema caiu antes de
+ * gravar o Estado); as linhas inteiras ficam e uma incompleta é cortada. Menor: o diário
+ * foi trocado por fora, e é conferido desde o começo.
+ */
+void MatchJournal::conferirFim(Estado& estado) {
+    std::error_code erro;
+    uint64_t tamanho = std::filesystem::file_size(caminho, erro);
+    if (erro) tamanho = 0; // Ainda não existe (ou acabou de ser movido)
+    if (tamanho == estado.tamanho) return;
+
+    uint64_t inicio = tamanho > estado.tamanho ? estado.tamanho : 0;
+    std::vector<Registro> novos;
+    uint64_t bytesValidos = inicio;
+    ler(caminho, novos, &bytesValidos, inicio);
+    for (const Registro& r : novos) {
+        if (r.seq > estado.seq) estado.seq = r.seq;
+    }
+    if (tamanho > bytesValidos) {
+        // Sem cortar, o próximo registro seria colado no pedaço de linha cortada
+        std::cerr << "AVISO: Diario " << caminho << " tinha " << (tamanho - bytesValidos)
+                  << " byte(s) incompleto(s) no fim; descartados.\n";
+        std::filesystem::resize_file(caminho, bytesValidos, erro);
+    }
+    estado.tamanho = bytesValidos;
+}
+
+/**
+ * @brief Abre a trava do diário, acerta o Estado combinado com os outros jogos e confere o fim do diário.
+ * @return true se o diário pode receber registros.
+ */
+bool MatchJournal::abrir(uint64_t ultimoSeq) {
+    if (aberto || !mutex || !mutexArquivo || !haRegistros || !filaLivre) return aberto;
+
+    // Garante que o diretório onde o diário e a trava serão criados exista
+    std::error_code erro;
+    std::filesystem::create_directories(std::filesystem::path(caminho).parent_path(), erro);
+    if (!trava.abrir(caminho + ".lock") || !trava.travar(FileLock::EXCLUSIVA)) {
+        trava.fechar();
+        return false;
+    }
+
+    Estado estado;
+    if (!lerEstado(estado)) {
+        // Trava nova: o diário é conferido desde o começo
+        estado = Estado();
+    }
+    if (ultimoSeq > estado.seq) estado.seq = ultimoSeq;
+    conferirFim(estado);
+
+    FILE* arquivo = fopen(caminho.c_str(), "ab"); // Cria o diário, se ainda não existe
+    bool ok = arquivo != nullptr;
+    if (arquivo) fclose(arquivo);
+    if (ok) gravarEstado(estado, true);
+    trava.destravar();
+    if (!ok) {
+        std::cerr << "Erro: não foi possível abrir o diário de partidas " << caminho << "\n";
+        trava.fechar();
+        return false;
+    }
+    ultimoSeqConhecido = estado.seq;
+    aberto = true;
+
+    if (sincronia == SYNC_GRUPO) {
+        escritor = al_create_thread(&MatchJournal::executarEscritor, this);
+        if (escritor) {
+            al_start_thread(escritor);
+        } else {
+            // Sem thread: cada registro é escrito na hora, como no SYNC_SEMPRE
+            std::cerr << "AVISO: Nao foi possivel criar a thread do diario. Gravando na thread do jogo.\n";
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Acrescenta um registro, escrevendo na hora ou deixando para a thread.
+ * @return false se o diário não está aberto.
+ */
+bool MatchJournal::anotar(const Registro& registro) {
+    if (!aberto) return false;
+
+    al_lock_mutex(mutex);
+    // Fila cheia (disco lento ou diário travado por outro jogo): espera a thread levar o que está nela
+    while (escritor && bytesFila >= LIMITE_FILA && !encerrando) {
+        al_wait_cond(filaLivre, mutex);
+    }
+    if (fila.empty()) inicioFila = std::chrono::steady_clock::now();
+    fila.push_back(registro);
+    bytesFila += registro.apelido.size() + registro.nome.size() + 32; // Linha sem o número de sequência
+    ++anotados;
+    if (escritor) al_signal_cond(haRegistros);
+    al_unlock_mutex(mutex);
+
+    if (!escritor) {
+        descarregar(false); // SYNC_SEMPRE / SYNC_NUNCA (ou sem thread): escreve agora
+    }
+    return true;
+}
+
+/**
+ * @brief Grava e sincroniza os registros pendentes agora.
+ */
+void MatchJournal::sincronizar() {
+    if (aberto) descarregar(true);
+}
+
+/**
+ * @brief Escreve um grupo com a trava: confere o fim do diário, numera, acrescenta, sincroniza,
+ * move o diário (na compactação) e guarda o Estado novo para os outros jogos.
+ * @return true se tudo funcionou.
+ */
+bool MatchJournal::escreverComTrava(const std::vector<Registro>& lote, bool sincronizarAgora, const std::string* destino) {
+    if (lote.empty() && !destino && !(sincronizarAgora && semSincronia)) return true;
+    if (!trava.travar(FileLock::EXCLUSIVA)) return false;
+
+    Estado estado;
+    if (!lerEstado(estado)) {
+        // Alguém apagou a trava: recomeça do que este jogo sabe e confere o diário inteiro
+        estado = Estado();
+        estado.seq = ultimoSeqConhecido;
+    }
+    conferirFim(estado);
+
+    std::string linhas;
+    for (const Registro& r : lote) {
+        Registro numerado = r;
+        numerado.seq = ++estado.seq;
+        linhas += formatar(numerado);
+    }
+
+    bool ok = true;
+    bool moverEstado = false;
+    if (!linhas.empty() || semSincronia || destino) {
+        FILE* arquivo = fopen(caminho.c_str(), "ab"); // Na compactação, cria o diário se nenhum jogo escreveu desde a última
+        if (arquivo) {
+            ok = fwrite(linhas.data(), 1, linhas.size(), arquivo) == linhas.size();
+            if (!linhas.empty()) ++escritas;
+            if (sincronia != SYNC_NUNCA || sincronizarAgora || destino) {
+                if (sincronizarArquivo(arquivo)) ++sincronizacoes;
+                semSincronia = false;
+            } else {
+                semSincronia = true;
+            }
+            ok = fclose(arquivo) == 0 && ok;
+        } else {
+            ok = linhas.empty() && !destino; // Só faltava o fsync: sem o arquivo, não há o que sincronizar
+        }
+        if (!ok) {
+            std::cerr << "Erro: falha ao escrever no diário de partidas " << caminho << "\n";
+            estado.seq -= lote.size(); // Nada foi anotado: os números voltam a ficar livres
+        } else {
+            estado.tamanho += linhas.size();
+        }
+    }
+
+    if (ok && destino) {
+        std::error_code erro;
+        std::filesystem::rename(caminho, *destino, erro);
+        if (erro) {
+            std::cerr << "Erro: não foi possível mover o diário " << caminho << " para " << *destino
+                      << ": " << erro.message() << "\n";
+            ok = false;
+        } else {
+            estado.tamanho = 0; // O próximo grupo (deste ou de outro jogo) cria um diário novo
+            moverEstado = true;
+        }
+    }
+    gravarEstado(estado, moverEstado); // A troca de diário precisa estar no disco antes da compactação
+    if (estado.seq > ultimoSeqConhecido) ultimoSeqConhecido = estado.seq;
+    trava.destravar();
+    return ok;
+}
+
+/**
+ * @brief Escreve a fila de uma vez e sincroniza conforme a política.
+ */
+void MatchJournal::descarregar(bool forcarSync) {
+    al_lock_mutex(mutexArquivo);
+    al_lock_mutex(mutex);
+    std::vector<Registro> lote;
+    lote.swap(fila);
+    bytesFila = 0;
+    std::chrono::steady_clock::time_point inicio = inicioFila;
+    al_broadcast_cond(filaLivre);
+    al_unlock_mutex(mutex);
+
+    escreverComTrava(lote, forcarSync, nullptr);
+    if (!lote.empty()) {
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+        al_lock_mutex(mutex);
+        ultimaLatenciaMs = ms;
+        if (ms > maiorLatenciaMs) maiorLatenciaMs = ms;
+        al_unlock_mutex(mutex);
+    }
+    al_unlock_mutex(mutexArquivo);
+}
+
+/**
+ * @brief Laço da thread de gravação: espera o primeiro registro, espera um pouco
+ * para o grupo crescer e escreve todos com um único fsync.
+ */
+void* MatchJournal::executarEscritor(ALLEGRO_THREAD* thread, void* arg) {
+    MatchJournal* self = static_cast<MatchJournal*>(arg);
+
+    al_lock_mutex(self->mutex);
+    while (true) {
+        while (self->fila.empty() && !self->encerrando) {
+            al_wait_cond(self->haRegistros, self->mutex);
+        }
+        if (self->fila.empty()) break; // Encerrando e sem nada pendente
+        bool juntar = !self->encerrando && self->esperaGrupoMs > 0;
+        al_unlock_mutex(self->mutex);
+
+        // Os registros que chegarem durante a espera vão no mesmo fsync
+        if (juntar) al_rest(self->esperaGrupoMs / 1000.0);
+        self->descarregar(false);
+
+        al_lock_mutex(self->mutex);
+    }
+    al_unlock_mutex(self->mutex);
+    return nullptr;
+}
+
+/**
+ * @brief Grava os pendentes no diário atual e o move para `destino`.
+ * @return true se o diário foi movido.
+ */
+bool MatchJournal::rotacionar(const std::string& destino) {
+    if (!aberto) return false;
+
+    al_lock_mutex(mutexArquivo);
+    // Os pendentes ficam no arquivo que vai ser movido
+    al_lock_mutex(mutex);
+    std::vector<Registro> lote;
+    lote.swap(fila);
+    bytesFila = 0;
+    al_broadcast_cond(filaLivre);
+    al_unlock_mutex(mutex);
+    bool ok = escreverComTrava(lote, true, &destino);
+    al_unlock_mutex(mutexArquivo);
+    return ok;
+}
+
+/**
+ * @brief Retorna a latência da última escrita.
+ */
+double MatchJournal::getUltimaLatenciaMs() const {
+    if (!mutex) return ultimaLatenciaMs;
+    al_lock_mutex(mutex);
+    double ms = ultimaLatenciaMs;
+    al_unlock_mutex(mutex);
+    return ms;
+}
+
+/**
+ * @brief Retorna a maior latência de uma escrita.
+ */
+double MatchJournal::getMaiorLatenciaMs() const {
+    if (!mutex) return maiorLatenciaMs;
+    al_lock_mutex(mutex);
+    double ms = maiorLatenciaMs;
+    al_unlock_mutex(mutex);
+    return ms;
+}
+
+/**
+ * @brief Lê os registros válidos de um diário.
+ * @return false se o arquivo não existe.
+ */
+bool MatchJournal::ler(const std::string& caminho, std::vector<Registro>& saida, uint64_t* bytesValidos,
+                       uint64_t inicio) {
+    FILE* f = fopen(caminho.c_str(), "rb");
+    if (!f) return false;
+    if (inicio > 0 && fseek(f, (long)inicio, SEEK_SET) != 0) {
+        fclose(f);
+        if (bytesValidos) *bytesValidos = inicio;
+        return true;
+    }
+
+    std::string conteudo;
+    char bloco[65536];
+    size_t lidos;
+    while ((lidos = fread(bloco, 1, sizeof(bloco), f)) > 0) {
+        conteudo.append(bloco, lidos);
+    }
+    fclose(f);
+
+    size_t posicao = 0;
+    while (posicao < conteudo.size()) {
+        size_t fim = conteudo.find('\n', posicao);
+        if (fim == std::string::npos) break; // Linha sem fim: a escrita foi interrompida
+
+        std::string linha = conteudo.substr(posicao, fim - posicao);
+        Registro r;
+        if (interpretar(linha, r)) {
+            saida.push_back(r);
+        } else {
+            std::string corpo;
+            if (!conferirHash(linha, corpo)) break; // Linha cortada ou estragada: o fim válido do diário
+            // Linha inteira (o hash confere) que esta versão não entende: só ela é pulada
+            std::cerr << "AVISO: Registro ignorado no diario " << caminho << ": " << corpo << "\n";
+        }
+        posicao = fim + 1;
+    }
+    if (bytesValidos) *bytesValidos = inicio + posicao;
+    return true;
+}
+
+/**
+ * @brief Monta a linha de um registro.
+ * @return A linha, com hash e quebra de linha.
+ */
+std::string MatchJournal::formatar(const Registro& registro) {
+    std::string linha = std::to_string(registro.seq) + " " + registro.tipo + " " + escaparCampo(registro.apelido) + " ";
+    linha += registro.tipo == 'C' ? escaparCampo(registro.nome) : std::to_string(registro.pontuacao);
+
+    char hash[16];
+    snprintf(hash, sizeof(hash), " %08" PRIx32 "\n", hashLinha(linha));
+    return linha + hash;
+}
+
+/**
+ * @brief Interpreta uma linha do diário.
+ * @return false se a linha não é um registro válido.
+ */
+bool MatchJournal::interpretar(const std::string& linha, Registro& saida) {
+    std::string corpo;
+    if (!conferirHash(linha, corpo)) return false;
+
+    // Exatamente quatro campos separados por um espaço: seq, tipo, apelido e nome/pontuação
+    std::vector<std::string> campos(1);
+    for (char c : corpo) {
+        if (c == ' ') {
+            campos.emplace_back();
+        } else {
+            campos.back() += c;
+        }
+    }
+    if (campos.size() != 4 || campos[1].size() != 1 || campos[0].empty() || campos[0].find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+
+    char* fim = nullptr;
+    saida.seq = strtoull(campos[0].c_str(), &fim, 10);
+    saida.tipo = campos[1][0];
+    if (!desescaparCampo(campos[2], saida.apelido)) return false;
+    if (saida.tipo == 'C') {
+        return desescaparCampo(campos[3], saida.nome);
+    }
+    if (saida.tipo == 'P') {
+        long pontuacao = strtol(campos[3].c_str(), &fim, 10);
+        if (campos[3].empty() || *fim != '\0') return false;
+        saida.pontuacao = (int)pontuacao;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Força os dados de um arquivo para o disco.
+ * @return true se funcionou.
+ */
+bool MatchJournal::sincronizarArquivo(FILE* arquivo) {
+    if (fflush(arquivo) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(arquivo)) == 0;
+#else
+    return fsync(fileno(arquivo)) == 0;
+#endif
+}
@@ -0,0 +1,202 @@
+/**
+ * @file MemoryTracker.cpp
+ * @brief MemoryTrackerimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "MemoryTracker.hpp"
+#include <algorithm>  // Para std::max e std::sort
+#include <filesystem> // Para criar a pasta do relatório
+#include <fstream>    // Para gravar o relatório
+#include <iostream>   // Para o aviso de orçamento
+#include <vector>     // Para ordenar os assets no relatório
+
+/// @brief Converte bytes para kilobytes no relatório.
+static double kb(size_t bytes) { return bytes / 1024.0; }
+
+/**
+ * @brief Construtor da classe MemoryTracker.
+ * @param orcamentoBytes Total acima do qual um aviso é emitido (0 = sem orçamento).
+ */
+MemoryTracker::MemoryTracker(size_t orcamentoBytes)
+    : orcamento(orcamentoBytes), excedido(false) {}
+
+/**
+ * @brief Soma ou subtrai bytes de um uso, guardando o pico.
+ */
+void MemoryTracker::ajustar(Uso& uso, size_t bytes, bool somar) {
+    if (somar) {
+        uso.atual += bytes;
+        uso.pico = std::max(uso.pico, uso.atual);
+    } else {
+        uso.atual -= std::min(uso.atual, bytes);
+    }
+}
+
+/**
+ * @brief Registra um asset com tamanho conhecido.
+ */
+void MemoryTracker::registrar(const void* asset, Categoria categoria, int nivel, size_t bytes, const std::string& nome) {
+    if (!asset) return; // O carregamento falhou: não há nada para contar
+    remover(asset);     // O Allegro pode reaproveitar o endereço de um asset esquecido
+
+    registros[asset] = {categoria, nivel, bytes, nome};
+    ajustar(total, bytes, true);
+    ajustar(categorias[categoria], bytes, true);
+    ajustar(niveis[nivel], bytes, true);
+    verificarOrcamento();
+}
+
+/**
+ * @brief Registra um bitmap.
+ */
+void MemoryTracker::registrarBitmap(ALLEGRO_BITMAP* bitmap, int nivel, const std::string& nome) {
+    registrar(bitmap, IMAGEM, nivel, bytesBitmap(bitmap), nome);
+}
+
+/**
+ * @brief Registra um efeito sonoro.
+ */
+void MemoryTracker::registrarSample(ALLEGRO_SAMPLE* sample, int nivel, const std::string& nome) {
+    registrar(sample, SOM, nivel, bytesSample(sample), nome);
+}
+
+/**
+ * @brief Registra uma música.
+ */
+void MemoryTracker::registrarStream(ALLEGRO_AUDIO_STREAM* stream, int nivel, const std::string& nome) {
+    registrar(stream, MUSICA, nivel, bytesStream(stream), nome);
+}
+
+/**
+ * @brief Remove um asset antes de ele ser destruído.
+ */
+void MemoryTracker::remover(const void* asset) {
+    auto it = registros.find(asset);
+    if (it == registros.end()) return;
+
+    const Registro& r = it->second;
+    ajustar(total, r.bytes, false);
+    ajustar(categorias[r.categoria], r.bytes, false);
+    ajustar(niveis[r.nivel], r.bytes, false);
+    registros.erase(it);
+
+    if (excedido && (orcamento == 0 || total.atual <= orcamento)) {
+        excedido = false; // Voltou para dentro do orçamento: a próxima ultrapassagem avisa de novo
+    }
+}
+
+/**
+ * @brief Retorna o uso de um nível.
+ */
+MemoryTracker::Uso MemoryTracker::getNivel(int nivel) const {
+    auto it = niveis.find(nivel);
+    return it != niveis.end() ? it->second : Uso();
+}
+
+/**
+ * @brief Define o orçamento de memória.
+ */
+void MemoryTracker::setOrcamento(size_t orcamentoBytes) {
+    orcamento = orcamentoBytes;
+    excedido = false;
+    verificarOrcamento();
+}
+
+/**
+ * @brief Emite o aviso na primeira vez que o total passa do orçamento.
+ */
+void MemoryTracker::verificarOrcamento() {
+    if (orcamento == 0 || excedido || total.atual <= orcamento) return;
+
+    excedido = true;
+    std::cerr << "AVISO: Assets ocupam " << total.atual / (1024 * 1024) << " MB, acima do orcamento de "
+              << orcamento / (1024 * 1024) << " MB (imagens " << categorias[IMAGEM].atual / (1024 * 1024)
+              << " MB, sons " << categorias[SOM].atual / (1024 * 1024) << " MB, musicas "
+              << categorias[MUSICA].atual / (1024 * 1024) << " MB).\n";
+}
+
+/**
+ * @brief Grava o relatório de memória.
+ * @return true se o arquivo foi gravado.
+ */
+bool MemoryTracker::salvarRelatorio(const std::string& caminho) const {
+    std::error_code erro;
+    std::filesystem::create_directories(std::filesystem::path(caminho).parent_path(), erro);
+
+    std::ofstream arq(caminho);
+    if (!arq.is_open()) {
+        std::cerr << "Erro: não foi possível gravar o relatório de memória em " << caminho << "\n";
+        return false;
+    }
+
+    arq.setf(std::ios::fixed);
+    arq.precision(1);
+    arq << "# Memoria dos assets (KB)\n";
+    arq << "total " << kb(total.atual) << " pico " << kb(total.pico) << " orcamento " << kb(orcamento)
+        << (excedido ? " EXCEDIDO" : "") << "\n";
+    for (int c = 0; c < NUM_CATEGORIAS; ++c) {
+        arq << "categoria " << nomeCategoria((Categoria)c) << " " << kb(categorias[c].atual)
+            << " pico " << kb(categorias[c].pico) << "\n";
+    }
+    for (const auto& par : niveis) {
+        if (par.first == GLOBAL) {
+            arq << "nivel global ";
+        } else {
+            arq << "nivel " << par.first << " ";
+        }
+        arq << kb(par.second.atual) << " pico " << kb(par.second.pico) << "\n";
+    }
+
+    // Assets carregados agora, do maior para o menor
+    std::vector<const Registro*> ordenados;
+    for (const auto& par : registros) ordenados.push_back(&par.second);
+    std::sort(ordenados.begin(), ordenados.end(), [](const Registro* a, const Registro* b) {
+        return a->bytes > b->bytes;
+    });
+    arq << "# " << ordenados.size() << " asset(s) carregado(s)\n";
+    for (const Registro* r : ordenados) {
+        arq << "asset " << nomeCategoria(r->categoria) << " " << r->nivel << " " << kb(r->bytes) << " " << r->nome << "\n";
+    }
+    return true;
+}
+
+/**
+ * @brief Calcula a memória de um bitmap a partir do formato dos pixels.
+ */
+size_t MemoryTracker::bytesBitmap(ALLEGRO_BITMAP* bitmap) {
+    if (!bitmap || al_is_sub_bitmap(bitmap)) return 0; // O sub-bitmap usa os pixels do pai
+    return (size_t)al_get_bitmap_width(bitmap) * al_get_bitmap_height(bitmap)
+         * al_get_pixel_size(al_get_bitmap_format(bitmap));
+}
+
+/**
+ * @brief Calcula a memória das amostras de um som.
+ */
+size_t MemoryTracker::bytesSample(ALLEGRO_SAMPLE* sample) {
+    if (!sample) return 0;
+    return (size_t)al_get_sample_length(sample) * al_get_channel_count(al_get_sample_channels(sample))
+         * al_get_audio_depth_size(al_get_sample_depth(sample));
+}
+
+/**
+ * @brief Calcula a memória dos buffers de uma música.
+ */
+size_t MemoryTracker::bytesStream(ALLEGRO_AUDIO_STREAM* stream) {
+    if (!stream) return 0;
+    return (size_t)al_get_audio_stream_fragments(stream) * al_get_audio_stream_length(stream)
+         * al_get_channel_count(al_get_audio_stream_channels(stream))
+         * al_get_audio_depth_size(al_get_audio_stream_depth(stream));
+}
+
+/**
+ * @brief Retorna o nome de uma categoria.
+ */
+const char* MemoryTracker::nomeCategoria(Categoria categoria) {
+    switch (categoria) {
+        case IMAGEM: return "imagem";
+        case SOM:    return "som";
+        case MUSICA: return "musica";
+        default:     return "?";
+    }
+}
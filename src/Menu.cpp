@@ -24,7 +24,7 @@ const double Menu::WARNING_DURATION = 3.0;
 Menu::Menu(ALLEGRO_FONT* fontNormal, ALLEGRO_FONT* fontGrande, ALLEGRO_BITMAP* bg)
     : font(fontNormal), fontlarge(fontGrande), background(bg), apelido(""), selectedAction(0),
       inputActive(false), cursorVisible(true), cursorTimer(0.0), scroll(0.0f),
-      currentWarningMessage(""), warningDisplayTimer(0.0), somHover(nullptr)
+      currentWarningMessage(""), warningDisplayTimer(0.0), sugestaoMarcada(0), somHover(nullptr)
 {
     // Obtém as dimensões atuais da tela para cálculo de escala e posicionamento
     SCREEN_W = static_cast<float>(al_get_display_width(al_get_current_display()));
@@ -149,6 +149,25 @@ void Menu::render() {
         }
     }
 
+    // Sugestões de apelido abaixo do campo (escondidas enquanto um aviso ocupa o mesmo lugar)
+    areasSugestoes.clear();
+    if (inputActive && !sugestoes.empty() && currentWarningMessage.empty()) {
+        float linhaH = al_get_font_line_height(font) + PADDING_Y;
+        float listaY = boxY + boxH + 6 * scale_y;
+        float listaW = MAX_INPUT_WIDTH;
+        float listaX = SCREEN_W / 2.0f - listaW / 2.0f;
+        al_draw_filled_rounded_rectangle(listaX, listaY, listaX + listaW, listaY + linhaH * sugestoes.size(),
+                                         6 * scale_x, 6 * scale_y, al_map_rgba(0, 0, 0, 170));
+        for (size_t i = 0; i < sugestoes.size(); ++i) {
+            float y1 = listaY + linhaH * i;
+            if ((int)i == sugestaoMarcada) {
+                al_draw_filled_rectangle(listaX, y1, listaX + listaW, y1 + linhaH, al_map_rgba(255, 255, 255, 60));
+            }
+            al_draw_text(font, al_map_rgb(220, 220, 220), listaX + PADDING_X, y1 + PADDING_Y / 2, 0, sugestoes[i].c_str());
+            areasSugestoes.push_back({listaX, y1, listaX + listaW, y1 + linhaH});
+        }
+    }
+
     ALLEGRO_MOUSE_STATE mouse;
     al_get_mouse_state(&mouse); // Obtém o estado atual do mouse
 
@@ -224,16 +243,8 @@ void Menu::drawButtonText(float x, float y, const std::string& text, bool hover)
         al_draw_filled_rounded_rectangle(rectLeft, rectTop, rectRight, rectBottom, 10 * scale_x, 10 * scale_y, bgColor);
     }
 
-    // Desenha o contorno/sombra do texto (múltiplas cópias deslocadas)
-    for (int dx = -3; dx <= 3; ++dx) {
-        for (int dy = -3; dy <= 3; ++dy) {
-            if (dx == 0 && dy == 0) continue; // Pula o centro
-            al_draw_text(buttonFont, outline, x + dx, y + dy, ALLEGRO_ALIGN_CENTER, text.c_str());
-        }
-    }
-
-    // Desenha o texto principal do botão
-    al_draw_text(buttonFont, textColor, x, y, ALLEGRO_ALIGN_CENTER, text.c_str());
+    // Desenha o texto do botão com contorno (rasterizado uma vez por rótulo e estado de hover)
+    textCache.draw(buttonFont, textColor, outline, 3, x, y, ALLEGRO_ALIGN_CENTER, text);
 }
 
 /**
@@ -261,6 +272,15 @@ void Menu::onClick(int mx, int my) {
     float halfW = buttonWidth / 2.0f;
     float halfH = buttonHeight / 2.0f;
 
+    // Um clique em uma sugestão (desenhada por cima dos botões) completa o apelido
+    for (size_t i = 0; inputActive && i < areasSugestoes.size() && i < sugestoes.size(); ++i) {
+        const std::array<float, 4>& a = areasSugestoes[i];
+        if (mx >= a[0] && mx <= a[2] && my >= a[1] && my <= a[3]) {
+            apelido = sugestoes[i];
+            return;
+        }
+    }
+
     // Verifica se algum botão foi clicado
     for (int i = 0; i < 4; ++i) {
         float bx = buttonPositions[i][0];
@@ -319,7 +339,16 @@ void Menu::onChar(int unichar, int keycode) {
     currentWarningMessage = ""; // Limpa qualquer aviso ao digitar
     warningDisplayTimer = 0.0; // Reseta o temporizador de aviso
 
-    if (keycode == ALLEGRO_KEY_BACKSPACE) {
+    if (keycode == ALLEGRO_KEY_TAB) {
+        // Completa com a sugestão marcada
+        if (!sugestoes.empty()) apelido = sugestoes[sugestaoMarcada];
+    } else if (keycode == ALLEGRO_KEY_DOWN || keycode == ALLEGRO_KEY_UP) {
+        // Muda a sugestão marcada, dando a volta na lista
+        if (!sugestoes.empty()) {
+            int n = (int)sugestoes.size();
+            sugestaoMarcada = (sugestaoMarcada + (keycode == ALLEGRO_KEY_DOWN ? 1 : n - 1)) % n;
+        }
+    } else if (keycode == ALLEGRO_KEY_BACKSPACE) {
         if (!apelido.empty()) {
             apelido.pop_back(); // Remove o último caractere
         }
@@ -415,4 +444,14 @@ void Menu::trimApelido() {
  */
 void Menu::setHoverSound(ALLEGRO_SAMPLE* som) {
     somHover = som;
+}
+
+/**
+ * @brief Troca as sugestões de apelido. A marcada volta para a primeira se a lista mudou.
+ * @param apelidos Os apelidos sugeridos.
+ */
+void Menu::setSugestoes(const std::vector<std::string>& apelidos) {
+    if (apelidos == sugestoes) return; // Mesma lista: mantém a sugestão marcada (setas)
+    sugestoes = apelidos;
+    sugestaoMarcada = 0;
 }
\ No newline at end of file
@@ -0,0 +1,218 @@
+/**
+ * @file NicknameIndex.cpp
+ * @brief NicknameIndeximplementação do projeto Traveling Dragon.
+ */
+
+
+#include "NicknameIndex.hpp"
+#include <algorithm> // Para std::sort, std::merge e o heap das sugestões
+
+/**
+ * @brief Construtor da classe NicknameIndex.
+ */
+NicknameIndex::NicknameIndex() : folhas(1) {
+    limpar();
+}
+
+/**
+ * @brief Remove todos os apelidos e a consulta guardada.
+ */
+void NicknameIndex::limpar() {
+    ordem.clear();
+    posicaoDe.clear();
+    pontos.clear();
+    recentes.clear();
+    montarArvore();
+    prefixoAnterior.clear();
+    faixas.clear();
+}
+
+/**
+ * @brief Compara duas posições pela pontuação; no empate, a menor posição (apelido menor) ganha.
+ */
+bool NicknameIndex::melhor(uint32_t a, uint32_t b) const {
+    if (a == NENHUMA) return false;
+    if (b == NENHUMA) return true;
+    int pa = pontos[ordem[a]];
+    int pb = pontos[ordem[b]];
+    return pa != pb ? pa > pb : a < b;
+}
+
+/**
+ * @brief Refaz a árvore: as folhas são as posições da tabela e cada nó guarda a melhor dos dois filhos.
+ */
+void NicknameIndex::montarArvore() {
+    folhas = 1;
+    while (folhas < ordem.size()) folhas <<= 1;
+    arvore.assign(folhas * 2, NENHUMA);
+    for (size_t i = 0; i < ordem.size(); ++i) arvore[folhas + i] = (uint32_t)i;
+    for (size_t k = folhas - 1; k >= 1; --k) {
+        arvore[k] = melhor(arvore[2 * k], arvore[2 * k + 1]) ? arvore[2 * k] : arvore[2 * k + 1];
+    }
+}
+
+/**
+ * @brief Monta a tabela ordenada com todos os jogadores.
+ */
+void NicknameIndex::reconstruir(const std::vector<Player>& jogadores) {
+    size_t n = jogadores.size();
+    ordem.resize(n);
+    pontos.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        ordem[i] = (uint32_t)i;
+        pontos[i] = jogadores[i].getMaiorPontuacao();
+    }
+    std::sort(ordem.begin(), ordem.end(), [&](uint32_t a, uint32_t b) {
+        int c = jogadores[a].getApelido().compare(jogadores[b].getApelido());
+        return c != 0 ? c < 0 : a < b;
+    });
+    posicaoDe.assign(n, NENHUMA);
+    for (size_t i = 0; i < n; ++i) posicaoDe[ordem[i]] = (uint32_t)i;
+    recentes.clear();
+    montarArvore();
+    prefixoAnterior.clear(); // As posições mudaram
+    faixas.clear();
+}
+
+/**
+ * @brief Acrescenta um jogador novo à lista de recentes (intercalada na tabela quando enche).
+ */
+void NicknameIndex::inserir(uint32_t id, const std::vector<Player>& jogadores) {
+    if (id >= jogadores.size()) return;
+    if (pontos.size() <= id) {
+        pontos.resize(id + 1, 0);
+        posicaoDe.resize(id + 1, NENHUMA);
+    }
+    pontos[id] = jogadores[id].getMaiorPontuacao();
+    recentes.push_back(id);
+    if (recentes.size() > LIMITE_RECENTES) intercalarRecentes(jogadores);
+}
+
+/**
+ * @brief Intercala os recentes, já ordenados, com a tabela.
+ */
+void NicknameIndex::intercalarRecentes(const std::vector<Player>& jogadores) {
+    auto antes = [&](uint32_t a, uint32_t b) {
+        int c = jogadores[a].getApelido().compare(jogadores[b].getApelido());
+        return c != 0 ? c < 0 : a < b;
+    };
+    std::sort(recentes.begin(), recentes.end(), antes);
+    std::vector<uint32_t> juntos(ordem.size() + recentes.size());
+    std::merge(ordem.begin(), ordem.end(), recentes.begin(), recentes.end(), juntos.begin(), antes);
+    ordem.swap(juntos);
+    for (size_t i = 0; i < ordem.size(); ++i) posicaoDe[ordem[i]] = (uint32_t)i;
+    recentes.clear();
+    montarArvore();
+    prefixoAnterior.clear(); // As posições mudaram
+    faixas.clear();
+}
+
+/**
+ * @brief Muda a pontuação de um jogador e corrige o caminho dele até a raiz da árvore.
+ */
+void NicknameIndex::atualizar(uint32_t id, int pontuacao) {
+    if (id >= pontos.size()) return;
+    pontos[id] = pontuacao;
+    uint32_t posicao = posicaoDe[id];
+    if (posicao == NENHUMA) return; // Nos recentes: a pontuação é lida na hora da consulta
+    for (size_t k = (folhas + posicao) / 2; k >= 1; k /= 2) {
+        arvore[k] = melhor(arvore[2 * k], arvore[2 * k + 1]) ? arvore[2 * k] : arvore[2 * k + 1];
+    }
+}
+
+/**
+ * @brief Encontra a melhor posição de um trecho subindo pela árvore pelos dois lados.
+ */
+uint32_t NicknameIndex::maisAlto(uint32_t inicio, uint32_t fim) const {
+    uint32_t resultado = NENHUMA;
+    for (size_t l = inicio + folhas, r = fim + folhas; l < r; l /= 2, r /= 2) {
+        if (l & 1) {
+            if (melhor(arvore[l], resultado)) resultado = arvore[l];
+            ++l;
+        }
+        if (r & 1) {
+            --r;
+            if (melhor(arvore[r], resultado)) resultado = arvore[r];
+        }
+    }
+    return resultado;
+}
+
+/**
+ * @brief Estreita a faixa do prefixo letra a letra e tira as melhores posições dela com um heap de trechos.
+ */
+std::vector<uint32_t> NicknameIndex::sugerir(const std::string& prefixo, size_t quantos, const std::vector<Player>& jogadores) {
+    std::vector<uint32_t> sugestoes;
+    if (quantos == 0) return sugestoes;
+
+    // Reaproveita as faixas do maior começo comum com o prefixo anterior
+    if (faixas.empty()) faixas.push_back(std::make_pair(0u, (uint32_t)ordem.size()));
+    size_t comum = 0;
+    while (comum < prefixo.size() && comum + 1 < faixas.size() && prefixo[comum] == prefixoAnterior[comum]) ++comum;
+    faixas.resize(comum + 1);
+    for (size_t tamanho = comum; tamanho < prefixo.size(); ++tamanho) {
+        // Na faixa atual todos têm os mesmos `tamanho` primeiros caracteres: basta olhar o seguinte
+        // (quem termina antes vem primeiro, como na ordem das strings)
+        int letra = (unsigned char)prefixo[tamanho];
+        auto chave = [&](uint32_t posicao) {
+            const std::string& apelido = jogadores[ordem[posicao]].getApelido();
+            return apelido.size() > tamanho ? (int)(unsigned char)apelido[tamanho] : -1;
+        };
+        uint32_t inicio = faixas.back().first, fim = faixas.back().second;
+        uint32_t baixo = inicio, alto = fim;
+        while (baixo < alto) { // Primeira posição com chave >= letra
+            uint32_t meio = baixo + (alto - baixo) / 2;
+            if (chave(meio) < letra) baixo = meio + 1; else alto = meio;
+        }
+        uint32_t novoInicio = baixo;
+        alto = fim;
+        while (baixo < alto) { // Primeira posição com chave > letra
+            uint32_t meio = baixo + (alto - baixo) / 2;
+            if (chave(meio) <= letra) baixo = meio + 1; else alto = meio;
+        }
+        faixas.push_back(std::make_pair(novoInicio, baixo));
+    }
+    prefixoAnterior = prefixo;
+
+    // As melhores da faixa: tira a melhor de um trecho e devolve ao heap os dois pedaços ao lado dela
+    struct Trecho {
+        uint32_t melhor;
+        uint32_t inicio;
+        uint32_t fim;
+    };
+    auto pior = [this](const Trecho& a, const Trecho& b) { return melhor(b.melhor, a.melhor); };
+    std::vector<Trecho> heap;
+    uint32_t primeiro = maisAlto(faixas.back().first, faixas.back().second);
+    if (primeiro != NENHUMA) heap.push_back(Trecho{primeiro, faixas.back().first, faixas.back().second});
+    while (!heap.empty() && sugestoes.size() < quantos) {
+        std::pop_heap(heap.begin(), heap.end(), pior);
+        Trecho t = heap.back();
+        heap.pop_back();
+        sugestoes.push_back(ordem[t.melhor]);
+        uint32_t esquerda = maisAlto(t.inicio, t.melhor);
+        if (esquerda != NENHUMA) {
+            heap.push_back(Trecho{esquerda, t.inicio, t.melhor});
+            std::push_heap(heap.begin(), heap.end(), pior);
+        }
+        uint32_t direita = maisAlto(t.melhor + 1, t.fim);
+        if (direita != NENHUMA) {
+            heap.push_back(Trecho{direita, t.melhor + 1, t.fim});
+            std::push_heap(heap.begin(), heap.end(), pior);
+        }
+    }
+
+    // Os recentes ainda não estão na tabela: confere um por um e junta às sugestões
+    size_t daTabela = sugestoes.size();
+    for (uint32_t id : recentes) {
+        if (jogadores[id].getApelido().compare(0, prefixo.size(), prefixo) == 0) sugestoes.push_back(id);
+    }
+    if (sugestoes.size() > daTabela) {
+        std::sort(sugestoes.begin(), sugestoes.end(), [&](uint32_t a, uint32_t b) {
+            if (pontos[a] != pontos[b]) return pontos[a] > pontos[b];
+            int c = jogadores[a].getApelido().compare(jogadores[b].getApelido());
+            return c != 0 ? c < 0 : a < b;
+        });
+        if (sugestoes.size() > quantos) sugestoes.resize(quantos);
+    }
+    return sugestoes;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file OutlinedTextCache.cpp
+ * @brief OutlinedTextCacheimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "OutlinedTextCache.hpp"
+#include "RenderStats.hpp" // Contagem de desenhos para o HUD de depuração
+#include <cstdio> // Para snprintf (montagem da chave)
+#include <iostream> // Para saída de avisos
+
+/**
+ * @brief Construtor da classe OutlinedTextCache.
+ * @param capacidade Número máximo de textos mantidos no cache.
+ */
+OutlinedTextCache::OutlinedTextCache(int capacidade)
+    : capacidade(capacidade > 0 ? capacidade : 1), relogio(0), rasterizacoes(0)
+{
+}
+
+/**
+ * @brief Destrutor da classe OutlinedTextCache.
+ * Libera os bitmaps de todos os textos rasterizados.
+ */
+OutlinedTextCache::~OutlinedTextCache() {
+    limpar();
+}
+
+/**
+ * @brief Descarta todos os textos rasterizados e libera seus bitmaps.
+ */
+void OutlinedTextCache::limpar() {
+    for (auto& par : entradas) {
+        if (par.second.bitmap) al_destroy_bitmap(par.second.bitmap);
+    }
+    entradas.clear();
+}
+
+/**
+ * @brief Monta a chave de cache de um texto.
+ * A fonte entra pelo endereço, e as cores pelos seus componentes em 8 bits.
+ * @return A chave única do texto.
+ */
+std::string OutlinedTextCache::montarChave(ALLEGRO_FONT* font, ALLEGRO_COLOR corTexto, ALLEGRO_COLOR corContorno,
+                                           int raio, const std::string& texto) {
+    unsigned char tr, tg, tb, ta, cr, cg, cb, ca;
+    al_unmap_rgba(corTexto, &tr, &tg, &tb, &ta);
+    al_unmap_rgba(corContorno, &cr, &cg, &cb, &ca);
+
+    char prefixo[96];
+    snprintf(prefixo, sizeof(prefixo), "%p|%02x%02x%02x%02x|%02x%02x%02x%02x|%d|",
+             static_cast<void*>(font), tr, tg, tb, ta, cr, cg, cb, ca, raio);
+    return std::string(prefixo) + texto;
+}
+
+/**
+ * @brief Rasteriza o texto com contorno em um bitmap transparente.
+ *
+ * Faz exatamente os mesmos desenhos que eram feitos a cada frame (todas as cópias
+ * deslocadas do contorno e o preenchimento por cima), mas uma única vez.
+ *
+ * @return A entrada com o bitmap resultante.
+ */
+OutlinedTextCache::Entrada OutlinedTextCache::rasterizar(ALLEGRO_FONT* font, ALLEGRO_COLOR corTexto, ALLEGRO_COLOR corContorno,
+                                                         int raio, const std::string& texto) {
+    Entrada e = {nullptr, 0, 0};
+    e.larguraTexto = al_get_text_width(font, texto.c_str());
+
+    int largura = e.larguraTexto + 2 * raio;
+    int altura = al_get_font_line_height(font) + 2 * raio;
+    if (largura <= 0 || altura <= 0) return e;
+
+    e.bitmap = al_create_bitmap(largura, altura);
+    if (!e.bitmap) {
+        std::cerr << "AVISO: Nao foi possivel criar o bitmap do texto \"" << texto << "\".\n";
+        return e;
+    }
+
+    // Trocar de alvo com o desenho segurado é indefinido: envia o lote pendente antes
+    bool estavaSegurando = al_is_bitmap_drawing_held();
+    if (estavaSegurando) RenderStats::segurarDesenho(false);
+
+    // Guarda o alvo e o blender atuais para restaurá-los depois da rasterização
+    ALLEGRO_STATE estado;
+    al_store_state(&estado, ALLEGRO_STATE_TARGET_BITMAP | ALLEGRO_STATE_BLENDER);
+
+    al_set_target_bitmap(e.bitmap);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0)); // Fundo totalmente transparente
+
+    // Desenha o contorno (cópias deslocadas) e depois o preenchimento por cima
+    for (int dx = -raio; dx <= raio; ++dx) {
+        for (int dy = -raio; dy <= raio; ++dy) {
+            if (dx == 0 && dy == 0) continue; // Pula o centro
+            al_draw_text(font, corContorno, raio + dx, raio + dy, ALLEGRO_ALIGN_LEFT, texto.c_str());
+        }
+    }
+    al_draw_text(font, corTexto, raio, raio, ALLEGRO_ALIGN_LEFT, texto.c_str());
+
+    al_restore_state(&estado);
+    if (estavaSegurando) RenderStats::segurarDesenho(true);
+    ++rasterizacoes;
+    return e;
+}
+
+/**
+ * @brief Remove do cache a entrada usada há mais tempo.
+ */
+void OutlinedTextCache::descartarMenosUsada() {
+    auto maisAntiga = entradas.end();
+    for (auto it = entradas.begin(); it != entradas.end(); ++it) {
+        if (maisAntiga == entradas.end() || it->second.ultimoUso < maisAntiga->second.ultimoUso) {
+            maisAntiga = it;
+        }
+    }
+    if (maisAntiga != entradas.end()) {
+        if (maisAntiga->second.bitmap) al_destroy_bitmap(maisAntiga->second.bitmap);
+        entradas.erase(maisAntiga);
+    }
+}
+
+/**
+ * @brief Retorna o bitmap de um texto com contorno e a posição onde desenhá-lo.
+ * Se o texto ainda não foi rasterizado, faz a rasterização antes.
+ */
+ALLEGRO_BITMAP* OutlinedTextCache::obter(ALLEGRO_FONT* font, ALLEGRO_COLOR corTexto, ALLEGRO_COLOR corContorno, int raio,
+                                         float x, float y, int flags, const std::string& texto,
+                                         float& destinoX, float& destinoY) {
+    if (!font || texto.empty()) return nullptr;
+
+    std::string chave = montarChave(font, corTexto, corContorno, raio, texto);
+    auto it = entradas.find(chave);
+    if (it == entradas.end()) {
+        // Abre espaço antes de inserir, descartando o texto menos usado
+        if ((int)entradas.size() >= capacidade) {
+            descartarMenosUsada();
+        }
+        it = entradas.emplace(chave, rasterizar(font, corTexto, corContorno, raio, texto)).first;
+    }
+
+    Entrada& e = it->second;
+    e.ultimoUso = ++relogio;
+    if (!e.bitmap) return nullptr;
+
+    // Converte a posição de acordo com o alinhamento, como al_draw_text faria
+    float drawX = x;
+    if (flags & ALLEGRO_ALIGN_CENTER) {
+        drawX = x - e.larguraTexto / 2.0f;
+    } else if (flags & ALLEGRO_ALIGN_RIGHT) {
+        drawX = x - e.larguraTexto;
+    }
+
+    destinoX = drawX - raio;
+    destinoY = y - raio;
+    return e.bitmap;
+}
+
+/**
+ * @brief Desenha um texto com contorno usando o bitmap do cache.
+ * Se o texto ainda não foi rasterizado, faz a rasterização antes de desenhar.
+ */
+void OutlinedTextCache::draw(ALLEGRO_FONT* font, ALLEGRO_COLOR corTexto, ALLEGRO_COLOR corContorno, int raio,
+                             float x, float y, int flags, const std::string& texto) {
+    if (!font || texto.empty()) return;
+
+    float destinoX = 0.0f, destinoY = 0.0f;
+    ALLEGRO_BITMAP* bitmap = obter(font, corTexto, corContorno, raio, x, y, flags, texto, destinoX, destinoY);
+    if (!bitmap) {
+        // Fallback: sem bitmap, desenha o texto da forma tradicional (sem contorno)
+        al_draw_text(font, corTexto, x, y, flags, texto.c_str());
+        RenderStats::registrarPrimitiva();
+        return;
+    }
+
+    al_draw_bitmap(bitmap, destinoX, destinoY, 0);
+    RenderStats::registrarDesenho(bitmap);
+}
@@ -9,6 +9,11 @@
 #include <iostream> // Para saída de avisos
 #include <cmath> // Para std::round
 
+/// @brief Largura do asset original do cano.
+const float Pipe::SPRITE_WIDTH = 538.0f;
+/// @brief Escala fixa do cano na tela (os assets são desenhados a 25%).
+const float Pipe::SPRITE_SCALE = 0.25f;
+
 /**
  * @brief Construtor da classe Pipe.
  *
@@ -24,7 +29,7 @@
  */
 Pipe::Pipe(float x_start, float gap_center_y, float gap_h, ALLEGRO_BITMAP* pipe_bmp, float screenHeight, float sX, float sY)
     : GameObject(x_start, 0.0f, // Posição Y inicial é 0, altura total da tela
-                     538.0f * sX, // Largura inicial baseada na imagem original e escala
+                     SPRITE_WIDTH * sX, // Largura inicial baseada na imagem original e escala
                      screenHeight), // Altura do GameObject é a altura da tela
       pipeSprite(pipe_bmp),
       gapY(gap_center_y),
@@ -33,25 +38,32 @@ Pipe::Pipe(float x_start, float gap_center_y, float gap_h, ALLEGRO_BITMAP* pipe_
       speedX(-2.0f * sX),
       scale_x(sX),
       scale_y(sY),
+      spriteScaleX(1.0f),
+      spriteScaleY(1.0f),
       scored(false) // Flag para controlar se o pássaro já marcou ponto passando por este cano
 {
     // Sobrescreve os valores recebidos para garantir uma escala padrão de design, se necessário.
     // Isso é útil se os assets foram desenhados para uma escala específica e queremos forçar essa escala.
-    sX = 0.25f;
-    sY = 0.25f;
+    sX = SPRITE_SCALE;
+    sY = SPRITE_SCALE;
 
     // Atualiza os fatores de escala internos com os valores forçados.
     scale_x = sX;
     scale_y = sY;
 
     // E também atualiza os valores dependentes da escala:
-    this->width = 538.0f * scale_x; // Recalcula a largura com a nova escala
+    this->width = SPRITE_WIDTH * scale_x; // Recalcula a largura com a nova escala
     // Recalcula a velocidade horizontal com a nova escala, para consistência de movimento
     speedX = -150.0f * scale_x;
 
     // Verifica se o sprite do cano foi carregado corretamente
     if (!pipeSprite) {
         std::cerr << "AVISO: Sprite do cano não carregado. Usando dimensões padrão." << std::endl;
+    } else {
+        // A escala do sprite é deduzida do tamanho real do bitmap: o asset original (538 de
+        // largura) fica com 0.25, e um bitmap já reduzido pelo cache fica com ~1.0.
+        int bmpW = al_get_bitmap_width(pipeSprite);
+        spriteScaleX = spriteScaleY = this->width / (float)(bmpW > 0 ? bmpW : 1);
     }
 }
 
@@ -65,24 +77,32 @@ void Pipe::update(float deltaTime) {
 }
 
 /**
- * @brief Renderiza o par de canos na tela.
- * Desenha o cano superior e o cano inferior, aplicando as transformações necessárias.
+ * @brief Grava o par de canos na lista de comandos do frame.
+ * O cano de cima é espelhado verticalmente; a lista descarta o que sai da tela.
+ * @param fila Lista de comandos do frame.
  */
-void Pipe::render() {
+void Pipe::render(RenderQueue& fila) {
     // Arredonda a posição X para um pixel inteiro para evitar artefatos de renderização
     int drawX = static_cast<int>(std::round(this->x));
 
     if (pipeSprite) {
-        int bmpW = al_get_bitmap_width(pipeSprite); // Deve ser 538 (largura original do asset)
-        int bmpH = al_get_bitmap_height(pipeSprite); // Deve ser 3310 (altura original do asset)
+        int bmpW = al_get_bitmap_width(pipeSprite); // 538 no asset original, ~135 se já veio reduzido do cache
+        int bmpH = al_get_bitmap_height(pipeSprite);
 
         // Prevenção de divisão por zero ou dimensões inválidas
         if (bmpW <= 0) bmpW = 1;
         if (bmpH <= 0) bmpH = 1;
 
         // Calcula a largura e altura do cano após aplicar a escala
-        float pipeDrawWidth = static_cast<float>(bmpW) * scale_x;
-        float pipeDrawHeight = static_cast<float>(bmpH) * scale_y;
+        float pipeDrawWidth = static_cast<float>(bmpW) * spriteScaleX;
+        float pipeDrawHeight = static_cast<float>(bmpH) * spriteScaleY;
+
+        // Se o bitmap já está no tamanho da tela (diferença de arredondamento menor que
+        // 1 pixel), desenha 1:1 para não reamostrar de novo na placa de vídeo
+        if (std::abs(pipeDrawWidth - bmpW) < 1.0f) {
+            pipeDrawWidth = static_cast<float>(bmpW);
+            pipeDrawHeight = static_cast<float>(bmpH);
+        }
 
         // --- CANO DE CIMA ---
         // Calcula a coordenada Y da parte inferior do cano de cima
@@ -90,32 +110,26 @@ void Pipe::render() {
         // Calcula a coordenada Y do topo do cano de cima (onde ele começa a ser desenhado)
         float topPipeY = topPipeBottomY - pipeDrawHeight;
 
-        // Desenha o cano de cima, escalado, na posição correta e espelhado verticalmente
-        al_draw_scaled_bitmap(
-            pipeSprite,
-            0, 0, bmpW, bmpH, // Região do bitmap de origem
-            drawX, topPipeY, // Posição de destino na tela
-            pipeDrawWidth, pipeDrawHeight, // Dimensões de destino
-            ALLEGRO_FLIP_VERTICAL // Inverte verticalmente para o cano superior
-        );
+        // Grava o cano de cima, escalado e espelhado verticalmente. Quase todo ele fica
+        // acima da tela, e só a ponta visível sai da textura.
+        fila.desenharEscalado(pipeSprite, RenderQueue::CAMADA_OBSTACULOS,
+                              0, 0, bmpW, bmpH,                         // Região do bitmap de origem
+                              drawX, topPipeY, pipeDrawWidth, pipeDrawHeight, // Destino na tela
+                              ALLEGRO_FLIP_VERTICAL);                   // Inverte verticalmente para o cano superior
 
         // --- CANO DE BAIXO ---
         // Calcula a coordenada Y da parte superior do cano de baixo
         float bottomPipeTopY = getBottomPipeTopY();
 
-        // Desenha o cano de baixo, escalado, na posição correta
-        al_draw_scaled_bitmap(
-            pipeSprite,
-            0, 0, bmpW, bmpH, // Região do bitmap de origem
-            drawX, bottomPipeTopY, // Posição de destino na tela
-            pipeDrawWidth, pipeDrawHeight, // Dimensões de destino
-            0 // Sem flags de inversão
-        );
+        // Grava o cano de baixo, escalado; a parte abaixo da tela é recortada
+        fila.desenharEscalado(pipeSprite, RenderQueue::CAMADA_OBSTACULOS,
+                              0, 0, bmpW, bmpH,
+                              drawX, bottomPipeTopY, pipeDrawWidth, pipeDrawHeight);
 
     } else {
         // Fallback: se o sprite não for carregado, desenha retângulos verdes
-        al_draw_filled_rectangle(drawX, 0, drawX + this->width, getTopPipeBottomY(), al_map_rgb(0, 255, 0));
-        al_draw_filled_rectangle(drawX, getBottomPipeTopY(), drawX + this->width, this->height, al_map_rgb(0, 255, 0));
+        fila.desenharRetangulo(RenderQueue::CAMADA_OBSTACULOS, drawX, 0, drawX + this->width, getTopPipeBottomY(), al_map_rgb(0, 255, 0));
+        fila.desenharRetangulo(RenderQueue::CAMADA_OBSTACULOS, drawX, getBottomPipeTopY(), drawX + this->width, this->height, al_map_rgb(0, 255, 0));
     }
 }
 
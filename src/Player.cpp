@@ -14,17 +14,27 @@
 Player::Player(std::string nome, std::string apelido)
     : nome(nome), apelido(apelido), partidas(0), maiorPontuacao(0) {}
 
+/**
+ * @brief Construtor que restaura um jogador salvo.
+ * @param nome O nome real do jogador.
+ * @param apelido O apelido (nickname) do jogador.
+ * @param partidas O número de partidas jogadas.
+ * @param maiorPontuacao A maior pontuação alcançada.
+ */
+Player::Player(std::string nome, std::string apelido, int partidas, int maiorPontuacao)
+    : nome(nome), apelido(apelido), partidas(partidas), maiorPontuacao(maiorPontuacao) {}
+
 /**
  * @brief Retorna o nome real do jogador.
  * @return O nome do jogador.
  */
-std::string Player::getNome() const { return nome; }
+const std::string& Player::getNome() const { return nome; }
 
 /**
  * @brief Retorna o apelido do jogador.
  * @return O apelido do jogador.
  */
-std::string Player::getApelido() const { return apelido; }
+const std::string& Player::getApelido() const { return apelido; }
 
 /**
  * @brief Retorna o número total de partidas jogadas pelo jogador.
@@ -0,0 +1,266 @@
+/**
+ * @file PlayerDatabase.cpp
+ * @brief PlayerDatabaseimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "PlayerDatabase.hpp"
+#include "MatchJournal.hpp" // Para sincronizar o arquivo temporário (fsync)
+#include <cstdio>           // Para gravar o banco com FILE*
+#include <cstring>          // Para memcpy e memcmp
+#include <filesystem>       // Para criar a pasta e renomear o arquivo temporário
+#include <iostream>         // Para mensagens de erro
+#include <unordered_map>    // Para juntar os textos repetidos na tabela
+
+/// @brief Identificador no início do banco.
+static const char BANCO_MAGICO[4] = {'T', 'D', 'P', 'L'};
+/// @brief Tamanho do cabeçalho fixo.
+static const size_t TAMANHO_CABECALHO = 32;
+/// @brief Tamanho de cada registro de jogador.
+static const size_t TAMANHO_REGISTRO = 16;
+
+/**
+ * @brief Capacidade do índice de apelidos para uma quantidade de jogadores.
+ * @return A menor potência de 2 com pelo menos o dobro de posições (0 sem jogadores).
+ */
+static uint32_t capacidadePara(uint32_t jogadores) {
+    if (jogadores == 0) return 0;
+    uint32_t capacidade = 1;
+    while (capacidade < (uint64_t)jogadores * 2) capacidade <<= 1;
+    return capacidade;
+}
+
+/**
+ * @brief Lê um inteiro do banco (o formato é little-endian, como as máquinas em que o jogo roda).
+ */
+template <typename T>
+static T lerInteiro(const unsigned char* p) {
+    T valor;
+    memcpy(&valor, p, sizeof(T));
+    return valor;
+}
+
+/**
+ * @brief Acrescenta um inteiro ao fim de um buffer.
+ */
+template <typename T>
+static void escreverInteiro(std::vector<unsigned char>& buffer, T valor) {
+    size_t fim = buffer.size();
+    buffer.resize(fim + sizeof(T));
+    memcpy(buffer.data() + fim, &valor, sizeof(T));
+}
+
+/**
+ * @brief Construtor da classe PlayerDatabase.
+ */
+PlayerDatabase::PlayerDatabase()
+    : quantidade(0), tamanhoTabela(0), seq(0), capacidadeIndice(0), registros(nullptr), indice(nullptr), tabela(nullptr) {}
+
+/**
+ * @brief Mapeia o banco e confere o cabeçalho e os tamanhos.
+ * Os registros não são percorridos aqui: os offsets são conferidos ao serem lidos.
+ * @return true se o banco é válido.
+ */
+bool PlayerDatabase::abrir(const std::string& caminho) {
+    fechar();
+    if (!arquivo.abrir(caminho)) return false;
+
+    const unsigned char* base = arquivo.getDados();
+    size_t tamanho = arquivo.getTamanho();
+    bool valido = tamanho >= TAMANHO_CABECALHO && memcmp(base, BANCO_MAGICO, 4) == 0
+               && lerInteiro<uint32_t>(base + 4) == VERSAO;
+    if (valido) {
+        uint32_t n = lerInteiro<uint32_t>(base + 8);
+        uint32_t t = lerInteiro<uint32_t>(base + 12);
+        uint32_t c = lerInteiro<uint32_t>(base + 24);
+        // O arquivo tem exatamente o cabeçalho, os registros, o índice e a tabela (64 bits: sem estouro)
+        valido = TAMANHO_CABECALHO + (uint64_t)n * TAMANHO_REGISTRO + (uint64_t)c * 4 + t == tamanho
+              && c == capacidadePara(n)
+              && (t == 0 ? n == 0 : base[tamanho - 1] == '\0'); // Todo texto termina dentro da tabela
+        if (valido) {
+            quantidade = n;
+            tamanhoTabela = t;
+            capacidadeIndice = c;
+            seq = lerInteiro<uint64_t>(base + 16);
+            registros = base + TAMANHO_CABECALHO;
+            indice = registros + (size_t)n * TAMANHO_REGISTRO;
+            tabela = reinterpret_cast<const char*>(indice + (size_t)c * 4);
+        }
+    }
+    if (!valido) fechar();
+    return valido;
+}
+
+/**
+ * @brief Desfaz o mapeamento e zera o cabeçalho lido.
+ */
+void PlayerDatabase::fechar() {
+    arquivo.fechar();
+    quantidade = 0;
+    tamanhoTabela = 0;
+    seq = 0;
+    capacidadeIndice = 0;
+    registros = nullptr;
+    indice = nullptr;
+    tabela = nullptr;
+}
+
+/**
+ * @brief Copia o índice de apelidos do mapeamento.
+ */
+void PlayerDatabase::copiarIndice(std::vector<uint32_t>& saida) const {
+    saida.resize(capacidadeIndice);
+    if (capacidadeIndice > 0) memcpy(saida.data(), indice, (size_t)capacidadeIndice * 4);
+}
+
+/**
+ * @brief Hash FNV-1a de 32 bits de um apelido.
+ */
+uint32_t PlayerDatabase::hashApelido(const std::string& apelido) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : apelido) {
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Procura um apelido no índice por sondagem linear até achar uma posição vazia.
+ * @return A posição do jogador, ou -1.
+ */
+int PlayerDatabase::buscarNoIndice(const std::vector<uint32_t>& indice, const std::string& apelido,
+                                   const std::vector<Player>& jogadores) {
+    if (indice.empty()) return -1;
+    uint32_t mascara = (uint32_t)indice.size() - 1;
+    uint32_t pos = hashApelido(apelido) & mascara;
+    for (size_t tentativas = 0; tentativas < indice.size(); ++tentativas) {
+        uint32_t valor = indice[pos];
+        if (valor == 0) return -1; // Posição vazia: o apelido não está no banco
+        // Confere o apelido (colisões de hash e bancos estragados não devolvem o jogador errado)
+        if (valor <= jogadores.size() && jogadores[valor - 1].getApelido() == apelido) return (int)(valor - 1);
+        pos = (pos + 1) & mascara;
+    }
+    return -1;
+}
+
+/**
+ * @brief Retorna um texto da tabela.
+ */
+const char* PlayerDatabase::texto(uint32_t offset) const {
+    return offset < tamanhoTabela ? tabela + offset : "";
+}
+
+/**
+ * @brief Retorna o nome de um jogador.
+ */
+const char* PlayerDatabase::getNome(uint32_t i) const {
+    return texto(lerInteiro<uint32_t>(registros + (size_t)i * TAMANHO_REGISTRO));
+}
+
+/**
+ * @brief Retorna o apelido de um jogador.
+ */
+const char* PlayerDatabase::getApelido(uint32_t i) const {
+    return texto(lerInteiro<uint32_t>(registros + (size_t)i * TAMANHO_REGISTRO + 4));
+}
+
+/**
+ * @brief Retorna as partidas de um jogador.
+ */
+int PlayerDatabase::getPartidas(uint32_t i) const {
+    return lerInteiro<int32_t>(registros + (size_t)i * TAMANHO_REGISTRO + 8);
+}
+
+/**
+ * @brief Retorna a maior pontuação de um jogador.
+ */
+int PlayerDatabase::getMaiorPontuacao(uint32_t i) const {
+    return lerInteiro<int32_t>(registros + (size_t)i * TAMANHO_REGISTRO + 12);
+}
+
+/**
+ * @brief Monta o banco na memória e o grava em um arquivo temporário renomeado por cima do atual.
+ * @return true se o banco foi gravado.
+ */
+bool PlayerDatabase::gravar(const std::string& caminho, const std::vector<Player>& jogadores, uint64_t seq) {
+    // Tabela de textos: cada texto entra uma vez só
+    std::string textos;
+    std::unordered_map<std::string, uint32_t> offsets;
+    offsets.reserve(jogadores.size());
+    auto internar = [&](const std::string& s) {
+        auto inserido = offsets.emplace(s, (uint32_t)textos.size());
+        if (inserido.second) {
+            textos += s;
+            textos += '\0';
+        }
+        return inserido.first->second;
+    };
+
+    std::vector<unsigned char> buffer;
+    buffer.reserve(TAMANHO_CABECALHO + jogadores.size() * (TAMANHO_REGISTRO + 8));
+    buffer.insert(buffer.end(), BANCO_MAGICO, BANCO_MAGICO + 4);
+    escreverInteiro<uint32_t>(buffer, VERSAO);
+    escreverInteiro<uint32_t>(buffer, (uint32_t)jogadores.size());
+    escreverInteiro<uint32_t>(buffer, 0); // Tamanho da tabela, preenchido no fim
+    escreverInteiro<uint64_t>(buffer, seq);
+    uint32_t capacidade = capacidadePara((uint32_t)jogadores.size());
+    escreverInteiro<uint32_t>(buffer, capacidade);
+    escreverInteiro<uint32_t>(buffer, 0); // Reservado
+    for (const Player& p : jogadores) {
+        escreverInteiro<uint32_t>(buffer, internar(p.getNome()));
+        escreverInteiro<uint32_t>(buffer, internar(p.getApelido()));
+        escreverInteiro<int32_t>(buffer, p.getPartidas());
+        escreverInteiro<int32_t>(buffer, p.getMaiorPontuacao());
+    }
+
+    // Índice de apelidos: apelido repetido fica só com o primeiro, como na busca
+    std::vector<uint32_t> posicoes(capacidade, 0);
+    for (uint32_t i = 0; i < (uint32_t)jogadores.size(); ++i) {
+        if (buscarNoIndice(posicoes, jogadores[i].getApelido(), jogadores) >= 0) continue;
+        uint32_t pos = hashApelido(jogadores[i].getApelido()) & (capacidade - 1);
+        while (posicoes[pos] != 0) pos = (pos + 1) & (capacidade - 1);
+        posicoes[pos] = i + 1;
+    }
+    size_t inicioIndice = buffer.size();
+    buffer.resize(inicioIndice + (size_t)capacidade * 4);
+    if (capacidade > 0) memcpy(buffer.data() + inicioIndice, posicoes.data(), (size_t)capacidade * 4);
+    uint32_t tamanhoTextos = (uint32_t)textos.size();
+    memcpy(buffer.data() + 12, &tamanhoTextos, sizeof(tamanhoTextos));
+
+    // Garante que o diretório onde o banco será salvo exista
+    std::error_code erro;
+    std::filesystem::create_directories(std::filesystem::path(caminho).parent_path(), erro);
+
+    std::string temporario = caminho + ".tmp";
+    FILE* arq = fopen(temporario.c_str(), "wb");
+    if (!arq) {
+        std::cerr << "Erro: não foi possível salvar os dados em " << caminho << "\n";
+        return false;
+    }
+    bool ok = fwrite(buffer.data(), 1, buffer.size(), arq) == buffer.size()
+           && fwrite(textos.data(), 1, textos.size(), arq) == textos.size();
+    ok = MatchJournal::sincronizarArquivo(arq) && ok;
+    ok = fclose(arq) == 0 && ok;
+
+    if (ok) std::filesystem::rename(temporario, caminho, erro);
+    if (!ok || erro) {
+        std::cerr << "Erro: não foi possível salvar os dados em " << caminho << "\n";
+        std::filesystem::remove(temporario, erro);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Confere a assinatura no início de um arquivo.
+ * @return true se é um banco binário.
+ */
+bool PlayerDatabase::reconhecer(const std::string& caminho) {
+    FILE* arq = fopen(caminho.c_str(), "rb");
+    if (!arq) return false;
+    char magico[4] = {0, 0, 0, 0};
+    size_t lidos = fread(magico, 1, 4, arq);
+    fclose(arq);
+    return lidos == 4 && memcmp(magico, BANCO_MAGICO, 4) == 0;
+}
@@ -4,77 +4,436 @@
  */
 
 #include "PlayerManager.hpp"
+#include "PlayerDatabase.hpp" // Banco binário (o snapshot)
 #include <fstream>      // Para operações de leitura e escrita de arquivos
 #include <iostream>     // Para mensagens no console (erros, avisos)
 #include <filesystem>   // Para garantir a criação da pasta de destino
+#include <sstream>      // Para ler o cabeçalho do snapshot
+#include <chrono>       // Para medir o tempo da compactação
 
 /**
  * @brief Construtor da classe PlayerManager.
  * 
  * Inicializa o gerenciador de jogadores com o caminho fornecido para o arquivo
- * de persistência de dados.
+ * de persistência de dados. O diário fica ao lado dele, com a extensão .journal, e o
+ * histograma de partidas, com a extensão .hist.
  * 
  * @param caminho O caminho completo do arquivo onde os dados serão salvos/carregados.
+ * @param sincronia Política de sincronia do diário de partidas.
  */
-PlayerManager::PlayerManager(const std::string& caminho) : caminhoArquivo(caminho) {}
+PlayerManager::PlayerManager(const std::string& caminho, MatchJournal::Sincronia sincronia)
+    : apelidosProntos(false), caminhoArquivo(caminho),
+      caminhoJournal(std::filesystem::path(caminho).replace_extension(".journal").string()),
+      caminhoHistograma(std::filesystem::path(caminho).replace_extension(".hist").string()),
+      sincronia(sincronia), journal(nullptr), registrosDesdeCompactacao(0), compactador(nullptr), compactando(false),
+      placarRemoto(nullptr) {}
+
+/**
+ * @brief Destrutor da classe PlayerManager.
+ * Espera a compactação e fecha o diário, que grava e sincroniza o que estiver pendente.
+ */
+PlayerManager::~PlayerManager() {
+    aguardarCompactacao();
+    if (!foraDoDiario.empty()) salvar(); // Diário indisponível: última tentativa de gravar o banco
+    delete journal;
+}
 
 /**
  * @brief Carrega os dados dos jogadores de um arquivo para a memória.
  * 
  * Os dados existentes na memória são limpos antes do carregamento.
- * Cada linha do arquivo deve conter: nome apelido partidas maiorPontuacao
+ * O arquivo é o banco binário (PlayerDatabase); um arquivo de texto antigo é migrado.
+ * Depois do snapshot, os registros mais novos do diário são reaplicados.
  */
 void PlayerManager::carregar() {
+    aguardarCompactacao();
+    if (!foraDoDiario.empty()) salvar(); // Não perde as mudanças que só estavam na memória
     jogadores.clear(); // Limpa os dados existentes na memória
+    indice.clear();
+    ranking.limpar();
+    recordesJogadores.limpar();
+    apelidos.limpar();
+    apelidosProntos = false; // Montado na primeira sugestão, com o cadastro já carregado
+    indiceBanco.clear();
+
+    std::error_code erro;
+    std::filesystem::create_directories(std::filesystem::path(caminhoArquivo).parent_path(), erro);
+    if (!travaSnapshot.isAberto()) travaSnapshot.abrir(caminhoArquivo + ".lock");
+
+    // Sem banco binário: migra o arquivo de texto antigo (no mesmo caminho ou com extensão .txt).
+    // Confere de novo com a trava: outro jogo pode ter migrado enquanto este esperava
+    if (!PlayerDatabase::reconhecer(caminhoArquivo)) {
+        travaSnapshot.travar(FileLock::EXCLUSIVA);
+        if (!PlayerDatabase::reconhecer(caminhoArquivo)) migrarTexto();
+        travaSnapshot.destravar();
+    }
 
-    std::ifstream arq(caminhoArquivo); // Tenta abrir o arquivo para leitura
-    if (!arq.is_open()) {
+    // Com a trava compartilhada, nenhuma compactação troca o snapshot ou o diário antigo durante a leitura
+    travaSnapshot.travar(FileLock::COMPARTILHADA);
+    uint64_t seq = 0;
+    PlayerDatabase banco;
+    if (PlayerDatabase::reconhecer(caminhoArquivo) && banco.abrir(caminhoArquivo)) {
+        // Registros prontos e índice de apelidos já montado: nada para interpretar nem refazer
+        seq = banco.getSeq();
+        jogadores.reserve(banco.getQuantidade());
+        for (uint32_t i = 0; i < banco.getQuantidade(); ++i) {
+            jogadores.emplace_back(banco.getNome(i), banco.getApelido(i), banco.getPartidas(i), banco.getMaiorPontuacao(i));
+        }
+        banco.copiarIndice(indiceBanco);
+        banco.fechar(); // Sem o mapeamento aberto, a compactação pode substituir o arquivo (no Windows também)
+    } else if (!lerSnapshot(caminhoArquivo, jogadores, indice, seq)) {
         std::cerr << "Aviso: não foi possível abrir " << caminhoArquivo << " para leitura.\n";
-        return; // Se o arquivo não existir, apenas termina (não é erro crítico)
+        // Se o arquivo não existir, segue só com o diário (não é erro crítico)
+    }
+
+    // O histograma de partidas tem o próprio número de sequência (pode estar à frente do snapshot)
+    uint64_t seqHistograma = 0;
+    pontuacoesPartidas.ler(caminhoHistograma, seqHistograma); // Sem arquivo: conta a partir do diário
+
+    // Uma compactação interrompida deixa o diário antigo para trás: ele vem antes do atual
+    // (e é dobrado no snapshot pela próxima compactação, deste ou de outro jogo)
+    std::vector<MatchJournal::Registro> registros;
+    MatchJournal::ler(caminhoJournal + ".old", registros);
+    MatchJournal::ler(caminhoJournal, registros);
+    travaSnapshot.destravar();
+
+    int reaplicados = 0;
+    uint64_t ultimoSeq = seq;
+    for (const MatchJournal::Registro& r : registros) {
+        if (r.tipo == 'P' && r.seq > seqHistograma) pontuacoesPartidas.adicionar(r.pontuacao);
+        if (r.seq > ultimoSeq) ultimoSeq = r.seq;
+        if (r.seq <= seq) continue; // Já está no snapshot
+        aplicar(jogadores, indice, indiceBanco, r);
+        ++reaplicados;
+    }
+
+    // O ranking e os recordes são montados uma vez aqui; depois, só cadastros e partidas mexem neles
+    std::vector<int> pontuacoes(jogadores.size());
+    for (size_t i = 0; i < jogadores.size(); ++i) {
+        pontuacoes[i] = jogadores[i].getMaiorPontuacao();
+        recordesJogadores.adicionar(pontuacoes[i]);
+    }
+    ranking.reconstruir(pontuacoes);
+
+    if (!journal) journal = new MatchJournal(caminhoJournal, sincronia);
+    if (!journal->abrir(ultimoSeq)) {
+        std::cerr << "AVISO: Nao foi possivel abrir o diario " << caminhoJournal << " (ou a trava dele). "
+                  << "O banco de jogadores sera gravado inteiro a cada partida.\n";
+    }
+    registrosDesdeCompactacao = reaplicados;
+    if (registrosDesdeCompactacao >= LIMITE_COMPACTACAO) compactar();
+}
+
+/**
+ * @brief Lê um snapshot: o banco binário ou, na migração, o arquivo de texto antigo.
+ * @return false se o arquivo não pôde ser aberto.
+ */
+bool PlayerManager::lerSnapshot(const std::string& caminho, std::vector<Player>& jogadores,
+                                std::unordered_map<std::string, Id>& indice, uint64_t& seq) {
+    seq = 0;
+    if (PlayerDatabase::reconhecer(caminho)) {
+        PlayerDatabase banco;
+        if (!banco.abrir(caminho)) {
+            // Guarda o arquivo estragado em vez de deixar a próxima gravação apagá-lo
+            std::error_code erro;
+            std::filesystem::rename(caminho, caminho + ".corrompido", erro);
+            std::cerr << "AVISO: Banco de jogadores " << caminho << " invalido; movido para "
+                      << caminho << ".corrompido.\n";
+            return false;
+        }
+
+        // Registros de tamanho fixo com as estatísticas prontas: nada para interpretar ou recalcular
+        seq = banco.getSeq();
+        jogadores.reserve(jogadores.size() + banco.getQuantidade());
+        indice.reserve(indice.size() + banco.getQuantidade());
+        for (uint32_t i = 0; i < banco.getQuantidade(); ++i) {
+            const char* apelido = banco.getApelido(i);
+            // Apelido repetido no arquivo: vale o primeiro, como na busca antiga (o resto continua salvo)
+            indice.emplace(apelido, (Id)jogadores.size());
+            jogadores.emplace_back(banco.getNome(i), apelido, banco.getPartidas(i), banco.getMaiorPontuacao(i));
+        }
+        return true;
+    }
+
+    std::ifstream arq(caminho); // Tenta abrir o arquivo de texto para leitura
+    if (!arq.is_open()) return false;
+
+    // Arquivos de texto sem o cabeçalho "# seq N" valem como sequência 0
+    if (arq.peek() == '#') {
+        std::string cabecalho, marcador;
+        std::getline(arq, cabecalho);
+        std::istringstream campos(cabecalho);
+        campos >> marcador >> marcador >> seq;
     }
 
     std::string nome, apelido;
     int partidas, maiorPontuacao;
 
     while (arq >> nome >> apelido >> partidas >> maiorPontuacao) {
-        Player p(nome, apelido);
-        for (int i = 0; i < partidas; ++i)
-            p.adicionarPartida(maiorPontuacao); // Simula partidas para manter contagem e recorde
-        jogadores.push_back(p);
+        indice.emplace(apelido, (Id)jogadores.size());
+        jogadores.emplace_back(nome, apelido, partidas, maiorPontuacao);
     }
 
     // O arquivo é fechado automaticamente ao sair do escopo
+    return true;
 }
 
 /**
- * @brief Salva os dados dos jogadores da memória para o arquivo.
- * 
- * O arquivo será sobrescrito. Cria a pasta automaticamente se ela não existir.
+ * @brief Converte o arquivo de texto antigo para o banco binário.
  */
-void PlayerManager::salvar() const {
-    // Garante que o diretório onde o arquivo será salvo exista
-    std::filesystem::create_directories(std::filesystem::path(caminhoArquivo).parent_path());
+void PlayerManager::migrarTexto() {
+    std::error_code erro;
+    std::string origem = caminhoArquivo;
+    if (!std::filesystem::exists(origem, erro)) {
+        origem = std::filesystem::path(caminhoArquivo).replace_extension(".txt").string();
+        if (origem == caminhoArquivo || !std::filesystem::exists(origem, erro)) return; // Primeira execução
+    }
+
+    std::vector<Player> antigos;
+    std::unordered_map<std::string, Id> indiceAntigo;
+    uint64_t seq = 0;
+    if (!lerSnapshot(origem, antigos, indiceAntigo, seq)) return;
+    if (PlayerDatabase::gravar(caminhoArquivo, antigos, seq)) {
+        // O arquivo de texto é mantido (em outro caminho) como cópia de segurança
+        std::cout << antigos.size() << " jogador(es) migrados de " << origem << " para o banco " << caminhoArquivo << ".\n";
+    }
+}
+
+/**
+ * @brief Aplica um cadastro ou uma partida do diário.
+ * O apelido é procurado primeiro no índice do banco, depois no da memória.
+ */
+void PlayerManager::aplicar(std::vector<Player>& jogadores, std::unordered_map<std::string, Id>& indice,
+                            const std::vector<uint32_t>& indiceBanco, const MatchJournal::Registro& registro) {
+    Id id = PlayerDatabase::buscarNoIndice(indiceBanco, registro.apelido, jogadores);
+    if (id < 0) {
+        auto inserido = indice.emplace(registro.apelido, (Id)jogadores.size());
+        if (inserido.second) {
+            // Partida de um jogador sem cadastro (não deveria acontecer): usa o apelido como nome
+            jogadores.emplace_back(registro.tipo == 'C' ? registro.nome : registro.apelido, registro.apelido);
+        }
+        id = inserido.first->second;
+    }
+    if (registro.tipo == 'P') {
+        jogadores[id].adicionarPartida(registro.pontuacao);
+    }
+}
+
+/**
+ * @brief Dobra um diário fechado no histograma e no snapshot e apaga o diário.
+ * @return true se o snapshot novo foi gravado.
+ */
+bool PlayerManager::dobrarJournal(const std::string& caminhoSnapshot, const std::string& caminhoHistograma,
+                                  const std::string& caminhoDiario) {
+    std::vector<Player> jogadores;
+    std::unordered_map<std::string, Id> indice;
+    uint64_t seq = 0;
+    lerSnapshot(caminhoSnapshot, jogadores, indice, seq); // Sem snapshot: começa vazio
+    ScoreHistogram partidas;
+    uint64_t seqHistograma = 0;
+    partidas.ler(caminhoHistograma, seqHistograma); // Sem histograma: começa vazio
 
-    std::ofstream arq(caminhoArquivo); // Abre o arquivo para escrita
-    if (!arq.is_open()) {
-        std::cerr << "Erro: não foi possível salvar os dados em " << caminhoArquivo << "\n";
+    std::vector<MatchJournal::Registro> registros;
+    if (!MatchJournal::ler(caminhoDiario, registros)) return false;
+    for (const MatchJournal::Registro& r : registros) {
+        if (r.seq > seqHistograma) {
+            if (r.tipo == 'P') partidas.adicionar(r.pontuacao);
+            seqHistograma = r.seq;
+        }
+        if (r.seq <= seq) continue;
+        aplicar(jogadores, indice, std::vector<uint32_t>(), r);
+        seq = r.seq;
+    }
+
+    if (!partidas.gravar(caminhoHistograma, seqHistograma)) return false;
+    if (!PlayerDatabase::gravar(caminhoSnapshot, jogadores, seq)) return false;
+    std::error_code erro;
+    std::filesystem::remove(caminhoDiario, erro); // Só depois de o snapshot estar no disco
+    return true;
+}
+
+/**
+ * @brief Corpo da thread de compactação: com a trava exclusiva do snapshot, troca o
+ * diário (de todos os jogos) por um vazio e dobra o antigo.
+ */
+void* PlayerManager::executarCompactacao(ALLEGRO_THREAD* thread, void* arg) {
+    PlayerManager* self = static_cast<PlayerManager*>(arg);
+    auto inicio = std::chrono::steady_clock::now();
+
+    // Espera a compactação de outro jogo (que já leva as partidas deste) terminar
+    self->travaSnapshot.travar(FileLock::EXCLUSIVA);
+    std::string diarioAntigo = self->caminhoJournal + ".old";
+    std::error_code erro;
+    bool sobra = std::filesystem::exists(diarioAntigo, erro);
+    // Primeiro a sobra de uma compactação interrompida: mover o diário agora a apagaria
+    if ((!sobra || dobrarJournal(self->caminhoArquivo, self->caminhoHistograma, diarioAntigo)) &&
+        self->journal->rotacionar(diarioAntigo) &&
+        dobrarJournal(self->caminhoArquivo, self->caminhoHistograma, diarioAntigo)) {
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+        std::cout << "Diario de jogadores compactado em " << ms << " ms.\n";
+    }
+    self->travaSnapshot.destravar();
+    self->compactando = false;
+    return nullptr;
+}
+
+/**
+ * @brief Inicia a compactação em segundo plano.
+ * Se a thread não puder ser criada, a compactação roda aqui mesmo.
+ */
+void PlayerManager::compactar() {
+    if (!journal || !journal->isAberto() || compactando) return;
+    aguardarCompactacao(); // Libera a thread da compactação anterior, que já terminou
+
+    compactando = true;
+    registrosDesdeCompactacao = 0;
+    compactador = al_create_thread(&PlayerManager::executarCompactacao, this);
+    if (compactador) {
+        al_start_thread(compactador);
+    } else {
+        executarCompactacao(nullptr, this);
+    }
+}
+
+/**
+ * @brief Espera a última compactação terminar e libera a thread dela.
+ */
+void PlayerManager::aguardarCompactacao() {
+    if (!compactador) return;
+    al_join_thread(compactador, nullptr);
+    al_destroy_thread(compactador);
+    compactador = nullptr;
+}
+
+/**
+ * @brief Garante que os dados dos jogadores estão no disco.
+ * 
+ * Com o diário aberto, sincroniza o que foi anotado. Sem ele, as mudanças que não
+ * foram para o diário são aplicadas ao banco que está no disco, com a trava exclusiva
+ * do snapshot: outro jogo pode ter compactado desde a carga, então o banco é relido
+ * e continua com o número de sequência dele (o diário dos outros jogos segue valendo
+ * por cima, e nada é aplicado duas vezes).
+ */
+void PlayerManager::salvar() {
+    if (journal && journal->isAberto()) {
+        journal->sincronizar();
         return;
     }
+    if (foraDoDiario.empty()) return;
 
-    for (const auto& p : jogadores) {
-        arq << p.getNome() << " " << p.getApelido() << " "
-            << p.getPartidas() << " " << p.getMaiorPontuacao() << "\n";
+    bool travado = travaSnapshot.travar(FileLock::EXCLUSIVA);
+    if (!travado) {
+        std::cerr << "AVISO: Gravando " << caminhoArquivo << " sem a trava do snapshot.\n";
     }
+    std::vector<Player> atuais;
+    std::unordered_map<std::string, Id> indiceAtual;
+    uint64_t seq = 0;
+    lerSnapshot(caminhoArquivo, atuais, indiceAtual, seq); // Sem snapshot: só as mudanças deste jogo
+    ScoreHistogram partidas;
+    uint64_t seqHistograma = 0;
+    partidas.ler(caminhoHistograma, seqHistograma);
+    for (const MatchJournal::Registro& r : foraDoDiario) {
+        aplicar(atuais, indiceAtual, std::vector<uint32_t>(), r);
+        if (r.tipo == 'P') partidas.adicionar(r.pontuacao);
+    }
+
+    if (PlayerDatabase::gravar(caminhoArquivo, atuais, seq)) {
+        foraDoDiario.clear();
+        if (!partidas.gravar(caminhoHistograma, seqHistograma)) {
+            std::cerr << "AVISO: Nao foi possivel gravar o histograma " << caminhoHistograma << ".\n";
+        }
+    } else {
+        std::cerr << "Erro: nao foi possivel gravar o banco de jogadores " << caminhoArquivo
+                  << "; " << foraDoDiario.size() << " mudanca(s) continuam so na memoria.\n";
+    }
+    if (travado) travaSnapshot.destravar();
+}
+
+/**
+ * @brief Anota um registro no diário e compacta quando ele fica grande.
+ * @param registro O registro.
+ */
+void PlayerManager::anotar(const MatchJournal::Registro& registro) {
+    if (!journal) return; // Antes de `carregar`: só memória
+    if (!journal->isAberto()) {
+        // Diário indisponível: a partida terminada grava o banco inteiro (o cadastro vai junto)
+        foraDoDiario.push_back(registro);
+        if (registro.tipo == 'P') salvar();
+        return;
+    }
+    journal->anotar(registro);
+    if (++registrosDesdeCompactacao >= LIMITE_COMPACTACAO) compactar();
 }
 
 /**
- * @brief Cadastra um novo jogador na memória.
+ * @brief Cadastra um novo jogador na memória e anota o cadastro no diário.
  * 
  * @param nome Nome real do jogador.
  * @param apelido Apelido único do jogador.
+ * @return O Id do jogador novo, ou o do já existente com esse apelido.
  */
-void PlayerManager::cadastrar(const std::string& nome, const std::string& apelido) {
+PlayerManager::Id PlayerManager::cadastrar(const std::string& nome, const std::string& apelido) {
+    Id existente = buscarId(apelido);
+    if (existente != ID_INVALIDO) {
+        return existente; // Apelido já cadastrado
+    }
+    Id id = (Id)jogadores.size();
+    indice.emplace(apelido, id);
     jogadores.emplace_back(nome, apelido);
+    ranking.atualizar(id, 0);
+    recordesJogadores.adicionar(0);
+    if (apelidosProntos) apelidos.inserir((uint32_t)id, jogadores);
+
+    MatchJournal::Registro registro;
+    registro.tipo = 'C';
+    registro.apelido = apelido;
+    registro.nome = nome;
+    anotar(registro);
+    return id;
+}
+
+/**
+ * @brief Registra uma partida terminada e a anota no diário.
+ * 
+ * @param id O Id do jogador.
+ * @param pontuacao A pontuação da partida.
+ * @return false se o Id não existe.
+ */
+bool PlayerManager::registrarPartida(Id id, int pontuacao) {
+    Player* jogador = getJogador(id);
+    if (!jogador) return false;
+    int recordeAnterior = jogador->getMaiorPontuacao();
+    jogador->adicionarPartida(pontuacao);
+    ranking.atualizar(id, jogador->getMaiorPontuacao()); // Só muda de lugar se bateu o recorde pessoal
+    pontuacoesPartidas.adicionar(pontuacao);
+    if (jogador->getMaiorPontuacao() != recordeAnterior) {
+        recordesJogadores.remover(recordeAnterior);
+        recordesJogadores.adicionar(jogador->getMaiorPontuacao());
+        if (apelidosProntos) apelidos.atualizar((uint32_t)id, jogador->getMaiorPontuacao());
+    }
+
+    MatchJournal::Registro registro;
+    registro.tipo = 'P';
+    registro.apelido = jogador->getApelido();
+    registro.pontuacao = pontuacao;
+    anotar(registro);
+    if (placarRemoto) placarRemoto->enviar(jogador->getApelido(), pontuacao); // Só entra na fila do envio
+    return true;
+}
+
+/**
+ * @brief Sugere apelidos que começam com um prefixo, montando o índice na primeira vez.
+ * @param prefixo O começo do apelido.
+ * @param quantos Quantas sugestões, no máximo.
+ * @return Os Ids sugeridos.
+ */
+std::vector<PlayerManager::Id> PlayerManager::sugerirApelidos(const std::string& prefixo, size_t quantos) {
+    if (!apelidosProntos) {
+        apelidos.reconstruir(jogadores);
+        apelidosProntos = true;
+    }
+    std::vector<uint32_t> encontrados = apelidos.sugerir(prefixo, quantos, jogadores);
+    return std::vector<Id>(encontrados.begin(), encontrados.end());
 }
 
 /**
@@ -91,11 +450,32 @@ const std::vector<Player>& PlayerManager::getJogadores() const {
  * @return Ponteiro para o jogador encontrado, ou nullptr se não existir.
  */
 Player* PlayerManager::buscar(const std::string& apelido) {
-    for (auto& p : jogadores) {
-        if (p.getApelido() == apelido)
-            return &p;
-    }
-    return nullptr;
+    return getJogador(buscarId(apelido));
+}
+
+/**
+ * @brief Busca o Id de um jogador nos índices de apelidos.
+ * 
+ * @param apelido O apelido do jogador a ser buscado.
+ * @return O Id do jogador, ou ID_INVALIDO se não existir.
+ */
+PlayerManager::Id PlayerManager::buscarId(const std::string& apelido) const {
+    // Primeiro os jogadores do banco (quase todos), depois os cadastrados desde o snapshot
+    int posicao = PlayerDatabase::buscarNoIndice(indiceBanco, apelido, jogadores);
+    if (posicao >= 0) return posicao;
+    auto it = indice.find(apelido);
+    return it != indice.end() ? it->second : ID_INVALIDO;
+}
+
+/**
+ * @brief Retorna o jogador de um Id.
+ * 
+ * @param id O Id do jogador.
+ * @return Ponteiro para o jogador, ou nullptr se o Id for inválido.
+ */
+Player* PlayerManager::getJogador(Id id) {
+    if (id < 0 || id >= (Id)jogadores.size()) return nullptr;
+    return &jogadores[id];
 }
 
 /**
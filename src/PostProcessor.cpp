@@ -0,0 +1,135 @@
+/**
+ * @file PostProcessor.cpp
+ * @brief PostProcessorimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "PostProcessor.hpp"
+#include "RenderStats.hpp" // Contagem de desenhos para o HUD de depuração
+#include <iostream> // Para saída de avisos
+
+/// @brief Deslocamentos das amostras do desfoque (kernel gaussiano de 9 pixels com amostragem linear).
+static const float OFFSETS_DESFOQUE[3] = {0.0f, 1.3846153846f, 3.2307692308f};
+/// @brief Pesos de cada amostra do desfoque (a soma de todas as 5 amostras é 1).
+static const float PESOS_DESFOQUE[3] = {0.2270270270f, 0.3162162162f, 0.0702702703f};
+
+/**
+ * @brief Cria um bitmap com filtragem linear, necessária para reduzir e desfocar suavemente.
+ * @return O bitmap criado, ou nullptr em caso de falha.
+ */
+static ALLEGRO_BITMAP* criarBitmapLinear(int largura, int altura) {
+    ALLEGRO_STATE estado;
+    al_store_state(&estado, ALLEGRO_STATE_NEW_BITMAP_PARAMETERS);
+    al_add_new_bitmap_flag(ALLEGRO_MIN_LINEAR | ALLEGRO_MAG_LINEAR);
+    ALLEGRO_BITMAP* bitmap = al_create_bitmap(largura > 0 ? largura : 1, altura > 0 ? altura : 1);
+    al_restore_state(&estado);
+    return bitmap;
+}
+
+/**
+ * @brief Construtor da classe PostProcessor.
+ * @param largura Largura da cena em resolução cheia.
+ * @param altura Altura da cena em resolução cheia.
+ */
+PostProcessor::PostProcessor(int largura, int altura)
+    : metade(criarBitmapLinear(largura / 2, altura / 2)),
+      quarto(criarBitmapLinear(largura / 4, altura / 4)),
+      quartoTemp(criarBitmapLinear(largura / 4, altura / 4)),
+      tempos{0.0, 0.0, 0.0, 0.0}
+{
+    if (!isValido()) {
+        std::cerr << "AVISO: Nao foi possivel criar os bitmaps do pos-processamento. Transicoes sem desfoque.\n";
+    }
+}
+
+/**
+ * @brief Destrutor da classe PostProcessor.
+ */
+PostProcessor::~PostProcessor() {
+    if (metade) al_destroy_bitmap(metade);
+    if (quarto) al_destroy_bitmap(quarto);
+    if (quartoTemp) al_destroy_bitmap(quartoTemp);
+}
+
+/**
+ * @brief Faz uma passada do desfoque em uma direção, somando as amostras ponderadas.
+ */
+void PostProcessor::passadaDesfoque(ALLEGRO_BITMAP* origem, ALLEGRO_BITMAP* destino, float dx, float dy) {
+    al_set_target_bitmap(destino);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ONE); // Soma das amostras
+
+    for (int i = 0; i < 3; ++i) {
+        float w = PESOS_DESFOQUE[i];
+        ALLEGRO_COLOR peso = al_map_rgba_f(w, w, w, w);
+        float o = OFFSETS_DESFOQUE[i];
+        al_draw_tinted_bitmap(origem, peso, o * dx, o * dy, 0);
+        RenderStats::registrarDesenho(origem);
+        if (i > 0) { // A amostra central é única; as outras são espelhadas
+            al_draw_tinted_bitmap(origem, peso, -o * dx, -o * dy, 0);
+            RenderStats::registrarDesenho(origem);
+        }
+    }
+}
+
+/**
+ * @brief Aplica o desfoque e o fade da transição, desenhando no alvo atual.
+ * @param cena Bitmap com a cena em resolução cheia.
+ * @param intensidade Intensidade do efeito (0 a 1).
+ * @param larguraDestino Largura da área de destino.
+ * @param alturaDestino Altura da área de destino.
+ */
+void PostProcessor::aplicar(ALLEGRO_BITMAP* cena, float intensidade, float larguraDestino, float alturaDestino) {
+    if (!cena || !isValido()) return;
+    if (intensidade < 0.0f) intensidade = 0.0f;
+    if (intensidade > 1.0f) intensidade = 1.0f;
+
+    ALLEGRO_STATE estado;
+    al_store_state(&estado, ALLEGRO_STATE_TARGET_BITMAP | ALLEGRO_STATE_BLENDER);
+    ALLEGRO_BITMAP* alvoFinal = al_get_target_bitmap();
+
+    // 1) Redução em cadeia: cheia -> 1/2 -> 1/4 (cópia direta, sem misturar com o conteúdo anterior)
+    double t0 = al_get_time();
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+    al_set_target_bitmap(metade);
+    al_draw_scaled_bitmap(cena, 0, 0, al_get_bitmap_width(cena), al_get_bitmap_height(cena),
+                          0, 0, al_get_bitmap_width(metade), al_get_bitmap_height(metade), 0);
+    RenderStats::registrarDesenho(cena);
+    al_set_target_bitmap(quarto);
+    al_draw_scaled_bitmap(metade, 0, 0, al_get_bitmap_width(metade), al_get_bitmap_height(metade),
+                          0, 0, al_get_bitmap_width(quarto), al_get_bitmap_height(quarto), 0);
+    RenderStats::registrarDesenho(metade);
+    double t1 = al_get_time();
+
+    // 2) Desfoque separável em 1/4 da resolução: horizontal (quarto -> temp), vertical (temp -> quarto)
+    passadaDesfoque(quarto, quartoTemp, 1.0f, 0.0f);
+    double t2 = al_get_time();
+    passadaDesfoque(quartoTemp, quarto, 0.0f, 1.0f);
+    double t3 = al_get_time();
+
+    // 3) Composição: nítida * brilho * (1 - s) + desfocada * brilho * s, onde brilho = 1 - s
+    //    faz o mesmo fade para o preto que o retângulo translúcido fazia.
+    al_set_target_bitmap(alvoFinal);
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_INVERSE_ALPHA);
+    float s = intensidade;
+    float brilho = 1.0f - s;
+    if (s < 0.999f) {
+        al_draw_tinted_scaled_bitmap(cena, al_map_rgba_f(brilho, brilho, brilho, 1.0f),
+                                     0, 0, al_get_bitmap_width(cena), al_get_bitmap_height(cena),
+                                     0, 0, larguraDestino, alturaDestino, 0);
+        RenderStats::registrarDesenho(cena);
+    }
+    float k = brilho * s; // Cor pré-multiplicada pelo alpha da camada desfocada
+    al_draw_tinted_scaled_bitmap(quarto, al_map_rgba_f(k, k, k, s),
+                                 0, 0, al_get_bitmap_width(quarto), al_get_bitmap_height(quarto),
+                                 0, 0, larguraDestino, alturaDestino, 0);
+    RenderStats::registrarDesenho(quarto);
+    double t4 = al_get_time();
+
+    al_restore_state(&estado);
+
+    tempos.reduzir = (t1 - t0) * 1000.0;
+    tempos.desfoqueH = (t2 - t1) * 1000.0;
+    tempos.desfoqueV = (t3 - t2) * 1000.0;
+    tempos.compor = (t4 - t3) * 1000.0;
+}
@@ -5,21 +5,11 @@
 
 
 #include "RankingScreen.hpp"
+#include "RenderStats.hpp" // Contagem de desenhos para o HUD de depuração
 #include <allegro5/allegro_primitives.h> // Para desenho de formas primitivas
 #include <iostream> // Para saída de avisos
 #include <string> // Para manipulação de strings
-#include <algorithm> // Para std::sort e std::max
-
-/**
- * @brief Função de comparação para ordenar jogadores por pontuação decrescente.
- * Usada com `std::sort`.
- * @param a Primeiro jogador a comparar.
- * @param b Segundo jogador a comparar.
- * @return True se a pontuação de 'a' for maior que a de 'b', false caso contrário.
- */
-static bool comparePlayersByScore(const Player& a, const Player& b) {
-    return a.getMaiorPontuacao() > b.getMaiorPontuacao();
-}
+#include <algorithm> // Para std::max e std::min
 
 /**
  * @brief Construtor da classe RankingScreen.
@@ -35,7 +25,11 @@ RankingScreen::RankingScreen(ALLEGRO_FONT* f, ALLEGRO_BITMAP* rankingBackground,
       playerManager(pm),
       SCREEN_W(static_cast<float>(screenW)), // Converte para float para cálculos
       SCREEN_H(static_cast<float>(screenH)), // Converte para float para cálculos
-      waitingForKeyPress(true) // Começa esperando por um input para sair
+      waitingForKeyPress(true), // Começa esperando por um input para sair
+      quadroCache(nullptr),
+      sujo(true),
+      jogadorDesenhado(nullptr),
+      primeiraLinha(0)
 {
     // Dimensões de design para cálculo da escala
     const float DESIGN_W = 1280.0f;
@@ -53,6 +47,14 @@ RankingScreen::RankingScreen(ALLEGRO_FONT* f, ALLEGRO_BITMAP* rankingBackground,
     }
 }
 
+/**
+ * @brief Destrutor da classe RankingScreen.
+ * Libera o bitmap da tela composta (a fonte e o fundo pertencem ao GameEngine).
+ */
+RankingScreen::~RankingScreen() {
+    if (quadroCache) al_destroy_bitmap(quadroCache);
+}
+
 /**
  * @brief Atualiza o estado da tela de ranking.
  * @param deltaTime Tempo decorrido desde a última atualização (atualmente não usado).
@@ -63,13 +65,55 @@ void RankingScreen::update(float deltaTime) {
     // Se tivéssemos elementos animados no ranking, seria aqui.
 }
 
+/**
+ * @brief Informa se a tela precisa ser recomposta.
+ * @param currentPlayer O jogador que será destacado.
+ * @return true se algo mudou desde a última composição.
+ */
+bool RankingScreen::precisaRedesenhar(Player* currentPlayer) const {
+    return sujo || !quadroCache || currentPlayer != jogadorDesenhado;
+}
+
 /**
  * @brief Renderiza a tela de ranking, exibindo os jogadores e suas pontuações.
+ *
+ * O ranking é composto em `quadroCache` só quando algo muda; nos demais frames
+ * a tela custa um único desenho de bitmap (e nada de ordenar a lista de jogadores).
+ *
  * @param currentPlayer Ponteiro para o jogador atual (pode ser nulo). Se presente,
  * a linha do jogador atual será destacada.
  * @param deltaTime Tempo decorrido desde a última atualização (não usado diretamente no render).
  */
 void RankingScreen::render(Player* currentPlayer, float deltaTime) {
+    if (!quadroCache) {
+        quadroCache = al_create_bitmap((int)SCREEN_W, (int)SCREEN_H);
+    }
+    if (!quadroCache) {
+        compor(currentPlayer); // Sem bitmap de cache: desenha direto, como antes
+        return;
+    }
+
+    if (precisaRedesenhar(currentPlayer)) {
+        ALLEGRO_STATE estado;
+        al_store_state(&estado, ALLEGRO_STATE_TARGET_BITMAP);
+        al_set_target_bitmap(quadroCache);
+        al_clear_to_color(al_map_rgb(0, 0, 0));
+        compor(currentPlayer);
+        al_restore_state(&estado);
+
+        sujo = false;
+        jogadorDesenhado = currentPlayer;
+    }
+
+    al_draw_bitmap(quadroCache, 0, 0, 0);
+    RenderStats::registrarDesenho(quadroCache);
+}
+
+/**
+ * @brief Desenha todos os elementos do ranking no alvo atual.
+ * @param currentPlayer Ponteiro para o jogador atual (pode ser nulo).
+ */
+void RankingScreen::compor(Player* currentPlayer) {
     // Desenha o fundo da tela de ranking
     if (rankingBackground) {
         int bg_w = al_get_bitmap_width(rankingBackground);
@@ -98,8 +142,19 @@ void RankingScreen::render(Player* currentPlayer, float deltaTime) {
     al_draw_filled_rounded_rectangle(panelX1, panelY1, panelX2, panelY2,
                                      cornerRadius, cornerRadius, al_map_rgba(0, 0, 0, 180)); // 180 de alpha = ~70% opaco
 
-    // Desenha o título do ranking
-    al_draw_text(font, al_map_rgb(255, 255, 0), SCREEN_W / 2.0f, 90.0f * scale_y, ALLEGRO_ALIGN_CENTER, "RANKING - TOP 10");
+    // Só a janela visível é buscada: uma descida no ranking e LINHAS_VISIVEIS linhas, com qualquer número de jogadores
+    const Leaderboard& ranking = playerManager->getRanking();
+    size_t total = ranking.getQuantidade();
+    primeiraLinha = limitarInicio(primeiraLinha, total, LINHAS_VISIVEIS); // O ranking pode ter mudado desde a rolagem
+    std::vector<int32_t> visiveis = ranking.listar(primeiraLinha + 1, LINHAS_VISIVEIS);
+
+    // Desenha o título do ranking, com as posições visíveis quando nem todos cabem no painel
+    std::string titulo = "RANKING - TOP 10";
+    if (total > LINHAS_VISIVEIS) {
+        titulo = "RANKING - " + std::to_string(primeiraLinha + 1) + " a " + std::to_string(primeiraLinha + visiveis.size()) +
+                 " de " + std::to_string(total);
+    }
+    al_draw_text(font, al_map_rgb(255, 255, 0), SCREEN_W / 2.0f, 90.0f * scale_y, ALLEGRO_ALIGN_CENTER, titulo.c_str());
 
     float y = 140.0f * scale_y; // Posição Y inicial para os cabeçalhos das colunas
     // Define as posições X para cada coluna, centralizadas ou alinhadas conforme necessário
@@ -115,43 +170,46 @@ void RankingScreen::render(Player* currentPlayer, float deltaTime) {
     al_draw_text(font, al_map_rgb(200, 200, 200), colPartidas, y, 0, "PARTIDAS");
     y += 40.0f * scale_y; // Avança a posição Y para a primeira linha de dados
 
-    // Obtém a lista de jogadores do PlayerManager e a ordena por pontuação
-    std::vector<Player> jogadores = playerManager->getJogadores();
-    std::sort(jogadores.begin(), jogadores.end(), comparePlayersByScore);
-
-    int colocacaoAtual = -1; // Variável para armazenar a colocação do jogador atual
-    if (currentPlayer) {
-        // Encontra a colocação do jogador atual na lista ordenada
-        for (size_t i = 0; i < jogadores.size(); ++i) {
-            if (jogadores[i].getApelido() == currentPlayer->getApelido()) {
-                colocacaoAtual = (int)i + 1; // Colocação é o índice + 1
-                break;
-            }
-        }
-    }
+    // O ranking já está em ordem: as linhas visíveis e a posição do jogador saem sem ordenar nada
+    PlayerManager::Id idAtual = currentPlayer ? playerManager->buscarId(currentPlayer->getApelido()) : PlayerManager::ID_INVALIDO;
+    int colocacaoAtual = idAtual != PlayerManager::ID_INVALIDO ? (int)ranking.getPosicao(idAtual) : -1;
+    if (colocacaoAtual == 0) colocacaoAtual = -1;
 
-    // Desenha os dados do TOP 10 jogadores
-    for (size_t i = 0; i < jogadores.size() && i < 10; ++i) {
-        const Player& p = jogadores[i];
+    // Desenha os dados dos jogadores da janela visível
+    float yLinhas = y;
+    const std::vector<Player>& jogadores = playerManager->getJogadores();
+    for (size_t i = 0; i < visiveis.size(); ++i) {
+        const Player& p = jogadores[visiveis[i]];
         ALLEGRO_COLOR cor = al_map_rgb(255, 255, 255); // Cor padrão branca
         // Se for o jogador atual, destaca a linha com cor verde
-        if (currentPlayer && p.getApelido() == currentPlayer->getApelido()) {
+        if (visiveis[i] == idAtual) {
             cor = al_map_rgb(0, 255, 0);
         }
         // Desenha os dados de cada jogador nas colunas correspondentes
-        al_draw_textf(font, cor, colPos, y, 0, "%d", (int)i + 1);
+        al_draw_textf(font, cor, colPos, y, 0, "%d", (int)(primeiraLinha + i + 1));
         al_draw_text(font, cor, colNome, y, 0, p.getApelido().c_str());
         al_draw_textf(font, cor, colPontos, y, 0, "%d", p.getMaiorPontuacao());
         al_draw_textf(font, cor, colPartidas, y, 0, "%d", p.getPartidas());
         y += 30.0f * scale_y; // Avança para a próxima linha
     }
 
+    // Barra de rolagem: o tamanho mostra a fração visível do ranking e a posição, onde a janela está
+    if (total > LINHAS_VISIVEIS) {
+        float trilhoX = panelX2 - 24.0f * scale_x;
+        float trilhoAltura = LINHAS_VISIVEIS * 30.0f * scale_y;
+        float barraAltura = std::max(trilhoAltura * LINHAS_VISIVEIS / (float)total, 8.0f * scale_y);
+        float barraY = yLinhas + (trilhoAltura - barraAltura) * primeiraLinha / (float)(total - LINHAS_VISIVEIS);
+        al_draw_filled_rectangle(trilhoX, yLinhas, trilhoX + 8.0f * scale_x, yLinhas + trilhoAltura, al_map_rgba(80, 80, 80, 200));
+        al_draw_filled_rectangle(trilhoX, barraY, trilhoX + 8.0f * scale_x, barraY + barraAltura, al_map_rgb(255, 255, 0));
+    }
+    y = yLinhas + LINHAS_VISIVEIS * 30.0f * scale_y; // A mensagem fica no mesmo lugar com a janela cheia ou não
+
     y += 20.0f * scale_y; // Espaçamento extra antes da mensagem do jogador atual
 
     // Mensagem sobre a colocação do jogador atual
     if (currentPlayer) {
         if (colocacaoAtual != -1) {
-            std::string msg = "Sua colocação: " + std::to_string(colocacaoAtual);
+            std::string msg = "Sua colocação: " + std::to_string(colocacaoAtual) + " de " + std::to_string(total);
             al_draw_text(font, al_map_rgb(0, 255, 0), SCREEN_W / 2.0f, y, ALLEGRO_ALIGN_CENTER, msg.c_str());
         } else {
             // Se o jogador não está no top 10 ou não tem pontos ainda
@@ -166,27 +224,98 @@ void RankingScreen::render(Player* currentPlayer, float deltaTime) {
         al_draw_text(font, al_map_rgb(255, 0, 0), SCREEN_W / 2.0f, y, ALLEGRO_ALIGN_CENTER, "Você ainda não jogou!");
     }
 
-    // Mensagem para o usuário voltar ao menu
-    al_draw_text(font, al_map_rgb(255, 255, 255), SCREEN_W / 2.0f, SCREEN_H - 80.0f * scale_y, ALLEGRO_ALIGN_CENTER, "Pressione qualquer tecla para voltar");
+    // Mensagem para o usuário rolar o ranking ou voltar ao menu
+    al_draw_text(font, al_map_rgb(255, 255, 255), SCREEN_W / 2.0f, SCREEN_H - 110.0f * scale_y, ALLEGRO_ALIGN_CENTER,
+                 "Setas, PgUp/PgDn e roda: rolar    M: minha posicao");
+    al_draw_text(font, al_map_rgb(255, 255, 255), SCREEN_W / 2.0f, SCREEN_H - 80.0f * scale_y, ALLEGRO_ALIGN_CENTER, "Outra tecla para voltar");
 }
 
 /**
  * @brief Lida com eventos de entrada na tela de ranking.
  * @param ev O evento Allegro a ser processado.
- * @return 1 se uma tecla for pressionada (sinal para voltar ao menu), 0 caso contrário.
+ * @param currentPlayer O jogador atual (pode ser nulo), para a tecla M.
+ * @return 1 se uma tecla que não rola a janela for pressionada (sinal para voltar ao menu), 0 caso contrário.
  */
-int RankingScreen::handleEvent(ALLEGRO_EVENT ev) {
+int RankingScreen::handleEvent(ALLEGRO_EVENT ev, Player* currentPlayer) {
+    if (ev.type == ALLEGRO_EVENT_MOUSE_AXES && ev.mouse.dz != 0) {
+        // Roda para cima (dz positivo) sobe no ranking
+        size_t passo = LINHAS_POR_RODA * (size_t)(ev.mouse.dz > 0 ? ev.mouse.dz : -ev.mouse.dz);
+        rolarPara(ev.mouse.dz > 0 ? (primeiraLinha > passo ? primeiraLinha - passo : 0) : primeiraLinha + passo);
+        return 0;
+    }
     if (ev.type == ALLEGRO_EVENT_KEY_DOWN) {
-        waitingForKeyPress = false; // Sinaliza que uma tecla foi pressionada
-        return 1; // Retorna 1 para indicar que a tela deve ser fechada/navegada
+        switch (ev.keyboard.keycode) {
+            case ALLEGRO_KEY_UP:
+                rolarPara(primeiraLinha > 0 ? primeiraLinha - 1 : 0);
+                return 0;
+            case ALLEGRO_KEY_DOWN:
+                rolarPara(primeiraLinha + 1);
+                return 0;
+            case ALLEGRO_KEY_PGUP:
+                rolarPara(primeiraLinha > LINHAS_VISIVEIS ? primeiraLinha - LINHAS_VISIVEIS : 0);
+                return 0;
+            case ALLEGRO_KEY_PGDN:
+                rolarPara(primeiraLinha + LINHAS_VISIVEIS);
+                return 0;
+            case ALLEGRO_KEY_HOME:
+                rolarPara(0);
+                return 0;
+            case ALLEGRO_KEY_END:
+                rolarPara(playerManager ? playerManager->getRanking().getQuantidade() : 0); // Ajustado para a última página
+                return 0;
+            case ALLEGRO_KEY_M:
+                // Pula para a posição do jogador atual, no meio da janela (O(log n), sem percorrer o ranking)
+                if (currentPlayer && playerManager) {
+                    const Leaderboard& ranking = playerManager->getRanking();
+                    size_t posicao = ranking.getPosicao(playerManager->buscarId(currentPlayer->getApelido()));
+                    if (posicao > 0) rolarPara(inicioParaPosicao(posicao, ranking.getQuantidade(), LINHAS_VISIVEIS));
+                }
+                return 0;
+            default:
+                waitingForKeyPress = false; // Sinaliza que uma tecla foi pressionada
+                return 1; // Retorna 1 para indicar que a tela deve ser fechada/navegada
+        }
     }
     return 0; // Nenhum evento relevante processado
 }
 
+/**
+ * @brief Move a janela visível, limitada ao fim do ranking.
+ * @param inicio O índice desejado da primeira linha.
+ */
+void RankingScreen::rolarPara(size_t inicio) {
+    size_t total = playerManager ? playerManager->getRanking().getQuantidade() : 0;
+    size_t ajustado = limitarInicio(inicio, total, LINHAS_VISIVEIS);
+    if (ajustado != primeiraLinha) {
+        primeiraLinha = ajustado;
+        sujo = true; // A janela mudou: recompõe no próximo desenho
+    }
+}
+
+/**
+ * @brief Ajusta o início de uma janela ao tamanho do ranking.
+ */
+size_t RankingScreen::limitarInicio(size_t inicio, size_t total, size_t linhas) {
+    size_t ultimoInicio = total > linhas ? total - linhas : 0; // A última página fica cheia
+    return std::min(inicio, ultimoInicio);
+}
+
+/**
+ * @brief Calcula o início da janela que deixa uma posição no meio.
+ */
+size_t RankingScreen::inicioParaPosicao(size_t posicao, size_t total, size_t linhas) {
+    if (posicao == 0) return 0;
+    size_t indice = posicao - 1;
+    size_t inicio = indice > linhas / 2 ? indice - linhas / 2 : 0;
+    return limitarInicio(inicio, total, linhas);
+}
+
 /**
  * @brief Reseta o estado da tela de ranking.
  * Útil para reexibir a tela.
  */
 void RankingScreen::resetState() {
     waitingForKeyPress = true; // Reinicia o estado de espera por uma tecla
+    primeiraLinha = 0; // Reabre no topo do ranking
+    sujo = true; // Ao reabrir a tela, os dados do ranking podem ter mudado
 }
\ No newline at end of file
@@ -0,0 +1,190 @@
+/**
+ * @file RenderQueue.cpp
+ * @brief RenderQueueimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "RenderQueue.hpp"
+#include "RenderStats.hpp"               // Contagem de desenhos, lotes e descartes para o HUD
+#include <allegro5/allegro_primitives.h> // Para os retângulos dos fallbacks
+#include <algorithm>                     // Para std::stable_sort, std::max e std::min
+#include <cmath>                         // Para std::sqrt
+#include <functional>                    // Para std::less (comparação de ponteiros)
+
+/**
+ * @brief Construtor da classe RenderQueue.
+ * @param largura Largura da área visível.
+ * @param altura Altura da área visível.
+ */
+RenderQueue::RenderQueue(float largura, float altura)
+    : larguraVisivel(largura), alturaVisivel(altura), enviados(0), descartados(0), descartadosUltimoEnvio(0) {}
+
+/**
+ * @brief Recorta um intervalo de destino à área visível, ajustando a origem na mesma proporção.
+ * @return false se o intervalo ficou vazio.
+ */
+bool RenderQueue::recortarEixo(float& d, float& tamanho, float& s, float& tamanhoOrigem, float limite, bool espelhado) {
+    if (tamanho <= 0.0f) return false;
+
+    float inicio = std::max(d, 0.0f);
+    float fim = std::min(d + tamanho, limite);
+    if (fim <= inicio) return false; // Totalmente fora da tela
+
+    // Frações do destino cortadas em cada ponta
+    float corteInicio = (inicio - d) / tamanho;
+    float corteFim = (d + tamanho - fim) / tamanho;
+
+    // Desenho invertido: o começo do destino vem do fim da origem
+    s += (espelhado ? corteFim : corteInicio) * tamanhoOrigem;
+    tamanhoOrigem *= 1.0f - corteInicio - corteFim;
+    d = inicio;
+    tamanho = fim - inicio;
+    return true;
+}
+
+/**
+ * @brief Grava o desenho de uma região de bitmap, descartando ou recortando o que sai da tela.
+ */
+void RenderQueue::desenharEscalado(ALLEGRO_BITMAP* bitmap, int camada,
+                                   float sx, float sy, float sw, float sh,
+                                   float dx, float dy, float dw, float dh,
+                                   int flags, Mistura mistura) {
+    if (!bitmap || sw <= 0.0f || sh <= 0.0f) return;
+
+    float escalaX = dw / sw; // A escala não muda com o recorte
+    float escalaY = dh / sh;
+    if (!recortarEixo(dx, dw, sx, sw, larguraVisivel, (flags & ALLEGRO_FLIP_HORIZONTAL) != 0) ||
+        !recortarEixo(dy, dh, sy, sh, alturaVisivel, (flags & ALLEGRO_FLIP_VERTICAL) != 0)) {
+        ++descartados;
+        RenderStats::registrarDescarte();
+        return;
+    }
+
+    Comando c;
+    c.bitmap = bitmap;
+    c.textura = al_get_parent_bitmap(bitmap) ? al_get_parent_bitmap(bitmap) : bitmap;
+    c.camada = camada;
+    c.mistura = mistura;
+    c.sx = sx; c.sy = sy; c.sw = sw; c.sh = sh;
+    c.cx = 0.0f; c.cy = 0.0f;
+    c.dx = dx; c.dy = dy;
+    c.escalaX = escalaX; c.escalaY = escalaY;
+    c.angulo = 0.0f;
+    c.flags = flags;
+    c.cor = al_map_rgba_f(1.0f, 1.0f, 1.0f, 1.0f);
+    comandos.push_back(c);
+}
+
+/**
+ * @brief Grava o desenho de um bitmap rotacionado em torno do centro.
+ */
+void RenderQueue::desenharRotacionado(ALLEGRO_BITMAP* bitmap, int camada, float centroX, float centroY,
+                                      float largura, float altura, float angulo) {
+    if (!bitmap) return;
+
+    // Qualquer rotação cabe no círculo com diâmetro igual à diagonal
+    float raio = 0.5f * std::sqrt(largura * largura + altura * altura);
+    if (centroX + raio < 0.0f || centroX - raio > larguraVisivel ||
+        centroY + raio < 0.0f || centroY - raio > alturaVisivel) {
+        ++descartados;
+        RenderStats::registrarDescarte();
+        return;
+    }
+
+    float bw = (float)al_get_bitmap_width(bitmap);
+    float bh = (float)al_get_bitmap_height(bitmap);
+    if (bw <= 0.0f || bh <= 0.0f) return;
+
+    Comando c;
+    c.bitmap = bitmap;
+    c.textura = al_get_parent_bitmap(bitmap) ? al_get_parent_bitmap(bitmap) : bitmap;
+    c.camada = camada;
+    c.mistura = MISTURA_ALFA;
+    c.sx = 0.0f; c.sy = 0.0f; c.sw = bw; c.sh = bh;
+    c.cx = bw / 2.0f; c.cy = bh / 2.0f;
+    c.dx = centroX; c.dy = centroY;
+    c.escalaX = largura / bw; c.escalaY = altura / bh;
+    c.angulo = angulo;
+    c.flags = 0;
+    c.cor = al_map_rgba_f(1.0f, 1.0f, 1.0f, 1.0f);
+    comandos.push_back(c);
+}
+
+/**
+ * @brief Grava um retângulo preenchido.
+ */
+void RenderQueue::desenharRetangulo(int camada, float x1, float y1, float x2, float y2, ALLEGRO_COLOR cor) {
+    if (x2 <= 0.0f || x1 >= larguraVisivel || y2 <= 0.0f || y1 >= alturaVisivel) {
+        ++descartados;
+        RenderStats::registrarDescarte();
+        return;
+    }
+
+    Comando c = {};
+    c.bitmap = nullptr;
+    c.textura = nullptr;
+    c.camada = camada;
+    c.mistura = MISTURA_ALFA;
+    c.sx = x1; c.sy = y1; c.sw = x2; c.sh = y2;
+    c.cor = cor;
+    comandos.push_back(c);
+}
+
+/**
+ * @brief Aplica o blender do modo de mistura.
+ */
+void RenderQueue::aplicarMistura(Mistura mistura) {
+    if (mistura == MISTURA_ADITIVA) {
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ONE);
+    } else {
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_INVERSE_ALPHA); // Padrão do Allegro
+    }
+}
+
+/**
+ * @brief Ordena os comandos e os desenha no alvo atual.
+ * Cada troca de mistura ou um retângulo encerra o lote; trocas de textura o Allegro encerra sozinho.
+ */
+void RenderQueue::enviar() {
+    // Ordem estável: dentro da mesma chave, a ordem de gravação é mantida
+    std::stable_sort(comandos.begin(), comandos.end(), [](const Comando& a, const Comando& b) {
+        if (a.camada != b.camada) return a.camada < b.camada;
+        if (a.mistura != b.mistura) return a.mistura < b.mistura;
+        return std::less<ALLEGRO_BITMAP*>()(a.textura, b.textura);
+    });
+
+    ALLEGRO_STATE estado;
+    al_store_state(&estado, ALLEGRO_STATE_BLENDER);
+
+    int misturaAtual = -1;
+    bool segurando = false;
+    for (const Comando& c : comandos) {
+        if (c.mistura != misturaAtual) {
+            // O blender não pode mudar com desenhos segurados pendentes
+            if (segurando) { RenderStats::segurarDesenho(false); segurando = false; }
+            aplicarMistura(c.mistura);
+            misturaAtual = c.mistura;
+        }
+
+        if (!c.bitmap) {
+            if (segurando) { RenderStats::segurarDesenho(false); segurando = false; }
+            al_draw_filled_rectangle(c.sx, c.sy, c.sw, c.sh, c.cor);
+            RenderStats::registrarPrimitiva();
+            continue;
+        }
+
+        if (!segurando) { RenderStats::segurarDesenho(true); segurando = true; }
+        al_draw_tinted_scaled_rotated_bitmap_region(c.bitmap, c.sx, c.sy, c.sw, c.sh, c.cor,
+                                                    c.cx, c.cy, c.dx, c.dy, c.escalaX, c.escalaY,
+                                                    c.angulo, c.flags);
+        RenderStats::registrarDesenho(c.bitmap);
+    }
+    if (segurando) RenderStats::segurarDesenho(false); // Envia o último lote
+
+    al_restore_state(&estado);
+
+    enviados = (int)comandos.size();
+    descartadosUltimoEnvio = descartados;
+    descartados = 0;
+    comandos.clear(); // Mantém a capacidade para o próximo frame
+}
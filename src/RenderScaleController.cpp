@@ -0,0 +1,94 @@
+/**
+ * @file RenderScaleController.cpp
+ * @brief RenderScaleControllerimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "RenderScaleController.hpp"
+#include <cmath> // Para std::round
+
+/// @brief Acima deste múltiplo do alvo a janela conta como lenta.
+static const double LIMITE_LENTO = 1.10;
+/// @brief Até este múltiplo do alvo a janela conta como folgada (com vsync a média nunca fica muito abaixo do alvo).
+static const double LIMITE_FOLGADO = 1.03;
+/// @brief Frames mais longos que isso são descartados da medição.
+static const double DURACAO_MAXIMA_MS = 250.0;
+
+/**
+ * @brief Construtor da classe RenderScaleController.
+ * @param minimo Menor escala permitida.
+ * @param maximo Maior escala permitida.
+ * @param passo Quanto a escala muda em cada ajuste.
+ * @param alvoMs Tempo de frame alvo, em milissegundos.
+ */
+RenderScaleController::RenderScaleController(float minimo, float maximo, float passo, double alvoMs)
+    : minimo(minimo), maximo(maximo), passo(passo), alvoMs(alvoMs), escala(maximo),
+      somaJanela(0.0), framesJanela(0), mediaMs(0.0), janelasFolgadas(0),
+      escalaQueFalhou(0.0f), esperaFalha(0) {}
+
+/**
+ * @brief Define a escala atual e descarta as medições em andamento.
+ * @param nova A escala inicial.
+ */
+void RenderScaleController::setEscala(float nova) {
+    if (nova < minimo) nova = minimo;
+    if (nova > maximo) nova = maximo;
+    escala = nova;
+    escalaQueFalhou = 0.0f;
+    esperaFalha = 0;
+    janelasFolgadas = 0;
+    reiniciarMedicao();
+}
+
+/**
+ * @brief Descarta a janela de medição em andamento.
+ */
+void RenderScaleController::reiniciarMedicao() {
+    somaJanela = 0.0;
+    framesJanela = 0;
+}
+
+/**
+ * @brief Registra a duração de um frame e ajusta a escala ao fim de cada janela.
+ * @param duracaoMs Tempo entre este frame e o anterior, em milissegundos.
+ * @return true se a escala mudou.
+ */
+bool RenderScaleController::registrarQuadro(double duracaoMs) {
+    if (duracaoMs <= 0.0 || duracaoMs > DURACAO_MAXIMA_MS) return false;
+
+    somaJanela += duracaoMs;
+    ++framesJanela;
+    if (framesJanela < FRAMES_POR_JANELA) return false;
+
+    mediaMs = somaJanela / framesJanela;
+    reiniciarMedicao();
+    if (esperaFalha > 0) --esperaFalha;
+
+    if (mediaMs > alvoMs * LIMITE_LENTO) {
+        // Lento: cai um passo e lembra que a escala atual não se sustentou
+        janelasFolgadas = 0;
+        if (escala <= minimo) return false;
+        escalaQueFalhou = escala;
+        esperaFalha = JANELAS_ESPERA_APOS_FALHA;
+        float nova = std::round((escala - passo) / passo) * passo;
+        escala = nova < minimo ? minimo : nova;
+        return true;
+    }
+
+    if (mediaMs > alvoMs * LIMITE_FOLGADO) {
+        janelasFolgadas = 0; // Nem lento nem folgado: mantém
+        return false;
+    }
+
+    // Folgado: só sobe depois de várias janelas seguidas
+    if (++janelasFolgadas < JANELAS_PARA_SUBIR || escala >= maximo) return false;
+
+    float nova = std::round((escala + passo) / passo) * passo;
+    if (nova > maximo) nova = maximo;
+    if (esperaFalha > 0 && nova >= escalaQueFalhou - passo * 0.5f) {
+        return false; // Essa escala falhou há pouco; espera mais antes de tentar de novo
+    }
+    janelasFolgadas = 0;
+    escala = nova;
+    return true;
+}
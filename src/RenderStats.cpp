@@ -0,0 +1,65 @@
+/**
+ * @file RenderStats.cpp
+ * @brief RenderStatsimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "RenderStats.hpp"
+
+int RenderStats::desenhos = 0;
+int RenderStats::lotes = 0;
+int RenderStats::desenhosQuadroAnterior = 0;
+int RenderStats::lotesQuadroAnterior = 0;
+int RenderStats::descartes = 0;
+int RenderStats::descartesQuadroAnterior = 0;
+ALLEGRO_BITMAP* RenderStats::texturaAtual = nullptr;
+
+/**
+ * @brief Guarda os contadores do frame que terminou e começa um novo.
+ */
+void RenderStats::iniciarQuadro() {
+    desenhosQuadroAnterior = desenhos;
+    lotesQuadroAnterior = lotes;
+    descartesQuadroAnterior = descartes;
+    desenhos = 0;
+    lotes = 0;
+    descartes = 0;
+    texturaAtual = nullptr;
+}
+
+/**
+ * @brief Registra o desenho de um bitmap.
+ * Abre um novo lote se o desenho não estiver segurado ou se a textura raiz mudou.
+ * @param bitmap O bitmap desenhado.
+ */
+void RenderStats::registrarDesenho(ALLEGRO_BITMAP* bitmap) {
+    if (!bitmap) return;
+
+    // Sub-bitmaps compartilham a textura do pai: é ela que decide o lote
+    ALLEGRO_BITMAP* raiz = al_get_parent_bitmap(bitmap);
+    if (!raiz) raiz = bitmap;
+
+    ++desenhos;
+    if (!al_is_bitmap_drawing_held() || raiz != texturaAtual) {
+        ++lotes;
+    }
+    texturaAtual = al_is_bitmap_drawing_held() ? raiz : nullptr;
+}
+
+/**
+ * @brief Registra um desenho que não pode ser agrupado.
+ */
+void RenderStats::registrarPrimitiva() {
+    ++desenhos;
+    ++lotes;
+    texturaAtual = nullptr;
+}
+
+/**
+ * @brief Liga ou desliga o desenho segurado.
+ * @param segurar true para agrupar, false para enviar o lote pendente.
+ */
+void RenderStats::segurarDesenho(bool segurar) {
+    al_hold_bitmap_drawing(segurar);
+    texturaAtual = nullptr; // Qualquer troca encerra o lote em andamento
+}
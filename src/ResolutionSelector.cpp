@@ -7,7 +7,6 @@
 #include "ResolutionSelector.hpp"
 #include <allegro5/allegro.h> // Core Allegro
 #include <allegro5/allegro_font.h> // Para fontes
-#include <allegro5/allegro_ttf.h> // Para fontes TrueType
 #include <allegro5/allegro_primitives.h> // Para desenhar formas primitivas (botões)
 #include <vector> // Para armazenar as opções de resolução
 #include <string> // Para strings de texto
@@ -23,54 +22,33 @@ struct Option {
     float x, y, w, h;        /**< Posição (x, y) e dimensões (largura, altura) da área clicável do botão. */
 };
 
+/// @brief Largura da janela do seletor.
+static const int SELETOR_W = 600;
+/// @brief Altura da janela do seletor.
+static const int SELETOR_H = 550;
+
 /**
- * @brief Exibe uma janela de seleção de resolução para o usuário.
+ * @brief Exibe a seleção de resolução dentro do display do jogo.
  *
- * Esta função inicializa partes básicas do Allegro, cria uma janela temporária
- * para a seleção e aguarda a interação do usuário.
+ * O display é colocado em uma janela comum do tamanho do seletor; os eventos vêm
+ * da fila do jogo (os do timer são ignorados, o seletor só redesenha quando algo muda).
  *
  * @return Um `std::optional<ResolutionConfig>` contendo a configuração selecionada
  * se o usuário escolher uma opção, ou `std::nullopt` se a janela for fechada
  * ou a seleção for cancelada (ex: ESC).
  */
-std::optional<ResolutionConfig> showResolutionSelector() {
-    // Inicializa os módulos básicos do Allegro. Se falhar, retorna nullopt.
-    if (!al_init()) {
-        fprintf(stderr, "Falha ao inicializar Allegro\n");
-        return std::nullopt;
-    }
-    // Instala os add-ons de mouse, teclado, fonte e primitivas.
-    al_install_mouse();
-    al_install_keyboard();
-    al_init_font_addon();
-    al_init_ttf_addon();
-    al_init_primitives_addon();
-
-    // Cria um display temporário para a tela de seleção de resolução.
-    // As dimensões são fixas para esta tela.
-    ALLEGRO_DISPLAY* disp = al_create_display(600, 550);
-    if (!disp) {
-        fprintf(stderr, "Falha ao criar display\n");
+std::optional<ResolutionConfig> showResolutionSelector(ALLEGRO_DISPLAY* disp, ALLEGRO_EVENT_QUEUE* queue,
+                                                       ALLEGRO_FONT* font, const ResolutionConfig& atual) {
+    if (!disp || !queue || !font) {
+        fprintf(stderr, "Seletor de resolucao sem display, fila ou fonte\n");
         return std::nullopt;
     }
 
-    // Carrega a fonte para o texto das opções.
-    ALLEGRO_FONT* font = al_load_ttf_font("assets/editundo.ttf", 20, 0);
-    if (!font) {
-        fprintf(stderr, "Falha ao carregar fonte\n");
-        al_destroy_display(disp); // Destrói o display antes de sair
-        return std::nullopt;
-    }
-
-    // Cria a fila de eventos e o timer para a renderização.
-    ALLEGRO_EVENT_QUEUE* queue = al_create_event_queue();
-    ALLEGRO_TIMER* timer = al_create_timer(1.0 / 60); // Timer para 60 FPS
-
-    // Registra as fontes de eventos relevantes.
-    al_register_event_source(queue, al_get_mouse_event_source());
-    al_register_event_source(queue, al_get_keyboard_event_source());
-    al_register_event_source(queue, al_get_display_event_source(disp));
-    al_register_event_source(queue, al_get_timer_event_source(timer));
+    // Volta o display para uma janela comum do tamanho do seletor.
+    al_set_display_flag(disp, ALLEGRO_FULLSCREEN_WINDOW, false);
+    al_set_display_flag(disp, ALLEGRO_FRAMELESS, false);
+    al_resize_display(disp, SELETOR_W, SELETOR_H);
+    al_set_target_backbuffer(disp);
 
     // Define as opções de resolução disponíveis.
     std::vector<Option> options = {
@@ -93,12 +71,16 @@ std::optional<ResolutionConfig> showResolutionSelector() {
         options[i].h = 40;
     }
 
-    int selected = 0; // Índice da opção atualmente selecionada (padrão: primeira)
+    int selected = 0; // Índice da opção atualmente selecionada (padrão: a que está em uso)
+    for (size_t i = 0; i < options.size(); ++i) {
+        if (options[i].config.width == atual.width && options[i].config.height == atual.height &&
+            options[i].config.mode == atual.mode) {
+            selected = static_cast<int>(i);
+        }
+    }
     bool running = true; // Flag para controlar o loop principal da tela de seleção
     bool redraw = true; // Flag para indicar se a tela precisa ser redesenhada
-    ResolutionConfig chosen = options[0].config; // Configuração escolhida pelo usuário (padrão: primeira opção)
-
-    al_start_timer(timer); // Inicia o timer
+    ResolutionConfig chosen = options[selected].config; // Configuração escolhida pelo usuário
 
     // Loop principal da tela de seleção de resolução
     while (running) {
@@ -156,8 +138,14 @@ std::optional<ResolutionConfig> showResolutionSelector() {
                 }
                 break;
 
-            case ALLEGRO_EVENT_TIMER:
-                redraw = true; // O timer força o redesenho para a animação (se houver, como o hover)
+            case ALLEGRO_EVENT_DISPLAY_RESIZE:
+                al_acknowledge_resize(disp); // Confirma o novo tamanho antes de redesenhar
+                redraw = true;
+                break;
+
+            case ALLEGRO_EVENT_DISPLAY_EXPOSE:
+            case ALLEGRO_EVENT_DISPLAY_SWITCH_IN:
+                redraw = true; // A janela foi descoberta: o conteúdo precisa ser refeito
                 break;
         }
 
@@ -181,12 +169,6 @@ std::optional<ResolutionConfig> showResolutionSelector() {
         }
     }
 
-    // Limpeza: destrói os recursos do Allegro antes de sair da função.
-    al_destroy_font(font);
-    al_destroy_timer(timer);
-    al_destroy_event_queue(queue);
-    al_destroy_display(disp);
-
     // Retorna nullopt se o usuário fechou a janela ou cancelou a seleção.
     if (chosen.width == -1 || chosen.height == -1)
         return std::nullopt;
@@ -0,0 +1,195 @@
+/**
+ * @file SaveQueue.cpp
+ * @brief SaveQueueimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "SaveQueue.hpp"
+#include "FileLock.hpp"     // Para acrescentar sem atrapalhar os outros jogos que usam o arquivo
+#include "MatchJournal.hpp" // Para sincronizarArquivo (fflush + fsync)
+#include <algorithm>        // Para std::max
+#include <cstdio>           // Para acrescentar com FILE*
+#include <filesystem>       // Para criar a pasta dos arquivos
+#include <iostream>         // Para mensagens de aviso
+#include <iterator>         // Para std::make_move_iterator (tarefas tiradas da fila)
+
+/**
+ * @brief Construtor da classe SaveQueue.
+ */
+SaveQueue::SaveQueue(size_t limiteBytes, int esperaGrupoMs)
+    : limiteBytes(limiteBytes), esperaGrupoMs(esperaGrupoMs), bytesNaFila(0), gravando(false), encerrando(false),
+      mutex(al_create_mutex()), haTarefas(al_create_cond()), filaLivre(al_create_cond()), escritor(nullptr),
+      semThread(false)
+{
+    if (!mutex || !haTarefas || !filaLivre) {
+        std::cerr << "AVISO: Nao foi possivel criar a sincronizacao da fila de gravacao. Gravando na thread do jogo.\n";
+        semThread = true;
+    }
+}
+
+/**
+ * @brief Destrutor da classe SaveQueue. A thread grava o resto da fila antes de sair.
+ */
+SaveQueue::~SaveQueue() {
+    if (escritor) {
+        al_lock_mutex(mutex);
+        encerrando = true;
+        al_signal_cond(haTarefas);
+        al_unlock_mutex(mutex);
+        al_join_thread(escritor, nullptr);
+        al_destroy_thread(escritor);
+    }
+    if (filaLivre) al_destroy_cond(filaLivre);
+    if (haTarefas) al_destroy_cond(haTarefas);
+    if (mutex) al_destroy_mutex(mutex);
+}
+
+/**
+ * @brief Entrega bytes para a thread acrescentar a um arquivo.
+ */
+void SaveQueue::acrescentar(const std::string& caminho, std::vector<unsigned char> dados) {
+    Tarefa tarefa;
+    tarefa.caminho = caminho;
+    tarefa.dados = std::move(dados);
+    tarefa.entrada = Relogio::now();
+
+    if (!semThread) {
+        al_lock_mutex(mutex);
+        if (!escritor) {
+            escritor = al_create_thread(&SaveQueue::executarEscritor, this);
+            if (escritor) {
+                al_start_thread(escritor);
+            } else {
+                std::cerr << "AVISO: Nao foi possivel criar a thread de gravacao. Gravando na thread do jogo.\n";
+                semThread = true;
+                al_unlock_mutex(mutex);
+            }
+        }
+    }
+    if (semThread) {
+        // Sem thread: grava na hora (a latência continua sendo medida)
+        std::vector<Tarefa> lote(1, std::move(tarefa));
+        int falhas = gravarLote(lote);
+        double ms = std::chrono::duration<double, std::milli>(Relogio::now() - lote[0].entrada).count();
+        if (mutex) al_lock_mutex(mutex);
+        ++estatisticas.tarefas;
+        ++estatisticas.lotes;
+        estatisticas.falhas += falhas;
+        estatisticas.ultimaLatenciaMs = ms;
+        estatisticas.maiorLatenciaMs = std::max(estatisticas.maiorLatenciaMs, ms);
+        if (mutex) al_unlock_mutex(mutex);
+        return;
+    }
+
+    // Fila cheia: espera a thread pegar o que está nela (uma gravação maior que o limite entra sozinha)
+    if (!fila.empty() && bytesNaFila + tarefa.dados.size() > limiteBytes) {
+        ++estatisticas.esperas;
+        while (!fila.empty() && bytesNaFila + tarefa.dados.size() > limiteBytes) {
+            al_wait_cond(filaLivre, mutex);
+        }
+    }
+    bytesNaFila += tarefa.dados.size();
+    fila.push_back(std::move(tarefa));
+    ++estatisticas.tarefas;
+    al_signal_cond(haTarefas);
+    al_unlock_mutex(mutex);
+}
+
+/**
+ * @brief Espera a fila esvaziar e o último lote terminar.
+ */
+void SaveQueue::descarregar() {
+    if (!escritor) return; // Sem thread, tudo já foi gravado na hora
+    al_lock_mutex(mutex);
+    while (!fila.empty() || gravando) {
+        al_wait_cond(filaLivre, mutex);
+    }
+    al_unlock_mutex(mutex);
+}
+
+/**
+ * @brief Retorna uma cópia dos contadores.
+ */
+SaveQueue::Estatisticas SaveQueue::getEstatisticas() const {
+    if (mutex) al_lock_mutex(mutex);
+    Estatisticas copia = estatisticas;
+    if (mutex) al_unlock_mutex(mutex);
+    return copia;
+}
+
+/**
+ * @brief Grava um lote, juntando as tarefas seguidas do mesmo arquivo.
+ * @return Quantas tarefas falharam.
+ */
+int SaveQueue::gravarLote(const std::vector<Tarefa>& lote) {
+    int falhas = 0;
+    size_t i = 0;
+    while (i < lote.size()) {
+        size_t fim = i + 1;
+        while (fim < lote.size() && lote[fim].caminho == lote[i].caminho) ++fim;
+
+        // Garante que o diretório do arquivo exista
+        std::error_code erro;
+        std::filesystem::create_directories(std::filesystem::path(lote[i].caminho).parent_path(), erro);
+
+        // Com a trava exclusiva do arquivo, os blocos de outro jogo nunca se misturam com estes
+        FileLock trava;
+        bool ok = trava.abrir(lote[i].caminho + ".lock") && trava.travar(FileLock::EXCLUSIVA);
+        FILE* arq = ok ? fopen(lote[i].caminho.c_str(), "ab") : nullptr;
+        ok = arq != nullptr;
+        for (size_t k = i; ok && k < fim; ++k) {
+            ok = fwrite(lote[k].dados.data(), 1, lote[k].dados.size(), arq) == lote[k].dados.size();
+        }
+        if (arq) {
+            ok = MatchJournal::sincronizarArquivo(arq) && ok; // Um fsync para todas as tarefas do arquivo
+            ok = fclose(arq) == 0 && ok;
+        }
+        if (!ok) {
+            std::cerr << "Erro: falha ao gravar " << (fim - i) << " bloco(s) em " << lote[i].caminho << "\n";
+            falhas += (int)(fim - i);
+        }
+        i = fim;
+    }
+    return falhas;
+}
+
+/**
+ * @brief Laço da thread de gravação: espera a primeira tarefa, espera um pouco para a
+ * rajada terminar de chegar e grava tudo o que estiver na fila de uma vez.
+ */
+void* SaveQueue::executarEscritor(ALLEGRO_THREAD* thread, void* arg) {
+    SaveQueue* self = static_cast<SaveQueue*>(arg);
+
+    al_lock_mutex(self->mutex);
+    while (true) {
+        while (self->fila.empty() && !self->encerrando) {
+            al_wait_cond(self->haTarefas, self->mutex);
+        }
+        if (self->fila.empty()) break; // Encerrando e sem nada pendente
+
+        self->gravando = true;
+        if (!self->encerrando && self->esperaGrupoMs > 0) {
+            al_unlock_mutex(self->mutex);
+            al_rest(self->esperaGrupoMs / 1000.0); // As gravações que chegarem agora vão no mesmo lote
+            al_lock_mutex(self->mutex);
+        }
+        std::vector<Tarefa> lote(std::make_move_iterator(self->fila.begin()), std::make_move_iterator(self->fila.end()));
+        self->fila.clear();
+        self->bytesNaFila = 0;
+        al_broadcast_cond(self->filaLivre); // Quem esperava espaço pode entregar
+        al_unlock_mutex(self->mutex);
+
+        int falhas = gravarLote(lote);
+        double ms = std::chrono::duration<double, std::milli>(Relogio::now() - lote.front().entrada).count();
+
+        al_lock_mutex(self->mutex);
+        self->gravando = false;
+        ++self->estatisticas.lotes;
+        self->estatisticas.falhas += falhas;
+        self->estatisticas.ultimaLatenciaMs = ms;
+        self->estatisticas.maiorLatenciaMs = std::max(self->estatisticas.maiorLatenciaMs, ms);
+        al_broadcast_cond(self->filaLivre); // Para `descarregar`
+    }
+    al_unlock_mutex(self->mutex);
+    return nullptr;
+}
@@ -0,0 +1,399 @@
+/**
+ * @file ScaledAssetCache.cpp
+ * @brief ScaledAssetCacheimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "ScaledAssetCache.hpp"
+#include "Lz4Block.hpp" // Compressão dos pixels gravados no cache
+#include <allegro5/allegro_memfile.h> // Para decodificar o original a partir dos bytes já lidos
+#include <algorithm>  // Para std::max/std::min
+#include <chrono>     // Para medir o tempo de cada imagem
+#include <cmath>      // Para std::ceil e std::floor
+#include <cstdio>     // Para snprintf (nome dos arquivos de cache)
+#include <cstring>    // Para memcpy
+#include <filesystem> // Para criar a pasta de cache e renomear arquivos
+#include <fstream>    // Para ler e gravar os arquivos
+#include <iostream>   // Para saída de avisos
+#include <iterator>   // Para std::istreambuf_iterator (leitura do arquivo inteiro)
+
+/// @brief Identificador no início de cada arquivo de cache.
+static const char CACHE_MAGICO[4] = {'T', 'D', 'S', 'C'};
+/// @brief Versão do formato do arquivo de cache (mudar invalida os caches antigos).
+static const uint32_t CACHE_VERSAO = 3;
+/// @brief Tamanho do cabeçalho: identificador, versão, largura, altura, compressão e tamanho dos dados.
+static const size_t CACHE_CABECALHO = 24;
+/// @brief Pixels gravados como estão.
+static const uint32_t COMPRESSAO_NENHUMA = 0;
+/// @brief Pixels gravados como um bloco LZ4.
+static const uint32_t COMPRESSAO_LZ4 = 1;
+
+/**
+ * @brief Construtor da classe ScaledAssetCache.
+ * @param diretorio Pasta onde os arquivos de cache são gravados.
+ * @param pacote Pacote de onde os originais são lidos (pode ser nulo).
+ */
+ScaledAssetCache::ScaledAssetCache(const std::string& diretorio, const AssetArchive* pacote)
+    : diretorio(diretorio), pacote(pacote), acertos(0), geradas(0), usAcertos(0), usGeradas(0)
+{
+    std::error_code erro;
+    std::filesystem::create_directories(diretorio, erro);
+    if (erro) {
+        std::cerr << "AVISO: Nao foi possivel criar a pasta de cache " << diretorio << ": " << erro.message() << "\n";
+    }
+}
+
+/**
+ * @brief Calcula o hash FNV-1a de 64 bits.
+ * @return O hash dos bytes informados.
+ */
+uint64_t ScaledAssetCache::hashFnv1a(const unsigned char* dados, size_t tamanho) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < tamanho; ++i) {
+        hash ^= dados[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Carrega uma imagem reduzida para preencher a tela.
+ * @return O bitmap redimensionado, ou nullptr em caso de falha.
+ */
+ALLEGRO_BITMAP* ScaledAssetCache::carregarPreenchendo(const std::string& caminho, int telaW, int telaH) {
+    Pixels pixels;
+    if (!prepararPreenchendo(caminho, telaW, telaH, pixels)) return nullptr;
+    return criarBitmap(pixels);
+}
+
+/**
+ * @brief Carrega uma imagem reduzida por um fator fixo.
+ * @return O bitmap redimensionado, ou nullptr em caso de falha.
+ */
+ALLEGRO_BITMAP* ScaledAssetCache::carregarComEscala(const std::string& caminho, float escala) {
+    Pixels pixels;
+    if (!prepararComEscala(caminho, escala, pixels)) return nullptr;
+    return criarBitmap(pixels);
+}
+
+/**
+ * @brief Prepara os pixels de uma imagem reduzida para preencher a tela.
+ * @return true se a imagem foi preparada.
+ */
+bool ScaledAssetCache::prepararPreenchendo(const std::string& caminho, int telaW, int telaH, Pixels& saida) {
+    char sufixo[48];
+    snprintf(sufixo, sizeof(sufixo), "fill%dx%d", telaW, telaH);
+    return preparar(caminho, sufixo, telaW, telaH, 1.0f, saida);
+}
+
+/**
+ * @brief Prepara os pixels de uma imagem reduzida por um fator fixo.
+ * @return true se a imagem foi preparada.
+ */
+bool ScaledAssetCache::prepararComEscala(const std::string& caminho, float escala, Pixels& saida) {
+    char sufixo[48];
+    snprintf(sufixo, sizeof(sufixo), "scale%d", static_cast<int>(escala * 10000.0f + 0.5f));
+    return preparar(caminho, sufixo, 0, 0, escala, saida);
+}
+
+/**
+ * @brief Lê a imagem do cache em disco ou, se não houver, gera a versão reduzida.
+ *
+ * O arquivo original é sempre lido para calcular o hash (é bem mais barato que
+ * decodificar o PNG); só quando o cache não existe a imagem é decodificada e reduzida,
+ * a partir dos mesmos bytes. Com o pacote de assets, os bytes são os do mapeamento,
+ * sem cópia nem leitura de arquivo.
+ * Nada aqui toca a placa de vídeo, então várias threads podem preparar imagens ao mesmo tempo.
+ *
+ * @return true se a imagem foi preparada.
+ */
+bool ScaledAssetCache::preparar(const std::string& caminho, const std::string& sufixoChave,
+                                int telaW, int telaH, float escala, Pixels& saida) {
+    auto inicio = std::chrono::steady_clock::now();
+    auto microssegundos = [&inicio]() {
+        return (long long)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - inicio).count();
+    };
+
+    // Bytes do original: do pacote, se estiver nele, ou do arquivo solto lido inteiro
+    const unsigned char* dados = nullptr;
+    size_t tamanho = 0;
+    std::vector<unsigned char> bytesSoltos;
+    if (!pacote || !pacote->obter(caminho, dados, tamanho)) {
+        std::ifstream entrada(caminho, std::ios::binary);
+        if (!entrada.is_open()) {
+            std::cerr << "Erro ao abrir o asset " << caminho << ".\n";
+            return false;
+        }
+        bytesSoltos.assign(std::istreambuf_iterator<char>(entrada), std::istreambuf_iterator<char>());
+        dados = bytesSoltos.data();
+        tamanho = bytesSoltos.size();
+    }
+
+    char nome[64];
+    snprintf(nome, sizeof(nome), "%016llx_", static_cast<unsigned long long>(hashFnv1a(dados, tamanho)));
+    std::string arquivoCache = (std::filesystem::path(diretorio) / (std::string(nome) + sufixoChave + ".bin")).string();
+
+    // Caso rápido: a versão reduzida já existe em disco
+    if (lerCache(arquivoCache, saida)) {
+        ++acertos;
+        usAcertos += microssegundos();
+        return true;
+    }
+
+    // Decodifica o original como bitmap de memória (os parâmetros de novo bitmap são por thread).
+    // Sem ALLEGRO_NO_PREMULTIPLIED_ALPHA, a cor vem multiplicada pelo alpha, como `reamostrar` espera
+    ALLEGRO_STATE estado;
+    al_store_state(&estado, ALLEGRO_STATE_NEW_BITMAP_PARAMETERS);
+    al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+    ALLEGRO_FILE* arquivo = al_open_memfile(const_cast<unsigned char*>(dados), (int64_t)tamanho, "r");
+    size_t ponto = caminho.find_last_of('.');
+    ALLEGRO_BITMAP* original = arquivo ? al_load_bitmap_f(arquivo, ponto == std::string::npos ? "" : caminho.c_str() + ponto) : nullptr;
+    if (arquivo) al_fclose(arquivo);
+    al_restore_state(&estado);
+    if (!original) {
+        return false;
+    }
+
+    int larguraOrigem = al_get_bitmap_width(original);
+    int alturaOrigem = al_get_bitmap_height(original);
+
+    // Calcula o tamanho final em pixels inteiros (arredondando para cima no modo preencher,
+    // para que a imagem nunca fique menor que a tela)
+    int larguraDestino, alturaDestino;
+    if (telaW > 0 && telaH > 0) {
+        float s = std::max(telaW / (float)larguraOrigem, telaH / (float)alturaOrigem);
+        larguraDestino = static_cast<int>(std::ceil(larguraOrigem * s - 0.01f));
+        alturaDestino = static_cast<int>(std::ceil(alturaOrigem * s - 0.01f));
+    } else {
+        larguraDestino = static_cast<int>(larguraOrigem * escala + 0.5f);
+        alturaDestino = static_cast<int>(alturaOrigem * escala + 0.5f);
+    }
+    larguraDestino = std::max(1, larguraDestino);
+    alturaDestino = std::max(1, alturaDestino);
+
+    // Copia os pixels do original para um buffer RGBA contínuo
+    std::vector<unsigned char> pixels((size_t)larguraOrigem * alturaOrigem * 4);
+    ALLEGRO_LOCKED_REGION* regiao = al_lock_bitmap(original, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_READONLY);
+    if (!regiao) {
+        std::cerr << "AVISO: Nao foi possivel ler os pixels de " << caminho << ".\n";
+        al_destroy_bitmap(original);
+        return false;
+    }
+    for (int y = 0; y < alturaOrigem; ++y) {
+        memcpy(&pixels[(size_t)y * larguraOrigem * 4],
+               static_cast<unsigned char*>(regiao->data) + (ptrdiff_t)y * regiao->pitch,
+               (size_t)larguraOrigem * 4);
+    }
+    al_unlock_bitmap(original);
+    al_destroy_bitmap(original);
+
+    saida.rgba = reamostrar(pixels, larguraOrigem, alturaOrigem, larguraDestino, alturaDestino);
+    saida.largura = larguraDestino;
+    saida.altura = alturaDestino;
+    gravarCache(arquivoCache, saida.rgba, larguraDestino, alturaDestino);
+    ++geradas;
+    usGeradas += microssegundos();
+    return true;
+}
+
+/**
+ * @brief Lê um arquivo de cache.
+ * Os pixels vêm em uma única leitura depois do cabeçalho: direto para a saída quando
+ * não há compressão, ou para um buffer que é descomprimido para a saída.
+ * @return false se o arquivo não existir ou estiver inválido.
+ */
+bool ScaledAssetCache::lerCache(const std::string& arquivo, Pixels& saida) {
+    std::ifstream entrada(arquivo, std::ios::binary);
+    if (!entrada.is_open()) return false;
+
+    unsigned char cabecalho[CACHE_CABECALHO];
+    entrada.read(reinterpret_cast<char*>(cabecalho), CACHE_CABECALHO);
+    if (!entrada || memcmp(cabecalho, CACHE_MAGICO, 4) != 0) return false;
+
+    uint32_t campos[5]; // versão, largura, altura, compressão, tamanho dos dados
+    memcpy(campos, cabecalho + 4, sizeof(campos));
+    uint32_t versao = campos[0], largura = campos[1], altura = campos[2];
+    uint32_t compressao = campos[3], tamanhoDados = campos[4];
+    if (versao != CACHE_VERSAO || largura == 0 || altura == 0 || largura > 16384 || altura > 16384) {
+        return false; // Arquivo corrompido ou de outra versão: será regenerado
+    }
+
+    size_t tamanhoPixels = (size_t)largura * altura * 4;
+    if (compressao == COMPRESSAO_NENHUMA) {
+        if (tamanhoDados != tamanhoPixels) return false;
+        saida.rgba.resize(tamanhoPixels);
+        entrada.read(reinterpret_cast<char*>(saida.rgba.data()), (std::streamsize)tamanhoPixels);
+        if (!entrada) return false;
+    } else if (compressao == COMPRESSAO_LZ4) {
+        if (tamanhoDados == 0 || tamanhoDados > tamanhoPixels + tamanhoPixels / 255 + 16) return false;
+        std::vector<unsigned char> comprimido(tamanhoDados);
+        entrada.read(reinterpret_cast<char*>(comprimido.data()), (std::streamsize)tamanhoDados);
+        if (!entrada) return false;
+        saida.rgba.resize(tamanhoPixels);
+        if (!Lz4Block::descomprimir(comprimido.data(), comprimido.size(), saida.rgba.data(), tamanhoPixels)) {
+            std::cerr << "AVISO: Cache " << arquivo << " corrompido. Gerando de novo.\n";
+            return false;
+        }
+    } else {
+        return false;
+    }
+
+    saida.largura = (int)largura;
+    saida.altura = (int)altura;
+    return true;
+}
+
+/**
+ * @brief Grava os pixels em um arquivo de cache, comprimidos com LZ4 quando isso economiza ao menos 1/4.
+ * Grava primeiro em um arquivo temporário e depois renomeia, para nunca deixar um cache pela metade.
+ * O temporário tem um número único porque duas threads podem gravar a mesma chave (assets repetidos).
+ */
+void ScaledAssetCache::gravarCache(const std::string& arquivo, const std::vector<unsigned char>& pixels, int largura, int altura) {
+    // Fundos com degradês e ruído quase não comprimem; aí não vale pagar a descompressão
+    std::vector<unsigned char> comprimido = Lz4Block::comprimir(pixels.data(), pixels.size());
+    bool usarLz4 = comprimido.size() <= pixels.size() / 4 * 3;
+    const std::vector<unsigned char>& dados = usarLz4 ? comprimido : pixels;
+
+    static std::atomic<unsigned> sequencia(0);
+    std::string temporario = arquivo + "." + std::to_string(sequencia++) + ".tmp";
+    {
+        std::ofstream saida(temporario, std::ios::binary | std::ios::trunc);
+        if (!saida.is_open()) {
+            std::cerr << "AVISO: Nao foi possivel gravar o cache " << arquivo << ".\n";
+            return;
+        }
+        uint32_t campos[5] = {CACHE_VERSAO, (uint32_t)largura, (uint32_t)altura,
+                              usarLz4 ? COMPRESSAO_LZ4 : COMPRESSAO_NENHUMA, (uint32_t)dados.size()};
+        saida.write(CACHE_MAGICO, 4);
+        saida.write(reinterpret_cast<const char*>(campos), sizeof(campos));
+        saida.write(reinterpret_cast<const char*>(dados.data()), (std::streamsize)dados.size());
+        if (!saida) {
+            std::cerr << "AVISO: Falha ao gravar o cache " << arquivo << ".\n";
+            return;
+        }
+    }
+
+    std::error_code erro;
+    std::filesystem::rename(temporario, arquivo, erro);
+    if (erro) {
+        std::cerr << "AVISO: Nao foi possivel finalizar o cache " << arquivo << ": " << erro.message() << "\n";
+        std::filesystem::remove(temporario, erro);
+    }
+}
+
+/**
+ * @brief Cria um bitmap (com os parâmetros atuais, normalmente de vídeo) a partir de pixels preparados.
+ * @return O bitmap criado, ou nullptr em caso de falha.
+ */
+ALLEGRO_BITMAP* ScaledAssetCache::criarBitmap(const Pixels& pixels) {
+    if (pixels.largura <= 0 || pixels.altura <= 0) return nullptr;
+
+    ALLEGRO_BITMAP* bitmap = al_create_bitmap(pixels.largura, pixels.altura);
+    if (!bitmap) return nullptr;
+
+    ALLEGRO_LOCKED_REGION* regiao = al_lock_bitmap(bitmap, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_WRITEONLY);
+    if (!regiao) {
+        al_destroy_bitmap(bitmap);
+        return nullptr;
+    }
+    if (regiao->pitch == pixels.largura * 4) {
+        memcpy(regiao->data, pixels.rgba.data(), pixels.rgba.size()); // Linhas contínuas: uma cópia só
+    } else {
+        for (int y = 0; y < pixels.altura; ++y) {
+            memcpy(static_cast<unsigned char*>(regiao->data) + (ptrdiff_t)y * regiao->pitch,
+                   &pixels.rgba[(size_t)y * pixels.largura * 4], (size_t)pixels.largura * 4);
+        }
+    }
+    al_unlock_bitmap(bitmap);
+    return bitmap;
+}
+
+/**
+ * @brief Calcula, para um eixo, quais pixels de origem cada pixel de destino cobre e com que peso.
+ *
+ * O pixel de destino i cobre o intervalo [i * razao, (i + 1) * razao) da origem; cada
+ * pixel de origem contribui proporcionalmente à parte desse intervalo que ele ocupa.
+ */
+static void calcularPesos(int tamanhoOrigem, int tamanhoDestino,
+                          std::vector<int>& inicio, std::vector<int>& quantidade, std::vector<float>& pesos) {
+    double razao = (double)tamanhoOrigem / tamanhoDestino;
+    inicio.assign(tamanhoDestino, 0);
+    quantidade.assign(tamanhoDestino, 0);
+    pesos.clear();
+
+    for (int i = 0; i < tamanhoDestino; ++i) {
+        double a = i * razao;
+        double b = std::min((double)tamanhoOrigem, (i + 1) * razao);
+        int primeiro = (int)std::floor(a);
+        int ultimo = std::min(tamanhoOrigem - 1, (int)std::ceil(b) - 1);
+        if (ultimo < primeiro) ultimo = primeiro;
+
+        inicio[i] = primeiro;
+        quantidade[i] = ultimo - primeiro + 1;
+        double total = b - a;
+        for (int s = primeiro; s <= ultimo; ++s) {
+            double cobertura = std::min(b, (double)s + 1) - std::max(a, (double)s);
+            pesos.push_back((float)(std::max(0.0, cobertura) / total));
+        }
+    }
+}
+
+/**
+ * @brief Redimensiona uma imagem RGBA com filtro de área, em duas passadas (horizontal e vertical).
+ * @return Os pixels redimensionados.
+ */
+std::vector<unsigned char> ScaledAssetCache::reamostrar(const std::vector<unsigned char>& origem,
+                                                        int larguraOrigem, int alturaOrigem,
+                                                        int larguraDestino, int alturaDestino) {
+    std::vector<int> inicioX, qtdX, inicioY, qtdY;
+    std::vector<float> pesosX, pesosY;
+    calcularPesos(larguraOrigem, larguraDestino, inicioX, qtdX, pesosX);
+    calcularPesos(alturaOrigem, alturaDestino, inicioY, qtdY, pesosY);
+
+    // Passada horizontal: (larguraOrigem x alturaOrigem) -> (larguraDestino x alturaOrigem).
+    // O Allegro entrega a cor já multiplicada pelo alpha, então os quatro canais têm o mesmo peso
+    std::vector<float> intermediario((size_t)larguraDestino * alturaOrigem * 4);
+    for (int y = 0; y < alturaOrigem; ++y) {
+        const unsigned char* linha = &origem[(size_t)y * larguraOrigem * 4];
+        float* saida = &intermediario[(size_t)y * larguraDestino * 4];
+        size_t p = 0;
+        for (int x = 0; x < larguraDestino; ++x) {
+            float r = 0, g = 0, b = 0, a = 0;
+            for (int k = 0; k < qtdX[x]; ++k, ++p) {
+                const unsigned char* px = linha + (size_t)(inicioX[x] + k) * 4;
+                float w = pesosX[p];
+                r += px[0] * w;
+                g += px[1] * w;
+                b += px[2] * w;
+                a += px[3] * w;
+            }
+            saida[x * 4 + 0] = r;
+            saida[x * 4 + 1] = g;
+            saida[x * 4 + 2] = b;
+            saida[x * 4 + 3] = a;
+        }
+    }
+
+    // Passada vertical: (larguraDestino x alturaOrigem) -> (larguraDestino x alturaDestino)
+    std::vector<unsigned char> destino((size_t)larguraDestino * alturaDestino * 4);
+    std::vector<float> acumulado((size_t)larguraDestino * 4);
+    size_t p = 0;
+    for (int y = 0; y < alturaDestino; ++y) {
+        std::fill(acumulado.begin(), acumulado.end(), 0.0f);
+        for (int k = 0; k < qtdY[y]; ++k, ++p) {
+            const float* linha = &intermediario[(size_t)(inicioY[y] + k) * larguraDestino * 4];
+            float w = pesosY[p];
+            for (size_t i = 0; i < acumulado.size(); ++i) {
+                acumulado[i] += linha[i] * w;
+            }
+        }
+
+        // Volta para 8 bits, ainda pré-multiplicado (como o bitmap que vai receber os pixels)
+        unsigned char* saida = &destino[(size_t)y * larguraDestino * 4];
+        for (size_t i = 0; i < acumulado.size(); ++i) {
+            saida[i] = (unsigned char)std::min(255.0f, acumulado[i] + 0.5f);
+        }
+    }
+    return destino;
+}
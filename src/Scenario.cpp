@@ -5,6 +5,7 @@
 
 
 #include "Scenario.hpp"
+#include "RenderStats.hpp" // Contagem de desenhos para o HUD de depuração
 #include <allegro5/allegro_primitives.h> // Para desenhar formas primitivas (fallback)
 #include <random> // Para geração de números aleatórios
 #include <algorithm> // Para std::remove_if e std::max/min
@@ -56,6 +57,7 @@ Scenario::Scenario(ALLEGRO_BITMAP* bg, ALLEGRO_BITMAP* bird_bmp, ALLEGRO_BITMAP*
       somPoint(pointSound), // Atribui o som de ponto
       somDie(dieSound),     // Atribui o som de morte
       scoredPointFlag(false), // Flag para indicar se um ponto foi marcado neste frame
+      filaDesenho(static_cast<float>(screenW), static_cast<float>(screenH)), // Área visível para o descarte
       totalPipesSpawnedThisLevel(0) // Contador de canos gerados na fase atual
 {
     // Define as dimensões de design para calcular os fatores de escala.
@@ -337,7 +339,8 @@ void Scenario::update(float deltaTime) {
 
 /**
  * @brief Renderiza todos os elementos do cenário na tela.
- * Desenha o fundo, os canos e o pássaro, além da pontuação e mensagens de Game Over.
+ * Grava o fundo, os canos, o pássaro e a pontuação na lista do frame e a envia de uma vez;
+ * a mensagem de Game Over é desenhada por cima, direto.
  */
 void Scenario::render() {
     // Desenha o fundo do cenário
@@ -353,22 +356,24 @@ void Scenario::render() {
         float final_bg_width = bg_w * bg_scale_to_fill;
         float final_bg_height = bg_h * bg_scale_to_fill;
 
-        // Desenha duas cópias do fundo para criar um efeito de rolagem contínuo
-        al_draw_scaled_bitmap(background, 0, 0, bg_w, bg_h,
-                              backgroundScrollOffset, 0, final_bg_width, final_bg_height, 0);
-        al_draw_scaled_bitmap(background, 0, 0, bg_w, bg_h,
-                              backgroundScrollOffset + final_bg_width, 0, final_bg_width, final_bg_height, 0);
+        // Duas cópias do fundo criam o efeito de rolagem contínuo. A lista recorta cada uma
+        // à parte visível, então juntas cobrem a tela uma única vez.
+        filaDesenho.desenharEscalado(background, RenderQueue::CAMADA_FUNDO, 0, 0, bg_w, bg_h,
+                                     backgroundScrollOffset, 0, final_bg_width, final_bg_height);
+        filaDesenho.desenharEscalado(background, RenderQueue::CAMADA_FUNDO, 0, 0, bg_w, bg_h,
+                                     backgroundScrollOffset + final_bg_width, 0, final_bg_width, final_bg_height);
     } else {
         // Fallback: se o background for nulo, pinta a tela de preto
         al_clear_to_color(al_map_rgb(0, 0, 0));
+        RenderStats::registrarPrimitiva();
     }
 
-    // Renderiza todos os canos
+    // Grava todos os canos (os que estão fora da tela são descartados pela lista)
     for (auto& p : pipes) {
-        p.render();
+        p.render(filaDesenho);
     }
 
-    bird.render(); // Renderiza o pássaro
+    bird.render(filaDesenho); // Grava o pássaro
 
     // Exibe a pontuação na tela
     if (fontlarge) {
@@ -379,22 +384,28 @@ void Scenario::render() {
         ALLEGRO_COLOR corContorno = al_map_rgb(0, 0, 0); // Cor para o contorno do texto (sombra)
         ALLEGRO_COLOR corTexto = al_map_rgb(255, 255, 255); // Cor principal do texto
 
-        // Desenha o contorno do texto para dar mais destaque (efeito de sombra)
-        for (int dx = -3; dx <= 3; ++dx) {
-            for (int dy = -3; dy <= 3; ++dy) {
-                if (dx == 0 && dy == 0) continue; // Pula o centro
-                al_draw_text(fontlarge, corContorno, x + dx, y + dy, ALLEGRO_ALIGN_CENTER, pontuacao.c_str());
-            }
+        // A pontuação com contorno vem do cache: a string só é rasterizada novamente quando
+        // a pontuação muda. O bitmap pronto entra na lista como qualquer outro sprite.
+        float textoX = 0.0f, textoY = 0.0f;
+        ALLEGRO_BITMAP* textoBmp = textCache.obter(fontlarge, corTexto, corContorno, 3, x, y,
+                                                   ALLEGRO_ALIGN_CENTER, pontuacao, textoX, textoY);
+        if (textoBmp) {
+            float w = (float)al_get_bitmap_width(textoBmp);
+            float h = (float)al_get_bitmap_height(textoBmp);
+            filaDesenho.desenharEscalado(textoBmp, RenderQueue::CAMADA_HUD, 0, 0, w, h, textoX, textoY, w, h);
         }
-
-        // Desenha o texto principal da pontuação (branco centralizado)
-        al_draw_text(fontlarge, corTexto, x, y, ALLEGRO_ALIGN_CENTER, pontuacao.c_str());
     }
 
+    // Ordena por camada e textura e desenha tudo: o fundo, e os canos junto com o pássaro
+    // (que dividem o atlas), viram um lote cada.
+    filaDesenho.enviar();
+
     // Se o jogo acabou, exibe a mensagem de Game Over
     if (gameOver && fontlarge) {
         al_draw_text(fontlarge, al_map_rgb(255, 0, 0), SCREEN_W / 2, SCREEN_H / 2 - 20 * scale_y, ALLEGRO_ALIGN_CENTER, "GAME OVER");
         al_draw_text(fontlarge, al_map_rgb(255, 255, 255), SCREEN_W / 2, SCREEN_H / 2 + 20 * scale_y, ALLEGRO_ALIGN_CENTER, "Pressione ESC para voltar ao menu");
+        RenderStats::registrarPrimitiva();
+        RenderStats::registrarPrimitiva();
     }
 }
 
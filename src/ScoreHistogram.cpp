@@ -0,0 +1,190 @@
+/**
+ * @file ScoreHistogram.cpp
+ * @brief ScoreHistogramimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "ScoreHistogram.hpp"
+#include "MatchJournal.hpp" // Para sincronizarArquivo (fflush + fsync)
+#include <cstdio>           // Para ler e gravar com FILE*
+#include <cstring>          // Para memcpy e memcmp
+#include <filesystem>       // Para criar a pasta e renomear o arquivo temporário
+#include <iostream>         // Para mensagens de erro
+
+/// @brief Identificador no início do arquivo.
+static const char HISTOGRAMA_MAGICO[4] = {'T', 'D', 'S', 'H'};
+/// @brief Versão do formato (muda se a divisão dos baldes mudar).
+static const uint32_t HISTOGRAMA_VERSAO = 1;
+/// @brief Tamanho do cabeçalho: assinatura, versão, baldes, baldes não vazios e seq.
+static const size_t HISTOGRAMA_CABECALHO = 24;
+/// @brief Tamanho de cada balde gravado: índice (4 bytes) e contagem (8 bytes).
+static const size_t HISTOGRAMA_ENTRADA = 12;
+
+/**
+ * @brief Construtor da classe ScoreHistogram.
+ */
+ScoreHistogram::ScoreHistogram() : total(0) {
+    limpar();
+}
+
+/**
+ * @brief Zera as contagens e a árvore.
+ */
+void ScoreHistogram::limpar() {
+    contagens.assign(BALDES, 0);
+    arvore.assign(BALDES + 1, 0);
+    total = 0;
+}
+
+/**
+ * @brief Calcula o balde: exato abaixo de LIMITE_EXATO; acima, a potência de 2 e os
+ * 6 bits seguintes ao mais alto escolhem um dos SUBDIVISOES baldes dela.
+ */
+int ScoreHistogram::balde(int pontuacao) {
+    if (pontuacao < LIMITE_EXATO) return pontuacao < 0 ? 0 : pontuacao;
+    int expoente = 10; // 2^10 == LIMITE_EXATO
+    while ((pontuacao >> (expoente + 1)) != 0) ++expoente;
+    int sub = (pontuacao >> (expoente - 6)) & (SUBDIVISOES - 1);
+    return LIMITE_EXATO + (expoente - 10) * SUBDIVISOES + sub;
+}
+
+/**
+ * @brief Soma uma quantidade a um balde (contagem, árvore e total).
+ */
+void ScoreHistogram::somar(int indice, int64_t quantidade) {
+    contagens[indice] += (uint64_t)quantidade;
+    total += (uint64_t)quantidade;
+    for (int i = indice + 1; i <= BALDES; i += i & -i) {
+        arvore[i] += (uint64_t)quantidade;
+    }
+}
+
+/**
+ * @brief Conta uma pontuação.
+ */
+void ScoreHistogram::adicionar(int pontuacao) {
+    somar(balde(pontuacao), 1);
+}
+
+/**
+ * @brief Descarta uma pontuação (ignorada se o balde dela está vazio).
+ */
+void ScoreHistogram::remover(int pontuacao) {
+    int indice = balde(pontuacao);
+    if (contagens[indice] == 0) return;
+    somar(indice, -1);
+}
+
+/**
+ * @brief Soma os baldes anteriores ao da pontuação, descendo pela árvore.
+ */
+uint64_t ScoreHistogram::contarAbaixo(int pontuacao) const {
+    uint64_t soma = 0;
+    for (int i = balde(pontuacao); i > 0; i -= i & -i) {
+        soma += arvore[i];
+    }
+    return soma;
+}
+
+/**
+ * @brief Calcula a porcentagem abaixo de um valor.
+ */
+double ScoreHistogram::percentualAbaixo(int pontuacao) const {
+    if (total == 0) return 0.0;
+    return 100.0 * (double)contarAbaixo(pontuacao) / (double)total;
+}
+
+/**
+ * @brief Grava os baldes não vazios (o arquivo fica pequeno com poucas pontuações distintas).
+ */
+bool ScoreHistogram::gravar(const std::string& caminho, uint64_t seq) const {
+    uint32_t naoVazios = 0;
+    for (uint64_t c : contagens) naoVazios += c != 0;
+
+    std::vector<unsigned char> buffer(HISTOGRAMA_CABECALHO + (size_t)naoVazios * HISTOGRAMA_ENTRADA);
+    uint32_t baldes = BALDES;
+    memcpy(buffer.data(), HISTOGRAMA_MAGICO, 4);
+    memcpy(buffer.data() + 4, &HISTOGRAMA_VERSAO, 4);
+    memcpy(buffer.data() + 8, &baldes, 4);
+    memcpy(buffer.data() + 12, &naoVazios, 4);
+    memcpy(buffer.data() + 16, &seq, 8);
+    unsigned char* p = buffer.data() + HISTOGRAMA_CABECALHO;
+    for (uint32_t i = 0; i < (uint32_t)BALDES; ++i) {
+        if (contagens[i] == 0) continue;
+        memcpy(p, &i, 4);
+        memcpy(p + 4, &contagens[i], 8);
+        p += HISTOGRAMA_ENTRADA;
+    }
+
+    // Garante que o diretório exista
+    std::error_code erro;
+    std::filesystem::create_directories(std::filesystem::path(caminho).parent_path(), erro);
+
+    std::string temporario = caminho + ".tmp";
+    FILE* arq = fopen(temporario.c_str(), "wb");
+    if (!arq) {
+        std::cerr << "Erro: não foi possível salvar o histograma em " << caminho << "\n";
+        return false;
+    }
+    bool ok = fwrite(buffer.data(), 1, buffer.size(), arq) == buffer.size();
+    ok = MatchJournal::sincronizarArquivo(arq) && ok;
+    ok = fclose(arq) == 0 && ok;
+
+    if (ok) std::filesystem::rename(temporario, caminho, erro);
+    if (!ok || erro) {
+        std::cerr << "Erro: não foi possível salvar o histograma em " << caminho << "\n";
+        std::filesystem::remove(temporario, erro);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Lê um histograma gravado. Um arquivo inválido é ignorado com um aviso.
+ */
+bool ScoreHistogram::ler(const std::string& caminho, uint64_t& seq) {
+    limpar();
+    seq = 0;
+    FILE* arq = fopen(caminho.c_str(), "rb");
+    if (!arq) return false; // Ainda não existe
+
+    unsigned char cabecalho[HISTOGRAMA_CABECALHO];
+    bool ok = fread(cabecalho, 1, sizeof(cabecalho), arq) == sizeof(cabecalho);
+    uint32_t versao = 0, baldes = 0, naoVazios = 0;
+    uint64_t seqLida = 0;
+    if (ok) {
+        memcpy(&versao, cabecalho + 4, 4);
+        memcpy(&baldes, cabecalho + 8, 4);
+        memcpy(&naoVazios, cabecalho + 12, 4);
+        memcpy(&seqLida, cabecalho + 16, 8);
+        ok = memcmp(cabecalho, HISTOGRAMA_MAGICO, 4) == 0 && versao == HISTOGRAMA_VERSAO &&
+             baldes == (uint32_t)BALDES && naoVazios <= (uint32_t)BALDES;
+    }
+    std::vector<unsigned char> entradas(ok ? (size_t)naoVazios * HISTOGRAMA_ENTRADA : 0);
+    if (ok) ok = fread(entradas.data(), 1, entradas.size(), arq) == entradas.size();
+    fclose(arq);
+
+    for (size_t k = 0; ok && k < naoVazios; ++k) {
+        uint32_t indice = 0;
+        uint64_t contagem = 0;
+        memcpy(&indice, entradas.data() + k * HISTOGRAMA_ENTRADA, 4);
+        memcpy(&contagem, entradas.data() + k * HISTOGRAMA_ENTRADA + 4, 8);
+        if (indice >= (uint32_t)BALDES) { ok = false; break; }
+        contagens[indice] += contagem;
+        total += contagem;
+    }
+    if (!ok) {
+        limpar();
+        std::cerr << "AVISO: Histograma " << caminho << " invalido; as pontuacoes recomecam do diario.\n";
+        return false;
+    }
+
+    // Monta a árvore de uma vez, em O(BALDES): cada nó passa a soma dele para o pai
+    for (int i = 1; i <= BALDES; ++i) {
+        arvore[i] += contagens[i - 1];
+        int pai = i + (i & -i);
+        if (pai <= BALDES) arvore[pai] += arvore[i];
+    }
+    seq = seqLida;
+    return true;
+}
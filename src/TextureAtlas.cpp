@@ -0,0 +1,148 @@
+/**
+ * @file TextureAtlas.cpp
+ * @brief TextureAtlasimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "TextureAtlas.hpp"
+#include <algorithm> // Para std::sort e std::min/std::max
+#include <iostream>  // Para saída de avisos
+
+/**
+ * @brief Construtor da classe TextureAtlas.
+ * @param tamanhoMaximo Lado máximo de uma página.
+ * @param espacamento Pixels vazios entre sprites.
+ */
+TextureAtlas::TextureAtlas(int tamanhoMaximo, int espacamento)
+    : tamanhoMaximo(tamanhoMaximo > 0 ? tamanhoMaximo : 4096),
+      espacamento(espacamento >= 0 ? espacamento : 0)
+{
+}
+
+/**
+ * @brief Destrutor da classe TextureAtlas.
+ * Os sub-bitmaps são destruídos antes das páginas, como o Allegro exige.
+ */
+TextureAtlas::~TextureAtlas() {
+    for (ALLEGRO_BITMAP* sub : subBitmaps) {
+        al_destroy_bitmap(sub);
+    }
+    for (ALLEGRO_BITMAP* pagina : paginas) {
+        al_destroy_bitmap(pagina);
+    }
+    for (ALLEGRO_BITMAP* avulso : avulsos) {
+        al_destroy_bitmap(avulso);
+    }
+    // Sprites registrados mas nunca empacotados (construir() não foi chamado)
+    for (Item& item : itens) {
+        if (item.origem) al_destroy_bitmap(item.origem);
+    }
+}
+
+/**
+ * @brief Registra um sprite para ser empacotado.
+ * @param slot Endereço do ponteiro do bitmap.
+ */
+void TextureAtlas::adicionar(ALLEGRO_BITMAP** slot) {
+    if (!slot || !*slot) return;
+    itens.push_back({slot, *slot, -1, 0, 0});
+}
+
+/**
+ * @brief Empacota os sprites registrados em prateleiras.
+ *
+ * Os sprites são ordenados do mais alto para o mais baixo e colocados lado a lado;
+ * quando a linha enche, abre-se uma nova prateleira abaixo, e quando a página enche,
+ * abre-se uma nova página. Depois disso cada página é criada com o tamanho exato
+ * usado, os sprites são copiados e os ponteiros dos donos passam a apontar para os
+ * sub-bitmaps correspondentes.
+ */
+void TextureAtlas::construir() {
+    if (itens.empty()) return;
+
+    // Respeita o maior bitmap que a placa de vídeo aceita
+    int lado = tamanhoMaximo;
+    if (al_get_current_display()) {
+        int maximoDisplay = al_get_display_option(al_get_current_display(), ALLEGRO_MAX_BITMAP_SIZE);
+        if (maximoDisplay > 0) lado = std::min(lado, maximoDisplay);
+    }
+
+    // Ordena por altura decrescente (prateleiras mais bem aproveitadas)
+    std::vector<Item*> ordem;
+    for (Item& item : itens) ordem.push_back(&item);
+    std::sort(ordem.begin(), ordem.end(), [](const Item* a, const Item* b) {
+        return al_get_bitmap_height(a->origem) > al_get_bitmap_height(b->origem);
+    });
+
+    // Primeira passada: calcula a posição de cada sprite e o tamanho usado de cada página
+    std::vector<int> larguraPagina, alturaPagina;
+    int pagina = -1, cursorX = 0, cursorY = 0, alturaPrateleira = 0;
+    for (Item* item : ordem) {
+        int w = al_get_bitmap_width(item->origem);
+        int h = al_get_bitmap_height(item->origem);
+        if (w > lado || h > lado) continue; // Não cabe em página nenhuma: fica avulso
+
+        if (pagina >= 0 && cursorX + w > lado) { // Linha cheia: nova prateleira
+            cursorX = 0;
+            cursorY += alturaPrateleira + espacamento;
+            alturaPrateleira = 0;
+        }
+        if (pagina < 0 || cursorY + h > lado) { // Página cheia: nova página
+            ++pagina;
+            larguraPagina.push_back(0);
+            alturaPagina.push_back(0);
+            cursorX = cursorY = alturaPrateleira = 0;
+        }
+
+        item->pagina = pagina;
+        item->x = cursorX;
+        item->y = cursorY;
+        larguraPagina[pagina] = std::max(larguraPagina[pagina], cursorX + w);
+        alturaPagina[pagina] = std::max(alturaPagina[pagina], cursorY + h);
+        cursorX += w + espacamento;
+        alturaPrateleira = std::max(alturaPrateleira, h);
+    }
+
+    // Segunda passada: cria as páginas e copia os sprites
+    ALLEGRO_STATE estado;
+    al_store_state(&estado, ALLEGRO_STATE_TARGET_BITMAP | ALLEGRO_STATE_BLENDER);
+
+    std::vector<ALLEGRO_BITMAP*> criadas(larguraPagina.size(), nullptr);
+    for (size_t p = 0; p < criadas.size(); ++p) {
+        criadas[p] = al_create_bitmap(larguraPagina[p], alturaPagina[p]);
+        if (!criadas[p]) {
+            std::cerr << "AVISO: Nao foi possivel criar a pagina " << p << " do atlas ("
+                      << larguraPagina[p] << "x" << alturaPagina[p] << "). Sprites ficarao avulsos.\n";
+            continue;
+        }
+        al_set_target_bitmap(criadas[p]);
+        al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+        paginas.push_back(criadas[p]);
+    }
+
+    // Cópia direta dos pixels, sem misturar com o fundo transparente
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+    for (Item& item : itens) {
+        ALLEGRO_BITMAP* destino = item.pagina >= 0 ? criadas[item.pagina] : nullptr;
+        ALLEGRO_BITMAP* sub = nullptr;
+        if (destino) {
+            al_set_target_bitmap(destino);
+            al_draw_bitmap(item.origem, item.x, item.y, 0);
+            sub = al_create_sub_bitmap(destino, item.x, item.y,
+                                       al_get_bitmap_width(item.origem), al_get_bitmap_height(item.origem));
+        }
+
+        if (sub) {
+            subBitmaps.push_back(sub);
+            al_destroy_bitmap(item.origem);
+            *item.slot = sub;
+        } else {
+            // Sem página (grande demais ou falha): o bitmap original continua valendo
+            avulsos.push_back(item.origem);
+        }
+        item.origem = nullptr;
+    }
+    itens.clear();
+
+    al_restore_state(&estado);
+}
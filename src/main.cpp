@@ -5,33 +5,25 @@
 
 
 #include "GameEngine.hpp" // Inclui a classe principal do motor do jogo
-#include "ResolutionSelector.hpp" // Inclui a função para seleção de resolução
-#include <optional> // Para usar std::optional, que lida com valores que podem ou não estar presentes
-#include <iostream> // Para saída de console
+#include <string> // Para comparar os argumentos da linha de comando
 
 /**
  * @brief Função principal do programa.
+ * @param argc Quantidade de argumentos.
+ * @param argv Argumentos; `--benchmark` mede o tempo até o primeiro frame de jogo e fecha.
  * @return 0 se o programa finalizar com sucesso, outro valor em caso de erro.
  */
-int main() {
-    // Inicializa a biblioteca Allegro. Isso deve ser feito antes de qualquer função Allegro
-    al_init(); 
+int main(int argc, char* argv[]) {
+    // O GameEngine inicializa o Allegro uma única vez e mostra o seletor de resolução
+    // no próprio display; a resolução abaixo é a destacada no seletor ao abrir.
+    GameEngine engine(1280, 720, WINDOWED);
 
-    // Chama a função para exibir o seletor de resolução.
-    // std::optional é usado pois o usuário pode fechar a janela sem selecionar uma resolução.
-    auto res = showResolutionSelector();
+    // No modo benchmark, não há seletor nem menu: o jogo carrega, entra na partida e sai.
+    bool benchmark = argc > 1 && std::string(argv[1]) == "--benchmark";
+    engine.setModoBenchmark(benchmark);
 
-    // Verifica se o usuário fechou a janela ou apertou ESC no seletor de resolução
-    if (!res.has_value()) {
-        std::cout << "Resolução não selecionada. Encerrando o jogo.\n";
-        return 0; // Sai do programa
-    }
-
-    // Se uma resolução foi selecionada, cria uma instância do GameEngine
-    // com as dimensões e o modo de exibição escolhidos.
-    GameEngine engine(res->width, res->height, res->mode);
-    // Inicia o loop principal do jogo.
+    // Inicia o loop principal do jogo (que termina na hora se o seletor for fechado).
     engine.run();
 
     return 0; // Retorna 0 indicando que o programa terminou sem erros
-}
\ No newline at end of file
+}
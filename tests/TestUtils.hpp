@@ -0,0 +1,25 @@
+/**
+ * @file TestUtils.hpp
+ * @brief Utils dos testes do projeto Traveling Dragon.
+ */
+
+#ifndef TESTUTILS_HPP
+#define TESTUTILS_HPP
+
+#include <filesystem> // Para a pasta temporária dos testes
+#include <string>     // Para o nome da pasta
+
+/**
+ * @brief Prepara uma pasta temporária vazia para um teste, apagando a de uma execução anterior.
+ * @param nome Nome da pasta (dentro da pasta temporária do sistema).
+ * @param criar false para deixar a pasta sem criar (quando o teste confere que o código a cria).
+ * @return O caminho da pasta.
+ */
+inline std::filesystem::path pastaLimpa(const std::string& nome, bool criar = true) {
+    std::filesystem::path pasta = std::filesystem::temp_directory_path() / nome;
+    std::filesystem::remove_all(pasta);
+    if (criar) std::filesystem::create_directories(pasta);
+    return pasta;
+}
+
+#endif // TESTUTILS_HPP
@@ -0,0 +1,80 @@
+/**
+ * @file test_AssetArchive.cpp
+ * @brief test_AssetArchiveimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                   // Inclui o cabeçalho do Doctest.
+#include "../include/AssetArchive.hpp" // Pacote único de assets.
+#include <cstring>                     // Para memcmp.
+#include <filesystem>                  // Para criar a pasta temporária dos testes.
+#include <fstream>                     // Para gravar os arquivos de teste.
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Grava um arquivo de teste com o conteúdo dado.
+ * @param caminho Caminho do arquivo.
+ * @param conteudo Bytes do arquivo.
+ */
+static void gravar(const fs::path& caminho, const std::string& conteudo) {
+    std::ofstream out(caminho, std::ios::binary);
+    out << conteudo;
+}
+
+/**
+ * @brief Verifica se os arquivos empacotados são encontrados pelo nome, alinhados e com os mesmos bytes.
+ */
+TEST_CASE("Pacote devolve os assets pelo nome com os dados alinhados") {
+    fs::path temp = fs::temp_directory_path() / "td_pacote_teste";
+    fs::remove_all(temp);
+    fs::create_directories(temp / "assets" / "sons");
+    gravar(temp / "assets" / "pipe1.png", "cano");
+    gravar(temp / "assets" / "sons" / "jump.wav", std::string(100, 'j'));
+    gravar(temp / "assets" / "vazio.txt", "");
+
+    std::string caminhoPacote = (temp / "assets.tdpk").string();
+    CHECK(AssetArchive::construir((temp / "assets").string(), caminhoPacote) == 3);
+
+    AssetArchive pacote(caminhoPacote);
+    REQUIRE(pacote.isAberto());
+    CHECK(pacote.getNumeroEntradas() == 3);
+
+    const unsigned char* dados = nullptr;
+    size_t tamanho = 0;
+    REQUIRE(pacote.obter("assets/pipe1.png", dados, tamanho));
+    CHECK(tamanho == 4);
+    CHECK(memcmp(dados, "cano", 4) == 0);
+    CHECK(reinterpret_cast<uintptr_t>(dados) % AssetArchive::ALINHAMENTO == 0);
+
+    REQUIRE(pacote.obter("assets/sons/jump.wav", dados, tamanho)); // Subpastas usam '/'
+    CHECK(tamanho == 100);
+    CHECK(dados[99] == 'j');
+
+    CHECK(pacote.obter("assets/vazio.txt", dados, tamanho));
+    CHECK(tamanho == 0);
+
+    CHECK_FALSE(pacote.obter("assets/pipe2.png", dados, tamanho));
+    CHECK_FALSE(pacote.existe("assets/pipe2.png"));
+
+    fs::remove_all(temp);
+}
+
+/**
+ * @brief Verifica se um pacote ausente ou corrompido faz o jogo cair para os arquivos soltos.
+ */
+TEST_CASE("Pacote ausente ou invalido nao e aberto") {
+    fs::path temp = fs::temp_directory_path() / "td_pacote_invalido";
+    fs::remove_all(temp);
+    fs::create_directories(temp);
+
+    AssetArchive ausente((temp / "nao_existe.tdpk").string());
+    CHECK_FALSE(ausente.isAberto());
+
+    gravar(temp / "lixo.tdpk", "TDPK isto nao e um pacote");
+    AssetArchive invalido((temp / "lixo.tdpk").string());
+    CHECK_FALSE(invalido.isAberto());
+    CHECK(invalido.getNumeroEntradas() == 0);
+
+    fs::remove_all(temp);
+}
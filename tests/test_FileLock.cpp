@@ -0,0 +1,97 @@
+/**
+ * @file test_FileLock.cpp
+ * @brief test_FileLockimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                    // Inclui o cabeçalho do Doctest.
+#include "../include/FileLock.hpp"      // Trava de arquivo entre processos.
+#include "../include/PlayerManager.hpp" // Cadastro compartilhado por dois jogos.
+#include "TestUtils.hpp"                // Pasta temporária dos testes.
+#include <filesystem>                   // Para os caminhos dos arquivos
+
+/**
+ * @brief Verifica se duas travas do mesmo arquivo se excluem (uma exclusiva barra
+ * qualquer outra; as compartilhadas convivem) e se os bytes gravados nela são lidos.
+ */
+TEST_CASE("Trava de arquivo exclusiva e compartilhada") {
+    std::filesystem::path pasta = pastaLimpa("td_test_trava");
+    std::string caminho = (pasta / "players.lock").string();
+
+    {
+        FileLock a, b, c;
+        REQUIRE(a.abrir(caminho));
+        REQUIRE(b.abrir(caminho));
+        REQUIRE(c.abrir(caminho));
+
+        REQUIRE(a.travar(FileLock::EXCLUSIVA));
+        CHECK_FALSE(b.tentarTravar(FileLock::EXCLUSIVA));
+        CHECK_FALSE(b.tentarTravar(FileLock::COMPARTILHADA));
+        uint64_t valor = 1234567890123ull;
+        CHECK(a.gravar(&valor, sizeof(valor), false));
+        a.destravar();
+
+        CHECK(b.tentarTravar(FileLock::COMPARTILHADA));
+        CHECK(c.tentarTravar(FileLock::COMPARTILHADA)); // Leitores juntos
+        CHECK_FALSE(a.tentarTravar(FileLock::EXCLUSIVA));
+        uint64_t lido = 0;
+        CHECK(c.ler(&lido, sizeof(lido)));
+        CHECK(lido == valor);
+        b.destravar();
+        c.destravar();
+        CHECK(a.tentarTravar(FileLock::EXCLUSIVA));
+
+        FileLock vazio;
+        CHECK_FALSE(vazio.tentarTravar(FileLock::EXCLUSIVA)); // Sem arquivo aberto
+    }
+
+    std::filesystem::remove_all(pasta);
+}
+
+/**
+ * @brief Simula dois gabinetes usando o mesmo cadastro: partidas intercaladas, o mesmo
+ * apelido cadastrado pelos dois e uma compactação no meio. Nada se perde, as partidas
+ * somam, a maior pontuação é a maior dos dois e cada registro tem um número único.
+ */
+TEST_CASE("Dois jogos no mesmo cadastro juntam as partidas") {
+    std::filesystem::path pasta = pastaLimpa("td_test_compartilhado");
+    std::string arquivo = (pasta / "players.dat").string();
+
+    {
+        PlayerManager gabinete1(arquivo, MatchJournal::SYNC_NUNCA);
+        PlayerManager gabinete2(arquivo, MatchJournal::SYNC_SEMPRE);
+        gabinete1.carregar();
+        gabinete2.carregar();
+        PlayerManager::Id ana1 = gabinete1.cadastrar("Ana", "ana");
+        PlayerManager::Id ana2 = gabinete2.cadastrar("Ana_B", "ana"); // O mesmo apelido nos dois
+        PlayerManager::Id bia = gabinete2.cadastrar("Bia", "bia");
+        for (int i = 1; i <= 10; ++i) {
+            gabinete1.registrarPartida(ana1, i);
+            gabinete2.registrarPartida(ana2, 100 + i);
+            if (i == 5) {
+                gabinete2.compactar(); // Leva também as partidas do gabinete 1
+                gabinete2.aguardarCompactacao();
+            }
+        }
+        gabinete1.registrarPartida(ana1, 500);
+        gabinete2.registrarPartida(bia, 7);
+    }
+
+    std::vector<MatchJournal::Registro> registros;
+    MatchJournal::ler((pasta / "players.journal").string(), registros);
+    for (size_t i = 1; i < registros.size(); ++i) CHECK(registros[i].seq > registros[i - 1].seq);
+
+    PlayerManager recarregado(arquivo, MatchJournal::SYNC_NUNCA);
+    recarregado.carregar();
+    Player* ana = recarregado.buscar("ana");
+    REQUIRE(ana != nullptr);
+    CHECK(ana->getNome() == "Ana"); // O primeiro cadastro vale
+    CHECK(ana->getPartidas() == 21);
+    CHECK(ana->getMaiorPontuacao() == 500);
+    REQUIRE(recarregado.buscar("bia") != nullptr);
+    CHECK(recarregado.buscar("bia")->getPartidas() == 1);
+    CHECK(recarregado.getPontuacoesPartidas().getTotal() == 22);
+    CHECK(recarregado.getJogadores().size() == 2);
+
+    std::filesystem::remove_all(pasta);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file test_Leaderboard.cpp
+ * @brief test_Leaderboardimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                    // Inclui o cabeçalho do Doctest.
+#include "../include/Leaderboard.hpp"   // Ranking mantido em ordem.
+#include "../include/PlayerManager.hpp" // Ranking atualizado pelo cadastro.
+#include "TestUtils.hpp"                // Pasta temporária dos testes.
+#include <filesystem>                   // Para os caminhos dos arquivos
+
+/**
+ * @brief Verifica posições, primeiros colocados e recorde depois de inserções e mudanças
+ * de pontuação, incluindo empates (o Id menor fica na frente) e Ids pulados.
+ */
+TEST_CASE("Ranking mantido em ordem a cada mudanca de pontuacao") {
+    Leaderboard ranking;
+    CHECK(ranking.getRecorde() == 0);
+    CHECK(ranking.melhores(10).empty());
+
+    ranking.reconstruir({30, 10, 20});
+    ranking.atualizar(5, 20); // Ids 3 e 4 ficam fora do ranking
+    REQUIRE(ranking.getQuantidade() == 4);
+    CHECK_FALSE(ranking.contem(3));
+    CHECK(ranking.getPosicao(3) == 0);
+    CHECK(ranking.melhores(10) == std::vector<int32_t>{0, 2, 5, 1}); // Empate em 20: o Id 2 vem antes
+    CHECK(ranking.getRecorde() == 30);
+
+    ranking.atualizar(1, 50); // Do último para o primeiro
+    ranking.atualizar(0, 5);  // Do primeiro para o último
+    CHECK(ranking.getRecorde() == 50);
+    CHECK(ranking.getPosicao(1) == 1);
+    CHECK(ranking.getPosicao(0) == 4);
+    CHECK(ranking.getJogadorNaPosicao(2) == 2);
+    CHECK(ranking.getJogadorNaPosicao(5) == -1);
+    CHECK(ranking.listar(2, 10) == std::vector<int32_t>{2, 5, 0});
+    CHECK(ranking.getPontuacao(5) == 20);
+
+    // Muitos jogadores: cada posição devolve o jogador certo
+    Leaderboard grande;
+    for (int32_t id = 0; id < 2000; ++id) grande.atualizar(id, (id * 37) % 500);
+    size_t certas = 0;
+    for (size_t posicao = 1; posicao <= grande.getQuantidade(); ++posicao) {
+        certas += grande.getPosicao(grande.getJogadorNaPosicao(posicao)) == posicao;
+    }
+    CHECK(certas == 2000);
+    CHECK(grande.getRecorde() == 499);
+}
+
+/**
+ * @brief Verifica se o PlayerManager mantém o ranking nas partidas e o remonta ao recarregar.
+ */
+TEST_CASE("Ranking do cadastro acompanha as partidas e o recarregamento") {
+    std::filesystem::path pasta = pastaLimpa("td_test_ranking");
+    std::string arquivo = (pasta / "players.dat").string();
+
+    {
+        PlayerManager manager(arquivo, MatchJournal::SYNC_NUNCA);
+        manager.carregar();
+        PlayerManager::Id ana = manager.cadastrar("Ana", "ana");
+        PlayerManager::Id bia = manager.cadastrar("Bia", "bia");
+        PlayerManager::Id caio = manager.cadastrar("Caio", "caio");
+        CHECK(manager.getRanking().getQuantidade() == 3);
+        manager.registrarPartida(bia, 15);
+        manager.registrarPartida(ana, 8);
+        manager.registrarPartida(bia, 4); // Não bate o recorde pessoal: não muda de lugar
+        CHECK(manager.getRanking().getPosicao(bia) == 1);
+        CHECK(manager.getRanking().getPosicao(caio) == 3);
+        CHECK(manager.getRanking().getRecorde() == 15);
+    }
+
+    PlayerManager recarregado(arquivo, MatchJournal::SYNC_NUNCA);
+    recarregado.carregar();
+    const Leaderboard& ranking = recarregado.getRanking();
+    REQUIRE(ranking.getQuantidade() == 3);
+    CHECK(ranking.melhores(3) == std::vector<int32_t>{recarregado.buscarId("bia"), recarregado.buscarId("ana"),
+                                                     recarregado.buscarId("caio")});
+    CHECK(ranking.getRecorde() == 15);
+
+    std::filesystem::remove_all(pasta);
+}
@@ -0,0 +1,217 @@
+/**
+ * @file test_LeaderboardClient.cpp
+ * @brief test_LeaderboardClientimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                        // Inclui o cabeçalho do Doctest.
+#include "../include/LeaderboardClient.hpp" // Envio das partidas em outra thread.
+#include "../include/LeaderboardServer.hpp" // Serviço de ranking compartilhado.
+#include "TestUtils.hpp"                    // Pasta temporária dos testes.
+#include <filesystem>                       // Para os caminhos dos arquivos
+#include <fstream>                          // Para montar e conferir o arquivo do ranking
+#include <iterator>                         // Para ler o arquivo do ranking inteiro
+
+/**
+ * @brief Corpo da thread que roda o serviço até `parar`.
+ * @param thread A thread atual (não usada).
+ * @param arg Ponteiro para o LeaderboardServer.
+ * @return Sempre nullptr.
+ */
+static void* rodarServico(ALLEGRO_THREAD* thread, void* arg) {
+    (void)thread;
+    static_cast<LeaderboardServer*>(arg)->executar();
+    return nullptr;
+}
+
+/**
+ * @brief Verifica se as partidas de dois jogos chegam ao serviço em lotes, se cada
+ * apelido fica com a maior pontuação e se as primeiras posições e a posição dos
+ * apelidos acompanhados chegam à cópia local. O ranking é lido de volta do arquivo.
+ */
+TEST_CASE("Servico de ranking recebe os lotes de dois jogos") {
+    std::filesystem::path pasta = pastaLimpa("td_test_servico");
+    std::string socket = (pasta / "ranking.sock").string();
+    std::string arquivo = (pasta / "ranking.txt").string();
+
+    LeaderboardServer servico(socket, arquivo, 0);
+    REQUIRE(servico.iniciar());
+    ALLEGRO_THREAD* thread = al_create_thread(&rodarServico, &servico);
+    REQUIRE(thread != nullptr);
+    al_start_thread(thread);
+
+    {
+        LeaderboardClient a(socket, (pasta / "a.txt").string());
+        LeaderboardClient b(socket, (pasta / "b.txt").string());
+        a.enviar("ana", 10);
+        a.enviar("ana", 30);
+        b.enviar("bia", 20);
+        b.enviar("ana", 25); // Menor que a do outro jogo: não muda o recorde
+        b.enviar("caio", 5);
+        REQUIRE(a.aguardar(5000));
+        REQUIRE(b.aguardar(5000));
+        b.enviar("caio", 6); // A resposta deste lote já vê as partidas dos dois jogos
+        REQUIRE(b.aguardar(5000));
+
+        std::vector<LeaderboardClient::Colocacao> melhores = b.getMelhores();
+        REQUIRE(melhores.size() == 3);
+        CHECK(melhores[0].apelido == "ana");
+        CHECK(melhores[0].pontuacao == 30);
+        CHECK(melhores[1].apelido == "bia");
+        CHECK(melhores[2].pontuacao == 6);
+        size_t posicao = 0, total = 0;
+        REQUIRE(b.getPosicao("caio", posicao, total));
+        CHECK(posicao == 3);
+        CHECK(total == 3);
+        CHECK_FALSE(b.getPosicao("zeca", posicao, total)); // Não acompanhado
+
+        // Rajada maior que a fila: cada partida é confirmada ou contada como descartada
+        LeaderboardClient c(socket, (pasta / "c.txt").string(), 8);
+        for (int i = 0; i < 200; ++i) c.enviar("dani", i % 20);
+        REQUIRE(c.aguardar(5000));
+        LeaderboardClient::Estatisticas e = c.getEstatisticas();
+        CHECK(e.enviadas == 200);
+        CHECK(e.confirmadas + e.descartadas == 200);
+        CHECK(e.lotes < 200);
+        CHECK(e.conectado);
+    }
+
+    servico.parar();
+    al_join_thread(thread, nullptr);
+    al_destroy_thread(thread);
+    CHECK(servico.getEstatisticas().repetidas == 0);
+    CHECK(servico.getRanking().getQuantidade() == 4);
+
+    LeaderboardServer relido(socket, arquivo);
+    REQUIRE(relido.iniciar());
+    CHECK(relido.getRanking().getQuantidade() == 4);
+    CHECK(relido.getRanking().getRecorde() == 30);
+
+    std::filesystem::remove_all(pasta);
+}
+
+/**
+ * @brief Sem o serviço, as partidas ficam no arquivo de pendentes e o jogo não espera;
+ * quando ele volta, uma próxima execução as entrega e apaga o arquivo. Um arquivo
+ * reenviado (confirmação perdida) não conta nenhuma partida duas vezes.
+ */
+TEST_CASE("Partidas ficam pendentes sem o servico e nao se repetem") {
+    std::filesystem::path pasta = pastaLimpa("td_test_pendentes");
+    std::string socket = (pasta / "ranking.sock").string();
+    std::string pendentes = (pasta / "pendentes.txt").string();
+
+    {
+        LeaderboardClient offline(socket, pendentes, LeaderboardClient::LIMITE_PADRAO, 0);
+        offline.enviar("ana", 7);
+        offline.enviar("bia", 9);
+        CHECK_FALSE(offline.aguardar(300));
+        LeaderboardClient::Estatisticas e = offline.getEstatisticas();
+        CHECK(e.pendentes == 2);
+        CHECK(e.confirmadas == 0);
+        CHECK(e.falhas >= 1);
+        CHECK_FALSE(e.conectado);
+    }
+    REQUIRE(std::filesystem::exists(pendentes));
+    std::filesystem::copy_file(pendentes, pendentes + ".copia");
+
+    LeaderboardServer servico(socket);
+    REQUIRE(servico.iniciar());
+    ALLEGRO_THREAD* thread = al_create_thread(&rodarServico, &servico);
+    REQUIRE(thread != nullptr);
+    al_start_thread(thread);
+
+    {
+        LeaderboardClient proxima(socket, pendentes);
+        REQUIRE(proxima.aguardar(5000)); // Entrega as pendentes sem nenhuma partida nova
+        CHECK(proxima.getEstatisticas().confirmadas == 2);
+        CHECK_FALSE(std::filesystem::exists(pendentes));
+    }
+
+    std::filesystem::copy_file(pendentes + ".copia", pendentes);
+    {
+        LeaderboardClient reenvio(socket, pendentes);
+        REQUIRE(reenvio.aguardar(5000));
+        std::vector<LeaderboardClient::Colocacao> melhores = reenvio.getMelhores();
+        REQUIRE(melhores.size() == 2);
+        CHECK(melhores[0].apelido == "bia");
+        CHECK(melhores[1].pontuacao == 7);
+    }
+
+    servico.parar();
+    al_join_thread(thread, nullptr);
+    al_destroy_thread(thread);
+    CHECK(servico.getEstatisticas().partidas == 2);
+    CHECK(servico.getEstatisticas().repetidas == 2);
+    CHECK_FALSE(std::filesystem::exists(socket)); // O serviço apaga o socket ao sair
+
+    std::filesystem::remove_all(pasta);
+}
+
+/**
+ * @brief Verifica se as origens antigas são esquecidas (na memória e no arquivo) e se um
+ * jogo que não lê as respostas não atrasa os outros: a resposta fica na conexão e é
+ * enviada inteira quando ele volta a ler.
+ */
+TEST_CASE("Servico esquece origens antigas e nao espera quem nao le") {
+    std::filesystem::path pasta = pastaLimpa("td_test_servico_origens");
+    std::string socket = (pasta / "ranking.sock").string();
+    std::string arquivo = (pasta / "ranking.txt").string();
+    {
+        std::ofstream arq(arquivo);
+        arq << "O velha 5 1000\n"  // Vista em 1970: esquecida
+            << "O antiga 3\n"      // Sem o instante (versão anterior): conta como vista agora
+            << "J 10 ana\n";
+    }
+
+    LeaderboardServer servico(socket, arquivo, 0);
+    REQUIRE(servico.iniciar());
+    CHECK(servico.getQuantidadeOrigens() == 1);
+    CHECK(servico.getEstatisticas().origensEsquecidas == 1);
+    ALLEGRO_THREAD* thread = al_create_thread(&rodarServico, &servico);
+    REQUIRE(thread != nullptr);
+    al_start_thread(thread);
+
+    // Um jogo pede muito mais resposta do que cabe no socket e não lê nada por enquanto
+    const int consultas = 50000;
+    LocalSocket lento;
+    REQUIRE(lento.conectar(socket, 2000));
+    std::string pedido;
+    for (int i = 0; i < consultas; ++i) pedido += "T 100\n";
+    REQUIRE(lento.enviarTudo(pedido, 5000));
+
+    {
+        LeaderboardClient outro(socket, (pasta / "outro.txt").string());
+        outro.enviar("bia", 3);
+        REQUIRE(outro.aguardar(5000)); // Atendido enquanto a resposta do lento espera
+        CHECK(outro.getEstatisticas().confirmadas == 1);
+    }
+
+    // Agora o lento lê: todas as respostas chegam
+    std::string entrada;
+    int fins = 0;
+    std::vector<const LocalSocket*> sockets(1, &lento);
+    std::vector<char> prontos;
+    for (int espera = 0; fins < consultas && espera < 500; ++espera) {
+        LocalSocket::esperar(sockets, prontos, 10);
+        if (lento.receber(entrada) < 0) break;
+        size_t pos;
+        while ((pos = entrada.find('\n')) != std::string::npos) {
+            if (entrada.compare(0, pos, ".") == 0) ++fins;
+            entrada.erase(0, pos + 1);
+        }
+    }
+    CHECK(fins == consultas);
+    lento.fechar();
+
+    servico.parar();
+    al_join_thread(thread, nullptr);
+    al_destroy_thread(thread);
+
+    std::ifstream relido(arquivo);
+    std::string conteudo((std::istreambuf_iterator<char>(relido)), std::istreambuf_iterator<char>());
+    CHECK(conteudo.find("O velha") == std::string::npos);
+    CHECK(conteudo.find("O antiga 3 ") != std::string::npos);
+    CHECK(conteudo.find("J 3 bia") != std::string::npos);
+
+    std::filesystem::remove_all(pasta);
+}
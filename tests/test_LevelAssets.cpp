@@ -0,0 +1,71 @@
+/**
+ * @file test_LevelAssets.cpp
+ * @brief test_LevelAssetsimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                        // Inclui o cabeçalho do Doctest.
+#include "../include/LevelAssetManager.hpp" // Política de descarte dos níveis.
+
+/// @brief Um megabyte, para deixar os tamanhos dos testes legíveis.
+static const size_t MB = 1024 * 1024;
+
+/**
+ * @brief Verifica se nada é descartado enquanto os níveis cabem no orçamento.
+ */
+TEST_CASE("Niveis dentro do orcamento nao sao descartados") {
+    std::vector<LevelAssetManager::Residencia> residentes = {
+        {0, 4 * MB, 1, true}, {1, 4 * MB, 2, false}, {2, 4 * MB, 3, true}
+    };
+    CHECK(LevelAssetManager::escolherDescartes(residentes, 12 * MB).empty());
+}
+
+/**
+ * @brief Verifica se os níveis fora do alcance saem do usado há mais tempo para o mais recente.
+ */
+TEST_CASE("Descarte comeca pelo nivel usado ha mais tempo") {
+    std::vector<LevelAssetManager::Residencia> residentes = {
+        {0, 4 * MB, 10, true},  // Primeiro nível: destino do "Reiniciar"
+        {1, 4 * MB, 3, false},
+        {2, 4 * MB, 5, false},
+        {3, 4 * MB, 7, false},
+        {4, 4 * MB, 11, true},  // Nível atual
+        {5, 4 * MB, 12, true}   // Próximo nível (pré-carregado)
+    };
+    std::vector<int> descartes = LevelAssetManager::escolherDescartes(residentes, 17 * MB);
+    REQUIRE(descartes.size() == 2);
+    CHECK(descartes[0] == 1);
+    CHECK(descartes[1] == 2);
+}
+
+/**
+ * @brief Verifica se os níveis ao alcance ficam mesmo quando sozinhos passam do orçamento.
+ */
+TEST_CASE("Niveis ao alcance nunca sao descartados") {
+    std::vector<LevelAssetManager::Residencia> residentes = {
+        {0, 8 * MB, 1, true}, {3, 8 * MB, 2, false}, {4, 8 * MB, 3, true}
+    };
+    std::vector<int> descartes = LevelAssetManager::escolherDescartes(residentes, 4 * MB);
+    REQUIRE(descartes.size() == 1);
+    CHECK(descartes[0] == 3);
+}
+
+/**
+ * @brief Simula níveis que falharam ao carregar e verifica qual nível os substitui.
+ */
+TEST_CASE("Nivel que falhou e substituido pelo carregado mais proximo") {
+    // Nível 2 falhou: usa o anterior, que o jogador já viu
+    std::vector<bool> disponiveis = {true, true, false, true};
+    CHECK(LevelAssetManager::escolherSubstituto(disponiveis, 2) == 1);
+    CHECK(LevelAssetManager::escolherSubstituto(disponiveis, 3) == 3); // Nível que carregou é usado direto
+
+    // Níveis 0 e 1 falharam: sem anterior, usa o seguinte mais próximo
+    disponiveis = {false, false, true, true};
+    CHECK(LevelAssetManager::escolherSubstituto(disponiveis, 0) == 2);
+    CHECK(LevelAssetManager::escolherSubstituto(disponiveis, 1) == 2);
+
+    // Todos falharam, ou o nível não existe
+    disponiveis = {false, false};
+    CHECK(LevelAssetManager::escolherSubstituto(disponiveis, 0) == -1);
+    CHECK(LevelAssetManager::escolherSubstituto({true}, 5) == -1);
+}
@@ -0,0 +1,63 @@
+/**
+ * @file test_Lz4Block.cpp
+ * @brief test_Lz4Blockimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"               // Inclui o cabeçalho do Doctest.
+#include "../include/Lz4Block.hpp" // Compressão do cache de imagens.
+#include <cstdint>                 // Para uint32_t.
+
+/**
+ * @brief Comprime e descomprime, conferindo que os bytes voltam iguais.
+ * @param original Bytes de teste.
+ * @return true se a ida e volta preservou os dados.
+ */
+static bool idaEVolta(const std::vector<unsigned char>& original) {
+    std::vector<unsigned char> comprimido = Lz4Block::comprimir(original.data(), original.size());
+    std::vector<unsigned char> volta(original.size());
+    return Lz4Block::descomprimir(comprimido.data(), comprimido.size(), volta.data(), volta.size()) &&
+           volta == original;
+}
+
+/**
+ * @brief Verifica se pixels repetidos comprimem bem e voltam iguais, assim como dados sem padrão.
+ */
+TEST_CASE("Compressao LZ4 preserva os pixels") {
+    // Céu de uma cor só com uma faixa diferente: o caso comum dos fundos
+    std::vector<unsigned char> ceu;
+    for (int i = 0; i < 64 * 64; ++i) {
+        bool faixa = (i / 64) % 16 == 0;
+        unsigned char px[4] = {40, 60, (unsigned char)(faixa ? 200 : 120), 255};
+        ceu.insert(ceu.end(), px, px + 4);
+    }
+    CHECK(idaEVolta(ceu));
+    CHECK(Lz4Block::comprimir(ceu.data(), ceu.size()).size() < ceu.size() / 10);
+
+    // Ruído: quase não comprime, mas precisa voltar igual
+    std::vector<unsigned char> ruido(5000);
+    uint32_t estado = 12345;
+    for (unsigned char& b : ruido) {
+        estado = estado * 1103515245u + 12345u;
+        b = (unsigned char)(estado >> 24);
+    }
+    CHECK(idaEVolta(ruido));
+
+    CHECK(idaEVolta({}));
+    CHECK(idaEVolta({1, 2, 3}));
+}
+
+/**
+ * @brief Verifica se um bloco truncado ou com o tamanho errado é recusado.
+ */
+TEST_CASE("Bloco LZ4 invalido e recusado") {
+    std::vector<unsigned char> original(1000, 7);
+    std::vector<unsigned char> comprimido = Lz4Block::comprimir(original.data(), original.size());
+    std::vector<unsigned char> volta(original.size());
+
+    CHECK_FALSE(Lz4Block::descomprimir(comprimido.data(), comprimido.size() - 1, volta.data(), volta.size()));
+    CHECK_FALSE(Lz4Block::descomprimir(comprimido.data(), comprimido.size(), volta.data(), volta.size() - 1));
+
+    unsigned char distanciaInvalida[] = {0x00, 0xFF, 0xFF}; // Cópia antes do início
+    CHECK_FALSE(Lz4Block::descomprimir(distanciaInvalida, sizeof(distanciaInvalida), volta.data(), 4));
+}
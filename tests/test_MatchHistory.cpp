@@ -0,0 +1,157 @@
+/**
+ * @file test_MatchHistory.cpp
+ * @brief test_MatchHistoryimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                   // Inclui o cabeçalho do Doctest.
+#include "../include/MatchHistory.hpp" // Histórico de partidas em colunas.
+#include "TestUtils.hpp"               // Pasta temporária dos testes.
+#include <cstdio>                      // Para acrescentar um bloco cortado ao arquivo
+#include <filesystem>                  // Para os caminhos dos arquivos
+
+/**
+ * @brief Cria uma partida para os testes.
+ */
+static MatchHistory::Partida partida(int32_t jogador, int32_t pontuacao, uint32_t instante) {
+    MatchHistory::Partida p;
+    p.jogador = jogador;
+    p.pontuacao = pontuacao;
+    p.nivel = 1 + pontuacao / 10;
+    p.duracaoMs = 1000 + pontuacao * 500;
+    p.batidas = pontuacao * 3;
+    p.instante = instante;
+    return p;
+}
+
+/**
+ * @brief Verifica as consultas: contagem, média, percentis, histograma por dia e melhores partidas.
+ */
+TEST_CASE("Consultas do historico de partidas") {
+    MatchHistory historico("nao_usado.dat");
+    REQUIRE(historico.cadastrarApelido("zero") == 0);
+    REQUIRE(historico.cadastrarApelido("um") == 1);
+    REQUIRE(historico.cadastrarApelido("dois") == 2);
+    CHECK(historico.cadastrarApelido("um") == 1);
+    CHECK(historico.getCodigo("tres") == MatchHistory::NENHUM);
+    const uint32_t dia = 86400;
+    // Jogador 1: pontuações 1..10, uma por dia; jogador 2: três partidas no primeiro dia
+    for (int i = 1; i <= 10; ++i) historico.registrar(partida(1, i, (i - 1) * dia + 100));
+    historico.registrar(partida(2, 40, 10));
+    historico.registrar(partida(2, 7, 20));
+    historico.registrar(partida(2, 40, 30));
+
+    CHECK(historico.contar(1) == 10);
+    CHECK(historico.contar(MatchHistory::TODOS) == 13);
+    CHECK(historico.contar(MatchHistory::NENHUM) == 0);
+    CHECK(historico.media(1) == doctest::Approx(5.5));
+    CHECK(historico.media(MatchHistory::NENHUM) == 0.0);
+
+    std::vector<int> p = historico.calcularPercentis(1, {90.0, 50.0, 0.0, 100.0});
+    REQUIRE(p.size() == 4);
+    CHECK(p[0] == 9);  // Posto ceil(0.9 * 10) = 9
+    CHECK(p[1] == 5);
+    CHECK(p[2] == 1);
+    CHECK(p[3] == 10);
+    CHECK(historico.calcularPercentis(MatchHistory::NENHUM, {50.0}).empty());
+
+    std::vector<int> porDia = historico.histogramaDiario(MatchHistory::TODOS, 0, 3);
+    REQUIRE(porDia.size() == 3);
+    CHECK(porDia[0] == 4); // Primeira do jogador 1 e as três do jogador 2
+    CHECK(porDia[1] == 1);
+    CHECK(historico.histogramaDiario(1, dia, 2)[0] == 1); // As do dia anterior ao início ficam de fora
+
+    std::vector<size_t> top = historico.melhores(MatchHistory::TODOS, 3);
+    REQUIRE(top.size() == 3);
+    CHECK(top[0] == 10); // Empate em 40: a mais antiga primeiro
+    CHECK(top[1] == 12);
+    CHECK(historico.getPartida(top[2]).pontuacao == 10);
+    CHECK(historico.melhores(2, 10).size() == 3);
+}
+
+/**
+ * @brief Verifica se as partidas voltam iguais do arquivo e se um bloco cortado no fim é descartado.
+ */
+TEST_CASE("Historico gravado em blocos sobrevive a uma queda") {
+    std::filesystem::path pasta = pastaLimpa("td_test_historico", false);
+    std::string arquivo = (pasta / "historico.dat").string();
+
+    {
+        MatchHistory historico(arquivo);
+        CHECK_FALSE(historico.carregar()); // Sem arquivo
+        int32_t ana = historico.cadastrarApelido("ana");
+        int32_t bia = historico.cadastrarApelido("bia");
+        historico.registrar(partida(bia, 12, 1700000000u));
+        historico.registrar(partida(ana, -1, 1700000005u)); // Valores negativos e apelidos fora de ordem
+        CHECK(historico.getPendentes() == 2);
+        REQUIRE(historico.salvar()); // Cria a pasta
+        MatchHistory::Partida longa = partida(bia, 70000, 1700000100u);
+        longa.batidas = 100000; // Limitada a 16 bits
+        historico.registrar(longa);
+        REQUIRE(historico.salvar()); // Segundo bloco
+        CHECK(historico.getPendentes() == 0);
+    }
+    uintmax_t tamanhoValido = std::filesystem::file_size(arquivo);
+
+    // Simula a queda: só o começo de um terceiro bloco
+    FILE* arq = fopen(arquivo.c_str(), "ab");
+    REQUIRE(arq != nullptr);
+    fwrite("TDH2\x05\x00", 1, 6, arq);
+    fclose(arq);
+
+    MatchHistory relido(arquivo);
+    REQUIRE(relido.carregar());
+    REQUIRE(relido.getQuantidade() == 3);
+    CHECK(std::filesystem::file_size(arquivo) == tamanhoValido); // O pedaço foi cortado
+    MatchHistory::Partida segunda = relido.getPartida(1);
+    CHECK(relido.getApelido(segunda.jogador) == "ana");
+    CHECK(segunda.pontuacao == -1);
+    CHECK(segunda.instante == 1700000005u);
+    MatchHistory::Partida terceira = relido.getPartida(2);
+    CHECK(terceira.pontuacao == 70000);
+    CHECK(terceira.nivel == 255);
+    CHECK(terceira.duracaoMs == 1000u + 70000u * 500u);
+    CHECK(terceira.batidas == 65535);
+    CHECK(relido.media(relido.getCodigo("bia")) == doctest::Approx(35006.0));
+
+    std::filesystem::remove_all(pasta);
+}
+
+/**
+ * @brief Verifica se dois jogos (gabinetes) gravando no mesmo arquivo, cada um com seus
+ * códigos, deixam as partidas de cada apelido juntas na releitura.
+ */
+TEST_CASE("Historico de dois jogos no mesmo arquivo") {
+    std::filesystem::path pasta = pastaLimpa("td_test_historico_gabinetes");
+    std::string arquivo = (pasta / "historico.dat").string();
+
+    MatchHistory gabinete1(arquivo);
+    MatchHistory gabinete2(arquivo);
+    gabinete1.carregar();
+    gabinete2.carregar();
+    // Cada gabinete cadastra os jogadores em outra ordem: o mesmo código é de jogadores diferentes
+    int32_t ana1 = gabinete1.cadastrarApelido("ana");
+    int32_t bia1 = gabinete1.cadastrarApelido("bia");
+    int32_t bia2 = gabinete2.cadastrarApelido("bia");
+    int32_t ana2 = gabinete2.cadastrarApelido("ana");
+    REQUIRE(ana1 == bia2);
+    gabinete1.registrar(partida(ana1, 10, 100));
+    gabinete1.registrar(partida(bia1, 20, 110));
+    REQUIRE(gabinete1.salvar());
+    gabinete2.registrar(partida(bia2, 30, 120));
+    gabinete2.registrar(partida(ana2, 40, 130));
+    gabinete2.registrar(partida(bia2, 50, 140));
+    REQUIRE(gabinete2.salvar());
+
+    MatchHistory relido(arquivo);
+    REQUIRE(relido.carregar());
+    REQUIRE(relido.getQuantidade() == 5);
+    int32_t ana = relido.getCodigo("ana");
+    int32_t bia = relido.getCodigo("bia");
+    CHECK(relido.contar(ana) == 2);
+    CHECK(relido.media(ana) == doctest::Approx(25.0));
+    CHECK(relido.contar(bia) == 3);
+    CHECK(relido.media(bia) == doctest::Approx(100.0 / 3.0));
+
+    std::filesystem::remove_all(pasta);
+}
@@ -0,0 +1,188 @@
+/**
+ * @file test_MatchJournal.cpp
+ * @brief test_MatchJournalimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                    // Inclui o cabeçalho do Doctest.
+#include "../include/PlayerManager.hpp" // Snapshot + diário de partidas.
+#include "TestUtils.hpp"                // Pasta temporária dos testes.
+#include <cstdio>                       // Para acrescentar uma linha cortada ao diário
+#include <filesystem>                   // Para os caminhos dos arquivos
+
+/**
+ * @brief Verifica se cadastros e partidas anotados no diário voltam ao recarregar,
+ * mesmo com uma última linha cortada por uma queda no meio da escrita.
+ */
+TEST_CASE("Diario de partidas sobrevive a uma queda") {
+    std::filesystem::path pasta = pastaLimpa("td_test_journal");
+    std::string arquivo = (pasta / "players.dat").string();
+
+    {
+        PlayerManager manager(arquivo, MatchJournal::SYNC_SEMPRE);
+        manager.carregar(); // Sem arquivos: começa vazio e abre o diário
+        PlayerManager::Id ana = manager.cadastrar("Ana", "ana");
+        manager.registrarPartida(ana, 7);
+        manager.registrarPartida(ana, 12);
+        manager.registrarPartida(manager.cadastrar("Bia", "bia"), 3);
+    }
+    CHECK_FALSE(std::filesystem::exists(arquivo)); // Nada regravou o arquivo de jogadores
+
+    // Simula a queda: metade de um registro no fim do diário
+    FILE* diario = fopen((pasta / "players.journal").string().c_str(), "ab");
+    REQUIRE(diario != nullptr);
+    fputs("6 P ana 99", diario);
+    fclose(diario);
+
+    PlayerManager recuperado(arquivo, MatchJournal::SYNC_SEMPRE);
+    recuperado.carregar();
+    Player* ana = recuperado.buscar("ana");
+    REQUIRE(ana != nullptr);
+    CHECK(ana->getPartidas() == 2);
+    CHECK(ana->getMaiorPontuacao() == 12); // O 99 da linha cortada foi descartado
+    REQUIRE(recuperado.buscar("bia") != nullptr);
+    CHECK(recuperado.buscar("bia")->getPartidas() == 1);
+
+    // O próximo registro continua a sequência e não fica colado no pedaço descartado
+    recuperado.registrarPartida(recuperado.buscarId("bia"), 20);
+    std::vector<MatchJournal::Registro> registros;
+    MatchJournal::ler((pasta / "players.journal").string(), registros);
+    REQUIRE(registros.size() == 6);
+    CHECK(registros.back().seq == 6);
+    CHECK(registros.back().pontuacao == 20);
+
+    std::filesystem::remove_all(pasta);
+}
+
+/**
+ * @brief Verifica se a compactação dobra o diário no arquivo de jogadores e se as
+ * partidas seguintes continuam no diário novo.
+ */
+TEST_CASE("Compactacao do diario no arquivo de jogadores") {
+    std::filesystem::path pasta = pastaLimpa("td_test_compactacao");
+    std::string arquivo = (pasta / "players.dat").string();
+
+    {
+        PlayerManager manager(arquivo, MatchJournal::SYNC_SEMPRE);
+        manager.carregar();
+        PlayerManager::Id ana = manager.cadastrar("Ana", "ana");
+        for (int i = 1; i <= 10; ++i) manager.registrarPartida(ana, i);
+
+        manager.compactar();
+        manager.aguardarCompactacao();
+        manager.registrarPartida(ana, 50); // Vai para o diário novo, depois do snapshot
+    }
+
+    CHECK(std::filesystem::exists(arquivo));
+    CHECK_FALSE(std::filesystem::exists(pasta / "players.journal.old"));
+    std::vector<MatchJournal::Registro> registros;
+    MatchJournal::ler((pasta / "players.journal").string(), registros);
+    REQUIRE(registros.size() == 1); // Só a partida anotada depois da compactação
+    CHECK(registros[0].seq == 12);
+
+    PlayerManager recarregado(arquivo, MatchJournal::SYNC_SEMPRE);
+    recarregado.carregar();
+    Player* ana = recarregado.buscar("ana");
+    REQUIRE(ana != nullptr);
+    CHECK(ana->getPartidas() == 11);
+    CHECK(ana->getMaiorPontuacao() == 50);
+
+    std::filesystem::remove_all(pasta);
+}
+
+/**
+ * @brief Verifica se um apelido com espaço volta inteiro do diário, inclusive depois
+ * de uma compactação, e se uma linha inteira que não pode ser interpretada não esconde
+ * as partidas anotadas depois dela.
+ */
+TEST_CASE("Apelido com espaco no diario de partidas") {
+    std::filesystem::path pasta = pastaLimpa("td_test_journal_espaco");
+    std::string arquivo = (pasta / "players.dat").string();
+    std::string diario = (pasta / "players.journal").string();
+
+    {
+        PlayerManager manager(arquivo, MatchJournal::SYNC_SEMPRE);
+        manager.carregar();
+        PlayerManager::Id ana = manager.cadastrar("Ana Maria", "Ana Maria");
+        manager.registrarPartida(ana, 8);
+    }
+
+    // Linha inteira (hash certo) de um tipo desconhecido, seguida de mais uma partida
+    MatchJournal::Registro desconhecido;
+    desconhecido.seq = 3;
+    desconhecido.tipo = 'X';
+    desconhecido.apelido = "Ana Maria";
+    FILE* f = fopen(diario.c_str(), "ab");
+    REQUIRE(f != nullptr);
+    fputs(MatchJournal::formatar(desconhecido).c_str(), f);
+    fclose(f);
+    {
+        PlayerManager manager(arquivo, MatchJournal::SYNC_SEMPRE);
+        manager.carregar();
+        manager.registrarPartida(manager.cadastrar("bob", "bob"), 5);
+        manager.registrarPartida(manager.buscarId("Ana Maria"), 15);
+    }
+
+    std::vector<MatchJournal::Registro> registros;
+    MatchJournal::ler(diario, registros);
+    REQUIRE(registros.size() == 5); // A linha desconhecida é pulada, não corta o diário
+    CHECK(registros[0].apelido == "Ana Maria");
+    CHECK(registros[0].nome == "Ana Maria");
+    CHECK(registros[1].apelido == "Ana Maria");
+    CHECK(registros[1].pontuacao == 8);
+    CHECK(registros.back().pontuacao == 15);
+
+    PlayerManager recarregado(arquivo, MatchJournal::SYNC_SEMPRE);
+    recarregado.carregar();
+    recarregado.compactar();
+    recarregado.aguardarCompactacao();
+    Player* ana = recarregado.buscar("Ana Maria");
+    REQUIRE(ana != nullptr);
+    CHECK(ana->getNome() == "Ana Maria");
+    CHECK(ana->getPartidas() == 2);
+    CHECK(ana->getMaiorPontuacao() == 15);
+    REQUIRE(recarregado.buscar("bob") != nullptr);
+    CHECK(recarregado.buscar("bob")->getPartidas() == 1);
+    CHECK(recarregado.buscar("Ana") == nullptr);
+
+    std::filesystem::remove_all(pasta);
+}
+
+/**
+ * @brief Verifica se, com o diário impossível de abrir, cada partida grava o banco
+ * inteiro sem apagar o que outro jogo compactou nele nem contar nada duas vezes.
+ */
+TEST_CASE("Sem o diario as partidas vao para o banco inteiro") {
+    std::filesystem::path pasta = pastaLimpa("td_test_sem_diario");
+    std::string arquivo = (pasta / "players.dat").string();
+
+    // Uma pasta no lugar da trava do diário: ele não abre
+    std::filesystem::create_directories(pasta / "players.journal.lock");
+    PlayerManager semDiario(arquivo, MatchJournal::SYNC_SEMPRE);
+    semDiario.carregar();
+    std::filesystem::remove_all(pasta / "players.journal.lock");
+
+    {
+        // Outro jogo, com o diário, compacta depois da carga do primeiro
+        PlayerManager outro(arquivo, MatchJournal::SYNC_SEMPRE);
+        outro.carregar();
+        outro.registrarPartida(outro.cadastrar("Bia", "bia"), 5);
+        outro.compactar();
+        outro.aguardarCompactacao();
+    }
+
+    PlayerManager::Id ana = semDiario.cadastrar("Ana", "ana");
+    semDiario.registrarPartida(ana, 7);
+    semDiario.registrarPartida(ana, 12);
+
+    PlayerManager recarregado(arquivo, MatchJournal::SYNC_SEMPRE);
+    recarregado.carregar();
+    REQUIRE(recarregado.buscar("ana") != nullptr);
+    CHECK(recarregado.buscar("ana")->getPartidas() == 2);
+    CHECK(recarregado.buscar("ana")->getMaiorPontuacao() == 12);
+    REQUIRE(recarregado.buscar("bia") != nullptr);
+    CHECK(recarregado.buscar("bia")->getPartidas() == 1);
+    CHECK(recarregado.getJogadores().size() == 2);
+
+    std::filesystem::remove_all(pasta);
+}
@@ -0,0 +1,63 @@
+/**
+ * @file test_MemoryTracker.cpp
+ * @brief test_MemoryTrackerimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                    // Inclui o cabeçalho do Doctest.
+#include "../include/MemoryTracker.hpp" // Contabilidade de memória dos assets.
+
+/// @brief Um megabyte, para deixar os tamanhos dos testes legíveis.
+static const size_t MB = 1024 * 1024;
+
+/**
+ * @brief Verifica os totais por categoria e por nível, e os picos depois de descarregar.
+ */
+TEST_CASE("Memoria e somada por categoria e por nivel, com pico") {
+    MemoryTracker memoria;
+    int fundo1, cano1, musica1, fundo5, som;
+
+    memoria.registrar(&fundo1, MemoryTracker::IMAGEM, 1, 4 * MB, "background1.png");
+    memoria.registrar(&cano1, MemoryTracker::IMAGEM, 1, 1 * MB, "pipe1.png");
+    memoria.registrar(&musica1, MemoryTracker::MUSICA, 1, 32 * 1024, "level1.ogg");
+    memoria.registrar(&fundo5, MemoryTracker::IMAGEM, 5, 4 * MB, "background5.png");
+    memoria.registrar(&som, MemoryTracker::SOM, MemoryTracker::GLOBAL, 2 * MB, "die.wav");
+    memoria.registrar(nullptr, MemoryTracker::IMAGEM, 1, 8 * MB, "falhou.png"); // Ignorado
+
+    CHECK(memoria.getQuantidade() == 5);
+    CHECK(memoria.getTotal().atual == 11 * MB + 32 * 1024);
+    CHECK(memoria.getCategoria(MemoryTracker::IMAGEM).atual == 9 * MB);
+    CHECK(memoria.getNivel(1).atual == 5 * MB + 32 * 1024);
+    CHECK(memoria.getNivel(5).atual == 4 * MB);
+
+    // Descarregar o nível 1 zera o uso atual dele, mas o pico continua
+    memoria.remover(&fundo1);
+    memoria.remover(&cano1);
+    memoria.remover(&musica1);
+    memoria.remover(&fundo1); // Remover de novo não muda nada
+    CHECK(memoria.getNivel(1).atual == 0);
+    CHECK(memoria.getNivel(1).pico == 5 * MB + 32 * 1024);
+    CHECK(memoria.getTotal().atual == 6 * MB);
+    CHECK(memoria.getTotal().pico == 11 * MB + 32 * 1024);
+    CHECK(memoria.getNivel(3).pico == 0); // Nível sem assets
+}
+
+/**
+ * @brief Verifica se o orçamento é marcado como excedido e volta ao normal ao liberar memória.
+ */
+TEST_CASE("Orcamento de memoria excedido e recuperado") {
+    MemoryTracker memoria(10 * MB);
+    int a, b;
+
+    memoria.registrar(&a, MemoryTracker::IMAGEM, MemoryTracker::GLOBAL, 6 * MB, "a");
+    CHECK_FALSE(memoria.isOrcamentoExcedido());
+    memoria.registrar(&b, MemoryTracker::IMAGEM, 2, 6 * MB, "b");
+    CHECK(memoria.isOrcamentoExcedido());
+
+    memoria.remover(&b);
+    CHECK_FALSE(memoria.isOrcamentoExcedido());
+
+    // Um orçamento menor vale na hora para o que já está carregado
+    memoria.setOrcamento(4 * MB);
+    CHECK(memoria.isOrcamentoExcedido());
+}
@@ -0,0 +1,76 @@
+/**
+ * @file test_NicknameIndex.cpp
+ * @brief test_NicknameIndeximplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                    // Inclui o cabeçalho do Doctest.
+#include "../include/NicknameIndex.hpp" // Índice de prefixos dos apelidos.
+#include "../include/PlayerManager.hpp" // Sugestões mantidas pelo cadastro.
+#include "TestUtils.hpp"                // Pasta temporária dos testes.
+#include <filesystem>                   // Para os caminhos dos arquivos
+
+/**
+ * @brief Verifica a ordem das sugestões (pontuação, depois apelido), o estreitamento tecla a
+ * tecla, a volta com o backspace, os cadastros recentes e a mudança de pontuação.
+ */
+TEST_CASE("Indice de apelidos sugere os melhores de cada prefixo") {
+    std::vector<Player> jogadores;
+    jogadores.emplace_back("Ana", "ana", 1, 30);     // 0
+    jogadores.emplace_back("Anabel", "anabel", 1, 50); // 1
+    jogadores.emplace_back("Andre", "andre", 1, 10); // 2
+    jogadores.emplace_back("Bruno", "bruno", 1, 90); // 3
+    jogadores.emplace_back("Anita", "anita", 1, 30); // 4
+
+    NicknameIndex indice;
+    indice.reconstruir(jogadores);
+    CHECK(indice.getQuantidade() == 5);
+    CHECK(indice.sugerir("a", 3, jogadores) == std::vector<uint32_t>{1, 0, 4}); // Empate: "ana" antes de "anita"
+    CHECK(indice.sugerir("an", 10, jogadores) == std::vector<uint32_t>{1, 0, 4, 2});
+    CHECK(indice.sugerir("ana", 10, jogadores) == std::vector<uint32_t>{1, 0});
+    CHECK(indice.sugerir("anab", 10, jogadores) == std::vector<uint32_t>{1});
+    CHECK(indice.sugerir("anaz", 10, jogadores).empty());
+    CHECK(indice.sugerir("an", 2, jogadores) == std::vector<uint32_t>{1, 0}); // Backspace duas vezes
+    CHECK(indice.sugerir("", 1, jogadores) == std::vector<uint32_t>{3});
+    CHECK(indice.sugerir("b", 0, jogadores).empty());
+
+    // Cadastro depois da montagem: fica nos recentes, mas já aparece nas sugestões
+    jogadores.emplace_back("Anaconda", "anaconda", 1, 40); // 5
+    indice.inserir(5, jogadores);
+    CHECK(indice.sugerir("ana", 10, jogadores) == std::vector<uint32_t>{1, 5, 0});
+
+    // Recorde novo muda a ordem
+    indice.atualizar(2, 100);
+    CHECK(indice.sugerir("an", 2, jogadores) == std::vector<uint32_t>{2, 1});
+
+    // Muitos cadastros: os recentes são intercalados na tabela e nada se perde
+    for (uint32_t i = 0; i < NicknameIndex::LIMITE_RECENTES + 10; ++i) {
+        jogadores.emplace_back("Z", "z" + std::to_string(i), 1, (int)i);
+        indice.inserir((uint32_t)jogadores.size() - 1, jogadores);
+    }
+    CHECK(indice.getQuantidade() == jogadores.size());
+    CHECK(indice.sugerir("z", 1, jogadores) == std::vector<uint32_t>{(uint32_t)jogadores.size() - 1});
+    CHECK(indice.sugerir("ana", 10, jogadores) == std::vector<uint32_t>{1, 5, 0});
+}
+
+/**
+ * @brief Verifica se o PlayerManager monta o índice na primeira sugestão e o mantém
+ * a cada cadastro e partida.
+ */
+TEST_CASE("Cadastro sugere apelidos depois de cadastros e partidas") {
+    std::filesystem::path pasta = pastaLimpa("td_test_apelidos");
+
+    PlayerManager manager((pasta / "players.dat").string(), MatchJournal::SYNC_NUNCA);
+    manager.carregar();
+    PlayerManager::Id leo = manager.cadastrar("Leo", "leo");
+    PlayerManager::Id leda = manager.cadastrar("Leda", "leda");
+    manager.registrarPartida(leo, 5);
+    CHECK(manager.sugerirApelidos("le", 5) == std::vector<PlayerManager::Id>{leo, leda});
+
+    PlayerManager::Id leon = manager.cadastrar("Leon", "leon"); // Depois da montagem
+    manager.registrarPartida(leda, 20);
+    CHECK(manager.sugerirApelidos("le", 5) == std::vector<PlayerManager::Id>{leda, leo, leon});
+    CHECK(manager.sugerirApelidos("leo", 5) == std::vector<PlayerManager::Id>{leo, leon});
+
+    std::filesystem::remove_all(pasta);
+}
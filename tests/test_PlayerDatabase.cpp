@@ -0,0 +1,90 @@
+/**
+ * @file test_PlayerDatabase.cpp
+ * @brief test_PlayerDatabaseimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                     // Inclui o cabeçalho do Doctest.
+#include "../include/PlayerDatabase.hpp" // Banco binário de jogadores.
+#include "../include/PlayerManager.hpp"  // Migração do arquivo de texto antigo.
+#include "TestUtils.hpp"                 // Pasta temporária dos testes.
+#include <filesystem>                    // Para os caminhos dos arquivos
+#include <fstream>                       // Para escrever o arquivo de texto antigo
+
+/**
+ * @brief Verifica se o banco guarda os jogadores e a sequência, se os textos repetidos
+ * entram uma vez só na tabela e se um arquivo cortado é recusado.
+ */
+TEST_CASE("Banco binario de jogadores: gravar, mapear e recusar arquivo cortado") {
+    std::filesystem::path pasta = pastaLimpa("td_test_banco");
+    std::string caminho = (pasta / "players.dat").string();
+
+    std::vector<Player> jogadores;
+    jogadores.emplace_back("ana", "ana", 40, 17);
+    jogadores.emplace_back("Beatriz", "bia", 3, 9);
+    REQUIRE(PlayerDatabase::gravar(caminho, jogadores, 77));
+    CHECK(PlayerDatabase::reconhecer(caminho));
+
+    // Cabeçalho (32) + 2 registros (16 cada) + índice de 4 posições + "ana\0" uma vez só + "Beatriz\0" + "bia\0"
+    CHECK(std::filesystem::file_size(caminho) == 32 + 2 * 16 + 4 * 4 + 4 + 8 + 4);
+
+    PlayerDatabase banco;
+    REQUIRE(banco.abrir(caminho));
+    CHECK(banco.getQuantidade() == 2);
+    CHECK(banco.getSeq() == 77);
+    CHECK(std::string(banco.getNome(1)) == "Beatriz");
+    CHECK(std::string(banco.getApelido(1)) == "bia");
+    CHECK(banco.getPartidas(0) == 40);
+    CHECK(banco.getMaiorPontuacao(0) == 17);
+
+    // O índice gravado acha os dois apelidos sem refazer o hash
+    std::vector<uint32_t> indice;
+    banco.copiarIndice(indice);
+    CHECK(PlayerDatabase::buscarNoIndice(indice, "bia", jogadores) == 1);
+    CHECK(PlayerDatabase::buscarNoIndice(indice, "ana", jogadores) == 0);
+    CHECK(PlayerDatabase::buscarNoIndice(indice, "Beatriz", jogadores) == -1); // Nome não é apelido
+    banco.fechar();
+
+    // Um banco cortado no meio não é aberto
+    std::filesystem::resize_file(caminho, 40);
+    CHECK_FALSE(banco.abrir(caminho));
+    CHECK(banco.getQuantidade() == 0);
+
+    std::filesystem::remove_all(pasta);
+}
+
+/**
+ * @brief Verifica se o players.txt das versões antigas é convertido para o banco na
+ * primeira carga, mantendo as partidas e os recordes.
+ */
+TEST_CASE("Migracao do arquivo de texto para o banco binario") {
+    std::filesystem::path pasta = pastaLimpa("td_test_migracao");
+    {
+        std::ofstream texto(pasta / "players.txt");
+        texto << "Gabriel gabriel 1000 52\n";
+        texto << "Ana ana 2 8\n";
+    }
+    std::string caminho = (pasta / "players.dat").string();
+
+    {
+        PlayerManager manager(caminho, MatchJournal::SYNC_SEMPRE);
+        manager.carregar();
+        REQUIRE(manager.getJogadores().size() == 2);
+        REQUIRE(manager.buscar("gabriel") != nullptr);
+        CHECK(manager.buscar("gabriel")->getPartidas() == 1000);
+        CHECK(manager.buscar("gabriel")->getMaiorPontuacao() == 52);
+    }
+    CHECK(PlayerDatabase::reconhecer(caminho));
+    CHECK(std::filesystem::exists(pasta / "players.txt")); // O texto antigo fica como cópia
+
+    // A segunda carga já vem do banco, e os cadastros novos convivem com o índice dele
+    PlayerManager recarregado(caminho, MatchJournal::SYNC_SEMPRE);
+    recarregado.carregar();
+    CHECK(recarregado.buscarId("ana") == 1);
+    CHECK(recarregado.cadastrar("Ana", "ana") == 1); // Já existe no banco
+    PlayerManager::Id novo = recarregado.cadastrar("Caio", "caio");
+    CHECK(novo == 2);
+    CHECK(recarregado.buscarId("caio") == novo);
+
+    std::filesystem::remove_all(pasta);
+}
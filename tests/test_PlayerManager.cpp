@@ -62,4 +62,26 @@ TEST_CASE("Cadastro de jogadores e ranking com Player::adicionarPartida") {
     CHECK(ranking[0].getApelido() == "gabriel");
     CHECK(ranking[1].getApelido() == "alvaro");
     CHECK(ranking[2].getApelido() == "joao");
-}
\ No newline at end of file
+}
+/**
+ * @brief Caso de teste para verificar se o Id de um jogador continua valendo depois de novos cadastros.
+ *
+ * @details Ponteiros para o vetor de jogadores são invalidados quando ele cresce;
+ * o Id não, e o apelido repetido devolve o jogador já existente.
+ */
+TEST_CASE("Id do jogador sobrevive a novos cadastros") {
+    PlayerManager manager("test_players.dat");
+
+    PlayerManager::Id id = manager.cadastrar("Gabriel", "gabriel");
+    for (int i = 0; i < 1000; ++i) {
+        manager.cadastrar("Jogador", "jogador" + std::to_string(i)); // Força o vetor a crescer várias vezes
+    }
+
+    REQUIRE(manager.getJogador(id) != nullptr);
+    CHECK(manager.getJogador(id)->getApelido() == "gabriel");
+    CHECK(manager.buscarId("jogador999") == id + 1000);
+    CHECK(manager.cadastrar("Outro", "gabriel") == id); // Apelido repetido não gera outro cadastro
+    CHECK(manager.getJogadores().size() == 1001);
+    CHECK(manager.buscarId("ninguem") == PlayerManager::ID_INVALIDO);
+    CHECK(manager.getJogador(PlayerManager::ID_INVALIDO) == nullptr);
+}
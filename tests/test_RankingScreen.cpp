@@ -0,0 +1,78 @@
+/**
+ * @file test_RankingScreen.cpp
+ * @brief test_RankingScreenimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                    // Inclui o cabeçalho do Doctest.
+#include "../include/RankingScreen.hpp" // Janela do ranking com rolagem.
+#include "TestUtils.hpp"                // Pasta temporária dos testes.
+#include <filesystem>                   // Para os caminhos dos arquivos
+
+/**
+ * @brief Monta um evento de tecla pressionada.
+ * @param tecla O código da tecla.
+ * @return O evento.
+ */
+static ALLEGRO_EVENT tecla(int tecla) {
+    ALLEGRO_EVENT ev = {};
+    ev.type = ALLEGRO_EVENT_KEY_DOWN;
+    ev.keyboard.keycode = tecla;
+    return ev;
+}
+
+/**
+ * @brief Verifica os limites da janela: ela nunca passa do fim do ranking e, ao pular
+ * para uma posição, deixa essa posição no meio.
+ */
+TEST_CASE("Janela do ranking limitada ao tamanho do ranking") {
+    CHECK(RankingScreen::limitarInicio(0, 5, 10) == 0);   // Todos cabem
+    CHECK(RankingScreen::limitarInicio(7, 5, 10) == 0);
+    CHECK(RankingScreen::limitarInicio(500, 1000, 10) == 500);
+    CHECK(RankingScreen::limitarInicio(995, 1000, 10) == 990); // A última página fica cheia
+
+    CHECK(RankingScreen::inicioParaPosicao(1, 1000, 10) == 0);
+    CHECK(RankingScreen::inicioParaPosicao(500, 1000, 10) == 494); // Posição 500 na sexta linha
+    CHECK(RankingScreen::inicioParaPosicao(1000, 1000, 10) == 990);
+    CHECK(RankingScreen::inicioParaPosicao(3, 2, 10) == 0);
+}
+
+/**
+ * @brief Verifica a rolagem pelo teclado e o salto para a posição do jogador, sem desenhar
+ * (a tela não precisa de fonte nem de display para tratar os eventos).
+ */
+TEST_CASE("Rolagem do ranking e salto para a posicao do jogador") {
+    std::filesystem::path pasta = pastaLimpa("td_test_tela_ranking");
+
+    PlayerManager manager((pasta / "players.dat").string(), MatchJournal::SYNC_NUNCA);
+    manager.carregar();
+    for (int i = 0; i < 100; ++i) {
+        PlayerManager::Id id = manager.cadastrar("Jogador", "jogador" + std::to_string(i));
+        manager.registrarPartida(id, 1000 - i); // jogador0 em primeiro, jogador99 em último
+    }
+
+    RankingScreen tela(nullptr, nullptr, &manager, 1280, 720);
+    CHECK(tela.handleEvent(tecla(ALLEGRO_KEY_DOWN)) == 0);
+    CHECK(tela.getPrimeiraLinha() == 1);
+    tela.handleEvent(tecla(ALLEGRO_KEY_PGDN));
+    CHECK(tela.getPrimeiraLinha() == 1 + RankingScreen::LINHAS_VISIVEIS);
+    tela.handleEvent(tecla(ALLEGRO_KEY_END));
+    CHECK(tela.getPrimeiraLinha() == 90);
+    tela.handleEvent(tecla(ALLEGRO_KEY_DOWN)); // Já está no fim
+    CHECK(tela.getPrimeiraLinha() == 90);
+    tela.handleEvent(tecla(ALLEGRO_KEY_HOME));
+    CHECK(tela.getPrimeiraLinha() == 0);
+    tela.handleEvent(tecla(ALLEGRO_KEY_UP)); // Já está no topo
+    CHECK(tela.getPrimeiraLinha() == 0);
+
+    Player* jogador = manager.buscar("jogador42"); // Posição 43
+    REQUIRE(jogador != nullptr);
+    CHECK(tela.handleEvent(tecla(ALLEGRO_KEY_M), jogador) == 0);
+    CHECK(tela.getPrimeiraLinha() == 37);
+
+    CHECK(tela.handleEvent(tecla(ALLEGRO_KEY_ESCAPE)) == 1); // Outras teclas voltam ao menu
+    tela.resetState();
+    CHECK(tela.getPrimeiraLinha() == 0);
+
+    std::filesystem::remove_all(pasta);
+}
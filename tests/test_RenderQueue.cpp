@@ -0,0 +1,63 @@
+/**
+ * @file test_RenderQueue.cpp
+ * @brief test_RenderQueueimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                  // Inclui o cabeçalho do Doctest.
+#include "../include/RenderQueue.hpp" // Lista de comandos de desenho (recorte de visibilidade).
+
+/**
+ * @brief Verifica se um intervalo totalmente dentro da tela não é alterado.
+ */
+TEST_CASE("Recorte mantem desenho totalmente visivel") {
+    float d = 100.0f, tamanho = 50.0f, s = 0.0f, tamanhoOrigem = 50.0f;
+    CHECK(RenderQueue::recortarEixo(d, tamanho, s, tamanhoOrigem, 720.0f, false));
+    CHECK(d == doctest::Approx(100.0f));
+    CHECK(tamanho == doctest::Approx(50.0f));
+    CHECK(s == doctest::Approx(0.0f));
+    CHECK(tamanhoOrigem == doctest::Approx(50.0f));
+}
+
+/**
+ * @brief Verifica se um intervalo totalmente fora da tela é descartado.
+ */
+TEST_CASE("Recorte descarta desenho fora da tela") {
+    float d = -300.0f, tamanho = 200.0f, s = 0.0f, tamanhoOrigem = 200.0f;
+    CHECK_FALSE(RenderQueue::recortarEixo(d, tamanho, s, tamanhoOrigem, 720.0f, false));
+
+    d = 720.0f; tamanho = 10.0f;
+    CHECK_FALSE(RenderQueue::recortarEixo(d, tamanho, s, tamanhoOrigem, 720.0f, false));
+}
+
+/**
+ * @brief Verifica o recorte de um cano de baixo que passa do fim da tela, com escala 2x.
+ */
+TEST_CASE("Recorte ajusta a origem na proporcao da escala") {
+    // Origem de 400 px desenhada com 800 px a partir de y = 500: só 220 px aparecem.
+    float d = 500.0f, tamanho = 800.0f, s = 0.0f, tamanhoOrigem = 400.0f;
+    REQUIRE(RenderQueue::recortarEixo(d, tamanho, s, tamanhoOrigem, 720.0f, false));
+    CHECK(d == doctest::Approx(500.0f));
+    CHECK(tamanho == doctest::Approx(220.0f));
+    CHECK(s == doctest::Approx(0.0f));
+    CHECK(tamanhoOrigem == doctest::Approx(110.0f));
+}
+
+/**
+ * @brief Verifica o recorte do cano de cima, que é desenhado espelhado.
+ */
+TEST_CASE("Recorte de desenho espelhado usa o fim da origem") {
+    // Cano de cima: 827 px de altura terminando em y = 200, espelhado verticalmente.
+    // A parte visível (0 a 200) é a base do cano espelhado, ou seja, o começo da origem.
+    float d = 200.0f - 827.0f, tamanho = 827.0f, s = 0.0f, tamanhoOrigem = 827.0f;
+    REQUIRE(RenderQueue::recortarEixo(d, tamanho, s, tamanhoOrigem, 720.0f, true));
+    CHECK(d == doctest::Approx(0.0f));
+    CHECK(tamanho == doctest::Approx(200.0f));
+    CHECK(s == doctest::Approx(0.0f));
+    CHECK(tamanhoOrigem == doctest::Approx(200.0f));
+
+    // Sem espelhar, os mesmos 200 px visíveis viriam do fim da origem.
+    d = 200.0f - 827.0f; tamanho = 827.0f; s = 0.0f; tamanhoOrigem = 827.0f;
+    REQUIRE(RenderQueue::recortarEixo(d, tamanho, s, tamanhoOrigem, 720.0f, false));
+    CHECK(s == doctest::Approx(627.0f));
+}
@@ -0,0 +1,104 @@
+/**
+ * @file test_RenderScale.cpp
+ * @brief test_RenderScaleimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                          // Inclui o cabeçalho do Doctest.
+#include "../include/GameConfig.hpp"          // Configurações persistentes.
+#include "../include/RenderScaleController.hpp" // Ajuste dinâmico da escala.
+#include <cstdio>                             // Para std::remove (limpeza do arquivo temporário).
+#include <fstream>                            // Para escrever um arquivo de configurações à mão.
+
+/**
+ * @brief Verifica se a escala é limitada ao intervalo aceito e arredondada para o passo.
+ */
+TEST_CASE("Escala de renderizacao limitada e arredondada") {
+    CHECK(GameConfig::ajustarEscala(0.1f) == doctest::Approx(GameConfig::ESCALA_MINIMA));
+    CHECK(GameConfig::ajustarEscala(3.0f) == doctest::Approx(GameConfig::ESCALA_MAXIMA));
+    CHECK(GameConfig::ajustarEscala(0.74f) == doctest::Approx(0.75f));
+}
+
+/**
+ * @brief Verifica se as configurações gravadas são lidas de volta iguais.
+ */
+TEST_CASE("Configuracoes salvas e carregadas") {
+    const std::string caminho = "test_config_tmp.txt";
+
+    GameConfig original(caminho);
+    original.setEscalaRender(0.6f);
+    original.setEscalaDinamica(true);
+    REQUIRE(original.salvar());
+
+    GameConfig lida(caminho);
+    REQUIRE(lida.carregar());
+    CHECK(lida.getEscalaRender() == doctest::Approx(0.6f));
+    CHECK(lida.isEscalaDinamica());
+
+    std::remove(caminho.c_str());
+}
+
+/**
+ * @brief Verifica se linhas inválidas não derrubam a leitura nem mudam os padrões.
+ */
+TEST_CASE("Arquivo de configuracoes com lixo mantem os padroes") {
+    const std::string caminho = "test_config_lixo_tmp.txt";
+    {
+        std::ofstream arq(caminho);
+        arq << "# comentario\n" << "escala_render=abc\n" << "sem_igual\n" << "chave_nova=1\n";
+    }
+
+    GameConfig config(caminho);
+    CHECK(config.carregar());
+    CHECK(config.getEscalaRender() == doctest::Approx(1.0f));
+    CHECK_FALSE(config.isEscalaDinamica());
+
+    std::remove(caminho.c_str());
+}
+
+/**
+ * @brief Verifica se frames lentos fazem a escala cair e frames folgados a fazem voltar.
+ */
+TEST_CASE("Escala dinamica acompanha o tempo de frame") {
+    RenderScaleController controle(0.5f, 1.0f, 0.05f, 16.0);
+    controle.setEscala(1.0f);
+
+    // Uma janela inteira lenta derruba a escala em um passo.
+    bool mudou = false;
+    for (int i = 0; i < RenderScaleController::FRAMES_POR_JANELA; ++i) {
+        mudou = controle.registrarQuadro(25.0) || mudou;
+    }
+    CHECK(mudou);
+    CHECK(controle.getEscala() == doctest::Approx(0.95f));
+
+    // Folgado, mas a escala que falhou só é tentada de novo depois da espera.
+    int janelas = RenderScaleController::JANELAS_PARA_SUBIR;
+    for (int i = 0; i < janelas * RenderScaleController::FRAMES_POR_JANELA; ++i) {
+        controle.registrarQuadro(16.0);
+    }
+    CHECK(controle.getEscala() == doctest::Approx(0.95f));
+
+    janelas = RenderScaleController::JANELAS_ESPERA_APOS_FALHA + RenderScaleController::JANELAS_PARA_SUBIR;
+    for (int i = 0; i < janelas * RenderScaleController::FRAMES_POR_JANELA; ++i) {
+        controle.registrarQuadro(16.0);
+    }
+    CHECK(controle.getEscala() == doctest::Approx(1.0f));
+}
+
+/**
+ * @brief Verifica se frames muito longos (janela arrastada) são ignorados e se o mínimo é respeitado.
+ */
+TEST_CASE("Escala dinamica ignora pausas e respeita o minimo") {
+    RenderScaleController controle(0.5f, 1.0f, 0.05f, 16.0);
+    controle.setEscala(0.5f);
+
+    for (int i = 0; i < 10 * RenderScaleController::FRAMES_POR_JANELA; ++i) {
+        CHECK_FALSE(controle.registrarQuadro(1000.0)); // Pausa: descartado
+    }
+    CHECK(controle.getMediaMs() == doctest::Approx(0.0));
+
+    for (int i = 0; i < 10 * RenderScaleController::FRAMES_POR_JANELA; ++i) {
+        controle.registrarQuadro(40.0);
+    }
+    CHECK(controle.getEscala() == doctest::Approx(0.5f));
+}
@@ -0,0 +1,79 @@
+/**
+ * @file test_SaveQueue.cpp
+ * @brief test_SaveQueueimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                    // Inclui o cabeçalho do Doctest.
+#include "../include/SaveQueue.hpp"     // Fila de gravações em outra thread.
+#include "../include/MatchHistory.hpp"  // Blocos do histórico gravados pela fila.
+#include "TestUtils.hpp"                // Pasta temporária dos testes.
+#include <filesystem>                   // Para os caminhos dos arquivos
+#include <fstream>                      // Para conferir o conteúdo gravado
+
+/**
+ * @brief Verifica se uma rajada de gravações é juntada em poucos lotes, na ordem de entrega,
+ * e se `descarregar` só retorna com tudo no disco.
+ */
+TEST_CASE("Fila de gravacao junta as rajadas e preserva a ordem") {
+    std::filesystem::path pasta = pastaLimpa("td_test_fila", false); // A fila cria a pasta
+    std::string a = (pasta / "a.dat").string();
+    std::string b = (pasta / "sub" / "b.dat").string();
+
+    SaveQueue fila(SaveQueue::LIMITE_PADRAO, 100);
+    for (int i = 0; i < 50; ++i) {
+        fila.acrescentar(a, std::vector<unsigned char>(1, (unsigned char)('A' + i % 26)));
+    }
+    fila.acrescentar(b, std::vector<unsigned char>(3, 'x')); // Cria a pasta
+    fila.descarregar();
+
+    SaveQueue::Estatisticas e = fila.getEstatisticas();
+    CHECK(e.tarefas == 51);
+    CHECK(e.lotes < 51); // A thread juntou a rajada
+    CHECK(e.falhas == 0);
+    CHECK(e.maiorLatenciaMs >= e.ultimaLatenciaMs);
+
+    std::ifstream arqA(a, std::ios::binary);
+    std::string conteudo((std::istreambuf_iterator<char>(arqA)), std::istreambuf_iterator<char>());
+    REQUIRE(conteudo.size() == 50);
+    CHECK(conteudo.substr(0, 3) == "ABC");
+    CHECK(conteudo[26] == 'A');
+    CHECK(std::filesystem::file_size(b) == 3);
+
+    std::filesystem::remove_all(pasta);
+}
+
+/**
+ * @brief Verifica se a fila cheia faz quem entrega esperar, sem perder nada, e se os
+ * blocos do histórico gravados pela fila são lidos de volta.
+ */
+TEST_CASE("Fila de gravacao limitada e historico gravado em outra thread") {
+    std::filesystem::path pasta = pastaLimpa("td_test_fila_limite", false);
+    std::string caminho = (pasta / "historico.dat").string();
+
+    MatchHistory historico(caminho);
+    const char* apelidos[3] = {"ana", "bia", "caio"};
+    {
+        SaveQueue fila(64, 20); // Cabem poucos blocos esperando
+        for (int i = 0; i < 40; ++i) {
+            MatchHistory::Partida p;
+            p.jogador = historico.cadastrarApelido(apelidos[i % 3]);
+            p.pontuacao = i;
+            p.instante = 1700000000u + i;
+            historico.registrar(p);
+            std::vector<unsigned char> bloco;
+            REQUIRE(historico.montarBloco(bloco));
+            fila.acrescentar(historico.getCaminho(), std::move(bloco));
+        }
+        CHECK(historico.getPendentes() == 0);
+        CHECK(fila.getEstatisticas().esperas > 0);
+    } // O destrutor grava o que ainda estiver na fila
+
+    MatchHistory relido(caminho);
+    REQUIRE(relido.carregar());
+    REQUIRE(relido.getQuantidade() == 40);
+    CHECK(relido.getPartida(39).pontuacao == 39);
+    CHECK(relido.contar(relido.getCodigo("bia")) == 13);
+
+    std::filesystem::remove_all(pasta);
+}
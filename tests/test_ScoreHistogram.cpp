@@ -0,0 +1,75 @@
+/**
+ * @file test_ScoreHistogram.cpp
+ * @brief test_ScoreHistogramimplementação do projeto Traveling Dragon.
+ */
+
+
+#include "doctest.h"                     // Inclui o cabeçalho do Doctest.
+#include "../include/ScoreHistogram.hpp" // Histograma de pontuações.
+#include "../include/PlayerManager.hpp"  // Histogramas mantidos pelo cadastro.
+#include "TestUtils.hpp"                 // Pasta temporária dos testes.
+#include <filesystem>                    // Para os caminhos dos arquivos
+
+/**
+ * @brief Verifica as contagens exatas abaixo de LIMITE_EXATO, os baldes largos acima dele,
+ * a remoção e a porcentagem de pontuações superadas.
+ */
+TEST_CASE("Histograma de pontuacoes conta quem ficou abaixo") {
+    ScoreHistogram h;
+    CHECK(h.percentualAbaixo(10) == 0.0); // Vazio
+
+    for (int p = 0; p < 100; ++p) h.adicionar(p);
+    CHECK(h.getTotal() == 100);
+    CHECK(h.contarAbaixo(0) == 0);
+    CHECK(h.contarAbaixo(73) == 73);
+    CHECK(h.percentualAbaixo(50) == doctest::Approx(50.0));
+    CHECK(h.contarAbaixo(1000000) == 100);
+
+    h.remover(10);
+    h.remover(10); // Já não há outro 10: ignorado
+    CHECK(h.getTotal() == 99);
+    CHECK(h.contarAbaixo(20) == 19);
+
+    // Acima de LIMITE_EXATO os baldes são largos, mas continuam em ordem e cobrem qualquer int
+    CHECK(ScoreHistogram::balde(ScoreHistogram::LIMITE_EXATO) == ScoreHistogram::LIMITE_EXATO);
+    CHECK(ScoreHistogram::balde(2000000000) < ScoreHistogram::BALDES);
+    CHECK(ScoreHistogram::balde(-5) == 0);
+    h.adicionar(5000);
+    h.adicionar(2000000000);
+    CHECK(h.contarAbaixo(100000) == 100);
+    CHECK(h.contarAbaixo(5000) == 99); // O do mesmo balde não conta
+}
+
+/**
+ * @brief Verifica se o PlayerManager mantém os histogramas de partidas e de recordes, e se o
+ * de partidas sobrevive à compactação do diário e ao recarregamento, sem contar nada duas vezes.
+ */
+TEST_CASE("Histogramas do cadastro sobrevivem a compactacao e recarga") {
+    std::filesystem::path pasta = pastaLimpa("td_test_histograma");
+    std::string arquivo = (pasta / "players.dat").string();
+
+    {
+        PlayerManager manager(arquivo, MatchJournal::SYNC_NUNCA);
+        manager.carregar();
+        PlayerManager::Id ana = manager.cadastrar("Ana", "ana");
+        PlayerManager::Id bia = manager.cadastrar("Bia", "bia");
+        for (int p = 1; p <= 10; ++p) manager.registrarPartida(ana, p);
+        manager.compactar(); // As 10 partidas vão para o arquivo .hist
+        manager.aguardarCompactacao();
+        manager.registrarPartida(bia, 4); // Esta fica só no diário
+
+        CHECK(manager.getPontuacoesPartidas().getTotal() == 11);
+        CHECK(manager.getRecordesJogadores().getTotal() == 2); // Um recorde por jogador
+        CHECK(manager.getRecordesJogadores().contarAbaixo(10) == 1);
+    }
+    CHECK(std::filesystem::exists(pasta / "players.hist"));
+
+    PlayerManager recarregado(arquivo, MatchJournal::SYNC_NUNCA);
+    recarregado.carregar();
+    const ScoreHistogram& partidas = recarregado.getPontuacoesPartidas();
+    REQUIRE(partidas.getTotal() == 11);
+    CHECK(partidas.contarAbaixo(5) == 5); // 1, 2, 3, 4 e o 4 da Bia
+    CHECK(recarregado.getRecordesJogadores().percentualAbaixo(10) == doctest::Approx(50.0));
+
+    std::filesystem::remove_all(pasta);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file LeaderboardDaemon.cpp
+ * @brief LeaderboardDaemonimplementação do projeto Traveling Dragon.
+ *
+ * Serviço de ranking compartilhado pelos gabinetes da mesma máquina: atende os jogos
+ * no socket local até receber Ctrl+C (ou SIGTERM) e guarda o ranking no arquivo.
+ * Cada jogo aponta para ele com `servidor_ranking=<socket>` no data/config.txt.
+ * Uso: leaderboard_daemon [socket] [arquivo].
+ */
+
+
+#include "LeaderboardServer.hpp" // Serviço
+#include <csignal>               // Para parar com Ctrl+C / SIGTERM
+#include <iostream>              // Para saída do resultado
+
+/// @brief Serviço em execução (para o tratador de sinal).
+static LeaderboardServer* servidor = nullptr;
+
+/**
+ * @brief Tratador de Ctrl+C e SIGTERM: só pede a parada (o laço termina e grava o arquivo).
+ * @param sinal O sinal recebido (não usado).
+ */
+static void pedirParada(int sinal) {
+    (void)sinal;
+    if (servidor) servidor->parar();
+}
+
+/**
+ * @brief Função principal do serviço de ranking.
+ * @param argc Quantidade de argumentos.
+ * @param argv Caminho do socket (padrão "ranking.sock") e do arquivo do ranking (padrão "ranking.txt").
+ * @return 0 em caso de sucesso, 1 se o socket não pôde ser aberto.
+ */
+int main(int argc, char** argv) {
+    std::string caminhoSocket = argc > 1 ? argv[1] : "ranking.sock";
+    std::string caminhoArquivo = argc > 2 ? argv[2] : "ranking.txt";
+
+    LeaderboardServer servico(caminhoSocket, caminhoArquivo);
+    if (!servico.iniciar()) {
+        std::cerr << "Erro ao iniciar o servico de ranking em " << caminhoSocket << ".\n";
+        return 1;
+    }
+    servidor = &servico;
+    std::signal(SIGINT, pedirParada);
+    std::signal(SIGTERM, pedirParada);
+
+    std::cout << "Servico de ranking em " << caminhoSocket << " (" << servico.getRanking().getQuantidade()
+              << " apelido(s) de " << caminhoArquivo << "). Ctrl+C para sair.\n";
+    servico.executar();
+    servidor = nullptr;
+
+    const LeaderboardServer::Estatisticas& e = servico.getEstatisticas();
+    std::cout << e.partidas << " partida(s) em " << e.lotes << " lote(s) de " << e.conexoes << " conexao(oes), "
+              << e.repetidas << " repetida(s), " << e.consultas << " consulta(s), " << e.invalidas
+              << " linha(s) invalida(s), " << e.origensEsquecidas << " origem(ns) esquecida(s); ranking gravado "
+              << e.gravacoes << " vez(es).\n";
+    return 0;
+}
@@ -0,0 +1,31 @@
+/**
+ * @file PackAssets.cpp
+ * @brief PackAssetsimplementação do projeto Traveling Dragon.
+ *
+ * Ferramenta que junta a pasta `assets/` em um único pacote (assets.tdpk) para o jogo
+ * mapear em memória. Uso: pack_assets [pasta] [saida].
+ */
+
+
+#include "AssetArchive.hpp" // Gravação do pacote
+#include <iostream>         // Para saída do resultado
+
+/**
+ * @brief Função principal da ferramenta de empacotamento.
+ * @param argc Quantidade de argumentos.
+ * @param argv Pasta dos assets (padrão "assets") e caminho do pacote (padrão "assets.tdpk").
+ * @return 0 em caso de sucesso, 1 em caso de erro.
+ */
+int main(int argc, char** argv) {
+    std::string diretorio = argc > 1 ? argv[1] : "assets";
+    std::string saida = argc > 2 ? argv[2] : "assets.tdpk";
+
+    int entradas = AssetArchive::construir(diretorio, saida);
+    if (entradas < 0) {
+        std::cerr << "Erro ao criar o pacote " << saida << ".\n";
+        return 1;
+    }
+
+    std::cout << entradas << " asset(s) de " << diretorio << " gravados em " << saida << ".\n";
+    return 0;
+}